@@ -374,9 +374,12 @@ gst_aravis_set_caps (GstBaseSrc *src, GstCaps *caps)
 			g_object_set (gst_aravis->stream, "packet-resend", ARV_GV_STREAM_PACKET_RESEND_NEVER, NULL);
 	}
 
-	for (i = 0; i < gst_aravis->num_arv_buffers; i++)
-		arv_stream_push_buffer (gst_aravis->stream,
-					arv_buffer_new (gst_aravis->payload, NULL));
+	gst_aravis->video_info_valid = gst_video_info_from_caps (&gst_aravis->video_info, caps);
+
+	if (!arv_stream_create_buffers (gst_aravis->stream, gst_aravis->num_arv_buffers, NULL, NULL, NULL))
+		for (i = 0; i < gst_aravis->num_arv_buffers; i++)
+			arv_stream_push_buffer (gst_aravis->stream,
+						arv_buffer_new (gst_aravis->payload, NULL));
 
 	GST_LOG_OBJECT (gst_aravis, "Start acquisition");
 	arv_camera_start_acquisition (gst_aravis->camera, &error);
@@ -559,11 +562,48 @@ gst_aravis_get_times (GstBaseSrc * basesrc, GstBuffer * buffer,
 	}
 }
 
+/* The ArvBuffer goes back to its stream once the last reference to the wrapping GstBuffer memory is dropped, which
+ * prevents the data from being overwritten while it is still used downstream. The stream is kept alive until then. */
+
+typedef struct {
+	ArvStream *stream;
+	ArvBuffer *buffer;
+} GstAravisBufferRelease;
+
+static void
+gst_aravis_release_buffer (gpointer data)
+{
+	GstAravisBufferRelease *release = data;
+
+	arv_stream_push_buffer (release->stream, release->buffer);
+	g_object_unref (release->stream);
+	g_free (release);
+}
+
+static gboolean
+gst_aravis_decide_allocation (GstBaseSrc *src, GstQuery *query)
+{
+	GstAravis *gst_aravis = GST_ARAVIS (src);
+	gboolean use_video_meta;
+
+	use_video_meta = gst_query_find_allocation_meta (query, GST_VIDEO_META_API_TYPE, NULL);
+
+	GST_OBJECT_LOCK (gst_aravis);
+	gst_aravis->use_video_meta = use_video_meta;
+	GST_OBJECT_UNLOCK (gst_aravis);
+
+	GST_DEBUG_OBJECT (gst_aravis, "Downstream %s video meta", use_video_meta ? "supports" : "does not support");
+
+	return GST_BASE_SRC_CLASS (gst_aravis_parent_class)->decide_allocation (src, query);
+}
+
 static GstFlowReturn
 gst_aravis_create (GstPushSrc * push_src, GstBuffer ** buffer)
 {
 	GstAravis *gst_aravis;
 	int arv_row_stride;
+	int gst_row_stride;
+	gboolean use_video_meta;
 	int width, height;
 	char *buffer_data;
 	size_t buffer_size;
@@ -589,15 +629,21 @@ gst_aravis_create (GstPushSrc * push_src, GstBuffer ** buffer)
 	arv_row_stride = width * ARV_PIXEL_FORMAT_BIT_PER_PIXEL (arv_buffer_get_image_pixel_format (arv_buffer)) / 8;
 	timestamp_ns = arv_buffer_get_timestamp (arv_buffer);
 
-	/* Gstreamer requires row stride to be a multiple of 4 */
-	if ((arv_row_stride & 0x3) != 0) {
-		int gst_row_stride;
+	/* Without video meta, Gstreamer expects the default stride of the format, which is a multiple of 4 */
+	if (gst_aravis->video_info_valid)
+		gst_row_stride = GST_VIDEO_INFO_PLANE_STRIDE (&gst_aravis->video_info, 0);
+	else
+		gst_row_stride = GST_ROUND_UP_4 (arv_row_stride);
+
+	use_video_meta = gst_aravis->use_video_meta &&
+		gst_aravis->video_info_valid &&
+		GST_VIDEO_INFO_N_PLANES (&gst_aravis->video_info) == 1;
+
+	if (arv_row_stride != gst_row_stride && !use_video_meta) {
 		size_t size;
 		char *data;
 		int i;
 
-		gst_row_stride = (arv_row_stride & ~(0x3)) + 4;
-
 		size = height * gst_row_stride;
 		data = g_malloc (size);
 
@@ -606,8 +652,23 @@ gst_aravis_create (GstPushSrc * push_src, GstBuffer ** buffer)
 
 		*buffer = gst_buffer_new_wrapped (data, size);
 	} else {
-		// FIXME Should arv_stream_push_buffer when the GstBuffer is destroyed
-		*buffer = gst_buffer_new_wrapped_full (0, buffer_data, buffer_size, 0, buffer_size, NULL, NULL);
+		GstAravisBufferRelease *release;
+
+		release = g_new (GstAravisBufferRelease, 1);
+		release->stream = g_object_ref (gst_aravis->stream);
+		release->buffer = g_steal_pointer (&arv_buffer);
+
+		*buffer = gst_buffer_new_wrapped_full (0, buffer_data, buffer_size, 0, buffer_size,
+						       release, gst_aravis_release_buffer);
+
+		if (use_video_meta) {
+			gsize offset[GST_VIDEO_MAX_PLANES] = { 0 };
+			gint stride[GST_VIDEO_MAX_PLANES] = { arv_row_stride };
+
+			gst_buffer_add_video_meta_full (*buffer, GST_VIDEO_FRAME_FLAG_NONE,
+							GST_VIDEO_INFO_FORMAT (&gst_aravis->video_info),
+							width, height, 1, offset, stride);
+		}
 	}
 
 	if (!base_src_does_timestamp) {
@@ -622,7 +683,9 @@ gst_aravis_create (GstPushSrc * push_src, GstBuffer ** buffer)
 		gst_aravis->last_timestamp = timestamp_ns;
 	}
 
-	arv_stream_push_buffer (gst_aravis->stream, arv_buffer);
+	/* Only the copied buffers are given back right away */
+	if (arv_buffer != NULL)
+		arv_stream_push_buffer (gst_aravis->stream, arv_buffer);
 	GST_OBJECT_UNLOCK (gst_aravis);
 
 	return GST_FLOW_OK;
@@ -1197,6 +1260,7 @@ gst_aravis_class_init (GstAravisClass * klass)
 	gstbasesrc_class->start = GST_DEBUG_FUNCPTR (gst_aravis_start);
 	gstbasesrc_class->stop = GST_DEBUG_FUNCPTR (gst_aravis_stop);
 	gstbasesrc_class->query = GST_DEBUG_FUNCPTR (gst_aravis_query);
+	gstbasesrc_class->decide_allocation = GST_DEBUG_FUNCPTR (gst_aravis_decide_allocation);
 
 	gstbasesrc_class->get_times = GST_DEBUG_FUNCPTR (gst_aravis_get_times);
 
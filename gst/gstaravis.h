@@ -28,6 +28,7 @@
 
 #include <gst/gst.h>
 #include <gst/base/gstpushsrc.h>
+#include <gst/video/video.h>
 #include <arv.h>
 
 G_BEGIN_DECLS
@@ -79,6 +80,11 @@ struct _GstAravis {
 
 	GstCaps *all_caps;
 
+	/* Negotiated format, only valid for raw video caps */
+	GstVideoInfo video_info;
+	gboolean video_info_valid;
+	gboolean use_video_meta;
+
 	guint64 timestamp_offset;
 	guint64 last_timestamp;
 
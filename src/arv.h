@@ -28,6 +28,7 @@
 #include <arvtypes.h>
 
 #include <arvbuffer.h>
+#include <arvbufferpool.h>
 #include <arvcamera.h>
 #include <arvchunkparser.h>
 #include <arvdebug.h>
@@ -103,6 +104,7 @@
 #include <arvgentldevice.h>
 #include <arvgentlstream.h>
 
+#include <arvimageconvert.h>
 #include <arvinterface.h>
 #include <arvmisc.h>
 #include <arvnetwork.h>
@@ -455,6 +455,46 @@ arv_buffer_set_system_timestamp (ArvBuffer *buffer, guint64 timestamp_ns)
 	buffer->priv->system_timestamp_ns = timestamp_ns;
 }
 
+/**
+ * arv_buffer_get_host_timestamp:
+ * @buffer: a #ArvBuffer
+ *
+ * Gets the device timestamp of the frame, converted to the host monotonic clock, the one of g_get_monotonic_time(),
+ * using a continuously fitted model of the offset and of the drift between the device and the host clocks. Unlike
+ * the system timestamp, it does not include the transmission latency, and unlike the device timestamp, it can be
+ * compared between devices. Expressed in nanoseconds.
+ *
+ * Returns: buffer host timestamp, in nanoseconds, or 0 if not available.
+ *
+ * Since: 0.10.0
+ */
+
+guint64
+arv_buffer_get_host_timestamp (ArvBuffer *buffer)
+{
+	g_return_val_if_fail (ARV_IS_BUFFER (buffer), 0);
+
+	return buffer->priv->host_timestamp_ns;
+}
+
+/**
+ * arv_buffer_set_host_timestamp:
+ * @buffer: a #ArvBuffer
+ * @timestamp_ns: a host monotonic timestamp, expressed in nanoseconds
+ *
+ * Sets the host timestamp of @buffer.
+ *
+ * Since: 0.10.0
+ */
+
+void
+arv_buffer_set_host_timestamp (ArvBuffer *buffer, guint64 timestamp_ns)
+{
+	g_return_if_fail (ARV_IS_BUFFER (buffer));
+
+	buffer->priv->host_timestamp_ns = timestamp_ns;
+}
+
 
 /**
  * arv_buffer_get_frame_id:
@@ -973,6 +1013,8 @@ arv_buffer_finalize (GObject *object)
 	if (buffer->priv->user_data && buffer->priv->user_data_destroy_func)
 		buffer->priv->user_data_destroy_func (buffer->priv->user_data);
 
+	g_clear_object (&buffer->priv->pool);
+
 	G_OBJECT_CLASS (arv_buffer_parent_class)->finalize (object);
 }
 
@@ -126,6 +126,8 @@ ARV_API guint64			arv_buffer_get_timestamp	(ArvBuffer *buffer);
 ARV_API void			arv_buffer_set_timestamp	(ArvBuffer *buffer, guint64 timestamp_ns);
 ARV_API guint64			arv_buffer_get_system_timestamp	(ArvBuffer *buffer);
 ARV_API void			arv_buffer_set_system_timestamp	(ArvBuffer *buffer, guint64 timestamp_ns);
+ARV_API guint64			arv_buffer_get_host_timestamp	(ArvBuffer *buffer);
+ARV_API void			arv_buffer_set_host_timestamp	(ArvBuffer *buffer, guint64 timestamp_ns);
 ARV_API void			arv_buffer_set_frame_id		(ArvBuffer *buffer, guint64 frame_id);
 ARV_API guint64 		arv_buffer_get_frame_id		(ArvBuffer *buffer);
 ARV_API const void *		arv_buffer_get_data		(ArvBuffer *buffer, size_t *size);
@@ -0,0 +1,539 @@
+/* Aravis - Digital camera library
+ *
+ * Copyright © 2009-2025 Emmanuel Pacaud <emmanuel.pacaud@free.fr>
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: Emmanuel Pacaud <emmanuel.pacaud@free.fr>
+ */
+
+/**
+ * ArvBufferPool:
+ *
+ * [class@ArvBufferPool] allocates the data of a set of buffers of the same size from a single memory arena.
+ *
+ * On Unix systems, the arena is an anonymous memory mapping, faulted in at creation, in order to not have page faults
+ * during the acquisition. It can optionally be backed by huge pages, limiting the TLB misses during the copy of large
+ * frames, be bound to a NUMA node, usually the one of the network adapter, and be locked in RAM. The data of each
+ * buffer is aligned on a configurable boundary, suitable for SIMD and DMA access.
+ *
+ * Each buffer holds a reference on the pool, the arena being released with the last of them.
+ *
+ * [method@ArvStream.create_buffers] uses a pool, configured with the `buffer-pool-flags` and `numa-node` stream
+ * properties.
+ */
+
+#include <arvbufferpool.h>
+#include <arvbufferprivate.h>
+#include <arvdebugprivate.h>
+#include <string.h>
+#include <errno.h>
+#include <stdio.h>
+
+#ifndef G_OS_WIN32
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#ifdef __linux__
+#include <sys/syscall.h>
+#include <linux/mempolicy.h>
+#endif
+
+#define ARV_BUFFER_POOL_HUGE_PAGE_SIZE_DEFAULT	(2 * 1024 * 1024)
+#define ARV_BUFFER_POOL_ALIGNMENT_MAX		(1 << 30)
+
+GQuark
+arv_buffer_pool_error_quark (void)
+{
+	return g_quark_from_static_string ("arv-buffer-pool-error-quark");
+}
+
+typedef struct {
+	GMutex mutex;
+
+	size_t buffer_size;
+	size_t stride;
+	size_t alignment;
+	guint n_buffers;
+	guint n_allocated_buffers;
+
+	/* Actual allocation, either a memory mapping or a heap block */
+	void *allocation;
+	size_t allocation_size;
+	gboolean is_mapped;
+
+	char *arena;
+	size_t size;
+	size_t page_size;
+	size_t locked_size;
+	gint numa_node;
+} ArvBufferPoolPrivate;
+
+struct _ArvBufferPool {
+	GObject	object;
+
+	ArvBufferPoolPrivate *priv;
+};
+
+struct _ArvBufferPoolClass {
+	GObjectClass parent_class;
+};
+
+G_DEFINE_TYPE_WITH_CODE (ArvBufferPool, arv_buffer_pool, G_TYPE_OBJECT, G_ADD_PRIVATE (ArvBufferPool))
+
+static size_t
+_round_up (size_t value, size_t alignment)
+{
+	return (value + alignment - 1) & ~(alignment - 1);
+}
+
+#ifndef G_OS_WIN32
+
+static size_t
+_get_huge_page_size (void)
+{
+#ifdef __linux__
+	char *meminfo = NULL;
+	char *line;
+	size_t size = ARV_BUFFER_POOL_HUGE_PAGE_SIZE_DEFAULT;
+
+	if (!g_file_get_contents ("/proc/meminfo", &meminfo, NULL, NULL))
+		return size;
+
+	line = strstr (meminfo, "Hugepagesize:");
+	if (line != NULL) {
+		unsigned long size_kb;
+
+		if (sscanf (line, "Hugepagesize: %lu kB", &size_kb) == 1 && size_kb > 0)
+			size = (size_t) size_kb * 1024;
+	}
+
+	g_free (meminfo);
+
+	return size;
+#else
+	return ARV_BUFFER_POOL_HUGE_PAGE_SIZE_DEFAULT;
+#endif
+}
+
+/* Maps size bytes aligned on alignment, trimming the excess of an oversized mapping */
+
+static gboolean
+_map (ArvBufferPoolPrivate *priv, size_t size, size_t alignment, int flags)
+{
+	size_t map_size;
+	char *mapping;
+	char *arena;
+
+	map_size = alignment > priv->page_size ? size + alignment : size;
+
+	mapping = mmap (NULL, map_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | flags, -1, 0);
+	if (mapping == MAP_FAILED)
+		return FALSE;
+
+	arena = (char *) _round_up ((size_t) mapping, alignment);
+	if (arena > mapping)
+		munmap (mapping, arena - mapping);
+	if (mapping + map_size > arena + size)
+		munmap (arena + size, (mapping + map_size) - (arena + size));
+
+	priv->allocation = arena;
+	priv->allocation_size = size;
+	priv->is_mapped = TRUE;
+	priv->arena = arena;
+	priv->size = size;
+
+	return TRUE;
+}
+
+static void
+_allocate (ArvBufferPoolPrivate *priv, size_t size, ArvBufferPoolFlags flags)
+{
+	priv->page_size = sysconf (_SC_PAGESIZE);
+
+	if ((flags & ARV_BUFFER_POOL_FLAGS_HUGE_PAGES) != 0) {
+		size_t huge_page_size = _get_huge_page_size ();
+
+#ifdef MAP_HUGETLB
+		/* Only succeeds if enough huge pages are reserved, see /proc/sys/vm/nr_hugepages */
+		if (priv->alignment <= huge_page_size &&
+		    _map (priv, _round_up (size, huge_page_size), priv->page_size, MAP_HUGETLB)) {
+			priv->page_size = huge_page_size;
+			arv_info_stream ("[BufferPool::allocate] %" G_GSIZE_FORMAT " bytes in %" G_GSIZE_FORMAT
+					 " bytes huge pages", priv->size, huge_page_size);
+			return;
+		}
+#endif
+#ifdef MADV_HUGEPAGE
+		if (_map (priv, _round_up (size, huge_page_size), MAX (priv->alignment, huge_page_size), 0)) {
+			if (madvise (priv->arena, priv->size, MADV_HUGEPAGE) == 0)
+				arv_info_stream ("[BufferPool::allocate] %" G_GSIZE_FORMAT
+						 " bytes, using transparent huge pages", priv->size);
+			else
+				arv_warning_stream ("[BufferPool::allocate] Transparent huge pages not available");
+			return;
+		}
+#endif
+		arv_warning_stream ("[BufferPool::allocate] Huge pages not available");
+	}
+
+	_map (priv, _round_up (size, priv->page_size), priv->alignment, 0);
+}
+
+static void
+_bind (ArvBufferPoolPrivate *priv, gint numa_node)
+{
+#if defined (__linux__) && defined (SYS_mbind)
+	unsigned long *node_mask;
+	unsigned long n_bits = 8 * sizeof (unsigned long);
+	unsigned long n_words = numa_node / n_bits + 1;
+
+	node_mask = g_new0 (unsigned long, n_words);
+	node_mask[numa_node / n_bits] = 1UL << (numa_node % n_bits);
+
+	/* Preferred rather than strict binding, as a strict one turns an exhausted node into a SIGBUS for huge pages */
+	if (syscall (SYS_mbind, priv->arena, priv->size, MPOL_PREFERRED, node_mask, n_words * n_bits + 1, 0) == 0)
+		priv->numa_node = numa_node;
+	else
+		arv_warning_stream ("[BufferPool::bind] Failed to bind memory to NUMA node %d: %s",
+				    numa_node, g_strerror (errno));
+
+	g_free (node_mask);
+#else
+	arv_warning_stream ("[BufferPool::bind] NUMA binding not supported");
+#endif
+}
+
+#endif
+
+/**
+ * arv_buffer_pool_new:
+ * @buffer_size: size of the data of each buffer, in bytes
+ * @n_buffers: number of buffers
+ * @alignment: alignment of each buffer data, a power of 2, or 0 for %ARV_BUFFER_POOL_DEFAULT_ALIGNMENT
+ * @numa_node: NUMA node the memory is bound to, or %ARV_BUFFER_POOL_NUMA_NODE_NONE
+ * @flags: allocation flags
+ * @error: a #GError placeholder, %NULL to ignore
+ *
+ * Allocates the memory for @n_buffers buffers of @buffer_size bytes. Huge pages, NUMA binding and memory locking are
+ * best effort, a failure only being reported in the debug log. The outcome can be checked using
+ * [method@ArvBufferPool.get_page_size], [method@ArvBufferPool.get_numa_node] and
+ * [method@ArvBufferPool.get_locked_size].
+ *
+ * Returns: (transfer full): a new #ArvBufferPool, %NULL on error
+ *
+ * Since: 0.10.0
+ */
+
+ArvBufferPool *
+arv_buffer_pool_new (size_t buffer_size, guint n_buffers, size_t alignment, gint numa_node,
+		     ArvBufferPoolFlags flags, GError **error)
+{
+	ArvBufferPool *pool;
+	ArvBufferPoolPrivate *priv;
+	size_t size;
+
+	if (alignment == 0)
+		alignment = ARV_BUFFER_POOL_DEFAULT_ALIGNMENT;
+
+	if (buffer_size == 0 || n_buffers == 0) {
+		g_set_error (error, ARV_BUFFER_POOL_ERROR, ARV_BUFFER_POOL_ERROR_INVALID_PARAMETER,
+			     "Invalid buffer size or count");
+		return NULL;
+	}
+
+	if ((alignment & (alignment - 1)) != 0 || alignment > ARV_BUFFER_POOL_ALIGNMENT_MAX) {
+		g_set_error (error, ARV_BUFFER_POOL_ERROR, ARV_BUFFER_POOL_ERROR_INVALID_PARAMETER,
+			     "Invalid alignment (%" G_GSIZE_FORMAT ")", alignment);
+		return NULL;
+	}
+
+	if (_round_up (buffer_size, alignment) < buffer_size ||
+	    _round_up (buffer_size, alignment) > G_MAXSIZE / 2 / n_buffers) {
+		g_set_error (error, ARV_BUFFER_POOL_ERROR, ARV_BUFFER_POOL_ERROR_INVALID_PARAMETER,
+			     "Pool size overflow");
+		return NULL;
+	}
+
+	pool = g_object_new (ARV_TYPE_BUFFER_POOL, NULL);
+	priv = pool->priv;
+
+	priv->buffer_size = buffer_size;
+	priv->alignment = alignment;
+	priv->stride = _round_up (buffer_size, alignment);
+	priv->n_buffers = n_buffers;
+
+	size = priv->stride * n_buffers;
+
+#ifndef G_OS_WIN32
+	_allocate (priv, size, flags);
+
+	if (priv->arena != NULL) {
+		size_t offset;
+
+		if (numa_node >= 0)
+			_bind (priv, numa_node);
+
+		/* Fault the pages in now, after the memory policy is set, rather than during the acquisition */
+		for (offset = 0; offset < priv->size; offset += priv->page_size)
+			priv->arena[offset] = 0;
+
+		if ((flags & ARV_BUFFER_POOL_FLAGS_LOCK) != 0) {
+			if (mlock (priv->arena, priv->size) == 0)
+				priv->locked_size = priv->size;
+			else
+				arv_warning_stream ("[BufferPool::new] Failed to lock %" G_GSIZE_FORMAT " bytes: %s",
+						    priv->size, g_strerror (errno));
+		}
+	}
+#endif
+
+	if (priv->arena == NULL) {
+		/* Heap fallback, without any of the optional features */
+		priv->page_size = 0;
+		priv->allocation = g_try_malloc (size + alignment);
+		if (priv->allocation == NULL) {
+			g_set_error (error, ARV_BUFFER_POOL_ERROR, ARV_BUFFER_POOL_ERROR_OUT_OF_MEMORY,
+				     "Failed to allocate %" G_GSIZE_FORMAT " bytes", size);
+			g_object_unref (pool);
+			return NULL;
+		}
+		priv->allocation_size = size + alignment;
+		priv->arena = (char *) _round_up ((size_t) priv->allocation, alignment);
+		priv->size = size;
+	}
+
+	arv_info_stream ("[BufferPool::new] %u buffers of %" G_GSIZE_FORMAT " bytes, stride %" G_GSIZE_FORMAT
+			 ", pool size %" G_GSIZE_FORMAT ", NUMA node %d, %" G_GSIZE_FORMAT " bytes locked",
+			 n_buffers, buffer_size, priv->stride, priv->size, priv->numa_node, priv->locked_size);
+
+	return pool;
+}
+
+/**
+ * arv_buffer_pool_new_buffer:
+ * @pool: a #ArvBufferPool
+ * @user_data: (nullable): a pointer to user data associated to this buffer
+ * @user_data_destroy_func: (nullable): an optional user data destroy callback
+ *
+ * Creates a new buffer using the next free slot of @pool. The slots are not reused, even after the corresponding
+ * buffer destruction.
+ *
+ * Returns: (transfer full) (nullable): a new #ArvBuffer, %NULL if all the pool slots are used
+ *
+ * Since: 0.10.0
+ */
+
+ArvBuffer *
+arv_buffer_pool_new_buffer (ArvBufferPool *pool, void *user_data, GDestroyNotify user_data_destroy_func)
+{
+	ArvBuffer *buffer;
+	guint index;
+
+	g_return_val_if_fail (ARV_IS_BUFFER_POOL (pool), NULL);
+
+	g_mutex_lock (&pool->priv->mutex);
+	if (pool->priv->n_allocated_buffers >= pool->priv->n_buffers) {
+		g_mutex_unlock (&pool->priv->mutex);
+		return NULL;
+	}
+	index = pool->priv->n_allocated_buffers++;
+	g_mutex_unlock (&pool->priv->mutex);
+
+	buffer = arv_buffer_new_full (pool->priv->buffer_size, pool->priv->arena + (size_t) index * pool->priv->stride,
+				      user_data, user_data_destroy_func);
+	buffer->priv->pool = g_object_ref (pool);
+
+	return buffer;
+}
+
+/**
+ * arv_buffer_pool_get_n_buffers:
+ * @pool: a #ArvBufferPool
+ *
+ * Returns: the number of buffer slots of @pool
+ *
+ * Since: 0.10.0
+ */
+
+guint
+arv_buffer_pool_get_n_buffers (ArvBufferPool *pool)
+{
+	g_return_val_if_fail (ARV_IS_BUFFER_POOL (pool), 0);
+
+	return pool->priv->n_buffers;
+}
+
+/**
+ * arv_buffer_pool_get_n_available_buffers:
+ * @pool: a #ArvBufferPool
+ *
+ * Returns: the number of buffer slots not used yet by [method@ArvBufferPool.new_buffer]
+ *
+ * Since: 0.10.0
+ */
+
+guint
+arv_buffer_pool_get_n_available_buffers (ArvBufferPool *pool)
+{
+	guint n_available;
+
+	g_return_val_if_fail (ARV_IS_BUFFER_POOL (pool), 0);
+
+	g_mutex_lock (&pool->priv->mutex);
+	n_available = pool->priv->n_buffers - pool->priv->n_allocated_buffers;
+	g_mutex_unlock (&pool->priv->mutex);
+
+	return n_available;
+}
+
+/**
+ * arv_buffer_pool_get_buffer_size:
+ * @pool: a #ArvBufferPool
+ *
+ * Returns: the data size of the buffers, in bytes
+ *
+ * Since: 0.10.0
+ */
+
+size_t
+arv_buffer_pool_get_buffer_size (ArvBufferPool *pool)
+{
+	g_return_val_if_fail (ARV_IS_BUFFER_POOL (pool), 0);
+
+	return pool->priv->buffer_size;
+}
+
+/**
+ * arv_buffer_pool_get_alignment:
+ * @pool: a #ArvBufferPool
+ *
+ * Returns: the alignment of the buffer data, in bytes
+ *
+ * Since: 0.10.0
+ */
+
+size_t
+arv_buffer_pool_get_alignment (ArvBufferPool *pool)
+{
+	g_return_val_if_fail (ARV_IS_BUFFER_POOL (pool), 0);
+
+	return pool->priv->alignment;
+}
+
+/**
+ * arv_buffer_pool_get_size:
+ * @pool: a #ArvBufferPool
+ *
+ * Returns: the size of the pool memory, in bytes
+ *
+ * Since: 0.10.0
+ */
+
+size_t
+arv_buffer_pool_get_size (ArvBufferPool *pool)
+{
+	g_return_val_if_fail (ARV_IS_BUFFER_POOL (pool), 0);
+
+	return pool->priv->size;
+}
+
+/**
+ * arv_buffer_pool_get_page_size:
+ * @pool: a #ArvBufferPool
+ *
+ * Returns: the size of the pages backing the pool, in bytes, 0 if unknown. Transparent huge pages are not reported, as
+ * the kernel may not use them.
+ *
+ * Since: 0.10.0
+ */
+
+size_t
+arv_buffer_pool_get_page_size (ArvBufferPool *pool)
+{
+	g_return_val_if_fail (ARV_IS_BUFFER_POOL (pool), 0);
+
+	return pool->priv->page_size;
+}
+
+/**
+ * arv_buffer_pool_get_locked_size:
+ * @pool: a #ArvBufferPool
+ *
+ * Returns: the number of bytes locked in RAM
+ *
+ * Since: 0.10.0
+ */
+
+size_t
+arv_buffer_pool_get_locked_size (ArvBufferPool *pool)
+{
+	g_return_val_if_fail (ARV_IS_BUFFER_POOL (pool), 0);
+
+	return pool->priv->locked_size;
+}
+
+/**
+ * arv_buffer_pool_get_numa_node:
+ * @pool: a #ArvBufferPool
+ *
+ * Returns: the NUMA node the pool memory is bound to, %ARV_BUFFER_POOL_NUMA_NODE_NONE if not bound
+ *
+ * Since: 0.10.0
+ */
+
+gint
+arv_buffer_pool_get_numa_node (ArvBufferPool *pool)
+{
+	g_return_val_if_fail (ARV_IS_BUFFER_POOL (pool), ARV_BUFFER_POOL_NUMA_NODE_NONE);
+
+	return pool->priv->numa_node;
+}
+
+static void
+arv_buffer_pool_init (ArvBufferPool *pool)
+{
+	pool->priv = arv_buffer_pool_get_instance_private (pool);
+	pool->priv->numa_node = ARV_BUFFER_POOL_NUMA_NODE_NONE;
+
+	g_mutex_init (&pool->priv->mutex);
+}
+
+static void
+_finalize (GObject *object)
+{
+	ArvBufferPool *pool = ARV_BUFFER_POOL (object);
+
+#ifndef G_OS_WIN32
+	if (pool->priv->is_mapped)
+		munmap (pool->priv->allocation, pool->priv->allocation_size);
+	else
+#endif
+		g_free (pool->priv->allocation);
+
+	g_mutex_clear (&pool->priv->mutex);
+
+	G_OBJECT_CLASS (arv_buffer_pool_parent_class)->finalize (object);
+}
+
+static void
+arv_buffer_pool_class_init (ArvBufferPoolClass *pool_class)
+{
+	GObjectClass *object_class = G_OBJECT_CLASS (pool_class);
+
+	object_class->finalize = _finalize;
+}
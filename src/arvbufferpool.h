@@ -0,0 +1,121 @@
+/* Aravis - Digital camera library
+ *
+ * Copyright © 2009-2025 Emmanuel Pacaud <emmanuel.pacaud@free.fr>
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: Emmanuel Pacaud <emmanuel.pacaud@free.fr>
+ */
+
+#ifndef ARV_BUFFER_POOL_H
+#define ARV_BUFFER_POOL_H
+
+#if !defined (ARV_H_INSIDE) && !defined (ARAVIS_COMPILATION)
+#error "Only <arv.h> can be included directly."
+#endif
+
+#include <arvapi.h>
+#include <arvtypes.h>
+#include <arvbuffer.h>
+
+G_BEGIN_DECLS
+
+#define ARV_BUFFER_POOL_ERROR arv_buffer_pool_error_quark()
+
+ARV_API GQuark		arv_buffer_pool_error_quark		(void);
+
+/**
+ * ArvBufferPoolError:
+ * @ARV_BUFFER_POOL_ERROR_INVALID_PARAMETER: invalid pool parameter
+ * @ARV_BUFFER_POOL_ERROR_OUT_OF_MEMORY: memory mapping failed
+ *
+ * Since: 0.10.0
+ */
+
+typedef enum {
+	ARV_BUFFER_POOL_ERROR_INVALID_PARAMETER,
+	ARV_BUFFER_POOL_ERROR_OUT_OF_MEMORY
+} ArvBufferPoolError;
+
+/**
+ * ArvBufferPoolFlags:
+ * @ARV_BUFFER_POOL_FLAGS_NONE: standard pages
+ * @ARV_BUFFER_POOL_FLAGS_HUGE_PAGES: back the pool with huge pages, using hugetlbfs pages if reserved, transparent huge
+ * pages otherwise
+ * @ARV_BUFFER_POOL_FLAGS_LOCK: lock the pool memory in RAM
+ *
+ * Since: 0.10.0
+ */
+
+typedef enum {
+	ARV_BUFFER_POOL_FLAGS_NONE =		0,
+	ARV_BUFFER_POOL_FLAGS_HUGE_PAGES =	1 << 0,
+	ARV_BUFFER_POOL_FLAGS_LOCK =		1 << 1
+} ArvBufferPoolFlags;
+
+/**
+ * ARV_BUFFER_POOL_NUMA_NODE_AUTO:
+ *
+ * Let the stream select the NUMA node of the network adapter, if known.
+ *
+ * Since: 0.10.0
+ */
+
+#define ARV_BUFFER_POOL_NUMA_NODE_AUTO		-1
+
+/**
+ * ARV_BUFFER_POOL_NUMA_NODE_NONE:
+ *
+ * Use the default memory policy.
+ *
+ * Since: 0.10.0
+ */
+
+#define ARV_BUFFER_POOL_NUMA_NODE_NONE		-2
+
+/**
+ * ARV_BUFFER_POOL_DEFAULT_ALIGNMENT:
+ *
+ * Default buffer data alignment, suitable for SIMD access and DMA.
+ *
+ * Since: 0.10.0
+ */
+
+#define ARV_BUFFER_POOL_DEFAULT_ALIGNMENT	4096
+
+#define ARV_TYPE_BUFFER_POOL             (arv_buffer_pool_get_type ())
+ARV_API G_DECLARE_FINAL_TYPE (ArvBufferPool, arv_buffer_pool, ARV, BUFFER_POOL, GObject)
+
+ARV_API ArvBufferPool *		arv_buffer_pool_new			(size_t buffer_size, guint n_buffers,
+									 size_t alignment, gint numa_node,
+									 ArvBufferPoolFlags flags, GError **error);
+
+ARV_API ArvBuffer *		arv_buffer_pool_new_buffer		(ArvBufferPool *pool,
+									 void *user_data,
+									 GDestroyNotify user_data_destroy_func);
+
+ARV_API guint			arv_buffer_pool_get_n_buffers		(ArvBufferPool *pool);
+ARV_API guint			arv_buffer_pool_get_n_available_buffers	(ArvBufferPool *pool);
+ARV_API size_t			arv_buffer_pool_get_buffer_size		(ArvBufferPool *pool);
+ARV_API size_t			arv_buffer_pool_get_alignment		(ArvBufferPool *pool);
+ARV_API size_t			arv_buffer_pool_get_size		(ArvBufferPool *pool);
+ARV_API size_t			arv_buffer_pool_get_page_size		(ArvBufferPool *pool);
+ARV_API size_t			arv_buffer_pool_get_locked_size		(ArvBufferPool *pool);
+ARV_API gint			arv_buffer_pool_get_numa_node		(ArvBufferPool *pool);
+
+G_END_DECLS
+
+#endif
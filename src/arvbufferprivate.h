@@ -24,6 +24,7 @@
 #define ARV_BUFFER_PRIVATE_H
 
 #include <arvbuffer.h>
+#include <arvbufferpool.h>
 #include <arvgvspprivate.h>
 #include <stddef.h>
 
@@ -47,6 +48,8 @@ typedef struct {
 	size_t allocated_size;
 	gboolean is_preallocated;
 	unsigned char *data;
+	/* Owner of the preallocated data, if any */
+	ArvBufferPool *pool;
 
 	void *user_data;
 	GDestroyNotify user_data_destroy_func;
@@ -62,6 +65,10 @@ typedef struct {
 	guint64 frame_id;
 	guint64 timestamp_ns;
 	guint64 system_timestamp_ns;
+	/* Device timestamp mapped to the host monotonic clock, 0 if not available */
+	guint64 host_timestamp_ns;
+	/* Monotonic time of the push to the stream output queue, in µs */
+	gint64 output_time_us;
 
         guint n_parts;
         ArvBufferPartInfos *parts;
@@ -0,0 +1,591 @@
+/* Aravis - Digital camera library
+ *
+ * Copyright © 2009-2025 Emmanuel Pacaud <emmanuel.pacaud@free.fr>
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: Emmanuel Pacaud <emmanuel.pacaud@free.fr>
+ */
+
+/*< private >
+ * SECTION:arvbufferqueue
+ * @title: ArvBufferQueue
+ * @short_description: buffer queue used between the stream threads
+ *
+ * #ArvBufferQueue is a multiple producer / multiple consumer FIFO of #ArvBuffer. The common path is a bounded lock
+ * free ring, in which each cell carries a sequence number telling if it is ready to be written or read. The ring is
+ * allocated once, with a size set by the first call to arv_buffer_queue_reserve(), usually from the buffer count
+ * given to arv_stream_create_buffers(). Buffers pushed when the ring is full go to an overflow list protected by a
+ * mutex, and as long as this list is not empty, the new buffers are appended to it, which keeps the queue order.
+ *
+ * The mutex and the associated condition are also used for the blocking pops, but only when the queue is found
+ * empty. Producers only take the mutex if a consumer is actually waiting.
+ *
+ * Buffers can also be moved in batches, a contiguous range of cells being claimed by a single compare and exchange
+ * of the queue position, with at most one wakeup of the waiting consumers.
+ */
+
+#include <arvbufferqueueprivate.h>
+
+typedef struct {
+	guint sequence;
+	ArvBuffer *buffer;
+} ArvBufferQueueCell;
+
+typedef struct {
+	guint mask;
+	ArvBufferQueueCell cells[];
+} ArvBufferQueueRing;
+
+struct _ArvBufferQueue {
+	ArvBufferQueueRing *ring;
+
+	/* Producer and consumer positions on separate cache lines */
+	char padding_0[64];
+	guint enqueue_position;
+	char padding_1[64];
+	guint dequeue_position;
+	char padding_2[64];
+
+	GMutex mutex;
+	GCond cond;
+	gint n_waiters;
+	GQueue overflow;
+	gint n_overflow;
+};
+
+static gboolean
+_ring_push (ArvBufferQueue *queue, ArvBuffer *buffer)
+{
+	ArvBufferQueueRing *ring = g_atomic_pointer_get (&queue->ring);
+	ArvBufferQueueCell *cell;
+	guint position;
+
+	if (ring == NULL)
+		return FALSE;
+
+	position = g_atomic_int_get (&queue->enqueue_position);
+
+	for (;;) {
+		gint diff;
+
+		cell = &ring->cells[position & ring->mask];
+		diff = (gint) (g_atomic_int_get (&cell->sequence) - position);
+
+		if (diff == 0) {
+			if (g_atomic_int_compare_and_exchange (&queue->enqueue_position, position, position + 1))
+				break;
+		} else if (diff < 0) {
+			/* Full */
+			return FALSE;
+		}
+
+		position = g_atomic_int_get (&queue->enqueue_position);
+	}
+
+	cell->buffer = buffer;
+	g_atomic_int_set (&cell->sequence, position + 1);
+
+	return TRUE;
+}
+
+static ArvBuffer *
+_ring_pop (ArvBufferQueue *queue)
+{
+	ArvBufferQueueRing *ring = g_atomic_pointer_get (&queue->ring);
+	ArvBufferQueueCell *cell;
+	ArvBuffer *buffer;
+	guint position;
+
+	if (ring == NULL)
+		return NULL;
+
+	position = g_atomic_int_get (&queue->dequeue_position);
+
+	for (;;) {
+		gint diff;
+
+		cell = &ring->cells[position & ring->mask];
+		diff = (gint) (g_atomic_int_get (&cell->sequence) - (position + 1));
+
+		if (diff == 0) {
+			if (g_atomic_int_compare_and_exchange (&queue->dequeue_position, position, position + 1))
+				break;
+		} else if (diff < 0) {
+			/* Empty */
+			return NULL;
+		}
+
+		position = g_atomic_int_get (&queue->dequeue_position);
+	}
+
+	buffer = cell->buffer;
+	cell->buffer = NULL;
+	g_atomic_int_set (&cell->sequence, position + ring->mask + 1);
+
+	return buffer;
+}
+
+/* Claims up to n_buffers contiguous cells ready to be written */
+
+static guint
+_ring_push_many (ArvBufferQueue *queue, ArvBuffer **buffers, guint n_buffers)
+{
+	ArvBufferQueueRing *ring = g_atomic_pointer_get (&queue->ring);
+	guint position;
+	guint n_free;
+	guint i;
+
+	if (ring == NULL || n_buffers == 0)
+		return 0;
+
+	n_buffers = MIN (n_buffers, ring->mask + 1);
+
+	do {
+		position = g_atomic_int_get (&queue->enqueue_position);
+
+		for (n_free = 0; n_free < n_buffers; n_free++) {
+			guint cell_position = position + n_free;
+
+			if (g_atomic_int_get (&ring->cells[cell_position & ring->mask].sequence) != cell_position)
+				break;
+		}
+
+		if (n_free == 0) {
+			/* Full, unless another producer just moved the position */
+			if (position == g_atomic_int_get (&queue->enqueue_position))
+				return 0;
+			continue;
+		}
+	} while (!g_atomic_int_compare_and_exchange (&queue->enqueue_position, position, position + n_free));
+
+	for (i = 0; i < n_free; i++) {
+		ArvBufferQueueCell *cell = &ring->cells[(position + i) & ring->mask];
+
+		cell->buffer = buffers[i];
+		g_atomic_int_set (&cell->sequence, position + i + 1);
+	}
+
+	return n_free;
+}
+
+/* Claims up to max_buffers contiguous cells ready to be read */
+
+static guint
+_ring_pop_many (ArvBufferQueue *queue, ArvBuffer **buffers, guint max_buffers)
+{
+	ArvBufferQueueRing *ring = g_atomic_pointer_get (&queue->ring);
+	guint position;
+	guint n_ready;
+	guint i;
+
+	if (ring == NULL || max_buffers == 0)
+		return 0;
+
+	max_buffers = MIN (max_buffers, ring->mask + 1);
+
+	do {
+		position = g_atomic_int_get (&queue->dequeue_position);
+
+		for (n_ready = 0; n_ready < max_buffers; n_ready++) {
+			guint cell_position = position + n_ready;
+
+			if (g_atomic_int_get (&ring->cells[cell_position & ring->mask].sequence) != cell_position + 1)
+				break;
+		}
+
+		if (n_ready == 0) {
+			/* Empty, unless another consumer just moved the position */
+			if (position == g_atomic_int_get (&queue->dequeue_position))
+				return 0;
+			continue;
+		}
+	} while (!g_atomic_int_compare_and_exchange (&queue->dequeue_position, position, position + n_ready));
+
+	for (i = 0; i < n_ready; i++) {
+		ArvBufferQueueCell *cell = &ring->cells[(position + i) & ring->mask];
+
+		buffers[i] = cell->buffer;
+		cell->buffer = NULL;
+		g_atomic_int_set (&cell->sequence, position + i + ring->mask + 1);
+	}
+
+	return n_ready;
+}
+
+/* Must be called with the mutex locked */
+
+static ArvBuffer *
+_try_pop_unlocked (ArvBufferQueue *queue)
+{
+	ArvBuffer *buffer;
+
+	buffer = _ring_pop (queue);
+	if (buffer == NULL && queue->n_overflow > 0) {
+		buffer = g_queue_pop_head (&queue->overflow);
+		g_atomic_int_add (&queue->n_overflow, -1);
+	}
+
+	return buffer;
+}
+
+static ArvBuffer *
+_pop (ArvBufferQueue *queue, gboolean wait_forever, gint64 end_time)
+{
+	ArvBuffer *buffer;
+
+	buffer = arv_buffer_queue_try_pop (queue);
+	if (buffer != NULL)
+		return buffer;
+
+	g_mutex_lock (&queue->mutex);
+
+	/* The waiter count is incremented before the queue is checked again, and the producers check it after their
+	 * push, so either the buffer is seen here, or the producer signals the condition. */
+	g_atomic_int_inc (&queue->n_waiters);
+
+	while ((buffer = _try_pop_unlocked (queue)) == NULL) {
+		if (wait_forever)
+			g_cond_wait (&queue->cond, &queue->mutex);
+		else if (!g_cond_wait_until (&queue->cond, &queue->mutex, end_time)) {
+			buffer = _try_pop_unlocked (queue);
+			break;
+		}
+	}
+
+	g_atomic_int_add (&queue->n_waiters, -1);
+
+	g_mutex_unlock (&queue->mutex);
+
+	return buffer;
+}
+
+/**
+ * arv_buffer_queue_new: (skip)
+ *
+ * Returns: a new empty #ArvBufferQueue
+ */
+
+ArvBufferQueue *
+arv_buffer_queue_new (void)
+{
+	ArvBufferQueue *queue;
+
+	queue = g_new0 (ArvBufferQueue, 1);
+
+	g_mutex_init (&queue->mutex);
+	g_cond_init (&queue->cond);
+	g_queue_init (&queue->overflow);
+
+	return queue;
+}
+
+/**
+ * arv_buffer_queue_free: (skip)
+ * @queue: a #ArvBufferQueue
+ *
+ * Frees @queue. The queue is expected to be empty, buffers still in it are not unreferenced.
+ */
+
+void
+arv_buffer_queue_free (ArvBufferQueue *queue)
+{
+	if (queue == NULL)
+		return;
+
+	g_queue_clear (&queue->overflow);
+	g_cond_clear (&queue->cond);
+	g_mutex_clear (&queue->mutex);
+
+	g_free (queue->ring);
+	g_free (queue);
+}
+
+/**
+ * arv_buffer_queue_reserve: (skip)
+ * @queue: a #ArvBufferQueue
+ * @n_buffers: expected number of buffers
+ *
+ * Allocates the lock free ring of @queue, rounding @n_buffers up to a power of 2. The ring is only allocated once,
+ * the later calls have no effect.
+ *
+ * Returns: %TRUE if the ring can hold @n_buffers
+ */
+
+gboolean
+arv_buffer_queue_reserve (ArvBufferQueue *queue, guint n_buffers)
+{
+	ArvBufferQueueRing *ring;
+	guint size;
+	guint i;
+
+	g_return_val_if_fail (queue != NULL, FALSE);
+
+	ring = g_atomic_pointer_get (&queue->ring);
+	if (ring != NULL)
+		return ring->mask + 1 >= n_buffers;
+
+	for (size = ARV_BUFFER_QUEUE_SIZE_MIN; size < n_buffers && size < ARV_BUFFER_QUEUE_SIZE_MAX; size *= 2);
+
+	ring = g_malloc (sizeof (ArvBufferQueueRing) + size * sizeof (ArvBufferQueueCell));
+	ring->mask = size - 1;
+	for (i = 0; i < size; i++) {
+		ring->cells[i].sequence = i;
+		ring->cells[i].buffer = NULL;
+	}
+
+	/* The positions are still 0, as nothing went through the ring yet */
+	if (!g_atomic_pointer_compare_and_exchange (&queue->ring, NULL, ring)) {
+		g_free (ring);
+		ring = g_atomic_pointer_get (&queue->ring);
+	}
+
+	return ring->mask + 1 >= n_buffers;
+}
+
+/**
+ * arv_buffer_queue_push: (skip)
+ * @queue: a #ArvBufferQueue
+ * @buffer: (transfer full): a #ArvBuffer
+ *
+ * Appends @buffer to @queue, waking up a waiting consumer if any.
+ */
+
+void
+arv_buffer_queue_push (ArvBufferQueue *queue, ArvBuffer *buffer)
+{
+	g_return_if_fail (queue != NULL);
+	g_return_if_fail (buffer != NULL);
+
+	if (G_UNLIKELY (g_atomic_pointer_get (&queue->ring) == NULL))
+		arv_buffer_queue_reserve (queue, ARV_BUFFER_QUEUE_SIZE_MIN);
+
+	if (G_LIKELY (g_atomic_int_get (&queue->n_overflow) == 0 && _ring_push (queue, buffer))) {
+		if (G_LIKELY (g_atomic_int_get (&queue->n_waiters) == 0))
+			return;
+
+		g_mutex_lock (&queue->mutex);
+		g_cond_signal (&queue->cond);
+		g_mutex_unlock (&queue->mutex);
+		return;
+	}
+
+	g_mutex_lock (&queue->mutex);
+	g_queue_push_tail (&queue->overflow, buffer);
+	g_atomic_int_inc (&queue->n_overflow);
+	g_cond_signal (&queue->cond);
+	g_mutex_unlock (&queue->mutex);
+}
+
+/**
+ * arv_buffer_queue_try_pop: (skip)
+ * @queue: a #ArvBufferQueue
+ *
+ * Returns: (transfer full) (nullable): the oldest buffer of @queue, %NULL if it is empty
+ */
+
+ArvBuffer *
+arv_buffer_queue_try_pop (ArvBufferQueue *queue)
+{
+	ArvBuffer *buffer;
+
+	g_return_val_if_fail (queue != NULL, NULL);
+
+	buffer = _ring_pop (queue);
+	if (buffer != NULL || g_atomic_int_get (&queue->n_overflow) == 0)
+		return buffer;
+
+	g_mutex_lock (&queue->mutex);
+	buffer = _try_pop_unlocked (queue);
+	g_mutex_unlock (&queue->mutex);
+
+	return buffer;
+}
+
+/**
+ * arv_buffer_queue_push_many: (skip)
+ * @queue: a #ArvBufferQueue
+ * @buffers: (array length=n_buffers) (transfer full): buffers to append
+ * @n_buffers: number of buffers
+ *
+ * Appends @buffers to @queue, in order, waking up the waiting consumers at most once.
+ */
+
+void
+arv_buffer_queue_push_many (ArvBufferQueue *queue, ArvBuffer **buffers, guint n_buffers)
+{
+	guint n_pushed = 0;
+	guint i;
+
+	g_return_if_fail (queue != NULL);
+	g_return_if_fail (buffers != NULL || n_buffers == 0);
+
+	if (n_buffers == 0)
+		return;
+
+	if (G_UNLIKELY (g_atomic_pointer_get (&queue->ring) == NULL))
+		arv_buffer_queue_reserve (queue, MAX (n_buffers, ARV_BUFFER_QUEUE_SIZE_MIN));
+
+	if (G_LIKELY (g_atomic_int_get (&queue->n_overflow) == 0)) {
+		guint n;
+
+		while (n_pushed < n_buffers &&
+		       (n = _ring_push_many (queue, buffers + n_pushed, n_buffers - n_pushed)) > 0)
+			n_pushed += n;
+
+		if (G_LIKELY (n_pushed == n_buffers)) {
+			if (G_LIKELY (g_atomic_int_get (&queue->n_waiters) == 0))
+				return;
+
+			g_mutex_lock (&queue->mutex);
+			g_cond_broadcast (&queue->cond);
+			g_mutex_unlock (&queue->mutex);
+			return;
+		}
+	}
+
+	g_mutex_lock (&queue->mutex);
+	for (i = n_pushed; i < n_buffers; i++)
+		g_queue_push_tail (&queue->overflow, buffers[i]);
+	g_atomic_int_add (&queue->n_overflow, n_buffers - n_pushed);
+	g_cond_broadcast (&queue->cond);
+	g_mutex_unlock (&queue->mutex);
+}
+
+/**
+ * arv_buffer_queue_try_pop_many: (skip)
+ * @queue: a #ArvBufferQueue
+ * @buffers: (out caller-allocates) (array length=max_buffers) (transfer full): array for the popped buffers
+ * @max_buffers: size of @buffers
+ *
+ * Pops the oldest buffers of @queue, without waiting.
+ *
+ * Returns: the number of buffers stored in @buffers
+ */
+
+guint
+arv_buffer_queue_try_pop_many (ArvBufferQueue *queue, ArvBuffer **buffers, guint max_buffers)
+{
+	guint n_popped = 0;
+	guint n;
+
+	g_return_val_if_fail (queue != NULL, 0);
+	g_return_val_if_fail (buffers != NULL || max_buffers == 0, 0);
+
+	while (n_popped < max_buffers &&
+	       (n = _ring_pop_many (queue, buffers + n_popped, max_buffers - n_popped)) > 0)
+		n_popped += n;
+
+	if (n_popped == max_buffers || g_atomic_int_get (&queue->n_overflow) == 0)
+		return n_popped;
+
+	g_mutex_lock (&queue->mutex);
+	while (n_popped < max_buffers) {
+		ArvBuffer *buffer = _try_pop_unlocked (queue);
+
+		if (buffer == NULL)
+			break;
+		buffers[n_popped++] = buffer;
+	}
+	g_mutex_unlock (&queue->mutex);
+
+	return n_popped;
+}
+
+/**
+ * arv_buffer_queue_timeout_pop_many: (skip)
+ * @queue: a #ArvBufferQueue
+ * @buffers: (out caller-allocates) (array length=max_buffers) (transfer full): array for the popped buffers
+ * @max_buffers: size of @buffers
+ * @timeout: timeout, in µs
+ *
+ * Pops the oldest buffers of @queue, waiting up to @timeout for at least one if it is empty.
+ *
+ * Returns: the number of buffers stored in @buffers, 0 on timeout
+ */
+
+guint
+arv_buffer_queue_timeout_pop_many (ArvBufferQueue *queue, ArvBuffer **buffers, guint max_buffers, guint64 timeout)
+{
+	guint n_popped;
+
+	g_return_val_if_fail (queue != NULL, 0);
+	g_return_val_if_fail (buffers != NULL || max_buffers == 0, 0);
+
+	if (max_buffers == 0)
+		return 0;
+
+	n_popped = arv_buffer_queue_try_pop_many (queue, buffers, max_buffers);
+	if (n_popped > 0)
+		return n_popped;
+
+	buffers[0] = _pop (queue, FALSE, g_get_monotonic_time () + MIN (timeout, G_MAXINT64 / 2));
+	if (buffers[0] == NULL)
+		return 0;
+
+	return 1 + arv_buffer_queue_try_pop_many (queue, buffers + 1, max_buffers - 1);
+}
+
+/**
+ * arv_buffer_queue_pop: (skip)
+ * @queue: a #ArvBufferQueue
+ *
+ * Returns: (transfer full): the oldest buffer of @queue, waiting for one if it is empty
+ */
+
+ArvBuffer *
+arv_buffer_queue_pop (ArvBufferQueue *queue)
+{
+	g_return_val_if_fail (queue != NULL, NULL);
+
+	return _pop (queue, TRUE, 0);
+}
+
+/**
+ * arv_buffer_queue_timeout_pop: (skip)
+ * @queue: a #ArvBufferQueue
+ * @timeout: timeout, in µs
+ *
+ * Returns: (transfer full) (nullable): the oldest buffer of @queue, %NULL if it is still empty after @timeout
+ */
+
+ArvBuffer *
+arv_buffer_queue_timeout_pop (ArvBufferQueue *queue, guint64 timeout)
+{
+	g_return_val_if_fail (queue != NULL, NULL);
+
+	return _pop (queue, FALSE, g_get_monotonic_time () + MIN (timeout, G_MAXINT64 / 2));
+}
+
+/**
+ * arv_buffer_queue_get_length: (skip)
+ * @queue: a #ArvBufferQueue
+ *
+ * Returns: the number of buffers in @queue. The value is only approximate when the queue is concurrently used.
+ */
+
+guint
+arv_buffer_queue_get_length (ArvBufferQueue *queue)
+{
+	gint length;
+
+	g_return_val_if_fail (queue != NULL, 0);
+
+	length = (gint) (g_atomic_int_get (&queue->enqueue_position) - g_atomic_int_get (&queue->dequeue_position)) +
+		g_atomic_int_get (&queue->n_overflow);
+
+	return MAX (length, 0);
+}
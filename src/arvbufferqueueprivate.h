@@ -0,0 +1,56 @@
+/* Aravis - Digital camera library
+ *
+ * Copyright © 2009-2025 Emmanuel Pacaud <emmanuel.pacaud@free.fr>
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: Emmanuel Pacaud <emmanuel.pacaud@free.fr>
+ */
+
+#ifndef ARV_BUFFER_QUEUE_PRIVATE_H
+#define ARV_BUFFER_QUEUE_PRIVATE_H
+
+#include <arvapi.h>
+#include <arvbuffer.h>
+
+G_BEGIN_DECLS
+
+#define ARV_BUFFER_QUEUE_SIZE_MIN	16
+#define ARV_BUFFER_QUEUE_SIZE_MAX	(1 << 16)
+
+typedef struct _ArvBufferQueue ArvBufferQueue;
+
+ARV_API ArvBufferQueue *	arv_buffer_queue_new		(void);
+ARV_API void			arv_buffer_queue_free		(ArvBufferQueue *queue);
+
+ARV_API gboolean		arv_buffer_queue_reserve	(ArvBufferQueue *queue, guint n_buffers);
+
+ARV_API void			arv_buffer_queue_push		(ArvBufferQueue *queue, ArvBuffer *buffer);
+ARV_API ArvBuffer *		arv_buffer_queue_pop		(ArvBufferQueue *queue);
+ARV_API ArvBuffer *		arv_buffer_queue_try_pop	(ArvBufferQueue *queue);
+ARV_API ArvBuffer *		arv_buffer_queue_timeout_pop	(ArvBufferQueue *queue, guint64 timeout);
+
+ARV_API void			arv_buffer_queue_push_many	(ArvBufferQueue *queue, ArvBuffer **buffers, guint n_buffers);
+ARV_API guint			arv_buffer_queue_try_pop_many	(ArvBufferQueue *queue, ArvBuffer **buffers,
+								 guint max_buffers);
+ARV_API guint			arv_buffer_queue_timeout_pop_many	(ArvBufferQueue *queue, ArvBuffer **buffers,
+									 guint max_buffers, guint64 timeout);
+
+ARV_API guint			arv_buffer_queue_get_length	(ArvBufferQueue *queue);
+
+G_END_DECLS
+
+#endif
@@ -32,6 +32,10 @@ static int arv_option_gv_packet_size = -1;
 static gboolean arv_option_realtime = FALSE;
 static gboolean arv_option_high_priority = FALSE;
 static gboolean arv_option_no_packet_socket = FALSE;
+static gboolean arv_option_zero_copy = FALSE;
+static gboolean arv_option_xdp = FALSE;
+static unsigned int arv_option_n_workers = 0;
+static unsigned int arv_option_n_sockets = 1;
 static gboolean arv_option_multipart = FALSE;
 static char *arv_option_chunks = NULL;
 static int arv_option_bandwidth_limit = -1;
@@ -45,6 +49,9 @@ static gboolean arv_option_show_version = FALSE;
 static gboolean arv_option_gv_allow_broadcast_discovery_ack = FALSE;
 static char *arv_option_gv_port_range = NULL;
 static gboolean arv_option_native_buffers = FALSE;
+static gboolean arv_option_huge_pages = FALSE;
+static gboolean arv_option_lock_buffers = FALSE;
+static int arv_option_numa_node = ARV_BUFFER_POOL_NUMA_NODE_AUTO;
 static char *arv_option_gv_discovery_interface = NULL;
 
 /* clang-format off */
@@ -187,6 +194,41 @@ static const GOptionEntry arv_option_entries[] =
 		&arv_option_no_packet_socket,		"Disable use of packet socket",
 		NULL
 	},
+	{
+		"zero-copy",				'\0', 0, G_OPTION_ARG_NONE,
+		&arv_option_zero_copy,			"Receive payload data directly into buffers",
+		NULL
+	},
+	{
+		"xdp",					'\0', 0, G_OPTION_ARG_NONE,
+		&arv_option_xdp,			"Receive packets using an AF_XDP socket",
+		NULL
+	},
+	{
+		"n-workers",				'\0', 0, G_OPTION_ARG_INT,
+		&arv_option_n_workers,			"Number of payload copy worker threads",
+		"<n_workers>"
+	},
+	{
+		"n-sockets",				'\0', 0, G_OPTION_ARG_INT,
+		&arv_option_n_sockets,			"Number of sockets bound to the stream port",
+		"<n_sockets>"
+	},
+	{
+		"huge-pages",				'\0', 0, G_OPTION_ARG_NONE,
+		&arv_option_huge_pages,			"Allocate the stream buffers in huge pages",
+		NULL
+	},
+	{
+		"lock-buffers",				'\0', 0, G_OPTION_ARG_NONE,
+		&arv_option_lock_buffers,		"Lock the stream buffers in RAM",
+		NULL
+	},
+	{
+		"numa-node",				'\0', 0, G_OPTION_ARG_INT,
+		&arv_option_numa_node,			"NUMA node of the stream buffers (-1: network adapter node, -2: none)",
+		"<node>"
+	},
 	{
 		"multipart",    			'\0', 0, G_OPTION_ARG_NONE,
 		&arv_option_multipart,		        "Enable multipart payload",
@@ -596,9 +638,16 @@ main (int argc, char **argv)
 			if (error == NULL) arv_camera_gv_select_stream_channel (camera, arv_option_gv_stream_channel, &error);
 			if (error == NULL) arv_camera_gv_set_packet_delay (camera, arv_option_gv_packet_delay, &error);
 			if (error == NULL) arv_camera_gv_set_packet_size (camera, arv_option_gv_packet_size, &error);
-                        arv_camera_gv_set_stream_options (camera, arv_option_no_packet_socket ?
-                                                          ARV_GV_STREAM_OPTION_PACKET_SOCKET_DISABLED :
-                                                          ARV_GV_STREAM_OPTION_NONE);
+                        arv_camera_gv_set_stream_options (camera,
+                                                          (arv_option_no_packet_socket ?
+                                                           ARV_GV_STREAM_OPTION_PACKET_SOCKET_DISABLED :
+                                                           ARV_GV_STREAM_OPTION_NONE) |
+                                                          (arv_option_zero_copy ?
+                                                           ARV_GV_STREAM_OPTION_ZERO_COPY_ENABLED :
+                                                           ARV_GV_STREAM_OPTION_NONE) |
+                                                          (arv_option_xdp ?
+                                                           ARV_GV_STREAM_OPTION_XDP_ENABLED :
+                                                           ARV_GV_STREAM_OPTION_NONE));
                         if (arv_option_packet_size_adjustment != NULL)
                                 arv_camera_gv_set_packet_size_adjustment (camera, adjustment);
                         if (error == NULL) arv_camera_gv_set_multipart (camera, TRUE,
@@ -707,10 +756,19 @@ main (int argc, char **argv)
 						  "initial-packet-timeout", (unsigned) arv_option_initial_packet_timeout * 1000,
 						  "packet-timeout", (unsigned) arv_option_packet_timeout * 1000,
 						  "frame-retention", (unsigned) arv_option_frame_retention * 1000,
+						  "n-workers", arv_option_n_workers,
+						  "n-sockets", arv_option_n_sockets,
 						  NULL);
 			    }
 
-                            if (arv_option_native_buffers)
+                            g_object_set (stream,
+                                          "buffer-pool-flags",
+                                          (arv_option_huge_pages ? ARV_BUFFER_POOL_FLAGS_HUGE_PAGES : 0) |
+                                          (arv_option_lock_buffers ? ARV_BUFFER_POOL_FLAGS_LOCK : 0),
+                                          "numa-node", arv_option_numa_node,
+                                          NULL);
+
+                            if (arv_option_native_buffers || arv_option_huge_pages || arv_option_lock_buffers)
                                     arv_stream_create_buffers(stream, N_BUFFERS, NULL, NULL, NULL);
                             else {
                                     for (i = 0; i < N_BUFFERS; i++)
@@ -0,0 +1,382 @@
+/* Aravis - Digital camera library
+ *
+ * Copyright © 2009-2025 Emmanuel Pacaud <emmanuel.pacaud@free.fr>
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: Emmanuel Pacaud <emmanuel.pacaud@free.fr>
+ */
+
+/*< private >
+ * SECTION:arvclockmodel
+ * @title: ArvClockModel
+ * @short_description: device to host clock correlation
+ *
+ * #ArvClockModel maps the timestamps of a device, counted by its own oscillator, to the host monotonic clock. The
+ * relation is modeled as a line, host = offset + (1 + drift) * device, fitted by a least squares regression in which
+ * the weight of the old samples decays exponentially with the device time, so that the fit follows the slow
+ * variations of the oscillator frequencies. The regression is incremental, using running weighted means and
+ * co-moments, which keeps the cost of a sample constant and avoids the loss of precision of the raw sums.
+ *
+ * The samples come from two sources. Latch samples pair a device timestamp latched on request with the host time
+ * of the request, whose uncertainty is the round trip time. Frame samples pair the device timestamp of a frame with
+ * its host arrival time, which includes a variable transmission latency. Only the frame with the smallest
+ * host - device difference of each window is used, which makes the fit follow the lower envelope of the arrival
+ * times. Latch samples are preferred, frame samples only feed the fit when no latch sample was received for a while.
+ *
+ * The writers are serialized by a mutex, but the stream threads only try to take it and drop their sample if it is
+ * busy, they never wait. The fitted parameters are published through a sequence lock, so the readers never block
+ * either.
+ */
+
+#include <arvclockmodelprivate.h>
+#include <arvdebugprivate.h>
+#include <math.h>
+
+#if defined (_MSC_VER)
+#include <windows.h>
+#define _acquire_fence()	MemoryBarrier ()
+#define _release_fence()	MemoryBarrier ()
+#else
+#define _acquire_fence()	__atomic_thread_fence (__ATOMIC_ACQUIRE)
+#define _release_fence()	__atomic_thread_fence (__ATOMIC_RELEASE)
+#endif
+
+typedef struct {
+	guint64 device_origin_ns;
+	gint64 host_origin_ns;
+	double device_mean;
+	double host_mean;
+	double slope;
+	guint64 last_device_ns;
+	guint n_samples;
+} ArvClockModelParameters;
+
+struct _ArvClockModel {
+	GMutex mutex;
+
+	/* Regression state, relative to the origins, protected by the mutex */
+	guint64 device_origin_ns;
+	gint64 host_origin_ns;
+	double weight;
+	double device_mean;
+	double host_mean;
+	double device_comoment;
+	double cross_comoment;
+	double slope;
+	guint64 last_device_ns;
+	guint n_samples;
+
+	gint64 last_latch_ns;
+	gint64 min_latch_round_trip_ns;
+
+	/* Frame arrival with the smallest latency in the current window */
+	gboolean has_frame_window;
+	gint64 frame_window_start_ns;
+	guint64 frame_device_ns;
+	gint64 frame_host_ns;
+
+	/* Published parameters, odd sequence while they are written */
+	gint sequence;
+	ArvClockModelParameters parameters;
+};
+
+static void
+_publish (ArvClockModel *model)
+{
+	g_atomic_int_inc (&model->sequence);
+
+	/* The odd sequence is visible before any parameter change */
+	_release_fence ();
+
+	model->parameters.device_origin_ns = model->device_origin_ns;
+	model->parameters.host_origin_ns = model->host_origin_ns;
+	model->parameters.device_mean = model->device_mean;
+	model->parameters.host_mean = model->host_mean;
+	model->parameters.slope = model->slope;
+	model->parameters.last_device_ns = model->last_device_ns;
+	model->parameters.n_samples = model->n_samples;
+
+	_release_fence ();
+
+	g_atomic_int_inc (&model->sequence);
+}
+
+static void
+_read_parameters (ArvClockModel *model, ArvClockModelParameters *parameters)
+{
+	gint sequence;
+
+	do {
+		sequence = g_atomic_int_get (&model->sequence);
+		*parameters = model->parameters;
+
+		/* The copy is complete before the sequence check */
+		_acquire_fence ();
+	} while ((sequence & 1) != 0 || g_atomic_int_get (&model->sequence) != sequence);
+}
+
+static double
+_predict (double slope, double device_mean, double host_mean, double device)
+{
+	return host_mean + slope * (device - device_mean);
+}
+
+static void
+_clear (ArvClockModel *model)
+{
+	model->weight = 0.0;
+	model->device_mean = 0.0;
+	model->host_mean = 0.0;
+	model->device_comoment = 0.0;
+	model->cross_comoment = 0.0;
+	model->slope = 1.0;
+	model->n_samples = 0;
+	model->last_latch_ns = 0;
+	model->min_latch_round_trip_ns = 0;
+	model->has_frame_window = FALSE;
+}
+
+static void
+_add_sample (ArvClockModel *model, guint64 device_ns, gint64 host_ns)
+{
+	double device;
+	double host;
+	double decay;
+	double device_delta;
+	double slope;
+
+	if (model->n_samples > 0) {
+		device = (gint64) (device_ns - model->device_origin_ns);
+		host = host_ns - model->host_origin_ns;
+
+		if ((gint64) (device_ns - model->last_device_ns) < -ARV_CLOCK_MODEL_RESET_THRESHOLD_NS ||
+		    fabs (host - _predict (model->slope, model->device_mean, model->host_mean, device)) >
+		    ARV_CLOCK_MODEL_RESET_THRESHOLD_NS) {
+			gint64 last_latch_ns = model->last_latch_ns;
+			gint64 min_latch_round_trip_ns = model->min_latch_round_trip_ns;
+
+			arv_info_misc ("[ClockModel::add_sample] Clock jump detected, restart the fit");
+
+			_clear (model);
+			model->last_latch_ns = last_latch_ns;
+			model->min_latch_round_trip_ns = min_latch_round_trip_ns;
+		}
+	}
+
+	if (model->n_samples == 0) {
+		model->device_origin_ns = device_ns;
+		model->host_origin_ns = host_ns;
+		model->last_device_ns = device_ns;
+	}
+
+	device = (gint64) (device_ns - model->device_origin_ns);
+	host = host_ns - model->host_origin_ns;
+	decay = exp (- (double) MAX ((gint64) (device_ns - model->last_device_ns), 0) /
+		     (double) ARV_CLOCK_MODEL_TIME_CONSTANT_NS);
+
+	model->weight = decay * model->weight + 1.0;
+	device_delta = device - model->device_mean;
+	model->device_mean += device_delta / model->weight;
+	model->host_mean += (host - model->host_mean) / model->weight;
+	model->device_comoment = decay * model->device_comoment + device_delta * (device - model->device_mean);
+	model->cross_comoment = decay * model->cross_comoment + device_delta * (host - model->host_mean);
+	model->last_device_ns = MAX (device_ns, model->last_device_ns);
+	model->n_samples++;
+
+	slope = model->device_comoment > 0.0 ? model->cross_comoment / model->device_comoment : 1.0;
+	model->slope = CLAMP (slope,
+			      1.0 - ARV_CLOCK_MODEL_DRIFT_MAX_PPM * 1e-6,
+			      1.0 + ARV_CLOCK_MODEL_DRIFT_MAX_PPM * 1e-6);
+
+	_publish (model);
+}
+
+ArvClockModel *
+arv_clock_model_new (void)
+{
+	ArvClockModel *model;
+
+	model = g_new0 (ArvClockModel, 1);
+	g_mutex_init (&model->mutex);
+	_clear (model);
+	_publish (model);
+
+	return model;
+}
+
+void
+arv_clock_model_free (ArvClockModel *model)
+{
+	if (model == NULL)
+		return;
+
+	g_mutex_clear (&model->mutex);
+	g_free (model);
+}
+
+void
+arv_clock_model_reset (ArvClockModel *model)
+{
+	g_return_if_fail (model != NULL);
+
+	g_mutex_lock (&model->mutex);
+	_clear (model);
+	_publish (model);
+	g_mutex_unlock (&model->mutex);
+}
+
+/**
+ * arv_clock_model_add_latch_sample:
+ * @model: a #ArvClockModel
+ * @device_ns: latched device timestamp, in nanoseconds
+ * @host_before_ns: host monotonic time before the latch request, in nanoseconds
+ * @host_after_ns: host monotonic time after the latch acknowledge, in nanoseconds
+ *
+ * The device timestamp is assumed to be latched at the middle of the request round trip. Samples with a round trip
+ * much longer than the shortest recently seen are discarded.
+ */
+
+void
+arv_clock_model_add_latch_sample (ArvClockModel *model, guint64 device_ns, gint64 host_before_ns, gint64 host_after_ns)
+{
+	gint64 round_trip_ns;
+
+	g_return_if_fail (model != NULL);
+	g_return_if_fail (host_after_ns >= host_before_ns);
+
+	round_trip_ns = host_after_ns - host_before_ns;
+
+	g_mutex_lock (&model->mutex);
+
+	/* The reference round trip relaxes slowly, in order to follow a degradation of the network conditions */
+	if (model->min_latch_round_trip_ns == 0 || round_trip_ns < model->min_latch_round_trip_ns)
+		model->min_latch_round_trip_ns = MAX (round_trip_ns, 1);
+	else
+		model->min_latch_round_trip_ns += MAX (model->min_latch_round_trip_ns / 16, 1);
+
+	if (round_trip_ns <= 2 * model->min_latch_round_trip_ns) {
+		_add_sample (model, device_ns, host_before_ns + round_trip_ns / 2);
+		model->last_latch_ns = host_after_ns;
+	}
+
+	g_mutex_unlock (&model->mutex);
+}
+
+/**
+ * arv_clock_model_add_frame_sample:
+ * @model: a #ArvClockModel
+ * @device_ns: device timestamp of the frame, in nanoseconds
+ * @host_ns: host monotonic time of the frame arrival, in nanoseconds
+ *
+ * This function never blocks. The sample is dropped if another thread is updating the model.
+ */
+
+void
+arv_clock_model_add_frame_sample (ArvClockModel *model, guint64 device_ns, gint64 host_ns)
+{
+	g_return_if_fail (model != NULL);
+
+	if (!g_mutex_trylock (&model->mutex))
+		return;
+
+	if (model->n_samples == 0 && model->last_latch_ns == 0) {
+		/* Seed the model, in order to have a first estimate from the first frame */
+		_add_sample (model, device_ns, host_ns);
+	} else if (!model->has_frame_window ||
+		   host_ns - model->frame_window_start_ns >= ARV_CLOCK_MODEL_FRAME_WINDOW_NS) {
+		if (model->has_frame_window &&
+		    (model->last_latch_ns == 0 ||
+		     model->frame_host_ns - model->last_latch_ns > ARV_CLOCK_MODEL_LATCH_TIMEOUT_NS))
+			_add_sample (model, model->frame_device_ns, model->frame_host_ns);
+
+		model->has_frame_window = TRUE;
+		model->frame_window_start_ns = host_ns;
+		model->frame_device_ns = device_ns;
+		model->frame_host_ns = host_ns;
+	} else if ((host_ns - model->frame_host_ns) - (gint64) (device_ns - model->frame_device_ns) < 0) {
+		model->frame_device_ns = device_ns;
+		model->frame_host_ns = host_ns;
+	}
+
+	g_mutex_unlock (&model->mutex);
+}
+
+/**
+ * arv_clock_model_to_host:
+ * @model: a #ArvClockModel
+ * @device_ns: a device timestamp, in nanoseconds
+ * @host_ns: (out): the corresponding host monotonic time, in nanoseconds
+ *
+ * Returns: %FALSE if the model has not received any sample yet
+ */
+
+gboolean
+arv_clock_model_to_host (ArvClockModel *model, guint64 device_ns, gint64 *host_ns)
+{
+	ArvClockModelParameters parameters;
+
+	g_return_val_if_fail (model != NULL, FALSE);
+	g_return_val_if_fail (host_ns != NULL, FALSE);
+
+	_read_parameters (model, &parameters);
+
+	if (parameters.n_samples == 0) {
+		*host_ns = 0;
+		return FALSE;
+	}
+
+	*host_ns = parameters.host_origin_ns +
+		(gint64) llround (_predict (parameters.slope, parameters.device_mean, parameters.host_mean,
+					    (gint64) (device_ns - parameters.device_origin_ns)));
+
+	return TRUE;
+}
+
+/**
+ * arv_clock_model_get_parameters:
+ * @model: a #ArvClockModel
+ * @drift_ppm: (out) (optional): drift of the device clock relative to the host clock, in parts per million
+ * @offset_ns: (out) (optional): host time minus device time at the last sample, in nanoseconds
+ * @n_samples: (out) (optional): number of samples used since the last reset
+ *
+ * Returns: %FALSE if the model has not received any sample yet
+ */
+
+gboolean
+arv_clock_model_get_parameters (ArvClockModel *model, double *drift_ppm, gint64 *offset_ns, guint *n_samples)
+{
+	ArvClockModelParameters parameters;
+	gint64 host_ns = 0;
+
+	g_return_val_if_fail (model != NULL, FALSE);
+
+	_read_parameters (model, &parameters);
+
+	if (parameters.n_samples > 0)
+		host_ns = parameters.host_origin_ns +
+			(gint64) llround (_predict (parameters.slope, parameters.device_mean, parameters.host_mean,
+						    (gint64) (parameters.last_device_ns - parameters.device_origin_ns)));
+
+	if (drift_ppm != NULL)
+		*drift_ppm = (parameters.slope - 1.0) * 1e6;
+	if (offset_ns != NULL)
+		*offset_ns = parameters.n_samples > 0 ? host_ns - (gint64) parameters.last_device_ns : 0;
+	if (n_samples != NULL)
+		*n_samples = parameters.n_samples;
+
+	return parameters.n_samples > 0;
+}
@@ -0,0 +1,60 @@
+/* Aravis - Digital camera library
+ *
+ * Copyright © 2009-2025 Emmanuel Pacaud <emmanuel.pacaud@free.fr>
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: Emmanuel Pacaud <emmanuel.pacaud@free.fr>
+ */
+
+#ifndef ARV_CLOCK_MODEL_PRIVATE_H
+#define ARV_CLOCK_MODEL_PRIVATE_H
+
+#include <arvapi.h>
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+/* Time constant of the exponential forgetting of the old samples */
+#define ARV_CLOCK_MODEL_TIME_CONSTANT_NS	60000000000LL
+/* Width of the window over which the frame arrival with the smallest latency is selected */
+#define ARV_CLOCK_MODEL_FRAME_WINDOW_NS		1000000000LL
+/* Frame arrivals are ignored as long as a latch sample was received during this time */
+#define ARV_CLOCK_MODEL_LATCH_TIMEOUT_NS	10000000000LL
+/* A sample further than this from the prediction means the device or the host clock has jumped */
+#define ARV_CLOCK_MODEL_RESET_THRESHOLD_NS	1000000000LL
+/* Bound of the estimated drift, in parts per million */
+#define ARV_CLOCK_MODEL_DRIFT_MAX_PPM		500.0
+
+typedef struct _ArvClockModel ArvClockModel;
+
+ARV_API ArvClockModel *		arv_clock_model_new			(void);
+ARV_API void			arv_clock_model_free			(ArvClockModel *model);
+ARV_API void			arv_clock_model_reset			(ArvClockModel *model);
+
+ARV_API void			arv_clock_model_add_latch_sample	(ArvClockModel *model, guint64 device_ns,
+									 gint64 host_before_ns, gint64 host_after_ns);
+ARV_API void			arv_clock_model_add_frame_sample	(ArvClockModel *model, guint64 device_ns,
+									 gint64 host_ns);
+
+ARV_API gboolean		arv_clock_model_to_host			(ArvClockModel *model, guint64 device_ns,
+									 gint64 *host_ns);
+ARV_API gboolean		arv_clock_model_get_parameters		(ArvClockModel *model, double *drift_ppm,
+									 gint64 *offset_ns, guint *n_samples);
+
+G_END_DECLS
+
+#endif
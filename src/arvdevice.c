@@ -42,6 +42,7 @@
 #include <arvgcstring.h>
 #include <arvstream.h>
 #include <arvdebug.h>
+#include <string.h>
 
 enum {
 	ARV_DEVICE_SIGNAL_CONTROL_LOST,
@@ -208,6 +209,98 @@ arv_device_write_register (ArvDevice *device, guint64 address, guint32 value, GE
 	return ARV_DEVICE_GET_CLASS (device)->write_register (device, address, value, error);
 }
 
+/**
+ * arv_device_read_registers:
+ * @device: a #ArvDevice
+ * @n_registers: number of registers
+ * @addresses: (array length=n_registers): register addresses
+ * @values: (out caller-allocates) (array length=n_registers): a placeholder for the read values
+ * @error: (out) (allow-none): a #GError placeholder
+ *
+ * Reads the values of a set of device registers. Depending on the protocol, this may use much less round trips than
+ * as many calls to arv_device_read_register(). On error, all the values from the first failed register onwards are
+ * set to 0.
+ *
+ * Return value: TRUE on success.
+ *
+ * Since: 0.10.0
+ **/
+
+gboolean
+arv_device_read_registers (ArvDevice *device, guint n_registers, const guint64 *addresses, guint32 *values,
+			   GError **error)
+{
+	ArvDeviceClass *device_class;
+	guint i;
+
+	g_return_val_if_fail (ARV_IS_DEVICE (device), FALSE);
+	g_return_val_if_fail (n_registers == 0 || addresses != NULL, FALSE);
+	g_return_val_if_fail (n_registers == 0 || values != NULL, FALSE);
+	g_return_val_if_fail (error == NULL || *error == NULL, FALSE);
+
+	if (n_registers == 0)
+		return TRUE;
+
+	device_class = ARV_DEVICE_GET_CLASS (device);
+
+	if (device_class->read_registers != NULL)
+		return device_class->read_registers (device, n_registers, addresses, values, error);
+
+	for (i = 0; i < n_registers; i++) {
+		if (!device_class->read_register (device, addresses[i], &values[i], error)) {
+			memset (&values[i], 0, (n_registers - i) * sizeof (guint32));
+			return FALSE;
+		}
+	}
+
+	return TRUE;
+}
+
+/**
+ * arv_device_write_registers:
+ * @device: a #ArvDevice
+ * @n_registers: number of registers
+ * @addresses: (array length=n_registers): register addresses
+ * @values: (array length=n_registers): values to write
+ * @error: (out) (allow-none): a #GError placeholder
+ *
+ * Writes a set of device registers, in the array order. Depending on the protocol, this may use much less round
+ * trips than as many calls to arv_device_write_register(). On error, the registers preceding the failed one may
+ * have been written.
+ *
+ * Return value: TRUE on success.
+ *
+ * Since: 0.10.0
+ **/
+
+gboolean
+arv_device_write_registers (ArvDevice *device, guint n_registers, const guint64 *addresses, const guint32 *values,
+			    GError **error)
+{
+	ArvDeviceClass *device_class;
+	guint i;
+
+	g_return_val_if_fail (ARV_IS_DEVICE (device), FALSE);
+	g_return_val_if_fail (n_registers == 0 || addresses != NULL, FALSE);
+	g_return_val_if_fail (n_registers == 0 || values != NULL, FALSE);
+	g_return_val_if_fail (error == NULL || *error == NULL, FALSE);
+
+	if (n_registers == 0)
+		return TRUE;
+
+	device_class = ARV_DEVICE_GET_CLASS (device);
+
+	if (device_class->write_registers != NULL)
+		return device_class->write_registers (device, n_registers, addresses, values, error);
+
+	for (i = 0; i < n_registers; i++) {
+		if (!device_class->write_register (device, addresses[i], values[i], error))
+			return FALSE;
+	}
+
+	return TRUE;
+}
+
 #if ARAVIS_HAS_EVENT
 /**
  * arv_device_read_event_data:
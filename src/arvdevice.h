@@ -105,8 +105,14 @@ struct _ArvDeviceClass {
 	void		(*device_event)		(ArvDevice *device);
 #endif
 
+	/* Appended, in order to keep the offsets of the previous members */
+	gboolean	(*read_registers)	(ArvDevice *device, guint n_registers, const guint64 *addresses,
+						 guint32 *values, GError **error);
+	gboolean	(*write_registers)	(ArvDevice *device, guint n_registers, const guint64 *addresses,
+						 const guint32 *values, GError **error);
+
         /* Padding for future expansion */
-        gpointer padding[10];
+        gpointer padding[8];
 };
 
 ARV_API ArvStream *	arv_device_create_stream        	(ArvDevice *device,
@@ -120,6 +126,10 @@ ARV_API gboolean	arv_device_read_memory			(ArvDevice *device, guint64 address, g
 ARV_API gboolean	arv_device_write_memory			(ArvDevice *device, guint64 address, guint32 size, const void *buffer, GError **error);
 ARV_API gboolean	arv_device_read_register		(ArvDevice *device, guint64 address, guint32 *value, GError **error);
 ARV_API gboolean	arv_device_write_register		(ArvDevice *device, guint64 address, guint32 value, GError **error);
+ARV_API gboolean	arv_device_read_registers		(ArvDevice *device, guint n_registers, const guint64 *addresses,
+								 guint32 *values, GError **error);
+ARV_API gboolean	arv_device_write_registers		(ArvDevice *device, guint n_registers, const guint64 *addresses,
+								 const guint32 *values, GError **error);
 #if ARAVIS_HAS_EVENT
 ARV_API gboolean	arv_device_read_event_data		(ArvDevice *device, int event_id,
                                                                  guint64 address, guint32 size, void *buffer,
@@ -25,7 +25,7 @@
 #include <arvdomimplementation.h>
 #include <arvdomnode.h>
 #include <arvdomelement.h>
-#include <arvdomparser.h>
+#include <arvdomparserprivate.h>
 #include <arvstr.h>
 #include <libxml/parser.h>
 #include <gio/gio.h>
@@ -35,6 +35,100 @@ typedef enum {
 	STATE
 } ArvDomSaxParserStateEnum;
 
+/* Recording of the parser events. The recording starts with a header, followed by a block of nul terminated
+ * strings, padded to a 4 byte boundary, and by the event stream, made of little endian 32 bit words. Strings are
+ * referred to by their offset in the string block. */
+
+#define ARV_DOM_RECORDING_MAGIC		"ARVDOMR1"
+#define ARV_DOM_RECORDING_MAGIC_SIZE	8
+
+typedef enum {
+	ARV_DOM_RECORDING_EVENT_START_ELEMENT = 1,	/* name, n_attributes, n_attributes * (name, value) */
+	ARV_DOM_RECORDING_EVENT_END_ELEMENT,
+	ARV_DOM_RECORDING_EVENT_CHARACTERS		/* text */
+} ArvDomRecordingEvent;
+
+typedef struct {
+	char magic[ARV_DOM_RECORDING_MAGIC_SIZE];
+	guint32 strings_size;
+	guint32 n_words;
+} ArvDomRecordingHeader;
+
+typedef struct {
+	GByteArray *strings;
+	GArray *words;
+	GHashTable *string_offsets;
+} ArvDomRecorder;
+
+static ArvDomRecorder *
+_recorder_new (void)
+{
+	ArvDomRecorder *recorder = g_new0 (ArvDomRecorder, 1);
+
+	recorder->strings = g_byte_array_new ();
+	recorder->words = g_array_new (FALSE, FALSE, sizeof (guint32));
+	recorder->string_offsets = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, NULL);
+
+	return recorder;
+}
+
+static void
+_recorder_free (ArvDomRecorder *recorder)
+{
+	g_byte_array_unref (recorder->strings);
+	g_array_unref (recorder->words);
+	g_hash_table_unref (recorder->string_offsets);
+	g_free (recorder);
+}
+
+static GBytes *
+_recorder_free_to_bytes (ArvDomRecorder *recorder)
+{
+	ArvDomRecordingHeader header;
+	GByteArray *recording;
+	guint32 padding = 0;
+
+	memcpy (header.magic, ARV_DOM_RECORDING_MAGIC, ARV_DOM_RECORDING_MAGIC_SIZE);
+	header.strings_size = GUINT32_TO_LE (recorder->strings->len);
+	header.n_words = GUINT32_TO_LE (recorder->words->len);
+
+	recording = g_byte_array_sized_new (sizeof (header) + recorder->strings->len + 3 +
+					    recorder->words->len * sizeof (guint32));
+	g_byte_array_append (recording, (guint8 *) &header, sizeof (header));
+	g_byte_array_append (recording, recorder->strings->data, recorder->strings->len);
+	g_byte_array_append (recording, (guint8 *) &padding, (4 - recorder->strings->len % 4) % 4);
+	g_byte_array_append (recording, (guint8 *) recorder->words->data,
+			     recorder->words->len * sizeof (guint32));
+
+	_recorder_free (recorder);
+
+	return g_byte_array_free_to_bytes (recording);
+}
+
+static void
+_recorder_add_word (ArvDomRecorder *recorder, guint32 word)
+{
+	word = GUINT32_TO_LE (word);
+	g_array_append_val (recorder->words, word);
+}
+
+static void
+_recorder_add_string (ArvDomRecorder *recorder, const char *string, int length)
+{
+	gpointer offset;
+	char *key;
+
+	key = length < 0 ? g_strdup (string) : g_strndup (string, length);
+	if (!g_hash_table_lookup_extended (recorder->string_offsets, key, NULL, &offset)) {
+		offset = GUINT_TO_POINTER (recorder->strings->len);
+		g_byte_array_append (recorder->strings, (guint8 *) key, strlen (key) + 1);
+		g_hash_table_insert (recorder->string_offsets, key, offset);
+	} else
+		g_free (key);
+
+	_recorder_add_word (recorder, GPOINTER_TO_UINT (offset));
+}
+
 typedef struct {
 	ArvDomSaxParserStateEnum state;
 
@@ -46,6 +140,8 @@ typedef struct {
 	int error_depth;
 
 	GHashTable *entities;
+
+	ArvDomRecorder *recorder;
 } ArvDomSaxParserState;
 
 static void
@@ -89,6 +185,20 @@ arv_dom_parser_start_element(void *user_data,
 	ArvDomNode *node;
 	int i;
 
+	if (state->recorder != NULL) {
+		int n_attributes = 0;
+
+		if (attrs != NULL)
+			for (i = 0; attrs[i] != NULL && attrs[i+1] != NULL; i += 2)
+				n_attributes++;
+
+		_recorder_add_word (state->recorder, ARV_DOM_RECORDING_EVENT_START_ELEMENT);
+		_recorder_add_string (state->recorder, (char *) name, -1);
+		_recorder_add_word (state->recorder, n_attributes);
+		for (i = 0; i < 2 * n_attributes; i++)
+			_recorder_add_string (state->recorder, (char *) attrs[i], -1);
+	}
+
 	if (state->is_error) {
 		state->error_depth++;
 		return;
@@ -125,6 +235,9 @@ arv_dom_parser_end_element (void *user_data,
 {
 	ArvDomSaxParserState *state = user_data;
 
+	if (state->recorder != NULL)
+		_recorder_add_word (state->recorder, ARV_DOM_RECORDING_EVENT_END_ELEMENT);
+
 	if (state->is_error) {
 		state->error_depth--;
 		if (state->error_depth > 0) {
@@ -143,6 +256,11 @@ arv_dom_parser_characters (void *user_data, const xmlChar *ch, int len)
 {
 	ArvDomSaxParserState *state = user_data;
 
+	if (state->recorder != NULL) {
+		_recorder_add_word (state->recorder, ARV_DOM_RECORDING_EVENT_CHARACTERS);
+		_recorder_add_string (state->recorder, (char *) ch, len);
+	}
+
 	if (!state->is_error) {
 		ArvDomNode *node;
 		char *text;
@@ -219,17 +337,19 @@ arv_dom_document_error_quark (void)
 #define ARV_DOM_DOCUMENT_ERROR arv_dom_document_error_quark ()
 
 typedef enum {
-	ARV_DOM_DOCUMENT_ERROR_INVALID_XML
+	ARV_DOM_DOCUMENT_ERROR_INVALID_XML,
+	ARV_DOM_DOCUMENT_ERROR_INVALID_RECORDING
 } ArvDomDocumentError;
 
 #if LIBXML_VERSION >= 21100
 static ArvDomDocument *
 _parse_memory (ArvDomDocument *document, ArvDomNode *node,
-	       const void *buffer, int size, GError **error)
+	       const void *buffer, int size, ArvDomRecorder *recorder, GError **error)
 {
 	static ArvDomSaxParserState state;
         xmlParserCtxt *xml_parser_ctxt;
 
+	state.recorder = recorder;
 	state.document = document;
 	if (node != NULL)
 		state.current_node = node;
@@ -270,10 +390,11 @@ _parse_memory (ArvDomDocument *document, ArvDomNode *node,
 #else
 static ArvDomDocument *
 _parse_memory (ArvDomDocument *document, ArvDomNode *node,
-	       const void *buffer, int size, GError **error)
+	       const void *buffer, int size, ArvDomRecorder *recorder, GError **error)
 {
 	static ArvDomSaxParserState state;
 
+	state.recorder = recorder;
 	state.document = document;
 	if (node != NULL)
 		state.current_node = node;
@@ -322,7 +443,7 @@ arv_dom_document_append_from_memory (ArvDomDocument *document, ArvDomNode *node,
 	g_return_if_fail (ARV_IS_DOM_NODE (node) || node == NULL);
 	g_return_if_fail (buffer != NULL);
 
-	_parse_memory (document, node, buffer, size, error);
+	_parse_memory (document, node, buffer, size, NULL, error);
 }
 
 ArvDomDocument *
@@ -330,7 +451,167 @@ arv_dom_document_new_from_memory (const void *buffer, int size, GError **error)
 {
 	g_return_val_if_fail (buffer != NULL, NULL);
 
-	return _parse_memory (NULL, NULL, buffer, size, error);
+	return _parse_memory (NULL, NULL, buffer, size, NULL, error);
+}
+
+ArvDomDocument *
+arv_dom_document_new_from_memory_recorded (const void *buffer, int size, GBytes **recording, GError **error)
+{
+	ArvDomDocument *document;
+	ArvDomRecorder *recorder;
+
+	g_return_val_if_fail (buffer != NULL, NULL);
+	g_return_val_if_fail (recording != NULL, NULL);
+
+	recorder = _recorder_new ();
+	document = _parse_memory (NULL, NULL, buffer, size, recorder, error);
+	if (document != NULL) {
+		*recording = _recorder_free_to_bytes (recorder);
+	} else {
+		*recording = NULL;
+		_recorder_free (recorder);
+	}
+
+	return document;
+}
+
+static guint32
+_recording_get_word (const guint8 *words, guint32 index)
+{
+	guint32 word;
+
+	memcpy (&word, words + index * sizeof (guint32), sizeof (guint32));
+
+	return GUINT32_FROM_LE (word);
+}
+
+ArvDomDocument *
+arv_dom_document_new_from_recording (const void *data, size_t size, GError **error)
+{
+	ArvDomRecordingHeader header;
+	ArvDomSaxParserState state = {0};
+	const char *strings;
+	const guint8 *words;
+	const xmlChar **attrs = NULL;
+	guint64 words_offset;
+	guint32 strings_size;
+	guint32 n_words;
+	guint32 i, j;
+	int depth = 0;
+	gboolean is_valid = TRUE;
+
+	g_return_val_if_fail (data != NULL, NULL);
+
+	if (size < sizeof (header)) {
+		g_set_error (error, ARV_DOM_DOCUMENT_ERROR, ARV_DOM_DOCUMENT_ERROR_INVALID_RECORDING,
+			     "Truncated recording header");
+		return NULL;
+	}
+
+	memcpy (&header, data, sizeof (header));
+	strings_size = GUINT32_FROM_LE (header.strings_size);
+	n_words = GUINT32_FROM_LE (header.n_words);
+	words_offset = sizeof (header) + (guint64) strings_size + (4 - strings_size % 4) % 4;
+	strings = (const char *) data + sizeof (header);
+
+	if (memcmp (header.magic, ARV_DOM_RECORDING_MAGIC, ARV_DOM_RECORDING_MAGIC_SIZE) != 0 ||
+	    strings_size == 0 ||
+	    words_offset + (guint64) n_words * sizeof (guint32) != size ||
+	    strings[strings_size - 1] != '\0') {
+		g_set_error (error, ARV_DOM_DOCUMENT_ERROR, ARV_DOM_DOCUMENT_ERROR_INVALID_RECORDING,
+			     "Invalid recording header");
+		return NULL;
+	}
+
+	words = (const guint8 *) data + words_offset;
+
+	arv_dom_parser_start_document (&state);
+
+	for (i = 0; i < n_words && is_valid; ) {
+		guint32 event = _recording_get_word (words, i++);
+
+		switch (event) {
+			case ARV_DOM_RECORDING_EVENT_START_ELEMENT:
+				{
+					guint32 name;
+					guint32 n_attributes;
+
+					if (n_words - i < 2) {
+						is_valid = FALSE;
+						break;
+					}
+
+					name = _recording_get_word (words, i++);
+					n_attributes = _recording_get_word (words, i++);
+					if (name >= strings_size || n_attributes > (n_words - i) / 2) {
+						is_valid = FALSE;
+						break;
+					}
+
+					attrs = g_renew (const xmlChar *, attrs, 2 * n_attributes + 1);
+					for (j = 0; j < 2 * n_attributes && is_valid; j++) {
+						guint32 offset = _recording_get_word (words, i++);
+
+						is_valid = offset < strings_size;
+						attrs[j] = (const xmlChar *) strings + (is_valid ? offset : 0);
+					}
+					attrs[j] = NULL;
+
+					if (is_valid) {
+						arv_dom_parser_start_element (&state, (const xmlChar *) strings + name,
+									      n_attributes > 0 ? attrs : NULL);
+						depth++;
+					}
+				}
+				break;
+			case ARV_DOM_RECORDING_EVENT_END_ELEMENT:
+				if (depth <= 0) {
+					is_valid = FALSE;
+					break;
+				}
+				arv_dom_parser_end_element (&state, NULL);
+				depth--;
+				break;
+			case ARV_DOM_RECORDING_EVENT_CHARACTERS:
+				{
+					guint32 text;
+
+					if (i >= n_words) {
+						is_valid = FALSE;
+						break;
+					}
+
+					text = _recording_get_word (words, i++);
+					if (text >= strings_size || depth <= 0) {
+						is_valid = FALSE;
+						break;
+					}
+
+					arv_dom_parser_characters (&state, (const xmlChar *) strings + text,
+								   strlen (strings + text));
+				}
+				break;
+			default:
+				is_valid = FALSE;
+				break;
+		}
+	}
+
+	arv_dom_parser_end_document (&state);
+
+	g_free (attrs);
+
+	if (!is_valid || depth != 0 || state.document == NULL) {
+		g_clear_object (&state.document);
+
+		arv_warning_dom ("[DomParser::from_recording] Invalid recording");
+
+		g_set_error (error, ARV_DOM_DOCUMENT_ERROR, ARV_DOM_DOCUMENT_ERROR_INVALID_RECORDING,
+			     "Invalid recording");
+		return NULL;
+	}
+
+	return state.document;
 }
 
 static ArvDomDocument *
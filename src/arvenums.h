@@ -127,11 +127,14 @@ typedef guint32 ArvPixelFormat;
 
 #define	ARV_PIXEL_FORMAT_MONO_10		((ArvPixelFormat) 0x01100003u)
 #define ARV_PIXEL_FORMAT_MONO_10_PACKED		((ArvPixelFormat) 0x010c0004u)
+#define ARV_PIXEL_FORMAT_MONO_10P		((ArvPixelFormat) 0x010a0046u)
 
 #define ARV_PIXEL_FORMAT_MONO_12		((ArvPixelFormat) 0x01100005u)
 #define ARV_PIXEL_FORMAT_MONO_12_PACKED		((ArvPixelFormat) 0x010c0006u)
+#define ARV_PIXEL_FORMAT_MONO_12P		((ArvPixelFormat) 0x010c0047u)
 
 #define ARV_PIXEL_FORMAT_MONO_14		((ArvPixelFormat) 0x01100025u)
+#define ARV_PIXEL_FORMAT_MONO_14P		((ArvPixelFormat) 0x010e0104u)
 
 #define ARV_PIXEL_FORMAT_MONO_16		((ArvPixelFormat) 0x01100007u)
 
@@ -236,6 +239,8 @@ typedef guint32 ArvPixelFormat;
 #define ARV_PIXEL_FORMAT_RGB_12_PACKED		((ArvPixelFormat) 0x0230001au)
 #define ARV_PIXEL_FORMAT_BGR_12_PACKED		((ArvPixelFormat) 0x0230001bu)
 
+#define ARV_PIXEL_FORMAT_RGB_16_PACKED		((ArvPixelFormat) 0x02300033u)
+
 #define ARV_PIXEL_FORMAT_YUV_411_PACKED		((ArvPixelFormat) 0x020c001eu)
 #define ARV_PIXEL_FORMAT_YUV_422_PACKED		((ArvPixelFormat) 0x0210001fu)
 #define ARV_PIXEL_FORMAT_YUV_444_PACKED		((ArvPixelFormat) 0x02180020u)
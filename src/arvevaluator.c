@@ -25,7 +25,7 @@
  * @short_description: A math expression evaluator with Genicam syntax
  */
 
-#include <arvevaluator.h>
+#include <arvevaluatorprivate.h>
 #include <arvdebugprivate.h>
 #include <arvmiscprivate.h>
 #include <arvstr.h>
@@ -52,11 +52,20 @@ typedef enum {
 	ARV_EVALUATOR_STATUS_FORBIDDEN_RECUSRION
 } ArvEvaluatorStatus;
 
+typedef struct _ArvEvaluatorInstruction ArvEvaluatorInstruction;
+
+typedef struct {
+	ArvEvaluatorInstruction *instructions;
+	guint n_instructions;
+} ArvEvaluatorProgram;
+
 typedef struct {
 	char *expression;
-	GSList *rpn_stack;
+	ArvEvaluatorProgram programs[2];	/* Indexed by the integer mode flag */
 	ArvEvaluatorStatus parsing_status;
-	GHashTable *variables;
+	GHashTable *variable_slots;		/* Variable name to slot index */
+	GPtrArray *variable_names;		/* Indexed by slot */
+	GArray *variables;			/* ArvValue, indexed by slot */
 	GHashTable *sub_expressions;
 	GHashTable *constants;
 } ArvEvaluatorPrivate;
@@ -221,6 +230,19 @@ typedef struct {
 	ArvValue value;
 } ArvEvaluatorValuesStackItem;
 
+/* Compiled form of a RPN token. Variables are resolved to a slot index at compilation time, in order to avoid any
+ * name lookup during the evaluation. */
+
+struct _ArvEvaluatorInstruction {
+	ArvEvaluatorTokenId	opcode;
+	gint32 parenthesis_level;
+	union {
+		double		v_double;
+		gint64		v_int64;
+		guint		slot;
+	} data;
+};
+
 static ArvEvaluatorToken *
 arv_evaluator_token_new (ArvEvaluatorTokenId token_id)
 {
@@ -269,35 +291,37 @@ arv_evaluator_token_free (ArvEvaluatorToken *token)
 }
 
 static void
-arv_evaluator_token_debug (ArvEvaluatorToken *token, GHashTable *variables)
+arv_evaluator_instruction_debug (const ArvEvaluatorInstruction *instruction, ArvEvaluatorPrivate *priv)
 {
 	ArvValue *value;
+	const char *name;
 
-	g_return_if_fail (token != NULL);
+	g_return_if_fail (instruction != NULL);
 
-	switch (token->token_id) {
+	switch (instruction->opcode) {
 		case ARV_EVALUATOR_TOKEN_VARIABLE:
-			value = g_hash_table_lookup (variables, token->data.name);
-                        if (value != NULL && arv_value_holds_double (value))
+			value = &g_array_index (priv->variables, ArvValue, instruction->data.slot);
+			name = g_ptr_array_index (priv->variable_names, instruction->data.slot);
+                        if (arv_value_holds_double (value))
                                 arv_debug_evaluator ("(var) %s = %g (double)",
-                                                     token->data.name,
+                                                     name,
                                                      arv_value_get_double (value));
-                        else if (value != NULL && arv_value_holds_int64 (value))
+                        else if (arv_value_holds_int64 (value))
                                 arv_debug_evaluator ("(var) %s = 0x%016" G_GINT64_MODIFIER "x %" G_GINT64_FORMAT" (int64)",
-                                                     token->data.name,
+                                                     name,
                                                      arv_value_get_int64 (value),
                                                      arv_value_get_int64 (value));
                         else
-                                arv_debug_evaluator ("(var) %s not found", token->data.name);
+                                arv_debug_evaluator ("(var) %s not found", name);
                         break;
                 case ARV_EVALUATOR_TOKEN_CONSTANT_INT64:
-                        arv_debug_evaluator ("(int64) %" G_GINT64_FORMAT, token->data.v_int64);
+                        arv_debug_evaluator ("(int64) %" G_GINT64_FORMAT, instruction->data.v_int64);
                         break;
                 case ARV_EVALUATOR_TOKEN_CONSTANT_DOUBLE:
-                        arv_debug_evaluator ("(double) %g", token->data.v_double);
+                        arv_debug_evaluator ("(double) %g", instruction->data.v_double);
                         break;
                 default:
-                        arv_debug_evaluator ("(operator) %s", arv_evaluator_token_infos[token->token_id].tag);
+                        arv_debug_evaluator ("(operator) %s", arv_evaluator_token_infos[instruction->opcode].tag);
         }
 }
 
@@ -553,80 +577,80 @@ get_arguments_count(ArvEvaluatorValuesStackItem * stack, int current_index)
 	return arguments_count;
 }
 
+/* When @priv is %NULL, @program must not reference any variable. The debug output is only enabled when @priv is
+ * defined, which is not the case during constant folding. */
+
 static ArvEvaluatorStatus
-evaluate (GSList *token_stack, GHashTable *variables, gint64 *v_int64, double *v_double)
+evaluate (const ArvEvaluatorProgram *program, ArvEvaluatorPrivate *priv, gboolean integer_mode,
+	  ArvEvaluatorValuesStackItem *result)
 {
-	ArvEvaluatorToken *token;
-	ArvEvaluatorStatus status;
-	GSList *iter;
+	const ArvEvaluatorInstruction *instruction;
 	ArvEvaluatorValuesStackItem stack[ARV_EVALUATOR_STACK_SIZE];
+	ArvValue *variables;
 	ArvValue *value;
+	gboolean debug;
 	int index = -1;
-	gboolean integer_mode;
+	guint i;
 
-	g_assert (v_int64 != NULL || v_double != NULL);
+	g_assert (result != NULL);
 
-	integer_mode = v_int64 != NULL;
+	variables = priv != NULL ? (ArvValue *) priv->variables->data : NULL;
+	debug = priv != NULL && arv_debug_check (ARV_DEBUG_CATEGORY_EVALUATOR, ARV_DEBUG_LEVEL_DEBUG);
 
-	for (iter = token_stack; iter != NULL; iter = iter->next) {
+	for (i = 0; i < program->n_instructions; i++) {
 		int actual_arguments_count;
 
-		token = iter->data;
+		instruction = &program->instructions[i];
 
-		if (index < (arv_evaluator_token_infos[token->token_id].n_args - 1)) {
-			status = ARV_EVALUATOR_STATUS_MISSING_ARGUMENTS;
-			goto CLEANUP;
-		}
+		if (index < (arv_evaluator_token_infos[instruction->opcode].n_args - 1))
+			return ARV_EVALUATOR_STATUS_MISSING_ARGUMENTS;
 
-		if (arv_evaluator_token_infos[token->token_id].double_only && integer_mode) {
-			status = ARV_EVALUATOR_STATUS_INVALID_DOUBLE_FUNCTION;
-			goto CLEANUP;
-		}
+		if (arv_evaluator_token_infos[instruction->opcode].double_only && integer_mode)
+			return ARV_EVALUATOR_STATUS_INVALID_DOUBLE_FUNCTION;
 
-		if (index >= ARV_EVALUATOR_STACK_SIZE - 1) {
-			status = ARV_EVALUATOR_STATUS_STACK_OVERFLOW;
-			goto CLEANUP;
-		}
+		if (index >= ARV_EVALUATOR_STACK_SIZE - 1)
+			return ARV_EVALUATOR_STATUS_STACK_OVERFLOW;
 
-		arv_evaluator_token_debug (token, variables);
+		if (G_UNLIKELY (debug))
+			arv_evaluator_instruction_debug (instruction, priv);
 
-		actual_arguments_count = arv_evaluator_token_infos[token->token_id].n_args;
+		actual_arguments_count = arv_evaluator_token_infos[instruction->opcode].n_args;
 
-		switch (token->token_id) {
+		switch (instruction->opcode) {
 			case ARV_EVALUATOR_TOKEN_LOGICAL_AND:
 				arv_value_set_int64 (&stack[index-1].value,
 						      arv_value_get_int64 (&stack[index-1].value) &&
 						      arv_value_get_int64 (&stack[index].value));
-				stack[index-1].parenthesis_level = token->parenthesis_level;
+				stack[index-1].parenthesis_level = instruction->parenthesis_level;
 				break;
 			case ARV_EVALUATOR_TOKEN_LOGICAL_OR:
 				arv_value_set_int64 (&stack[index-1].value,
 						      arv_value_get_int64 (&stack[index-1].value) ||
 						      arv_value_get_int64 (&stack[index].value));
-				stack[index-1].parenthesis_level = token->parenthesis_level;
+				stack[index-1].parenthesis_level = instruction->parenthesis_level;
 				break;
 			case ARV_EVALUATOR_TOKEN_BITWISE_NOT:
 				arv_value_set_int64 (&stack[index].value,
 						      ~arv_value_get_int64 (&stack[index].value));
-				stack[index].parenthesis_level = token->parenthesis_level;
+				stack[index].parenthesis_level = instruction->parenthesis_level;
 				break;
 			case ARV_EVALUATOR_TOKEN_BITWISE_AND:
 				arv_value_set_int64 (&stack[index-1].value,
 						      arv_value_get_int64 (&stack[index-1].value) &
 						      arv_value_get_int64 (&stack[index].value));
-				stack[index-1].parenthesis_level = token->parenthesis_level;
+				stack[index-1].parenthesis_level = instruction->parenthesis_level;
 				break;
 			case ARV_EVALUATOR_TOKEN_BITWISE_OR:
 				arv_value_set_int64 (&stack[index-1].value,
 						      arv_value_get_int64 (&stack[index-1].value) |
 						      arv_value_get_int64 (&stack[index].value));
-				stack[index-1].parenthesis_level = token->parenthesis_level;
+				stack[index-1].parenthesis_level = instruction->parenthesis_level;
 				break;
 			case ARV_EVALUATOR_TOKEN_BITWISE_XOR:
 				arv_value_set_int64 (&stack[index-1].value,
 						      arv_value_get_int64 (&stack[index-1].value) ^
 						      arv_value_get_int64 (&stack[index].value));
-				stack[index-1].parenthesis_level = token->parenthesis_level;
+				stack[index-1].parenthesis_level = instruction->parenthesis_level;
 				break;
 			case ARV_EVALUATOR_TOKEN_EQUAL:
 				if (integer_mode ||
@@ -639,7 +663,7 @@ evaluate (GSList *token_stack, GHashTable *variables, gint64 *v_int64, double *v
 					arv_value_set_int64 (&stack[index - 1].value,
 							     arv_value_get_double (&stack[index-1].value) ==
 							     arv_value_get_double (&stack[index].value));
-				stack[index-1].parenthesis_level = token->parenthesis_level;
+				stack[index-1].parenthesis_level = instruction->parenthesis_level;
 				break;
 			case ARV_EVALUATOR_TOKEN_NOT_EQUAL:
 				if (integer_mode ||
@@ -652,7 +676,7 @@ evaluate (GSList *token_stack, GHashTable *variables, gint64 *v_int64, double *v
 					arv_value_set_int64 (&stack[index - 1].value,
 							     arv_value_get_double (&stack[index-1].value) !=
 							     arv_value_get_double (&stack[index].value));
-				stack[index-1].parenthesis_level = token->parenthesis_level;
+				stack[index-1].parenthesis_level = instruction->parenthesis_level;
 				break;
 			case ARV_EVALUATOR_TOKEN_LESS_OR_EQUAL:
 				if (integer_mode ||
@@ -665,7 +689,7 @@ evaluate (GSList *token_stack, GHashTable *variables, gint64 *v_int64, double *v
 					arv_value_set_int64 (&stack[index - 1].value,
 							     arv_value_get_double (&stack[index-1].value) <=
 							     arv_value_get_double (&stack[index].value));
-				stack[index-1].parenthesis_level = token->parenthesis_level;
+				stack[index-1].parenthesis_level = instruction->parenthesis_level;
 				break;
 			case ARV_EVALUATOR_TOKEN_GREATER_OR_EQUAL:
 				if (integer_mode ||
@@ -678,7 +702,7 @@ evaluate (GSList *token_stack, GHashTable *variables, gint64 *v_int64, double *v
 					arv_value_set_int64 (&stack[index - 1].value,
 							     arv_value_get_double (&stack[index-1].value) >=
 							     arv_value_get_double (&stack[index].value));
-				stack[index-1].parenthesis_level = token->parenthesis_level;
+				stack[index-1].parenthesis_level = instruction->parenthesis_level;
 				break;
 			case ARV_EVALUATOR_TOKEN_LESS:
 				if (integer_mode ||
@@ -691,7 +715,7 @@ evaluate (GSList *token_stack, GHashTable *variables, gint64 *v_int64, double *v
 					arv_value_set_int64 (&stack[index - 1].value,
 							     arv_value_get_double (&stack[index-1].value) <
 							     arv_value_get_double (&stack[index].value));
-				stack[index-1].parenthesis_level = token->parenthesis_level;
+				stack[index-1].parenthesis_level = instruction->parenthesis_level;
 				break;
 			case ARV_EVALUATOR_TOKEN_GREATER:
 				if (integer_mode ||
@@ -704,19 +728,19 @@ evaluate (GSList *token_stack, GHashTable *variables, gint64 *v_int64, double *v
 					arv_value_set_int64 (&stack[index - 1].value,
 							     arv_value_get_double (&stack[index-1].value) >
 							     arv_value_get_double (&stack[index].value));
-				stack[index-1].parenthesis_level = token->parenthesis_level;
+				stack[index-1].parenthesis_level = instruction->parenthesis_level;
 				break;
 			case ARV_EVALUATOR_TOKEN_SHIFT_RIGHT:
 				arv_value_set_int64 (&stack[index-1].value,
 						     arv_value_get_int64 (&stack[index-1].value) >>
 						     arv_value_get_int64 (&stack[index].value));
-				stack[index-1].parenthesis_level = token->parenthesis_level;
+				stack[index-1].parenthesis_level = instruction->parenthesis_level;
 				break;
 			case ARV_EVALUATOR_TOKEN_SHIFT_LEFT:
 				arv_value_set_int64 (&stack[index-1].value,
 						     arv_value_get_int64 (&stack[index-1].value) <<
 						     arv_value_get_int64 (&stack[index].value));
-				stack[index-1].parenthesis_level = token->parenthesis_level;
+				stack[index-1].parenthesis_level = instruction->parenthesis_level;
 				break;
 			case ARV_EVALUATOR_TOKEN_SUBSTRACTION:
 				if (integer_mode ||
@@ -729,7 +753,7 @@ evaluate (GSList *token_stack, GHashTable *variables, gint64 *v_int64, double *v
 					arv_value_set_double (&stack[index-1].value,
 							      arv_value_get_double (&stack[index-1].value) -
 							      arv_value_get_double (&stack[index].value));
-				stack[index-1].parenthesis_level = token->parenthesis_level;
+				stack[index-1].parenthesis_level = instruction->parenthesis_level;
 				break;
 			case ARV_EVALUATOR_TOKEN_ADDITION:
 				if (integer_mode ||
@@ -742,37 +766,43 @@ evaluate (GSList *token_stack, GHashTable *variables, gint64 *v_int64, double *v
 					arv_value_set_double (&stack[index-1].value,
 							      arv_value_get_double (&stack[index-1].value) +
 							      arv_value_get_double (&stack[index].value));
-				stack[index-1].parenthesis_level = token->parenthesis_level;
+				stack[index-1].parenthesis_level = instruction->parenthesis_level;
 				break;
 			case ARV_EVALUATOR_TOKEN_REMAINDER:
 				if (arv_value_get_int64 (&stack[index].value) == 0) {
-					status = ARV_EVALUATOR_STATUS_DIVISION_BY_ZERO;
-					goto CLEANUP;
+					return ARV_EVALUATOR_STATUS_DIVISION_BY_ZERO;
 				}
-				arv_value_set_int64 (&stack[index-1].value,
-						     arv_value_get_int64 (&stack[index-1].value) %
-						     arv_value_get_int64 (&stack[index].value));
-				stack[index-1].parenthesis_level = token->parenthesis_level;
+				/* G_MININT64 % -1 traps on x86 */
+				if (arv_value_get_int64 (&stack[index].value) == -1)
+					arv_value_set_int64 (&stack[index-1].value, 0);
+				else
+					arv_value_set_int64 (&stack[index-1].value,
+							     arv_value_get_int64 (&stack[index-1].value) %
+							     arv_value_get_int64 (&stack[index].value));
+				stack[index-1].parenthesis_level = instruction->parenthesis_level;
 				break;
 			case ARV_EVALUATOR_TOKEN_DIVISION:
 				if (integer_mode) {
 					if (arv_value_get_int64 (&stack[index].value) == 0) {
-						status = ARV_EVALUATOR_STATUS_DIVISION_BY_ZERO;
-						goto CLEANUP;
+						return ARV_EVALUATOR_STATUS_DIVISION_BY_ZERO;
 					}
-					arv_value_set_int64 (&stack[index-1].value,
-							     arv_value_get_int64 (&stack[index-1].value) /
-							     arv_value_get_int64 (&stack[index].value));
+					/* Same for G_MININT64 / -1 */
+					if (arv_value_get_int64 (&stack[index].value) == -1)
+						arv_value_set_int64 (&stack[index-1].value,
+								     (gint64) (0 - (guint64) arv_value_get_int64 (&stack[index-1].value)));
+					else
+						arv_value_set_int64 (&stack[index-1].value,
+								     arv_value_get_int64 (&stack[index-1].value) /
+								     arv_value_get_int64 (&stack[index].value));
 				} else {
 					if (arv_value_get_double (&stack[index].value) == 0.0) {
-						status = ARV_EVALUATOR_STATUS_DIVISION_BY_ZERO;
-						goto CLEANUP;
+						return ARV_EVALUATOR_STATUS_DIVISION_BY_ZERO;
 					}
 					arv_value_set_double (&stack[index-1].value,
 							      arv_value_get_double (&stack[index-1].value) /
 							      arv_value_get_double (&stack[index].value));
 				}
-				stack[index-1].parenthesis_level = token->parenthesis_level;
+				stack[index-1].parenthesis_level = instruction->parenthesis_level;
 				break;
 			case ARV_EVALUATOR_TOKEN_MULTIPLICATION:
 				if (integer_mode ||
@@ -785,7 +815,7 @@ evaluate (GSList *token_stack, GHashTable *variables, gint64 *v_int64, double *v
 					arv_value_set_double (&stack[index-1].value,
 							      arv_value_get_double (&stack[index-1].value) *
 							      arv_value_get_double (&stack[index].value));
-				stack[index-1].parenthesis_level = token->parenthesis_level;
+				stack[index-1].parenthesis_level = instruction->parenthesis_level;
 				break;
 			case ARV_EVALUATOR_TOKEN_POWER:
 				if (integer_mode)
@@ -796,7 +826,7 @@ evaluate (GSList *token_stack, GHashTable *variables, gint64 *v_int64, double *v
 					arv_value_set_double (&stack[index-1].value,
 							      pow (arv_value_get_double(&stack[index-1].value),
 								   arv_value_get_double(&stack[index].value)));
-				stack[index-1].parenthesis_level = token->parenthesis_level;
+				stack[index-1].parenthesis_level = instruction->parenthesis_level;
 				break;
 			case ARV_EVALUATOR_TOKEN_MINUS:
 				if (integer_mode || arv_value_holds_int64 (&stack[index].value))
@@ -805,17 +835,17 @@ evaluate (GSList *token_stack, GHashTable *variables, gint64 *v_int64, double *v
 				else
 					arv_value_set_double (&stack[index].value,
 							      -arv_value_get_double (&stack[index].value));
-				stack[index].parenthesis_level = token->parenthesis_level;
+				stack[index].parenthesis_level = instruction->parenthesis_level;
 				break;
 			case ARV_EVALUATOR_TOKEN_PLUS:
 				break;
 			case ARV_EVALUATOR_TOKEN_FUNCTION_SIN:
 				arv_value_set_double (&stack[index].value, sin (arv_value_get_double (&stack[index].value)));
-				stack[index].parenthesis_level = token->parenthesis_level;
+				stack[index].parenthesis_level = instruction->parenthesis_level;
 				break;
 			case ARV_EVALUATOR_TOKEN_FUNCTION_COS:
 				arv_value_set_double (&stack[index].value, cos (arv_value_get_double (&stack[index].value)));
-				stack[index].parenthesis_level = token->parenthesis_level;
+				stack[index].parenthesis_level = instruction->parenthesis_level;
 				break;
 			case ARV_EVALUATOR_TOKEN_FUNCTION_SGN:
 				if (integer_mode || arv_value_holds_int64 (&stack[index].value)) {
@@ -835,7 +865,7 @@ evaluate (GSList *token_stack, GHashTable *variables, gint64 *v_int64, double *v
 					else
 						arv_value_set_int64 (&stack[index].value, 0);
 				}
-				stack[index].parenthesis_level = token->parenthesis_level;
+				stack[index].parenthesis_level = instruction->parenthesis_level;
 				break;
 			case ARV_EVALUATOR_TOKEN_FUNCTION_NEG:
 				if (integer_mode || arv_value_holds_int64 (&stack[index].value))
@@ -844,15 +874,15 @@ evaluate (GSList *token_stack, GHashTable *variables, gint64 *v_int64, double *v
 				else
 					arv_value_set_double (&stack[index].value,
 							      -arv_value_get_double (&stack[index].value));
-				stack[index].parenthesis_level = token->parenthesis_level;
+				stack[index].parenthesis_level = instruction->parenthesis_level;
 				break;
 			case ARV_EVALUATOR_TOKEN_FUNCTION_ATAN:
 				arv_value_set_double (&stack[index].value, atan (arv_value_get_double (&stack[index].value)));
-				stack[index].parenthesis_level = token->parenthesis_level;
+				stack[index].parenthesis_level = instruction->parenthesis_level;
 				break;
 			case ARV_EVALUATOR_TOKEN_FUNCTION_TAN:
 				arv_value_set_double (&stack[index].value, tan (arv_value_get_double (&stack[index].value)));
-				stack[index].parenthesis_level = token->parenthesis_level;
+				stack[index].parenthesis_level = instruction->parenthesis_level;
 				break;
 			case ARV_EVALUATOR_TOKEN_FUNCTION_ABS:
 				if (arv_value_holds_double (&stack[index].value))
@@ -861,23 +891,23 @@ evaluate (GSList *token_stack, GHashTable *variables, gint64 *v_int64, double *v
 				else
 					arv_value_set_int64 (&stack[index].value,
 							     llabs (arv_value_get_int64 (&stack[index].value)));
-				stack[index].parenthesis_level = token->parenthesis_level;
+				stack[index].parenthesis_level = instruction->parenthesis_level;
 				break;
 			case ARV_EVALUATOR_TOKEN_FUNCTION_EXP:
 				arv_value_set_double (&stack[index].value, exp (arv_value_get_double (&stack[index].value)));
-				stack[index].parenthesis_level = token->parenthesis_level;
+				stack[index].parenthesis_level = instruction->parenthesis_level;
 				break;
 			case ARV_EVALUATOR_TOKEN_FUNCTION_LN:
 				arv_value_set_double (&stack[index].value, log (arv_value_get_double (&stack[index].value)));
-				stack[index].parenthesis_level = token->parenthesis_level;
+				stack[index].parenthesis_level = instruction->parenthesis_level;
 				break;
 			case ARV_EVALUATOR_TOKEN_FUNCTION_LG:
 				arv_value_set_double (&stack[index].value, log10 (arv_value_get_double (&stack[index].value)));
-				stack[index].parenthesis_level = token->parenthesis_level;
+				stack[index].parenthesis_level = instruction->parenthesis_level;
 				break;
 			case ARV_EVALUATOR_TOKEN_FUNCTION_SQRT:
 				arv_value_set_double (&stack[index].value, sqrt (arv_value_get_double (&stack[index].value)));
-				stack[index].parenthesis_level = token->parenthesis_level;
+				stack[index].parenthesis_level = instruction->parenthesis_level;
 				break;
 			case ARV_EVALUATOR_TOKEN_FUNCTION_TRUNC:
 				if (arv_value_get_double (&stack[index].value) > 0.0)
@@ -886,64 +916,59 @@ evaluate (GSList *token_stack, GHashTable *variables, gint64 *v_int64, double *v
 				else
 					arv_value_set_double (&stack[index].value,
 							      ceil (arv_value_get_double (&stack[index].value)));
-				stack[index].parenthesis_level = token->parenthesis_level;
+				stack[index].parenthesis_level = instruction->parenthesis_level;
 				break;
 			case ARV_EVALUATOR_TOKEN_FUNCTION_ROUND:
 				actual_arguments_count = get_arguments_count(stack, index);
 				if (actual_arguments_count==1) {
 					arv_value_set_double(&stack[index].value, round(arv_value_get_double(&stack[index].value)));
-					stack[index].parenthesis_level = token->parenthesis_level;
+					stack[index].parenthesis_level = instruction->parenthesis_level;
 				} else if (actual_arguments_count==2) {
 					arv_value_set_double(&stack[index - 1].value,
 										 round_with_precision(arv_value_get_double(&stack[index - 1].value),
 															  arv_value_get_int64(&stack[index].value)));
-					stack[index - 1].parenthesis_level = token->parenthesis_level;
+					stack[index - 1].parenthesis_level = instruction->parenthesis_level;
 				} else {
-					if (actual_arguments_count<1) {
-						status = ARV_EVALUATOR_STATUS_MISSING_ARGUMENTS;
-					} else {
-						status = ARV_EVALUATOR_STATUS_REMAINING_OPERANDS;
-					}
-					goto CLEANUP;
+					if (actual_arguments_count<1)
+						return ARV_EVALUATOR_STATUS_MISSING_ARGUMENTS;
+					else
+						return ARV_EVALUATOR_STATUS_REMAINING_OPERANDS;
 				}
 
 				break;
 			case ARV_EVALUATOR_TOKEN_FUNCTION_FLOOR:
 				arv_value_set_double (&stack[index].value, floor (arv_value_get_double (&stack[index].value)));
-				stack[index].parenthesis_level = token->parenthesis_level;
+				stack[index].parenthesis_level = instruction->parenthesis_level;
 				break;
 			case ARV_EVALUATOR_TOKEN_FUNCTION_CEIL:
 				arv_value_set_double (&stack[index].value, ceil (arv_value_get_double (&stack[index].value)));
-				stack[index].parenthesis_level = token->parenthesis_level;
+				stack[index].parenthesis_level = instruction->parenthesis_level;
 				break;
 			case ARV_EVALUATOR_TOKEN_FUNCTION_ASIN:
 				arv_value_set_double (&stack[index].value, asin (arv_value_get_double (&stack[index].value)));
-				stack[index].parenthesis_level = token->parenthesis_level;
+				stack[index].parenthesis_level = instruction->parenthesis_level;
 				break;
 			case ARV_EVALUATOR_TOKEN_FUNCTION_ACOS:
 				arv_value_set_double (&stack[index].value, acos (arv_value_get_double (&stack[index].value)));
-				stack[index].parenthesis_level = token->parenthesis_level;
+				stack[index].parenthesis_level = instruction->parenthesis_level;
 				break;
 			case ARV_EVALUATOR_TOKEN_CONSTANT_INT64:
-				arv_value_set_int64 (&stack[index+1].value, token->data.v_int64);
-				stack[index+1].parenthesis_level = token->parenthesis_level;
+				arv_value_set_int64 (&stack[index+1].value, instruction->data.v_int64);
+				stack[index+1].parenthesis_level = instruction->parenthesis_level;
 				break;
 			case ARV_EVALUATOR_TOKEN_CONSTANT_DOUBLE:
 				if (integer_mode)
-					arv_value_set_int64 (&stack[index+1].value, token->data.v_double);
+					arv_value_set_int64 (&stack[index+1].value, instruction->data.v_double);
 				else
-					arv_value_set_double (&stack[index+1].value, token->data.v_double);
-				stack[index+1].parenthesis_level = token->parenthesis_level;
+					arv_value_set_double (&stack[index+1].value, instruction->data.v_double);
+				stack[index+1].parenthesis_level = instruction->parenthesis_level;
 				break;
 			case ARV_EVALUATOR_TOKEN_VARIABLE:
-				value = g_hash_table_lookup (variables, token->data.name);
-				if (value != NULL) {
-					arv_value_copy (&stack[index+1].value, value);
-					stack[index+1].parenthesis_level = token->parenthesis_level;
-				} else {
-					status = ARV_EVALUATOR_STATUS_UNKNOWN_VARIABLE;
-					goto CLEANUP;
-				}
+				value = &variables[instruction->data.slot];
+				if (value->type == G_TYPE_INVALID)
+					return ARV_EVALUATOR_STATUS_UNKNOWN_VARIABLE;
+				arv_value_copy (&stack[index+1].value, value);
+				stack[index+1].parenthesis_level = instruction->parenthesis_level;
 				break;
 			case ARV_EVALUATOR_TOKEN_TERNARY_COLON:
 				break;
@@ -957,38 +982,27 @@ evaluate (GSList *token_stack, GHashTable *variables, gint64 *v_int64, double *v
 				}
 				break;
 			default:
-				status = ARV_EVALUATOR_STATUS_UNKNOWN_OPERATOR;
-				goto CLEANUP;
+				return ARV_EVALUATOR_STATUS_UNKNOWN_OPERATOR;
 				break;
 		}
 		index = index - actual_arguments_count + 1;
 	}
 
-	if (index != 0) {
-		status = ARV_EVALUATOR_STATUS_REMAINING_OPERANDS;
-		goto CLEANUP;
-	}
-
-	if (v_double != NULL)
-		*v_double = arv_value_get_double (&stack[0].value);
+	if (index != 0)
+		return ARV_EVALUATOR_STATUS_REMAINING_OPERANDS;
 
-	if (v_int64 != NULL)
-		*v_int64 = arv_value_get_int64 (&stack[0].value);
+	if (G_UNLIKELY (debug)) {
+		if (arv_value_holds_int64 (&stack[0].value))
+			arv_debug_evaluator ("[Evaluator::evaluate] Result = (int64) %" G_GINT64_FORMAT,
+					     arv_value_get_int64 (&stack[0].value));
+		else
+			arv_debug_evaluator ("[Evaluator::evaluate] Result = (double) %g",
+					     arv_value_get_double (&stack[0].value));
+	}
 
-	if (arv_value_holds_int64 (&stack[0].value))
-		arv_debug_evaluator ("[Evaluator::evaluate] Result = (int64) %" G_GINT64_FORMAT, arv_value_get_int64 (&stack[0].value));
-	else
-		arv_debug_evaluator ("[Evaluator::evaluate] Result = (double) %g", arv_value_get_double (&stack[0].value));
+	*result = stack[0];
 
 	return ARV_EVALUATOR_STATUS_SUCCESS;
-CLEANUP:
-	if (v_double != NULL)
-		*v_double = 0.0;
-
-	if (v_int64 != NULL)
-		*v_int64 = 0.0;
-
-	return status;
 }
 
 typedef struct {
@@ -1130,15 +1144,205 @@ CLEANUP:
 	return status;
 }
 
-static void
-free_rpn_stack (ArvEvaluator *evaluator)
+static guint
+_get_variable_slot (ArvEvaluator *evaluator, const char *name)
 {
+	ArvValue value = {0};
+	gpointer slot;
+	char *key;
+
+	if (g_hash_table_lookup_extended (evaluator->priv->variable_slots, name, NULL, &slot))
+		return GPOINTER_TO_UINT (slot);
+
+	/* The value type stays invalid until the variable is set */
+
+	key = g_strdup (name);
+	g_ptr_array_add (evaluator->priv->variable_names, key);
+	g_array_append_val (evaluator->priv->variables, value);
+	g_hash_table_insert (evaluator->priv->variable_slots, key,
+			     GUINT_TO_POINTER (evaluator->priv->variables->len - 1));
+
+	return evaluator->priv->variables->len - 1;
+}
+
+static ArvEvaluatorInstruction *
+compile_rpn_stack (ArvEvaluator *evaluator, GSList *rpn_stack, guint *n_instructions)
+{
+	ArvEvaluatorInstruction *instructions;
 	GSList *iter;
+	guint i;
 
-	for (iter = evaluator->priv->rpn_stack; iter != NULL; iter = iter->next)
-		arv_evaluator_token_free (iter->data);
-	g_slist_free (evaluator->priv->rpn_stack);
-	evaluator->priv->rpn_stack = NULL;
+	*n_instructions = g_slist_length (rpn_stack);
+	instructions = g_new0 (ArvEvaluatorInstruction, *n_instructions);
+
+	for (iter = rpn_stack, i = 0; iter != NULL; iter = iter->next, i++) {
+		ArvEvaluatorToken *token = iter->data;
+
+		instructions[i].opcode = token->token_id;
+		instructions[i].parenthesis_level = token->parenthesis_level;
+
+		switch (token->token_id) {
+			case ARV_EVALUATOR_TOKEN_VARIABLE:
+				instructions[i].data.slot = _get_variable_slot (evaluator, token->data.name);
+				break;
+			case ARV_EVALUATOR_TOKEN_CONSTANT_INT64:
+				instructions[i].data.v_int64 = token->data.v_int64;
+				break;
+			case ARV_EVALUATOR_TOKEN_CONSTANT_DOUBLE:
+				instructions[i].data.v_double = token->data.v_double;
+				break;
+			default:
+				break;
+		}
+	}
+
+	return instructions;
+}
+
+typedef struct {
+	guint start;			/* Index of the first instruction computing this value */
+	gint32 parenthesis_level;
+	gboolean is_level_known;
+	gboolean is_constant;
+} ArvEvaluatorFoldItem;
+
+/* Same as get_arguments_count (), returns -1 if the parenthesis levels depend on a ternary condition */
+
+static int
+get_fold_arguments_count (ArvEvaluatorFoldItem *stack, int current_index)
+{
+	int arguments_count = 0;
+	int index;
+
+	for (index = current_index; index >= 0; index--) {
+		if (!stack[index].is_level_known)
+			return -1;
+		if (stack[index].parenthesis_level < stack[current_index].parenthesis_level)
+			break;
+		arguments_count++;
+	}
+
+	return arguments_count;
+}
+
+/* Replace the operators with only constant operands by their result. The result of an operation may depend on the
+ * evaluation mode (10/4 or a double constant in integer mode), hence one program per mode. The operation is evaluated
+ * using the same code than at run time. Operations failing at compilation time are left in the program, in order
+ * to report the error at evaluation time. The folding stops at the first instruction for which the stack state can
+ * not be predicted. */
+
+static void
+fold_constants (const ArvEvaluatorInstruction *instructions, guint n_instructions, gboolean integer_mode,
+		ArvEvaluatorProgram *program)
+{
+	ArvEvaluatorFoldItem stack[ARV_EVALUATOR_STACK_SIZE];
+	GArray *folded;
+	int index = -1;
+	guint i;
+
+	folded = g_array_sized_new (FALSE, FALSE, sizeof (ArvEvaluatorInstruction), n_instructions);
+
+	for (i = 0; i < n_instructions; i++) {
+		const ArvEvaluatorInstruction *instruction = &instructions[i];
+		ArvEvaluatorFoldItem item;
+		int n_args;
+		int j;
+
+		g_array_append_val (folded, *instruction);
+
+		n_args = arv_evaluator_token_infos[instruction->opcode].n_args;
+
+		if (index < n_args - 1 || index >= ARV_EVALUATOR_STACK_SIZE - 1)
+			break;
+
+		if (n_args == 0) {
+			index++;
+			stack[index].start = folded->len - 1;
+			stack[index].parenthesis_level = instruction->parenthesis_level;
+			stack[index].is_level_known = TRUE;
+			stack[index].is_constant = instruction->opcode != ARV_EVALUATOR_TOKEN_VARIABLE;
+			continue;
+		}
+
+		if (instruction->opcode == ARV_EVALUATOR_TOKEN_FUNCTION_ROUND) {
+			n_args = get_fold_arguments_count (stack, index);
+			if (n_args < 1 || n_args > 2)
+				break;
+		}
+
+		item.start = stack[index - n_args + 1].start;
+		item.is_constant = TRUE;
+		for (j = index - n_args + 1; j <= index; j++)
+			item.is_constant = item.is_constant && stack[j].is_constant;
+
+		if (item.is_constant) {
+			ArvEvaluatorProgram operation;
+			ArvEvaluatorValuesStackItem result;
+
+			operation.instructions = &g_array_index (folded, ArvEvaluatorInstruction, item.start);
+			operation.n_instructions = folded->len - item.start;
+
+			if (evaluate (&operation, NULL, integer_mode, &result) == ARV_EVALUATOR_STATUS_SUCCESS) {
+				ArvEvaluatorInstruction constant = {0};
+
+				constant.parenthesis_level = result.parenthesis_level;
+				if (arv_value_holds_int64 (&result.value)) {
+					constant.opcode = ARV_EVALUATOR_TOKEN_CONSTANT_INT64;
+					constant.data.v_int64 = arv_value_get_int64 (&result.value);
+				} else {
+					constant.opcode = ARV_EVALUATOR_TOKEN_CONSTANT_DOUBLE;
+					constant.data.v_double = arv_value_get_double (&result.value);
+				}
+
+				g_array_set_size (folded, item.start);
+				g_array_append_val (folded, constant);
+
+				item.parenthesis_level = result.parenthesis_level;
+				item.is_level_known = TRUE;
+			} else
+				item.is_constant = FALSE;
+		}
+
+		if (!item.is_constant) {
+			switch (instruction->opcode) {
+				case ARV_EVALUATOR_TOKEN_PLUS:
+				case ARV_EVALUATOR_TOKEN_TERNARY_COLON:
+					item.parenthesis_level = stack[index].parenthesis_level;
+					item.is_level_known = stack[index].is_level_known;
+					break;
+				case ARV_EVALUATOR_TOKEN_TERNARY_QUESTION_MARK:
+					item.parenthesis_level = stack[index].parenthesis_level;
+					item.is_level_known = stack[index].is_level_known &&
+						stack[index - 1].is_level_known &&
+						stack[index].parenthesis_level == stack[index - 1].parenthesis_level;
+					break;
+				default:
+					item.parenthesis_level = instruction->parenthesis_level;
+					item.is_level_known = TRUE;
+					break;
+			}
+		}
+
+		index = index - n_args + 1;
+		stack[index] = item;
+	}
+
+	if (i < n_instructions)
+		g_array_append_vals (folded, &instructions[i + 1], n_instructions - i - 1);
+
+	program->n_instructions = folded->len;
+	program->instructions = (ArvEvaluatorInstruction *) g_array_free (folded, FALSE);
+}
+
+static void
+free_programs (ArvEvaluator *evaluator)
+{
+	guint i;
+
+	for (i = 0; i < G_N_ELEMENTS (evaluator->priv->programs); i++) {
+		g_clear_pointer (&evaluator->priv->programs[i].instructions, g_free);
+		evaluator->priv->programs[i].n_instructions = 0;
+	}
 }
 
 static ArvEvaluatorStatus
@@ -1146,6 +1350,8 @@ parse_expression (ArvEvaluator *evaluator)
 {
 	ArvEvaluatorParserState state;
 	ArvEvaluatorStatus status;
+	ArvEvaluatorInstruction *instructions;
+	guint n_instructions;
 	GSList *iter;
 	int count;
 
@@ -1157,7 +1363,7 @@ parse_expression (ArvEvaluator *evaluator)
 	state.garbage_stack = NULL;
 	state.in_sub_expression = FALSE;
 
-	free_rpn_stack (evaluator);
+	free_programs (evaluator);
 
 	arv_debug_evaluator ("[Evaluator::parse_expression] %s", evaluator->priv->expression);
 
@@ -1177,16 +1383,35 @@ parse_expression (ArvEvaluator *evaluator)
 		state.operator_stack = g_slist_delete_link (state.operator_stack, state.operator_stack);
 	}
 
-	evaluator->priv->rpn_stack = g_slist_reverse (state.token_stack);
+	state.token_stack = g_slist_reverse (state.token_stack);
 
 	for (iter = state.garbage_stack, count = 0; iter != NULL; iter = iter->next, count++)
 		arv_evaluator_token_free (iter->data);
 	g_slist_free (state.garbage_stack);
+	state.garbage_stack = NULL;
 
 	arv_debug_evaluator ("[Evaluator::parse_expression] %d items in garbage list", count);
-	arv_debug_evaluator ("[Evaluator::parse_expression] %d items in token list", g_slist_length (evaluator->priv->rpn_stack));
+	arv_debug_evaluator ("[Evaluator::parse_expression] %d items in token list", g_slist_length (state.token_stack));
+
+	if (state.token_stack == NULL)
+		return ARV_EVALUATOR_STATUS_EMPTY_EXPRESSION;
+
+	instructions = compile_rpn_stack (evaluator, state.token_stack, &n_instructions);
 
-	return evaluator->priv->rpn_stack == NULL ? ARV_EVALUATOR_STATUS_EMPTY_EXPRESSION : ARV_EVALUATOR_STATUS_SUCCESS;
+	fold_constants (instructions, n_instructions, FALSE, &evaluator->priv->programs[FALSE]);
+	fold_constants (instructions, n_instructions, TRUE, &evaluator->priv->programs[TRUE]);
+
+	g_free (instructions);
+
+	arv_debug_evaluator ("[Evaluator::parse_expression] %d instructions after constant folding (%d in integer mode)",
+			     evaluator->priv->programs[FALSE].n_instructions,
+			     evaluator->priv->programs[TRUE].n_instructions);
+
+	for (iter = state.token_stack; iter != NULL; iter = iter->next)
+		arv_evaluator_token_free (iter->data);
+	g_slist_free (state.token_stack);
+
+	return ARV_EVALUATOR_STATUS_SUCCESS;
 
 CLEANUP:
 	for (iter = state.garbage_stack; iter != NULL; iter = iter->next)
@@ -1220,8 +1445,8 @@ arv_evaluator_set_error (GError **error, ArvEvaluatorStatus status)
 double
 arv_evaluator_evaluate_as_double (ArvEvaluator *evaluator, GError **error)
 {
+	ArvEvaluatorValuesStackItem result;
 	ArvEvaluatorStatus status;
-	double value;
 
 	g_return_val_if_fail (ARV_IS_EVALUATOR (evaluator), 0.0);
 
@@ -1239,21 +1464,21 @@ arv_evaluator_evaluate_as_double (ArvEvaluator *evaluator, GError **error)
 		return 0.0;
 	}
 
-	status = evaluate (evaluator->priv->rpn_stack, evaluator->priv->variables, NULL, &value);
+	status = evaluate (&evaluator->priv->programs[FALSE], evaluator->priv, FALSE, &result);
 
 	if (status != ARV_EVALUATOR_STATUS_SUCCESS) {
 		arv_evaluator_set_error (error, status);
 		return 0.0;
 	}
 
-	return value;
+	return arv_value_get_double (&result.value);
 }
 
 gint64
 arv_evaluator_evaluate_as_int64 (ArvEvaluator *evaluator, GError **error)
 {
+	ArvEvaluatorValuesStackItem result;
 	ArvEvaluatorStatus status;
-	gint64 value;
 
 	g_return_val_if_fail (ARV_IS_EVALUATOR (evaluator), 0.0);
 
@@ -1271,7 +1496,7 @@ arv_evaluator_evaluate_as_int64 (ArvEvaluator *evaluator, GError **error)
 		return 0.0;
 	}
 
-	status = evaluate (evaluator->priv->rpn_stack, evaluator->priv->variables, &value, NULL);
+	status = evaluate (&evaluator->priv->programs[TRUE], evaluator->priv, TRUE, &result);
 
 	if (status != ARV_EVALUATOR_STATUS_SUCCESS) {
 
@@ -1279,7 +1504,7 @@ arv_evaluator_evaluate_as_int64 (ArvEvaluator *evaluator, GError **error)
 		return 0.0;
 	}
 
-	return value;
+	return arv_value_get_int64 (&result.value);
 }
 
 void
@@ -1426,40 +1651,64 @@ arv_evaluator_get_constant (ArvEvaluator *evaluator, const char *name)
 void
 arv_evaluator_set_double_variable (ArvEvaluator *evaluator, const char *name, double v_double)
 {
-	ArvValue *old_value;
+	g_return_if_fail (ARV_IS_EVALUATOR (evaluator));
+	g_return_if_fail (name != NULL);
 
+	arv_evaluator_set_double_variable_by_slot (evaluator, _get_variable_slot (evaluator, name), v_double);
+}
+
+void
+arv_evaluator_set_int64_variable (ArvEvaluator *evaluator, const char *name, gint64 v_int64)
+{
 	g_return_if_fail (ARV_IS_EVALUATOR (evaluator));
 	g_return_if_fail (name != NULL);
 
-	old_value = g_hash_table_lookup (evaluator->priv->variables, name);
-	if (old_value != NULL && (arv_value_get_double (old_value) == v_double))
+	arv_evaluator_set_int64_variable_by_slot (evaluator, _get_variable_slot (evaluator, name), v_int64);
+}
+
+guint
+arv_evaluator_get_variable_slot (ArvEvaluator *evaluator, const char *name)
+{
+	g_return_val_if_fail (ARV_IS_EVALUATOR (evaluator), 0);
+	g_return_val_if_fail (name != NULL, 0);
+
+	return _get_variable_slot (evaluator, name);
+}
+
+void
+arv_evaluator_set_double_variable_by_slot (ArvEvaluator *evaluator, guint slot, double v_double)
+{
+	ArvValue *value;
+
+	g_return_if_fail (ARV_IS_EVALUATOR (evaluator));
+	g_return_if_fail (slot < evaluator->priv->variables->len);
+
+	value = &g_array_index (evaluator->priv->variables, ArvValue, slot);
+	if (value->type != G_TYPE_INVALID && arv_value_get_double (value) == v_double)
 		return;
 
-        g_hash_table_replace (evaluator->priv->variables,
-                              g_strdup (name),
-                              arv_value_new_double (v_double));
+	arv_value_set_double (value, v_double);
 
 	arv_debug_evaluator ("[Evaluator::set_double_variable] %s = %g",
-			   name, v_double);
+			   (char *) g_ptr_array_index (evaluator->priv->variable_names, slot), v_double);
 }
 
 void
-arv_evaluator_set_int64_variable (ArvEvaluator *evaluator, const char *name, gint64 v_int64)
+arv_evaluator_set_int64_variable_by_slot (ArvEvaluator *evaluator, guint slot, gint64 v_int64)
 {
-	ArvValue *old_value;
+	ArvValue *value;
 
 	g_return_if_fail (ARV_IS_EVALUATOR (evaluator));
-	g_return_if_fail (name != NULL);
+	g_return_if_fail (slot < evaluator->priv->variables->len);
 
-	old_value = g_hash_table_lookup (evaluator->priv->variables, name);
-	if (old_value != NULL && (arv_value_get_int64 (old_value) == v_int64))
+	value = &g_array_index (evaluator->priv->variables, ArvValue, slot);
+	if (value->type != G_TYPE_INVALID && arv_value_get_int64 (value) == v_int64)
 		return;
 
-        g_hash_table_replace (evaluator->priv->variables,
-                              g_strdup (name),
-                              arv_value_new_int64 (v_int64));
+	arv_value_set_int64 (value, v_int64);
 
-	arv_debug_evaluator ("[Evaluator::set_int64_variable] %s = %" G_GINT64_FORMAT, name, v_int64);
+	arv_debug_evaluator ("[Evaluator::set_int64_variable] %s = %" G_GINT64_FORMAT,
+			     (char *) g_ptr_array_index (evaluator->priv->variable_names, slot), v_int64);
 }
 
 /**
@@ -1489,8 +1738,9 @@ arv_evaluator_init (ArvEvaluator *evaluator)
 	evaluator->priv = arv_evaluator_get_instance_private (evaluator);
 
 	evaluator->priv->expression = NULL;
-	evaluator->priv->rpn_stack = NULL;
-	evaluator->priv->variables = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, (GDestroyNotify) arv_value_free);
+	evaluator->priv->variable_slots = g_hash_table_new (g_str_hash, g_str_equal);
+	evaluator->priv->variable_names = g_ptr_array_new_with_free_func (g_free);
+	evaluator->priv->variables = g_array_new (FALSE, FALSE, sizeof (ArvValue));
 	evaluator->priv->sub_expressions = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, g_free);
 	evaluator->priv->constants = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, g_free);
 
@@ -1504,10 +1754,12 @@ arv_evaluator_finalize (GObject *object)
 	ArvEvaluator *evaluator = ARV_EVALUATOR (object);
 
 	arv_evaluator_set_expression (evaluator, NULL);
-	g_hash_table_unref (evaluator->priv->variables);
+	g_hash_table_unref (evaluator->priv->variable_slots);
+	g_ptr_array_unref (evaluator->priv->variable_names);
+	g_array_unref (evaluator->priv->variables);
 	g_hash_table_unref (evaluator->priv->sub_expressions);
 	g_hash_table_unref (evaluator->priv->constants);
-	free_rpn_stack (evaluator);
+	free_programs (evaluator);
 
 	G_OBJECT_CLASS (arv_evaluator_parent_class)->finalize (object);
 }
@@ -0,0 +1,39 @@
+/* Aravis - Digital camera library
+ *
+ * Copyright © 2009-2025 Emmanuel Pacaud <emmanuel.pacaud@free.fr>
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: Emmanuel Pacaud <emmanuel.pacaud@free.fr>
+ */
+
+#ifndef ARV_EVALUATOR_PRIVATE_H
+#define ARV_EVALUATOR_PRIVATE_H
+
+#include <arvevaluator.h>
+
+G_BEGIN_DECLS
+
+/* Variable slots are allocated once per name and stay valid for the lifetime of the evaluator, whatever the
+ * expression. They allow the callers that update the same variables on each evaluation to skip the name lookup. */
+
+ARV_API guint		arv_evaluator_get_variable_slot			(ArvEvaluator *evaluator, const char *name);
+ARV_API void		arv_evaluator_set_double_variable_by_slot	(ArvEvaluator *evaluator, guint slot, double v_double);
+ARV_API void		arv_evaluator_set_int64_variable_by_slot	(ArvEvaluator *evaluator, guint slot, gint64 v_int64);
+
+G_END_DECLS
+
+#endif
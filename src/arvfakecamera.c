@@ -127,6 +127,19 @@ arv_fake_camera_read_memory (ArvFakeCamera *camera, guint32 address, guint32 siz
 	return TRUE;
 }
 
+static guint32
+_get_register (ArvFakeCamera *camera, guint32 address)
+{
+	guint32 value;
+
+	if (address + sizeof (guint32) > ARV_FAKE_CAMERA_MEMORY_SIZE)
+		return 0;
+
+	value = *((guint32 *) (((char *)(camera->priv->memory) + address)));
+
+	return GUINT32_FROM_BE (value);
+}
+
 gboolean
 arv_fake_camera_write_memory (ArvFakeCamera *camera, guint32 address, guint32 size, const void *buffer)
 {
@@ -141,6 +154,18 @@ arv_fake_camera_write_memory (ArvFakeCamera *camera, guint32 address, guint32 si
 
 	memcpy (((char *) camera->priv->memory) + address, buffer, size);
 
+	/* Timestamp latch, with the same time base than the frame timestamps, at the nominal 1 GHz tick frequency */
+	if (address <= ARV_GVBS_TIMESTAMP_CONTROL_OFFSET &&
+	    address + size >= ARV_GVBS_TIMESTAMP_CONTROL_OFFSET + sizeof (guint32) &&
+	    (_get_register (camera, ARV_GVBS_TIMESTAMP_CONTROL_OFFSET) & ARV_GVBS_TIMESTAMP_CONTROL_LATCH) != 0) {
+		guint64 timestamp_ns = g_get_real_time () * 1000;
+
+		arv_fake_camera_write_register (camera, ARV_GVBS_TIMESTAMP_LATCHED_VALUE_HIGH_OFFSET, timestamp_ns >> 32);
+		arv_fake_camera_write_register (camera, ARV_GVBS_TIMESTAMP_LATCHED_VALUE_LOW_OFFSET,
+						timestamp_ns & 0xffffffff);
+		arv_fake_camera_write_register (camera, ARV_GVBS_TIMESTAMP_CONTROL_OFFSET, 0);
+	}
+
 	return TRUE;
 }
 
@@ -176,19 +201,6 @@ arv_fake_camera_write_register (ArvFakeCamera *camera, guint32 address, guint32
 	return arv_fake_camera_write_memory (camera, address, sizeof (value), &be_value);
 }
 
-static guint32
-_get_register (ArvFakeCamera *camera, guint32 address)
-{
-	guint32 value;
-
-	if (address + sizeof (guint32) > ARV_FAKE_CAMERA_MEMORY_SIZE)
-		return 0;
-
-	value = *((guint32 *) (((char *)(camera->priv->memory) + address)));
-
-	return GUINT32_FROM_BE (value);
-}
-
 size_t
 arv_fake_camera_get_payload (ArvFakeCamera *camera)
 {
@@ -1090,6 +1102,9 @@ arv_fake_camera_new_full (const char *serial_number, const char *genicam_filenam
 
 	arv_fake_camera_write_register (fake_camera, ARV_GVBS_N_STREAM_CHANNELS_OFFSET, 1);
 
+	arv_fake_camera_write_register (fake_camera, ARV_GVBS_GVCP_CAPABILITY_OFFSET,
+					ARV_GVBS_GVCP_CAPABILITY_CONCATENATION);
+
 	arv_fake_camera_write_register (fake_camera, ARV_FAKE_CAMERA_REGISTER_TEST, ARV_FAKE_CAMERA_TEST_REGISTER_DEFAULT);
 
 	return fake_camera;
@@ -98,11 +98,7 @@ arv_fake_stream_thread (void *data)
 				thread_data->n_completed_buffers++;
 			else
 				thread_data->n_failures++;
-			arv_stream_push_output_buffer (thread_data->stream, buffer);
-
-			if (thread_data->callback != NULL)
-				thread_data->callback (thread_data->callback_data, ARV_STREAM_CALLBACK_TYPE_BUFFER_DONE,
-						       buffer);
+			arv_stream_push_completed_buffer (thread_data->stream, buffer);
 		} else
 			thread_data->n_underruns++;
 	}
@@ -31,7 +31,7 @@
 
 #include <arvgcprivate.h>
 #include <arvgcnode.h>
-#include <arvgcpropertynode.h>
+#include <arvgcpropertynodeprivate.h>
 #include <arvgcindexnode.h>
 #include <arvgcvalueindexednode.h>
 #include <arvgcinvalidatornode.h>
@@ -59,10 +59,16 @@
 #include <arvgcconverternode.h>
 #include <arvgcintconverternode.h>
 #include <arvgcport.h>
+#include <arvgcregisternodeprivate.h>
+#include <arvgcfeaturenodeprivate.h>
+#include <arvgcswissknife.h>
+#include <arvgvdevice.h>
 #include <arvbuffer.h>
+#include <arvmiscprivate.h>
 #include <arvdebugprivate.h>
-#include <arvdomparser.h>
+#include <arvdomparserprivate.h>
 #include <string.h>
+#include <errno.h>
 #include <stdarg.h>
 #include <stdio.h>
 
@@ -76,8 +82,27 @@ typedef struct {
 	ArvAccessCheckPolicy access_check_policy;
 
         unsigned n_register_cache_errors;
+
+	guint transaction_depth;
+	guint validation_depth;
+	GArray *pending_writes;		/* ArvGcPendingWrite */
+
+	guint link_generation;		/* Incremented on each node registration, never 0 */
+
+	guint64 value_serial;		/* Incremented on each feature node change count increment */
+	guint64 cache_serial;		/* Incremented on events invalidating all the cached values */
+
+	GHashTable *dependents;		/* ArvGcFeatureNode -> GPtrArray of the directly affected ArvGcFeatureNode */
+	guint dependents_link_generation;
 } ArvGcPrivate;
 
+typedef struct {
+	guint64 address;
+	guint64 length;
+	guint8 *data;
+	gboolean use_registers;
+} ArvGcPendingWrite;
+
 struct _ArvGc {
 	ArvDomDocument base;
 
@@ -339,10 +364,215 @@ arv_gc_register_feature_node (ArvGc *genicam, ArvGcFeatureNode *node)
 	g_hash_table_remove (genicam->priv->nodes, (char *) name);
 	g_hash_table_insert (genicam->priv->nodes, (char *) name, node);
 
+	genicam->priv->link_generation++;
+	if (genicam->priv->link_generation == 0)
+		genicam->priv->link_generation = 1;
+	genicam->priv->cache_serial++;
+
 	arv_debug_genicam ("[Gc::register_feature_node] Register node '%s' [%s]", name,
 			 arv_dom_node_get_node_name (ARV_DOM_NODE (node)));
 }
 
+/* Property nodes keep their resolved links as long as the link generation is unchanged */
+
+guint
+arv_gc_get_link_generation (ArvGc *genicam)
+{
+	g_return_val_if_fail (ARV_IS_GC (genicam), 0);
+
+	return genicam->priv->link_generation;
+}
+
+/* Dependency index */
+
+static void
+_add_dependent (GHashTable *dependents, ArvGcFeatureNode *node, ArvGcFeatureNode *dependent)
+{
+	GPtrArray *array;
+
+	if (node == dependent)
+		return;
+
+	array = g_hash_table_lookup (dependents, node);
+	if (array == NULL) {
+		array = g_ptr_array_new ();
+		g_hash_table_insert (dependents, node, array);
+	}
+
+	g_ptr_array_add (array, dependent);
+}
+
+static void
+_update_dependency_index (ArvGc *genicam)
+{
+	ArvGcPrivate *priv = genicam->priv;
+	GHashTableIter iter;
+	gpointer node;
+
+	if (priv->dependents != NULL && priv->dependents_link_generation == priv->link_generation)
+		return;
+
+	if (priv->dependents == NULL)
+		priv->dependents = g_hash_table_new_full (g_direct_hash, g_direct_equal,
+							  NULL, (GDestroyNotify) g_ptr_array_unref);
+	else
+		g_hash_table_remove_all (priv->dependents);
+
+	g_hash_table_iter_init (&iter, priv->nodes);
+	while (g_hash_table_iter_next (&iter, NULL, &node)) {
+		ArvDomNode *parent = arv_dom_node_get_parent_node (node);
+		ArvDomNode *child;
+
+		/* Feature nodes nested in another feature node. A struct entry write goes through its register, which
+		 * is enough to reach the other entries. */
+		if ((ARV_IS_GC_ENUM_ENTRY (node) && ARV_IS_GC_ENUMERATION (parent)) ||
+		    (ARV_IS_GC_SWISS_KNIFE (node) && ARV_IS_GC_REGISTER_NODE (parent)))
+			_add_dependent (priv->dependents, node, ARV_GC_FEATURE_NODE (parent));
+		else if (ARV_IS_GC_STRUCT_ENTRY_NODE (node) && ARV_IS_GC_REGISTER_NODE (parent))
+			_add_dependent (priv->dependents, ARV_GC_FEATURE_NODE (parent), node);
+
+		for (child = arv_dom_node_get_first_child (node);
+		     child != NULL;
+		     child = arv_dom_node_get_next_sibling (child)) {
+			ArvGcNode *linked_node;
+
+			if (!ARV_IS_GC_PROPERTY_NODE (child))
+				continue;
+
+			linked_node = arv_gc_property_node_get_linked_node (ARV_GC_PROPERTY_NODE (child));
+			if (!ARV_IS_GC_FEATURE_NODE (linked_node))
+				continue;
+
+			switch (arv_gc_property_node_get_node_type (ARV_GC_PROPERTY_NODE (child))) {
+				case ARV_GC_PROPERTY_NODE_TYPE_P_SELECTED:
+					_add_dependent (priv->dependents, node, ARV_GC_FEATURE_NODE (linked_node));
+					break;
+				case ARV_GC_PROPERTY_NODE_TYPE_P_FEATURE:
+				case ARV_GC_PROPERTY_NODE_TYPE_P_ALIAS:
+				case ARV_GC_PROPERTY_NODE_TYPE_P_CAST_ALIAS:
+				case ARV_GC_PROPERTY_NODE_TYPE_P_PORT:
+					break;
+				default:
+					/* pValue, pInvalidator, pIsAvailable, pIsLocked, pVariable, pIndex... */
+					_add_dependent (priv->dependents, ARV_GC_FEATURE_NODE (linked_node), node);
+					break;
+			}
+		}
+	}
+
+	priv->dependents_link_generation = priv->link_generation;
+
+	arv_debug_genicam ("[Gc::update_dependency_index] %u node(s) with dependents",
+			   g_hash_table_size (priv->dependents));
+}
+
+static GSList *
+_get_affected_features (ArvGc *genicam, ArvGcFeatureNode *node)
+{
+	GHashTable *visited;
+	GQueue queue = G_QUEUE_INIT;
+	GSList *affected = NULL;
+
+	_update_dependency_index (genicam);
+
+	if (!g_hash_table_contains (genicam->priv->dependents, node))
+		return NULL;
+
+	visited = g_hash_table_new (g_direct_hash, g_direct_equal);
+	g_hash_table_add (visited, node);
+	g_queue_push_tail (&queue, node);
+
+	while (!g_queue_is_empty (&queue)) {
+		GPtrArray *dependents;
+		unsigned int i;
+
+		dependents = g_hash_table_lookup (genicam->priv->dependents, g_queue_pop_head (&queue));
+		if (dependents == NULL)
+			continue;
+
+		for (i = 0; i < dependents->len; i++) {
+			ArvGcFeatureNode *dependent = g_ptr_array_index (dependents, i);
+
+			if (g_hash_table_contains (visited, dependent))
+				continue;
+
+			g_hash_table_add (visited, dependent);
+			g_queue_push_tail (&queue, dependent);
+			affected = g_slist_prepend (affected, dependent);
+		}
+	}
+
+	g_hash_table_unref (visited);
+
+	return g_slist_reverse (affected);
+}
+
+/**
+ * arv_gc_get_affected_features:
+ * @genicam: a #ArvGc object
+ * @node: a #ArvGcFeatureNode
+ *
+ * Lists the features which may change when @node is written. They are the features depending on @node, directly
+ * or not, through a pValue, pMin, pMax, pIndex, pInvalidator, pIsAvailable, pIsLocked or pVariable property, and
+ * the features selected by @node. This allows to only refresh the affected features after a write.
+ *
+ * Returns: (transfer container) (element-type ArvGcFeatureNode): the list of the affected features, ordered by
+ * distance to @node, not including @node.
+ *
+ * Since: 0.10.0
+ */
+
+GSList *
+arv_gc_get_affected_features (ArvGc *genicam, ArvGcFeatureNode *node)
+{
+	g_return_val_if_fail (ARV_IS_GC (genicam), NULL);
+	g_return_val_if_fail (ARV_IS_GC_FEATURE_NODE (node), NULL);
+
+	return _get_affected_features (genicam, node);
+}
+
+/* Called on each feature node change count increment. The register caches and the cached computed values of the
+ * affected nodes are invalidated right away, instead of being checked on each read. */
+
+void
+arv_gc_notify_feature_change (ArvGc *genicam, ArvGcFeatureNode *node)
+{
+	GSList *affected;
+	GSList *iter;
+
+	g_return_if_fail (ARV_IS_GC (genicam));
+
+	genicam->priv->value_serial++;
+
+	affected = _get_affected_features (genicam, node);
+	for (iter = affected; iter != NULL; iter = iter->next) {
+		if (ARV_IS_GC_REGISTER_NODE (iter->data))
+			arv_gc_register_node_invalidate_cache (iter->data);
+		arv_gc_feature_node_invalidate_cached_values (iter->data);
+	}
+	g_slist_free (affected);
+}
+
+/* Feature nodes caching computed values compare these serials with the ones they stored along the values. The
+ * value serial changes on any feature write, the cache serial on any event not reflected by the change count of a
+ * feature, like a global register cache invalidation or a policy change. */
+
+guint64
+arv_gc_get_value_serial (ArvGc *genicam)
+{
+	g_return_val_if_fail (ARV_IS_GC (genicam), 0);
+
+	return genicam->priv->value_serial;
+}
+
+guint64
+arv_gc_get_cache_serial (ArvGc *genicam)
+{
+	g_return_val_if_fail (ARV_IS_GC (genicam), 0);
+
+	return genicam->priv->cache_serial;
+}
+
 void
 arv_gc_set_default_node_data (ArvGc *genicam, const char *node_name, ...)
 {
@@ -372,6 +602,7 @@ arv_gc_set_register_cache_policy (ArvGc *genicam, ArvRegisterCachePolicy policy)
 	g_return_if_fail (ARV_IS_GC (genicam));
 
 	genicam->priv->cache_policy = policy;
+	genicam->priv->cache_serial++;
 }
 
 ArvRegisterCachePolicy
@@ -404,6 +635,7 @@ arv_gc_set_access_check_policy (ArvGc *genicam, ArvAccessCheckPolicy policy)
 	g_return_if_fail (ARV_IS_GC (genicam));
 
 	genicam->priv->access_check_policy = policy;
+	genicam->priv->cache_serial++;
 }
 
 ArvAccessCheckPolicy
@@ -434,6 +666,7 @@ arv_gc_set_buffer (ArvGc *genicam, ArvBuffer *buffer)
 	g_object_weak_ref (G_OBJECT (buffer), _weak_notify_cb, genicam);
 
 	genicam->priv->buffer = buffer;
+	genicam->priv->cache_serial++;
 }
 
 /**
@@ -463,13 +696,388 @@ arv_gc_register_cache_error_add (ArvGc *genicam, guint64 n_errors)
         return genicam->priv->n_register_cache_errors;
 }
 
+/* Transactions */
+
+static void
+_pending_write_clear (ArvGcPendingWrite *pending_write)
+{
+	g_clear_pointer (&pending_write->data, g_free);
+}
+
+static void
+_invalidate_register_caches (ArvGc *genicam)
+{
+	GHashTableIter iter;
+	gpointer node;
+
+	g_hash_table_iter_init (&iter, genicam->priv->nodes);
+	while (g_hash_table_iter_next (&iter, NULL, &node))
+		if (ARV_IS_GC_REGISTER_NODE (node))
+			arv_gc_register_node_invalidate_cache (node);
+
+	genicam->priv->cache_serial++;
+}
+
+static gboolean
+_write_registers (ArvDevice *device, GArray *addresses, GArray *values, GError **error)
+{
+	gboolean success;
+
+	if (addresses->len == 0)
+		return TRUE;
+
+	success = arv_device_write_registers (device, addresses->len,
+					      (guint64 *) addresses->data, (guint32 *) values->data, error);
+
+	g_array_set_size (addresses, 0);
+	g_array_set_size (values, 0);
+
+	return success;
+}
+
+/*
+ * Pending writes are sent in their original order. The writes ArvGcPort would have sent as register writes, that is
+ * the 32 bit registers of the GigE Vision devices using the legacy endianness mechanism, are carried by a handful of
+ * commands. Their values are big endian, as for the schema versions older than 1.1.0. The other writes are sent as
+ * memory writes, which keeps the register endianness declared by the Genicam description.
+ */
+
+static gboolean
+_flush_pending_writes (ArvGc *genicam, GError **error)
+{
+	ArvGcPrivate *priv = genicam->priv;
+	GArray *addresses;
+	GArray *values;
+	gboolean success = TRUE;
+	guint i, j;
+
+	if (priv->pending_writes->len == 0)
+		return TRUE;
+
+	if (!ARV_IS_DEVICE (priv->device)) {
+		g_set_error (error, ARV_GC_ERROR, ARV_GC_ERROR_NO_DEVICE_SET, "No device set");
+		g_array_set_size (priv->pending_writes, 0);
+		return FALSE;
+	}
+
+	arv_debug_genicam ("[Gc::flush_pending_writes] %u pending write(s)", priv->pending_writes->len);
+
+	addresses = g_array_new (FALSE, FALSE, sizeof (guint64));
+	values = g_array_new (FALSE, FALSE, sizeof (guint32));
+
+	for (i = 0; i < priv->pending_writes->len && success; i++) {
+		ArvGcPendingWrite *pending_write = &g_array_index (priv->pending_writes, ArvGcPendingWrite, i);
+
+		if (pending_write->use_registers &&
+		    pending_write->address % 4 == 0 &&
+		    pending_write->length % 4 == 0) {
+			for (j = 0; j < pending_write->length; j += 4) {
+				guint64 address = pending_write->address + j;
+				guint32 value;
+
+				memcpy (&value, pending_write->data + j, sizeof (value));
+				value = GUINT32_FROM_BE (value);
+
+				g_array_append_val (addresses, address);
+				g_array_append_val (values, value);
+			}
+		} else {
+			success = _write_registers (priv->device, addresses, values, error) &&
+				arv_device_write_memory (priv->device, pending_write->address, pending_write->length,
+							 pending_write->data, error);
+		}
+	}
+
+	success = success && _write_registers (priv->device, addresses, values, error);
+
+	g_array_unref (addresses);
+	g_array_unref (values);
+
+	g_array_set_size (priv->pending_writes, 0);
+
+	/* The caches may hold values that never reached the device */
+	if (!success)
+		_invalidate_register_caches (genicam);
+
+	return success;
+}
+
+/**
+ * arv_gc_begin_transaction:
+ * @genicam: a #ArvGc object
+ *
+ * Starts a transaction. Until the matching arv_gc_commit_transaction() call, the register writes resulting from
+ * feature value changes are queued instead of being sent to the device. Consecutive writes to the same or to
+ * adjacent addresses, like the bitfields of a register shared by several MaskedIntReg nodes, are merged. At commit
+ * time, the queued writes are sent in their original order, using the batched register access of the device for
+ * the registers accessed by register writes outside of a transaction.
+ *
+ * Reads of addresses fully covered by a queued write are served from the queue. Any other read first flushes the
+ * queued writes, so the values depending on device side state, like selected registers, are always correct. The
+ * exception is the validation of a new feature value, access mode and range limits, which reads the device without
+ * sending the queued writes. The limits the device derives from a queued write are then the ones in effect before
+ * the transaction.
+ *
+ * Transactions can be nested, only the outermost commit sends the queued writes.
+ *
+ * Since: 0.10.0
+ */
+
+void
+arv_gc_begin_transaction (ArvGc *genicam)
+{
+	g_return_if_fail (ARV_IS_GC (genicam));
+
+	genicam->priv->transaction_depth++;
+}
+
+/**
+ * arv_gc_commit_transaction:
+ * @genicam: a #ArvGc object
+ * @error: a #GError placeholder
+ *
+ * Ends a transaction started by arv_gc_begin_transaction(), and sends the queued writes to the device if this is
+ * the outermost one. On error, the remaining queued writes are dropped, and the register caches are invalidated.
+ *
+ * Returns: %TRUE on success.
+ *
+ * Since: 0.10.0
+ */
+
+gboolean
+arv_gc_commit_transaction (ArvGc *genicam, GError **error)
+{
+	g_return_val_if_fail (ARV_IS_GC (genicam), FALSE);
+	g_return_val_if_fail (genicam->priv->transaction_depth > 0, FALSE);
+
+	genicam->priv->transaction_depth--;
+
+	if (genicam->priv->transaction_depth > 0)
+		return TRUE;
+
+	return _flush_pending_writes (genicam, error);
+}
+
+gboolean
+arv_gc_transaction_write (ArvGc *genicam, guint64 address, guint64 length, const void *buffer,
+			  gboolean use_registers)
+{
+	ArvGcPrivate *priv;
+	ArvGcPendingWrite pending_write;
+
+	g_return_val_if_fail (ARV_IS_GC (genicam), FALSE);
+
+	priv = genicam->priv;
+
+	if (priv->transaction_depth == 0 || length == 0)
+		return FALSE;
+
+	if (priv->pending_writes->len > 0) {
+		ArvGcPendingWrite *last;
+
+		last = &g_array_index (priv->pending_writes, ArvGcPendingWrite, priv->pending_writes->len - 1);
+
+		/* Only merge with the last write, in order to keep the write order intact */
+		if (use_registers == last->use_registers &&
+		    address <= last->address + last->length && last->address <= address + length) {
+			guint64 start = MIN (address, last->address);
+			guint64 end = MAX (address + length, last->address + last->length);
+
+			if (start != last->address || end != last->address + last->length) {
+				guint8 *data = g_malloc (end - start);
+
+				memcpy (data + (last->address - start), last->data, last->length);
+				g_free (last->data);
+				last->data = data;
+				last->address = start;
+				last->length = end - start;
+			}
+
+			memcpy (last->data + (address - last->address), buffer, length);
+
+			return TRUE;
+		}
+	}
+
+	pending_write.address = address;
+	pending_write.length = length;
+	pending_write.data = arv_memdup (buffer, length);
+	pending_write.use_registers = use_registers;
+
+	g_array_append_val (priv->pending_writes, pending_write);
+
+	return TRUE;
+}
+
+gboolean
+arv_gc_transaction_read (ArvGc *genicam, guint64 address, guint64 length, void *buffer, GError **error)
+{
+	ArvGcPrivate *priv;
+	guint i;
+
+	g_return_val_if_fail (ARV_IS_GC (genicam), FALSE);
+
+	priv = genicam->priv;
+
+	if (priv->transaction_depth == 0 || priv->pending_writes->len == 0)
+		return FALSE;
+
+	/* The last overlapping write has the most recent data */
+	for (i = priv->pending_writes->len; i > 0; i--) {
+		ArvGcPendingWrite *pending_write = &g_array_index (priv->pending_writes, ArvGcPendingWrite, i - 1);
+
+		if (address < pending_write->address + pending_write->length &&
+		    pending_write->address < address + length) {
+			if (address >= pending_write->address &&
+			    address + length <= pending_write->address + pending_write->length) {
+				memcpy (buffer, pending_write->data + (address - pending_write->address), length);
+				return TRUE;
+			}
+			break;
+		}
+	}
+
+	/* Validation reads don't flush the queue, unless they partially overlap a queued write */
+	if (priv->validation_depth > 0 && i == 0)
+		return FALSE;
+
+	return !_flush_pending_writes (genicam, error);
+}
+
+/* Brackets the reads of the validation of a feature write, which don't flush the transaction queue */
+
+void
+arv_gc_begin_validation (ArvGc *genicam)
+{
+	g_return_if_fail (ARV_IS_GC (genicam));
+
+	genicam->priv->validation_depth++;
+}
+
+void
+arv_gc_end_validation (ArvGc *genicam)
+{
+	g_return_if_fail (ARV_IS_GC (genicam));
+	g_return_if_fail (genicam->priv->validation_depth > 0);
+
+	genicam->priv->validation_depth--;
+}
+
+static void
+_link_nodes (ArvDomNode *node, unsigned int *n_links, unsigned int *n_dangling_links)
+{
+	ArvDomNode *iter;
+
+	if (ARV_IS_GC_PROPERTY_NODE (node)) {
+		if (!arv_gc_property_node_link (ARV_GC_PROPERTY_NODE (node))) {
+			ArvDomNode *parent = arv_dom_node_get_parent_node (node);
+
+			arv_info_genicam ("[Gc::link_nodes] Dangling reference to '%s' in <%s> of '%s'",
+					  arv_gc_property_node_get_string (ARV_GC_PROPERTY_NODE (node), NULL),
+					  arv_dom_node_get_node_name (node),
+					  ARV_IS_GC_FEATURE_NODE (parent) ?
+					  arv_gc_feature_node_get_name (ARV_GC_FEATURE_NODE (parent)) : "");
+			(*n_dangling_links)++;
+		}
+		(*n_links)++;
+		return;
+	}
+
+	for (iter = arv_dom_node_get_first_child (node);
+	     iter != NULL;
+	     iter = arv_dom_node_get_next_sibling (iter))
+		_link_nodes (iter, n_links, n_dangling_links);
+}
+
+/* Genicam descriptions can be cached on disk in their recorded form, keyed by the SHA-1 of the xml data. Loading a
+ * recording bypasses the xml parser, but the nodes are still created one by one. The cache is only enabled when the
+ * ARV_GENICAM_CACHE environment variable is set to 1. Small descriptions, as the ones used in tests, are not worth a
+ * cache file. */
+
+#define ARV_GC_MODEL_CACHE_MIN_SIZE	65536
+
+static char *
+_get_model_cache_path (const void *xml, size_t size)
+{
+	char *checksum;
+	char *filename;
+	char *path;
+
+	if (xml == NULL || size < ARV_GC_MODEL_CACHE_MIN_SIZE ||
+	    g_strcmp0 (g_getenv ("ARV_GENICAM_CACHE"), "1") != 0)
+		return NULL;
+
+	checksum = g_compute_checksum_for_data (G_CHECKSUM_SHA1, xml, size);
+	filename = g_strdup_printf ("%s.arvdom", checksum);
+	path = g_build_filename (g_get_user_cache_dir (), "aravis", "genicam", filename, NULL);
+
+	g_free (filename);
+	g_free (checksum);
+
+	return path;
+}
+
+static ArvDomDocument *
+_new_document (const void *xml, size_t size)
+{
+	ArvDomDocument *document;
+	GMappedFile *mapped_file;
+	GBytes *recording = NULL;
+	GError *error = NULL;
+	char *path;
+
+	path = _get_model_cache_path (xml, size);
+	if (path == NULL)
+		return arv_dom_document_new_from_memory (xml, size, NULL);
+
+	mapped_file = g_mapped_file_new (path, FALSE, NULL);
+	if (mapped_file != NULL) {
+		document = arv_dom_document_new_from_recording (g_mapped_file_get_contents (mapped_file),
+								g_mapped_file_get_length (mapped_file), &error);
+		g_mapped_file_unref (mapped_file);
+
+		if (document != NULL) {
+			arv_info_genicam ("[Gc::new] Description loaded from cache '%s'", path);
+			g_free (path);
+			return document;
+		}
+
+		arv_warning_genicam ("[Gc::new] Ignoring cache file '%s': %s", path, error->message);
+		g_clear_error (&error);
+	}
+
+	document = arv_dom_document_new_from_memory_recorded (xml, size, &recording, NULL);
+	if (recording != NULL) {
+		char *dirname = g_path_get_dirname (path);
+
+		if (g_mkdir_with_parents (dirname, 0700) == 0 &&
+		    g_file_set_contents (path, g_bytes_get_data (recording, NULL), g_bytes_get_size (recording),
+					 &error))
+			arv_info_genicam ("[Gc::new] Description saved to cache '%s'", path);
+		else {
+			arv_info_genicam ("[Gc::new] Failed to save description to cache '%s': %s", path,
+					  error != NULL ? error->message : g_strerror (errno));
+			g_clear_error (&error);
+		}
+
+		g_free (dirname);
+		g_bytes_unref (recording);
+	}
+
+	g_free (path);
+
+	return document;
+}
+
 ArvGc *
 arv_gc_new (ArvDevice *device, const void *xml, size_t size)
 {
 	ArvDomDocument *document;
 	ArvGc *genicam;
+	unsigned int n_links = 0;
+	unsigned int n_dangling_links = 0;
 
-	document = arv_dom_document_new_from_memory (xml, size, NULL);
+	document = _new_document (xml, size);
 	if (!ARV_IS_GC (document)) {
 		if (document != NULL)
 			g_object_unref (document);
@@ -479,6 +1087,13 @@ arv_gc_new (ArvDevice *device, const void *xml, size_t size)
 	genicam = ARV_GC (document);
 	genicam->priv->device = device;
 
+	_link_nodes (ARV_DOM_NODE (genicam), &n_links, &n_dangling_links);
+	if (n_dangling_links > 0)
+		arv_warning_genicam ("[Gc::new] %u dangling node reference(s) in %u properties",
+				     n_dangling_links, n_links);
+
+	_update_dependency_index (genicam);
+
 	return genicam;
 }
 
@@ -491,6 +1106,9 @@ arv_gc_init (ArvGc *genicam)
 
 	genicam->priv->nodes = g_hash_table_new_full (g_str_hash, g_str_equal, NULL, g_object_unref);
 	genicam->priv->cache_policy = ARV_REGISTER_CACHE_POLICY_DISABLE;
+	genicam->priv->link_generation = 1;
+	genicam->priv->pending_writes = g_array_new (FALSE, FALSE, sizeof (ArvGcPendingWrite));
+	g_array_set_clear_func (genicam->priv->pending_writes, (GDestroyNotify) _pending_write_clear);
 }
 
 static void
@@ -501,6 +1119,12 @@ arv_gc_finalize (GObject *object)
 	if (genicam->priv->buffer != NULL)
 		g_object_weak_unref (G_OBJECT (genicam->priv->buffer), _weak_notify_cb, genicam);
 
+	if (genicam->priv->pending_writes->len > 0)
+		arv_warning_genicam ("[Gc::finalize] %u pending write(s) dropped, transaction not committed",
+				     genicam->priv->pending_writes->len);
+	g_array_unref (genicam->priv->pending_writes);
+
+	g_clear_pointer (&genicam->priv->dependents, g_hash_table_unref);
 	g_hash_table_unref (genicam->priv->nodes);
 
 	G_OBJECT_CLASS (arv_gc_parent_class)->finalize (object);
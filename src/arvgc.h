@@ -122,6 +122,11 @@ ARV_API ArvDevice *			arv_gc_get_device			(ArvGc *genicam);
 ARV_API void				arv_gc_set_buffer			(ArvGc *genicam, ArvBuffer *buffer);
 ARV_API ArvBuffer *			arv_gc_get_buffer			(ArvGc *genicam);
 
+ARV_API void				arv_gc_begin_transaction		(ArvGc *genicam);
+ARV_API gboolean			arv_gc_commit_transaction		(ArvGc *genicam, GError **error);
+
+ARV_API GSList *			arv_gc_get_affected_features		(ArvGc *genicam, ArvGcFeatureNode *node);
+
 G_END_DECLS
 
 #endif
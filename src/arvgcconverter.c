@@ -27,7 +27,7 @@
 
 #include <arvgcfeaturenodeprivate.h>
 #include <arvgcconverterprivate.h>
-#include <arvevaluator.h>
+#include <arvevaluatorprivate.h>
 #include <arvgcinteger.h>
 #include <arvgcfloat.h>
 #include <arvgcdefaultsprivate.h>
@@ -52,6 +52,12 @@ typedef struct {
 
 	ArvEvaluator *formula_to;
 	ArvEvaluator *formula_from;
+
+	/* Evaluator slots of the variables, in list order */
+	GArray *formula_to_slots;
+	GArray *formula_from_slots;
+	guint from_slot;
+	guint to_slot;
 } ArvGcConverterPrivate;
 
 G_DEFINE_ABSTRACT_TYPE_WITH_CODE (ArvGcConverter, arv_gc_converter, ARV_TYPE_GC_FEATURE_NODE,
@@ -70,6 +76,8 @@ arv_gc_converter_post_new_child (ArvDomNode *self, ArvDomNode *child)
 		switch (arv_gc_property_node_get_node_type (property_node)) {
 			case ARV_GC_PROPERTY_NODE_TYPE_P_VARIABLE:
 				priv->variables = g_slist_prepend (priv->variables, property_node);
+				g_clear_pointer (&priv->formula_to_slots, g_array_unref);
+				g_clear_pointer (&priv->formula_from_slots, g_array_unref);
 				break;
 			case ARV_GC_PROPERTY_NODE_TYPE_P_VALUE:
 				priv->value = property_node;
@@ -126,6 +134,8 @@ arv_gc_converter_init (ArvGcConverter *self)
 
 	priv->formula_to = arv_evaluator_new (NULL);
 	priv->formula_from = arv_evaluator_new (NULL);
+	priv->from_slot = arv_evaluator_get_variable_slot (priv->formula_to, "FROM");
+	priv->to_slot = arv_evaluator_get_variable_slot (priv->formula_from, "TO");
 	priv->value = NULL;
 }
 
@@ -153,6 +163,8 @@ arv_gc_converter_finalize (GObject *object)
 	g_slist_free (priv->variables);
 	g_slist_free (priv->expressions);
 	g_slist_free (priv->constants);
+	g_clear_pointer (&priv->formula_to_slots, g_array_unref);
+	g_clear_pointer (&priv->formula_from_slots, g_array_unref);
 
 	g_object_unref (priv->formula_to);
 	g_object_unref (priv->formula_from);
@@ -199,6 +211,21 @@ arv_gc_converter_get_is_linear (ArvGcConverter *gc_converter, GError **error)
 	return ARV_GC_IS_LINEAR_NO;
 }
 
+static GArray *
+_get_variable_slots (ArvEvaluator *evaluator, GSList *variables)
+{
+	GArray *slots;
+	GSList *iter;
+
+	slots = g_array_new (FALSE, FALSE, sizeof (guint));
+	for (iter = variables; iter != NULL; iter = iter->next) {
+		guint slot = arv_evaluator_get_variable_slot (evaluator, arv_gc_property_node_get_name (iter->data));
+		g_array_append_val (slots, slot);
+	}
+
+	return slots;
+}
+
 static gboolean
 arv_gc_converter_update_from_variables (ArvGcConverter *gc_converter, ArvGcConverterNodeType node_type, GError **error)
 {
@@ -207,6 +234,7 @@ arv_gc_converter_update_from_variables (ArvGcConverter *gc_converter, ArvGcConve
 	GError *local_error = NULL;
 	GSList *iter;
 	const char *expression;
+	guint i;
 
 	if (priv->formula_from_node != NULL)
 		expression = arv_gc_property_node_get_string (priv->formula_from_node, &local_error);
@@ -250,7 +278,10 @@ arv_gc_converter_update_from_variables (ArvGcConverter *gc_converter, ArvGcConve
 		arv_evaluator_set_constant (priv->formula_from, name, constant);
 	}
 
-	for (iter = priv->variables; iter != NULL; iter = iter->next) {
+	if (priv->formula_from_slots == NULL)
+		priv->formula_from_slots = _get_variable_slots (priv->formula_from, priv->variables);
+
+	for (iter = priv->variables, i = 0; iter != NULL; iter = iter->next, i++) {
 		ArvGcPropertyNode *variable_node = iter->data;
 
 		node = arv_gc_property_node_get_linked_node (ARV_GC_PROPERTY_NODE (variable_node));
@@ -264,9 +295,9 @@ arv_gc_converter_update_from_variables (ArvGcConverter *gc_converter, ArvGcConve
                                 return FALSE;
                         }
 
-			arv_evaluator_set_int64_variable (priv->formula_from,
-							  arv_gc_property_node_get_name (variable_node),
-							  value);
+			arv_evaluator_set_int64_variable_by_slot (priv->formula_from,
+								  g_array_index (priv->formula_from_slots, guint, i),
+								  value);
 		} else if (ARV_IS_GC_FLOAT (node)) {
 			double value;
 
@@ -277,9 +308,9 @@ arv_gc_converter_update_from_variables (ArvGcConverter *gc_converter, ArvGcConve
 				return FALSE;
 			}
 
-			arv_evaluator_set_double_variable (priv->formula_from,
-							  arv_gc_property_node_get_name (variable_node),
-							  value);
+			arv_evaluator_set_double_variable_by_slot (priv->formula_from,
+								   g_array_index (priv->formula_from_slots, guint, i),
+								   value);
 		}
 	}
 
@@ -315,7 +346,7 @@ arv_gc_converter_update_from_variables (ArvGcConverter *gc_converter, ArvGcConve
 				return FALSE;
 			}
 
-			arv_evaluator_set_int64_variable (priv->formula_from, "TO", value);
+			arv_evaluator_set_int64_variable_by_slot (priv->formula_from, priv->to_slot, value);
 		} else if (ARV_IS_GC_FLOAT (node)) {
 			double value;
 
@@ -348,7 +379,7 @@ arv_gc_converter_update_from_variables (ArvGcConverter *gc_converter, ArvGcConve
                                 return FALSE;
                         }
 
-			arv_evaluator_set_double_variable (priv->formula_from, "TO", value);
+			arv_evaluator_set_double_variable_by_slot (priv->formula_from, priv->to_slot, value);
 		} else {
 			arv_warning_genicam ("[GcConverter::set_value] Invalid pValue node '%s'",
 					     arv_gc_property_node_get_string (priv->value, NULL));
@@ -366,6 +397,21 @@ arv_gc_converter_update_from_variables (ArvGcConverter *gc_converter, ArvGcConve
 	return TRUE;
 }
 
+static ArvGcFeatureNodeCachedValue
+_get_cached_value (ArvGcConverterNodeType node_type)
+{
+	switch (node_type) {
+		case ARV_GC_CONVERTER_NODE_TYPE_MIN:
+			return ARV_GC_FEATURE_NODE_CACHED_MIN;
+		case ARV_GC_CONVERTER_NODE_TYPE_MAX:
+			return ARV_GC_FEATURE_NODE_CACHED_MAX;
+		case ARV_GC_CONVERTER_NODE_TYPE_INC:
+			return ARV_GC_FEATURE_NODE_CACHED_INC;
+		default:
+			return ARV_GC_FEATURE_NODE_CACHED_VALUE;
+	}
+}
+
 double
 arv_gc_converter_convert_to_double (ArvGcConverter *gc_converter, ArvGcConverterNodeType node_type, GError **error)
 {
@@ -375,6 +421,9 @@ arv_gc_converter_convert_to_double (ArvGcConverter *gc_converter, ArvGcConverter
 
 	g_return_val_if_fail (ARV_IS_GC_CONVERTER (gc_converter), 0.0);
 
+	if (arv_gc_feature_node_get_cached_double (ARV_GC_FEATURE_NODE (gc_converter), _get_cached_value (node_type), &value))
+		return value;
+
 	if (!arv_gc_converter_update_from_variables (gc_converter, node_type, &local_error)) {
 		if (local_error != NULL)
                         g_propagate_prefixed_error (error, local_error, "[%s] ",
@@ -395,6 +444,8 @@ arv_gc_converter_convert_to_double (ArvGcConverter *gc_converter, ArvGcConverter
         if (local_error != NULL)
                 g_propagate_prefixed_error (error, local_error, "[%s] ",
                                             arv_gc_feature_node_get_name (ARV_GC_FEATURE_NODE (gc_converter)));
+	else
+		arv_gc_feature_node_set_cached_double (ARV_GC_FEATURE_NODE (gc_converter), _get_cached_value (node_type), value);
 
         return value;
 }
@@ -408,6 +459,9 @@ arv_gc_converter_convert_to_int64 (ArvGcConverter *gc_converter, ArvGcConverterN
 
 	g_return_val_if_fail (ARV_IS_GC_CONVERTER (gc_converter), 0);
 
+	if (arv_gc_feature_node_get_cached_int64 (ARV_GC_FEATURE_NODE (gc_converter), _get_cached_value (node_type), &value))
+		return value;
+
 	if (!arv_gc_converter_update_from_variables (gc_converter, node_type, &local_error)) {
 		if (local_error != NULL)
                         g_propagate_prefixed_error (error, local_error, "[%s] ",
@@ -428,6 +482,8 @@ arv_gc_converter_convert_to_int64 (ArvGcConverter *gc_converter, ArvGcConverterN
         if (local_error != NULL)
                 g_propagate_prefixed_error (error, local_error, "[%s] ",
                                             arv_gc_feature_node_get_name (ARV_GC_FEATURE_NODE (gc_converter)));
+	else
+		arv_gc_feature_node_set_cached_int64 (ARV_GC_FEATURE_NODE (gc_converter), _get_cached_value (node_type), value);
 
         return value;
 }
@@ -440,6 +496,7 @@ arv_gc_converter_update_to_variables (ArvGcConverter *gc_converter, GError **err
 	GError *local_error = NULL;
 	GSList *iter;
 	const char *expression;
+	guint i;
 
 	if (priv->formula_to_node != NULL)
 		expression = arv_gc_property_node_get_string (priv->formula_to_node, &local_error);
@@ -483,7 +540,10 @@ arv_gc_converter_update_to_variables (ArvGcConverter *gc_converter, GError **err
 		arv_evaluator_set_constant (priv->formula_to, name, constant);
 	}
 
-	for (iter = priv->variables; iter != NULL; iter = iter->next) {
+	if (priv->formula_to_slots == NULL)
+		priv->formula_to_slots = _get_variable_slots (priv->formula_to, priv->variables);
+
+	for (iter = priv->variables, i = 0; iter != NULL; iter = iter->next, i++) {
 		ArvGcPropertyNode *variable_node = iter->data;
 
 		node = arv_gc_property_node_get_linked_node (ARV_GC_PROPERTY_NODE (variable_node));
@@ -497,9 +557,9 @@ arv_gc_converter_update_to_variables (ArvGcConverter *gc_converter, GError **err
 				return;
 			}
 
-			arv_evaluator_set_int64_variable (priv->formula_to,
-							  arv_gc_property_node_get_name (variable_node),
-							  value);
+			arv_evaluator_set_int64_variable_by_slot (priv->formula_to,
+								  g_array_index (priv->formula_to_slots, guint, i),
+								  value);
 		} else if (ARV_IS_GC_FLOAT (node)) {
 			double value;
 
@@ -510,9 +570,9 @@ arv_gc_converter_update_to_variables (ArvGcConverter *gc_converter, GError **err
 				return;
 			}
 
-			arv_evaluator_set_double_variable (priv->formula_to,
-							   arv_gc_property_node_get_name (variable_node),
-							   value);
+			arv_evaluator_set_double_variable_by_slot (priv->formula_to,
+								   g_array_index (priv->formula_to_slots, guint, i),
+								   value);
 		}
 	}
 
@@ -552,7 +612,7 @@ arv_gc_converter_convert_from_double (ArvGcConverter *gc_converter, double value
 	g_return_if_fail (ARV_IS_GC_CONVERTER (gc_converter));
 
 	arv_gc_feature_node_increment_change_count (ARV_GC_FEATURE_NODE (gc_converter));
-	arv_evaluator_set_double_variable (priv->formula_to, "FROM", value);
+	arv_evaluator_set_double_variable_by_slot (priv->formula_to, priv->from_slot, value);
 	arv_gc_converter_update_to_variables (gc_converter, &local_error);
 
         if (local_error != NULL)
@@ -569,7 +629,7 @@ arv_gc_converter_convert_from_int64 (ArvGcConverter *gc_converter, gint64 value,
 	g_return_if_fail (ARV_IS_GC_CONVERTER (gc_converter));
 
 	arv_gc_feature_node_increment_change_count (ARV_GC_FEATURE_NODE (gc_converter));
-	arv_evaluator_set_int64_variable (priv->formula_to, "FROM", value);
+	arv_evaluator_set_int64_variable_by_slot (priv->formula_to, priv->from_slot, value);
 	arv_gc_converter_update_to_variables (gc_converter, &local_error);
 
         if (local_error != NULL)
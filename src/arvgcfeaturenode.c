@@ -30,7 +30,9 @@
 
 #include <arvgcfeaturenodeprivate.h>
 #include <arvgcpropertynode.h>
-#include <arvgc.h>
+#include <arvgcregisternodeprivate.h>
+#include <arvgcstructentrynode.h>
+#include <arvgcprivate.h>
 #include <arvgcboolean.h>
 #include <arvgcinteger.h>
 #include <arvgcfloat.h>
@@ -41,6 +43,24 @@
 #include <arvdebugprivate.h>
 #include <string.h>
 
+/* Computed values, valid as long as the change counts of the feature node transitive inputs are unchanged */
+
+typedef struct {
+	guint link_generation;
+	GPtrArray *dependencies;	/* ArvGcFeatureNode, including the feature node itself */
+	GArray *change_counts;		/* guint64, dependency change counts when the values were computed */
+	gboolean is_volatile;		/* Depends on a value that can change without a write */
+	gboolean has_register;		/* Only valid if the register cache is enabled */
+
+	guint64 value_serial;
+	guint64 cache_serial;
+
+	guint int64_mask;
+	guint double_mask;
+	gint64 v_int64[ARV_GC_FEATURE_NODE_CACHED_N_ELEMENTS];
+	double v_double[ARV_GC_FEATURE_NODE_CACHED_N_ELEMENTS];
+} ArvGcValueCache;
+
 typedef struct {
 
 	char *name;
@@ -63,6 +83,8 @@ typedef struct {
 	guint64 change_count;
 
 	char *string_buffer;
+
+	ArvGcValueCache *value_cache;
 } ArvGcFeatureNodePrivate;
 
 G_DEFINE_ABSTRACT_TYPE_WITH_CODE (ArvGcFeatureNode, arv_gc_feature_node, ARV_TYPE_GC_NODE, G_ADD_PRIVATE (ArvGcFeatureNode))
@@ -568,10 +590,15 @@ void
 arv_gc_feature_node_increment_change_count (ArvGcFeatureNode *self)
 {
 	ArvGcFeatureNodePrivate *priv = arv_gc_feature_node_get_instance_private (self);
+	ArvGc *genicam;
 
 	g_return_if_fail (ARV_IS_GC_FEATURE_NODE (self));
 
 	priv->change_count++;
+
+	genicam = arv_gc_node_get_genicam (ARV_GC_NODE (self));
+	if (genicam != NULL)
+		arv_gc_notify_feature_change (genicam, self);
 }
 
 guint64
@@ -584,6 +611,248 @@ arv_gc_feature_node_get_change_count (ArvGcFeatureNode *self)
 	return priv->change_count;
 }
 
+static void
+_value_cache_free (ArvGcValueCache *cache)
+{
+	g_ptr_array_unref (cache->dependencies);
+	g_array_unref (cache->change_counts);
+	g_free (cache);
+}
+
+static void
+_value_cache_add_dependencies (ArvGcValueCache *cache, ArvGcFeatureNode *node, GHashTable *visited)
+{
+	ArvDomNode *iter;
+
+	g_hash_table_add (visited, node);
+	g_ptr_array_add (cache->dependencies, node);
+
+	if (ARV_IS_GC_REGISTER_NODE (node)) {
+		if (arv_gc_register_node_get_cachable (ARV_GC_REGISTER_NODE (node)) == ARV_GC_CACHABLE_NO_CACHE)
+			cache->is_volatile = TRUE;
+		else
+			cache->has_register = TRUE;
+	} else if (ARV_IS_GC_STRUCT_ENTRY_NODE (node))
+		cache->is_volatile = TRUE;
+
+	for (iter = arv_dom_node_get_first_child (ARV_DOM_NODE (node));
+	     iter != NULL;
+	     iter = arv_dom_node_get_next_sibling (iter)) {
+		ArvGcNode *linked_node;
+
+		if (!ARV_IS_GC_PROPERTY_NODE (iter))
+			continue;
+
+		/* Selected features, aliases and category features are not inputs */
+		switch (arv_gc_property_node_get_node_type (ARV_GC_PROPERTY_NODE (iter))) {
+			case ARV_GC_PROPERTY_NODE_TYPE_P_SELECTED:
+			case ARV_GC_PROPERTY_NODE_TYPE_P_FEATURE:
+			case ARV_GC_PROPERTY_NODE_TYPE_P_ALIAS:
+			case ARV_GC_PROPERTY_NODE_TYPE_P_CAST_ALIAS:
+				continue;
+			default:
+				break;
+		}
+
+		linked_node = arv_gc_property_node_get_linked_node (ARV_GC_PROPERTY_NODE (iter));
+		if (ARV_IS_GC_FEATURE_NODE (linked_node) &&
+		    !g_hash_table_contains (visited, linked_node))
+			_value_cache_add_dependencies (cache, ARV_GC_FEATURE_NODE (linked_node), visited);
+	}
+}
+
+static void
+_value_cache_save_change_counts (ArvGcValueCache *cache, ArvGc *genicam)
+{
+	unsigned int i;
+
+	for (i = 0; i < cache->dependencies->len; i++)
+		g_array_index (cache->change_counts, guint64, i) =
+			arv_gc_feature_node_get_change_count (g_ptr_array_index (cache->dependencies, i));
+
+	cache->value_serial = arv_gc_get_value_serial (genicam);
+	cache->cache_serial = arv_gc_get_cache_serial (genicam);
+	cache->int64_mask = 0;
+	cache->double_mask = 0;
+}
+
+/* Returns the value cache of the feature node, with its value masks cleared if any of its inputs has changed, or
+ * NULL if its values can not be cached. */
+
+static ArvGcValueCache *
+_get_value_cache (ArvGcFeatureNode *self)
+{
+	ArvGcFeatureNodePrivate *priv = arv_gc_feature_node_get_instance_private (self);
+	ArvGcValueCache *cache = priv->value_cache;
+	ArvGc *genicam;
+	guint64 value_serial;
+	unsigned int i;
+
+	genicam = arv_gc_node_get_genicam (ARV_GC_NODE (self));
+	if (genicam == NULL)
+		return NULL;
+
+	if (cache == NULL || cache->link_generation != arv_gc_get_link_generation (genicam)) {
+		GHashTable *visited;
+
+		if (cache == NULL) {
+			cache = g_new0 (ArvGcValueCache, 1);
+			priv->value_cache = cache;
+		} else {
+			g_ptr_array_unref (cache->dependencies);
+			g_array_unref (cache->change_counts);
+		}
+
+		cache->dependencies = g_ptr_array_new ();
+		cache->is_volatile = FALSE;
+		cache->has_register = FALSE;
+
+		visited = g_hash_table_new (g_direct_hash, g_direct_equal);
+		_value_cache_add_dependencies (cache, self, visited);
+		g_hash_table_unref (visited);
+
+		cache->change_counts = g_array_sized_new (FALSE, TRUE, sizeof (guint64), cache->dependencies->len);
+		g_array_set_size (cache->change_counts, cache->dependencies->len);
+		cache->link_generation = arv_gc_get_link_generation (genicam);
+
+		_value_cache_save_change_counts (cache, genicam);
+
+		arv_debug_genicam ("[GcFeatureNode::get_value_cache] '%s' depends on %u node(s)%s",
+				   priv->name, cache->dependencies->len, cache->is_volatile ? ", volatile" : "");
+	}
+
+	if (cache->is_volatile ||
+	    (cache->has_register && arv_gc_get_register_cache_policy (genicam) != ARV_REGISTER_CACHE_POLICY_ENABLE))
+		return NULL;
+
+	value_serial = arv_gc_get_value_serial (genicam);
+	if (cache->value_serial == value_serial &&
+	    cache->cache_serial == arv_gc_get_cache_serial (genicam))
+		return cache;
+
+	if (cache->cache_serial == arv_gc_get_cache_serial (genicam)) {
+		for (i = 0; i < cache->dependencies->len; i++)
+			if (g_array_index (cache->change_counts, guint64, i) !=
+			    arv_gc_feature_node_get_change_count (g_ptr_array_index (cache->dependencies, i)))
+				break;
+
+		if (i == cache->dependencies->len) {
+			/* Some features changed, but none of our inputs */
+			cache->value_serial = value_serial;
+			return cache;
+		}
+	}
+
+	_value_cache_save_change_counts (cache, genicam);
+
+	return cache;
+}
+
+gboolean
+arv_gc_feature_node_get_cached_int64 (ArvGcFeatureNode *self, ArvGcFeatureNodeCachedValue cached_value, gint64 *value)
+{
+	ArvGcValueCache *cache;
+
+	g_return_val_if_fail (ARV_IS_GC_FEATURE_NODE (self), FALSE);
+	g_return_val_if_fail (cached_value < ARV_GC_FEATURE_NODE_CACHED_N_ELEMENTS, FALSE);
+	g_return_val_if_fail (value != NULL, FALSE);
+
+	cache = _get_value_cache (self);
+	if (cache == NULL || (cache->int64_mask & (1 << cached_value)) == 0)
+		return FALSE;
+
+	*value = cache->v_int64[cached_value];
+
+	return TRUE;
+}
+
+gboolean
+arv_gc_feature_node_get_cached_double (ArvGcFeatureNode *self, ArvGcFeatureNodeCachedValue cached_value, double *value)
+{
+	ArvGcValueCache *cache;
+
+	g_return_val_if_fail (ARV_IS_GC_FEATURE_NODE (self), FALSE);
+	g_return_val_if_fail (cached_value < ARV_GC_FEATURE_NODE_CACHED_N_ELEMENTS, FALSE);
+	g_return_val_if_fail (value != NULL, FALSE);
+
+	cache = _get_value_cache (self);
+	if (cache == NULL || (cache->double_mask & (1 << cached_value)) == 0)
+		return FALSE;
+
+	*value = cache->v_double[cached_value];
+
+	return TRUE;
+}
+
+/* The value must have been computed right after a get_cached call, which has saved the input change counts */
+
+static ArvGcValueCache *
+_get_value_cache_for_update (ArvGcFeatureNode *self)
+{
+	ArvGcFeatureNodePrivate *priv = arv_gc_feature_node_get_instance_private (self);
+	ArvGcValueCache *cache = priv->value_cache;
+	ArvGc *genicam;
+
+	if (cache == NULL || cache->is_volatile)
+		return NULL;
+
+	genicam = arv_gc_node_get_genicam (ARV_GC_NODE (self));
+	if (genicam == NULL ||
+	    cache->link_generation != arv_gc_get_link_generation (genicam) ||
+	    cache->value_serial != arv_gc_get_value_serial (genicam) ||
+	    cache->cache_serial != arv_gc_get_cache_serial (genicam) ||
+	    (cache->has_register && arv_gc_get_register_cache_policy (genicam) != ARV_REGISTER_CACHE_POLICY_ENABLE))
+		return NULL;
+
+	return cache;
+}
+
+void
+arv_gc_feature_node_set_cached_int64 (ArvGcFeatureNode *self, ArvGcFeatureNodeCachedValue cached_value, gint64 value)
+{
+	ArvGcValueCache *cache;
+
+	g_return_if_fail (ARV_IS_GC_FEATURE_NODE (self));
+	g_return_if_fail (cached_value < ARV_GC_FEATURE_NODE_CACHED_N_ELEMENTS);
+
+	cache = _get_value_cache_for_update (self);
+	if (cache == NULL)
+		return;
+
+	cache->v_int64[cached_value] = value;
+	cache->int64_mask |= 1 << cached_value;
+}
+
+void
+arv_gc_feature_node_set_cached_double (ArvGcFeatureNode *self, ArvGcFeatureNodeCachedValue cached_value, double value)
+{
+	ArvGcValueCache *cache;
+
+	g_return_if_fail (ARV_IS_GC_FEATURE_NODE (self));
+	g_return_if_fail (cached_value < ARV_GC_FEATURE_NODE_CACHED_N_ELEMENTS);
+
+	cache = _get_value_cache_for_update (self);
+	if (cache == NULL)
+		return;
+
+	cache->v_double[cached_value] = value;
+	cache->double_mask |= 1 << cached_value;
+}
+
+void
+arv_gc_feature_node_invalidate_cached_values (ArvGcFeatureNode *self)
+{
+	ArvGcFeatureNodePrivate *priv = arv_gc_feature_node_get_instance_private (self);
+
+	g_return_if_fail (ARV_IS_GC_FEATURE_NODE (self));
+
+	if (priv->value_cache == NULL)
+		return;
+
+	priv->value_cache->int64_mask = 0;
+	priv->value_cache->double_mask = 0;
+}
+
 static void
 arv_gc_feature_node_init (ArvGcFeatureNode *self)
 {
@@ -600,6 +869,7 @@ arv_gc_feature_node_finalize (GObject *object)
 	g_clear_pointer (&priv->name, g_free);
         g_clear_pointer (&priv->comment, g_free);
 	g_clear_pointer (&priv->string_buffer, g_free);
+	g_clear_pointer (&priv->value_cache, _value_cache_free);
 
 	G_OBJECT_CLASS (arv_gc_feature_node_parent_class)->finalize (object);
 }
@@ -26,6 +26,7 @@
 
 #include <arvgcfeaturenode.h>
 #include <arvgc.h>
+#include <arvgcprivate.h>
 #include <arvgcenums.h>
 
 G_BEGIN_DECLS
@@ -33,11 +34,34 @@ G_BEGIN_DECLS
 void			arv_gc_feature_node_increment_change_count	(ArvGcFeatureNode *gc_feature_node);
 guint64 		arv_gc_feature_node_get_change_count 		(ArvGcFeatureNode *gc_feature_node);
 
+typedef enum {
+	ARV_GC_FEATURE_NODE_CACHED_VALUE,
+	ARV_GC_FEATURE_NODE_CACHED_MIN,
+	ARV_GC_FEATURE_NODE_CACHED_MAX,
+	ARV_GC_FEATURE_NODE_CACHED_INC,
+	ARV_GC_FEATURE_NODE_CACHED_N_ELEMENTS
+} ArvGcFeatureNodeCachedValue;
+
+gboolean		arv_gc_feature_node_get_cached_int64		(ArvGcFeatureNode *gc_feature_node,
+									 ArvGcFeatureNodeCachedValue cached_value,
+									 gint64 *value);
+void			arv_gc_feature_node_set_cached_int64		(ArvGcFeatureNode *gc_feature_node,
+									 ArvGcFeatureNodeCachedValue cached_value,
+									 gint64 value);
+gboolean		arv_gc_feature_node_get_cached_double		(ArvGcFeatureNode *gc_feature_node,
+									 ArvGcFeatureNodeCachedValue cached_value,
+									 double *value);
+void			arv_gc_feature_node_set_cached_double		(ArvGcFeatureNode *gc_feature_node,
+									 ArvGcFeatureNodeCachedValue cached_value,
+									 double value);
+void			arv_gc_feature_node_invalidate_cached_values	(ArvGcFeatureNode *gc_feature_node);
+
 static inline gboolean
 arv_gc_feature_node_check_write_access (ArvGcFeatureNode *gc_feature_node, GError **error)
 {
 	ArvGc *genicam;
         ArvAccessCheckPolicy policy;
+        ArvGcAccessMode access_mode;
 
         g_return_val_if_fail (ARV_IS_GC_FEATURE_NODE (gc_feature_node), FALSE);
 	genicam = arv_gc_node_get_genicam (ARV_GC_NODE (gc_feature_node));
@@ -47,7 +71,11 @@ arv_gc_feature_node_check_write_access (ArvGcFeatureNode *gc_feature_node, GErro
         if (policy != ARV_ACCESS_CHECK_POLICY_ENABLE)
                 return TRUE;
 
-        if (arv_gc_feature_node_get_actual_access_mode (gc_feature_node) != ARV_GC_ACCESS_MODE_RO)
+        arv_gc_begin_validation (genicam);
+        access_mode = arv_gc_feature_node_get_actual_access_mode (gc_feature_node);
+        arv_gc_end_validation (genicam);
+
+        if (access_mode != ARV_GC_ACCESS_MODE_RO)
                 return TRUE;
 
         g_set_error (error, ARV_GC_ERROR, ARV_GC_ERROR_READ_ONLY, "[%s] Write error on read only feature",
@@ -73,6 +73,8 @@ arv_gc_float_set_value (ArvGcFloat *gc_float, double value, GError **error)
 	if (policy != ARV_RANGE_CHECK_POLICY_DISABLE) {
 		ArvGcFloatInterface *iface = ARV_GC_FLOAT_GET_IFACE (gc_float);
 
+		arv_gc_begin_validation (genicam);
+
 		if (iface->get_min != NULL) {
 			double min = iface->get_min (gc_float, &local_error);
 
@@ -93,6 +95,8 @@ arv_gc_float_set_value (ArvGcFloat *gc_float, double value, GError **error)
 			}
 		}
 
+		arv_gc_end_validation (genicam);
+
 		if (local_error != NULL) {
 			if (policy == ARV_RANGE_CHECK_POLICY_DEBUG) {
 				arv_warning_policies ("Range check (%s) ignored", local_error->message);
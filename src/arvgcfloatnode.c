@@ -443,6 +443,7 @@ arv_gc_float_node_impose_min (ArvGcFloat *gc_float, double minimum, GError **err
 	if (gc_float_node->minimum == NULL)
 		return;
 
+	arv_gc_feature_node_increment_change_count (ARV_GC_FEATURE_NODE (gc_float_node));
 	arv_gc_property_node_set_double (ARV_GC_PROPERTY_NODE (gc_float_node->minimum), minimum, &local_error);
 
 	if (local_error != NULL)
@@ -459,6 +460,7 @@ arv_gc_float_node_impose_max (ArvGcFloat *gc_float, double maximum, GError **err
 	if (gc_float_node->maximum == NULL)
 		return;
 
+	arv_gc_feature_node_increment_change_count (ARV_GC_FEATURE_NODE (gc_float_node));
 	arv_gc_property_node_set_double (ARV_GC_PROPERTY_NODE (gc_float_node->maximum), maximum, &local_error);
 
 	if (local_error != NULL)
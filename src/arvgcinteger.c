@@ -71,6 +71,8 @@ arv_gc_integer_set_value (ArvGcInteger *gc_integer, gint64 value, GError **error
 	if (policy != ARV_RANGE_CHECK_POLICY_DISABLE) {
 		ArvGcIntegerInterface *iface = ARV_GC_INTEGER_GET_IFACE (gc_integer);
 
+		arv_gc_begin_validation (genicam);
+
 		if (iface->get_min != NULL) {
 			gint64 min = iface->get_min (gc_integer, &local_error);
 
@@ -93,6 +95,8 @@ arv_gc_integer_set_value (ArvGcInteger *gc_integer, gint64 value, GError **error
 			}
 		}
 
+		arv_gc_end_validation (genicam);
+
 		if (local_error != NULL) {
 			if (policy == ARV_RANGE_CHECK_POLICY_DEBUG) {
 				arv_warning_policies ("Range check (%s) ignored", local_error->message);
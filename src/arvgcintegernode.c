@@ -421,6 +421,7 @@ arv_gc_integer_node_impose_min (ArvGcInteger *gc_integer, gint64 minimum, GError
 	if (gc_integer_node->minimum == NULL)
 		return;
 
+	arv_gc_feature_node_increment_change_count (ARV_GC_FEATURE_NODE (gc_integer_node));
 	arv_gc_property_node_set_int64 (ARV_GC_PROPERTY_NODE (gc_integer_node->minimum), minimum, &local_error);
 
 	if (local_error != NULL)
@@ -437,6 +438,7 @@ arv_gc_integer_node_impose_max (ArvGcInteger *gc_integer, gint64 maximum, GError
 	if (gc_integer_node->maximum == NULL)
 		return;
 
+	arv_gc_feature_node_increment_change_count (ARV_GC_FEATURE_NODE (gc_integer_node));
 	arv_gc_property_node_set_int64 (ARV_GC_PROPERTY_NODE (gc_integer_node->maximum), maximum, &local_error);
 
 	if (local_error != NULL)
@@ -34,7 +34,7 @@
 #include <arvchunkparserprivate.h>
 #include <arvbuffer.h>
 #include <arvgcpropertynode.h>
-#include <arvgc.h>
+#include <arvgcprivate.h>
 #include <memory.h>
 
 typedef struct {
@@ -224,7 +224,9 @@ arv_gc_port_read (ArvGcPort *port, void *buffer, guint64 address, guint64 length
                 ArvDevice *device;
 
 		device = arv_gc_get_device (genicam);
-		if (ARV_IS_DEVICE (device)) {
+		if (arv_gc_transaction_read (genicam, address, length, buffer, error)) {
+			/* Read from the pending transaction writes, or pending writes flush error */
+		} else if (ARV_IS_DEVICE (device)) {
 			/* For schema < 1.1.0 and length == 4, register read must be used instead of memory read.
 			 * Only applies to GigE Vision devices. See Appendix 3 of Genicam 2.0 specification. */
 			if (ARV_IS_GV_DEVICE (device) && _use_legacy_endianness_mechanism (port, length)) {
@@ -288,12 +290,18 @@ arv_gc_port_write (ArvGcPort *port, void *buffer, guint64 address, guint64 lengt
 			     "[%s] Events  not implemented",
                              arv_gc_feature_node_get_name (ARV_GC_FEATURE_NODE (port)));
 	} else {
+		gboolean use_register;
+
 		device = arv_gc_get_device (genicam);
 
-		if (ARV_IS_DEVICE (device)) {
-			/* For schema < 1.1.0 and length == 4, register write must be used instead of memory write.
-			 * Only applies to GigE Vision devices. See Appendix 3 of Genicam 2.0 specification. */
-			if (ARV_IS_GV_DEVICE (device) && _use_legacy_endianness_mechanism (port, length)) {
+		/* For schema < 1.1.0 and length == 4, register write must be used instead of memory write.
+		 * Only applies to GigE Vision devices. See Appendix 3 of Genicam 2.0 specification. */
+		use_register = ARV_IS_GV_DEVICE (device) && _use_legacy_endianness_mechanism (port, length);
+
+		if (ARV_IS_DEVICE (device) && arv_gc_transaction_write (genicam, address, length, buffer, use_register)) {
+			/* Queued until the transaction commit */
+		} else if (ARV_IS_DEVICE (device)) {
+			if (use_register) {
 				guint32 value;
 
 				/* For schema < 1.1.0, all registers are big endian. */
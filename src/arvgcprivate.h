@@ -27,4 +27,17 @@
 
 ARV_API guint64            arv_gc_register_cache_error_add         (ArvGc *genicam, guint64 n_errors);
 
+guint			arv_gc_get_link_generation		(ArvGc *genicam);
+
+void			arv_gc_notify_feature_change		(ArvGc *genicam, ArvGcFeatureNode *node);
+guint64			arv_gc_get_value_serial			(ArvGc *genicam);
+guint64			arv_gc_get_cache_serial			(ArvGc *genicam);
+
+gboolean		arv_gc_transaction_write		(ArvGc *genicam, guint64 address, guint64 length,
+								 const void *buffer, gboolean use_registers);
+gboolean		arv_gc_transaction_read			(ArvGc *genicam, guint64 address, guint64 length,
+								 void *buffer, GError **error);
+void			arv_gc_begin_validation			(ArvGc *genicam);
+void			arv_gc_end_validation			(ArvGc *genicam);
+
 #endif
@@ -28,13 +28,13 @@
  * types of Genicam property nodes (Value, pValue, Endianness...).
  */
 
-#include <arvgcpropertynode.h>
+#include <arvgcpropertynodeprivate.h>
 #include <arvgcfeaturenode.h>
 #include <arvgcinteger.h>
 #include <arvgcfloat.h>
 #include <arvgcboolean.h>
 #include <arvgcstring.h>
-#include <arvgc.h>
+#include <arvgcprivate.h>
 #include <arvdomtext.h>
 #include <arvmiscprivate.h>
 #include <arvdebugprivate.h>
@@ -55,6 +55,14 @@ typedef struct {
 
 	gboolean value_data_up_to_date;
 	char *value_data;
+
+	/* Caches derived from value_data, cleared by _value_data_changed */
+	ArvGcNode *linked_node;
+	guint linked_node_generation;	/* 0 if not resolved */
+	gboolean v_int64_up_to_date;
+	gint64 v_int64;
+	gboolean v_double_up_to_date;
+	double v_double;
 } ArvGcPropertyNodePrivate;
 
 G_DEFINE_TYPE_WITH_CODE (ArvGcPropertyNode, arv_gc_property_node, ARV_TYPE_GC_NODE, G_ADD_PRIVATE (ArvGcPropertyNode))
@@ -182,12 +190,22 @@ _can_append_child (ArvDomNode *self, ArvDomNode *child)
 	return ARV_IS_DOM_TEXT (child);
 }
 
+static void
+_value_data_changed (ArvGcPropertyNodePrivate *priv)
+{
+	priv->linked_node = NULL;
+	priv->linked_node_generation = 0;
+	priv->v_int64_up_to_date = FALSE;
+	priv->v_double_up_to_date = FALSE;
+}
+
 static void
 _post_new_child (ArvDomNode *parent, ArvDomNode *child)
 {
 	ArvGcPropertyNodePrivate *priv = arv_gc_property_node_get_instance_private (ARV_GC_PROPERTY_NODE (parent));
 
 	priv->value_data_up_to_date = FALSE;
+	_value_data_changed (priv);
 }
 
 static void
@@ -196,6 +214,7 @@ _pre_remove_child (ArvDomNode *parent, ArvDomNode *child)
 	ArvGcPropertyNodePrivate *priv = arv_gc_property_node_get_instance_private (ARV_GC_PROPERTY_NODE (parent));
 
 	priv->value_data_up_to_date = FALSE;
+	_value_data_changed (priv);
 }
 
 /* ArvDomElement implementation */
@@ -268,23 +287,66 @@ _set_value_data (ArvGcPropertyNode *property_node, const char *data)
 	g_free (priv->value_data);
 	priv->value_data = g_strdup (data);
 	priv->value_data_up_to_date = TRUE;
+
+	_value_data_changed (priv);
 }
 
-static ArvDomNode *
-_get_pvalue_node (ArvGcPropertyNode *property_node)
+/* The linked node is resolved once, and resolved again only if the value data changes or if a feature node
+ * is registered in the genicam document afterwards, as it may shadow or provide the referenced name. */
+
+static ArvGcNode *
+_get_linked_node (ArvGcPropertyNode *property_node)
 {
-	ArvDomNode *pvalue_node;
-	const char *node_name;
+	ArvGcPropertyNodePrivate *priv = arv_gc_property_node_get_instance_private (property_node);
 	ArvGc *genicam;
+	guint generation;
 
-	if (arv_gc_property_node_get_node_type (property_node) < ARV_GC_PROPERTY_NODE_TYPE_P_UNKNONW)
+	genicam = arv_gc_node_get_genicam (ARV_GC_NODE (property_node));
+	if (genicam == NULL)
 		return NULL;
 
-	node_name = _get_value_data (property_node);
-	genicam = arv_gc_node_get_genicam (ARV_GC_NODE (property_node));
-	pvalue_node = ARV_DOM_NODE (arv_gc_get_node (genicam, node_name));
+	generation = arv_gc_get_link_generation (genicam);
+	if (priv->linked_node_generation != generation) {
+		priv->linked_node = arv_gc_get_node (genicam, _get_value_data (property_node));
+		priv->linked_node_generation = generation;
+	}
+
+	return priv->linked_node;
+}
+
+static gint64
+_get_int64_value_data (ArvGcPropertyNode *property_node)
+{
+	ArvGcPropertyNodePrivate *priv = arv_gc_property_node_get_instance_private (property_node);
+
+	if (!priv->v_int64_up_to_date) {
+		priv->v_int64 = g_ascii_strtoll (_get_value_data (property_node), NULL, 0);
+		priv->v_int64_up_to_date = TRUE;
+	}
 
-	return pvalue_node;
+	return priv->v_int64;
+}
+
+static double
+_get_double_value_data (ArvGcPropertyNode *property_node)
+{
+	ArvGcPropertyNodePrivate *priv = arv_gc_property_node_get_instance_private (property_node);
+
+	if (!priv->v_double_up_to_date) {
+		priv->v_double = g_ascii_strtod (_get_value_data (property_node), NULL);
+		priv->v_double_up_to_date = TRUE;
+	}
+
+	return priv->v_double;
+}
+
+static ArvDomNode *
+_get_pvalue_node (ArvGcPropertyNode *property_node)
+{
+	if (arv_gc_property_node_get_node_type (property_node) < ARV_GC_PROPERTY_NODE_TYPE_P_UNKNONW)
+		return NULL;
+
+	return ARV_DOM_NODE (_get_linked_node (property_node));
 }
 
 /**
@@ -375,7 +437,7 @@ arv_gc_property_node_get_int64 (ArvGcPropertyNode *node, GError **error)
 
 	pvalue_node = _get_pvalue_node (node);
 	if (pvalue_node == NULL)
-		return g_ascii_strtoll (_get_value_data (node), NULL, 0);
+		return _get_int64_value_data (node);
 
 	if (ARV_IS_GC_INTEGER (pvalue_node)) {
 		return arv_gc_integer_get_value (ARV_GC_INTEGER (pvalue_node), error);
@@ -431,7 +493,7 @@ arv_gc_property_node_get_double (ArvGcPropertyNode *node, GError **error)
 
 	pvalue_node = _get_pvalue_node (node);
 	if (pvalue_node == NULL)
-		return g_ascii_strtod (_get_value_data (node), NULL);
+		return _get_double_value_data (node);
 
 
 	if (ARV_IS_GC_FLOAT (pvalue_node)) {
@@ -495,15 +557,40 @@ arv_gc_property_node_get_node_type (ArvGcPropertyNode *node)
 ArvGcNode *
 arv_gc_property_node_get_linked_node (ArvGcPropertyNode *node)
 {
-	ArvGc *genicam;
-
 	g_return_val_if_fail (ARV_IS_GC_PROPERTY_NODE (node), NULL);
 
 	if (arv_gc_property_node_get_node_type (node) <= ARV_GC_PROPERTY_NODE_TYPE_P_UNKNONW)
 		return NULL;
 
-	genicam = arv_gc_node_get_genicam (ARV_GC_NODE (node));
-	return arv_gc_get_node (genicam, _get_value_data (node));
+	return _get_linked_node (node);
+}
+
+/* Resolves the node referenced by a pointer property, or parses the value of a numerical literal property, and
+ * keeps the result for the subsequent accesses. Returns FALSE for a pointer to a node which doesn't exist. */
+
+gboolean
+arv_gc_property_node_link (ArvGcPropertyNode *node)
+{
+	g_return_val_if_fail (ARV_IS_GC_PROPERTY_NODE (node), FALSE);
+
+	switch (arv_gc_property_node_get_node_type (node)) {
+		case ARV_GC_PROPERTY_NODE_TYPE_VALUE:
+		case ARV_GC_PROPERTY_NODE_TYPE_ADDRESS:
+		case ARV_GC_PROPERTY_NODE_TYPE_MINIMUM:
+		case ARV_GC_PROPERTY_NODE_TYPE_MAXIMUM:
+		case ARV_GC_PROPERTY_NODE_TYPE_INCREMENT:
+		case ARV_GC_PROPERTY_NODE_TYPE_LENGTH:
+			_get_int64_value_data (node);
+			_get_double_value_data (node);
+			return TRUE;
+		default:
+			break;
+	}
+
+	if (arv_gc_property_node_get_node_type (node) <= ARV_GC_PROPERTY_NODE_TYPE_P_UNKNONW)
+		return TRUE;
+
+	return _get_linked_node (node) != NULL;
 }
 
 static ArvGcNode *
@@ -27,7 +27,6 @@
 
 #include <arvgcregisternodeprivate.h>
 #include <arvgcindexnode.h>
-#include <arvgcinvalidatornode.h>
 #include <arvgcfeaturenodeprivate.h>
 #include <arvgcswissknife.h>
 #include <arvgcregister.h>
@@ -83,8 +82,6 @@ typedef struct {
 	ArvGcPropertyNode *access_mode;
 	ArvGcPropertyNode *endianness;
 
-	GSList *invalidators;		/* #ArvGcPropertyNode */
-
 	gboolean cached;
 	GHashTable *caches;
 	guint n_cache_hits;
@@ -145,7 +142,7 @@ arv_gc_register_node_post_new_child (ArvDomNode *self, ArvDomNode *child)
 				priv->access_mode = property_node;
 				break;
 			case ARV_GC_PROPERTY_NODE_TYPE_P_INVALIDATOR:
-				priv->invalidators = g_slist_prepend (priv->invalidators, property_node);
+				/* Cache invalidation is pushed by the genicam dependency index */
 				break;
 			default:
 				ARV_DOM_NODE_CLASS (arv_gc_register_node_parent_class)->post_new_child (self, child);
@@ -261,7 +258,6 @@ _get_cached (ArvGcRegisterNode *self, ArvRegisterCachePolicy *cache_policy)
 {
 	ArvGcRegisterNodePrivate *priv = arv_gc_register_node_get_instance_private (ARV_GC_REGISTER_NODE (self));
 	ArvGc *genicam;
-	GSList *iter;
 	gboolean cached = priv->cached;
 
 	*cache_policy = ARV_REGISTER_CACHE_POLICY_DISABLE;
@@ -274,11 +270,6 @@ _get_cached (ArvGcRegisterNode *self, ArvRegisterCachePolicy *cache_policy)
 	if (*cache_policy == ARV_REGISTER_CACHE_POLICY_DISABLE)
 		return FALSE;
 
-	for (iter = priv->invalidators; iter != NULL; iter = iter->next) {
-		if (arv_gc_invalidator_has_changed (iter->data))
-			cached = FALSE;
-	}
-
 	if (cached)
 		priv->n_cache_hits++;
 	else
@@ -443,7 +434,6 @@ arv_gc_register_node_finalize (GObject *self)
 	g_slist_free (priv->addresses);
 	g_slist_free (priv->swiss_knives);
 	g_slist_free (priv->indexes);
-	g_slist_free (priv->invalidators);
 	g_clear_pointer (&priv->caches, g_hash_table_unref);
 
 	genicam = arv_gc_node_get_genicam (ARV_GC_NODE (self));
@@ -781,3 +771,22 @@ arv_gc_register_node_get_endianness  (ArvGcRegisterNode *register_node)
 	return _get_endianness (register_node);
 }
 
+void
+arv_gc_register_node_invalidate_cache (ArvGcRegisterNode *register_node)
+{
+	ArvGcRegisterNodePrivate *priv;
+
+	g_return_if_fail (ARV_IS_GC_REGISTER_NODE (register_node));
+
+	priv = arv_gc_register_node_get_instance_private (register_node);
+
+	priv->cached = FALSE;
+}
+
+ArvGcCachable
+arv_gc_register_node_get_cachable (ArvGcRegisterNode *register_node)
+{
+	g_return_val_if_fail (ARV_IS_GC_REGISTER_NODE (register_node), ARV_GC_CACHABLE_NO_CACHE);
+
+	return _get_cachable (register_node);
+}
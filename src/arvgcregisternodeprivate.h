@@ -37,6 +37,8 @@ void 		arv_gc_register_node_set_masked_integer_value 	(ArvGcRegisterNode *gc_reg
 								 gboolean is_masked,
 								 gint64 value, GError **error);
 guint 		arv_gc_register_node_get_endianness 		(ArvGcRegisterNode *register_node);
+void		arv_gc_register_node_invalidate_cache		(ArvGcRegisterNode *register_node);
+ArvGcCachable	arv_gc_register_node_get_cachable		(ArvGcRegisterNode *register_node);
 
 
 #endif
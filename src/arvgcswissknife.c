@@ -26,7 +26,8 @@
  */
 
 #include <arvgcswissknifeprivate.h>
-#include <arvevaluator.h>
+#include <arvgcfeaturenodeprivate.h>
+#include <arvevaluatorprivate.h>
 #include <arvgcinteger.h>
 #include <arvgcfloat.h>
 #include <arvgcport.h>
@@ -45,6 +46,7 @@ typedef struct {
 	ArvGcPropertyNode *representation;
 
 	ArvEvaluator *formula;
+	GArray *variable_slots;	/* Evaluator slots of the variables, in list order */
 } ArvGcSwissKnifePrivate;
 
 G_DEFINE_ABSTRACT_TYPE_WITH_CODE (ArvGcSwissKnife, arv_gc_swiss_knife, ARV_TYPE_GC_FEATURE_NODE, G_ADD_PRIVATE (ArvGcSwissKnife))
@@ -62,6 +64,7 @@ arv_gc_swiss_knife_post_new_child (ArvDomNode *self, ArvDomNode *child)
 		switch (arv_gc_property_node_get_node_type (property_node)) {
 			case ARV_GC_PROPERTY_NODE_TYPE_P_VARIABLE:
 				priv->variables = g_slist_prepend (priv->variables, property_node);
+				g_clear_pointer (&priv->variable_slots, g_array_unref);
 				break;
 			case ARV_GC_PROPERTY_NODE_TYPE_FORMULA:
 				priv->formula_node = property_node;
@@ -115,6 +118,7 @@ arv_gc_swiss_knife_finalize (GObject *object)
 	g_slist_free (priv->variables);
 	g_slist_free (priv->expressions);
 	g_slist_free (priv->constants);
+	g_clear_pointer (&priv->variable_slots, g_array_unref);
 
 	g_clear_object (&priv->formula);
 
@@ -144,6 +148,7 @@ _update_variables (ArvGcSwissKnife *self, GError **error)
 	GError *local_error = NULL;
 	GSList *iter;
 	const char *expression;
+	guint i;
 
 	if (priv->formula_node != NULL)
 		expression = arv_gc_property_node_get_string (priv->formula_node, &local_error);
@@ -190,7 +195,16 @@ _update_variables (ArvGcSwissKnife *self, GError **error)
 		arv_evaluator_set_constant (priv->formula, name, constant);
 	}
 
-	for (iter = priv->variables; iter != NULL; iter = iter->next) {
+	if (priv->variable_slots == NULL) {
+		priv->variable_slots = g_array_new (FALSE, FALSE, sizeof (guint));
+		for (iter = priv->variables; iter != NULL; iter = iter->next) {
+			guint slot = arv_evaluator_get_variable_slot (priv->formula,
+								      arv_gc_property_node_get_name (iter->data));
+			g_array_append_val (priv->variable_slots, slot);
+		}
+	}
+
+	for (iter = priv->variables, i = 0; iter != NULL; iter = iter->next, i++) {
 		ArvGcPropertyNode *variable_node = iter->data;
 
 		node = arv_gc_property_node_get_linked_node (ARV_GC_PROPERTY_NODE (variable_node));
@@ -205,9 +219,9 @@ _update_variables (ArvGcSwissKnife *self, GError **error)
                                 return;
                         }
 
-			arv_evaluator_set_int64_variable (priv->formula,
-							  arv_gc_property_node_get_name (variable_node),
-							  value);
+			arv_evaluator_set_int64_variable_by_slot (priv->formula,
+								  g_array_index (priv->variable_slots, guint, i),
+								  value);
 		} else if (ARV_IS_GC_FLOAT (node)) {
 			double value;
 
@@ -219,9 +233,9 @@ _update_variables (ArvGcSwissKnife *self, GError **error)
 				return;
 			}
 
-			arv_evaluator_set_double_variable (priv->formula,
-							  arv_gc_property_node_get_name (variable_node),
-							  value);
+			arv_evaluator_set_double_variable_by_slot (priv->formula,
+								   g_array_index (priv->variable_slots, guint, i),
+								   value);
 		}
 	}
 }
@@ -231,9 +245,13 @@ arv_gc_swiss_knife_get_integer_value (ArvGcSwissKnife *self, GError **error)
 {
 	ArvGcSwissKnifePrivate *priv = arv_gc_swiss_knife_get_instance_private (self);
 	GError *local_error = NULL;
+	gint64 value;
 
 	g_return_val_if_fail (ARV_IS_GC_SWISS_KNIFE (self), 0);
 
+	if (arv_gc_feature_node_get_cached_int64 (ARV_GC_FEATURE_NODE (self), ARV_GC_FEATURE_NODE_CACHED_VALUE, &value))
+		return value;
+
 	_update_variables (self, &local_error);
 
 	if (local_error != NULL) {
@@ -242,7 +260,11 @@ arv_gc_swiss_knife_get_integer_value (ArvGcSwissKnife *self, GError **error)
                 return 0;
         }
 
-	return arv_evaluator_evaluate_as_int64 (priv->formula, NULL);
+	value = arv_evaluator_evaluate_as_int64 (priv->formula, NULL);
+
+	arv_gc_feature_node_set_cached_int64 (ARV_GC_FEATURE_NODE (self), ARV_GC_FEATURE_NODE_CACHED_VALUE, value);
+
+	return value;
 }
 
 double
@@ -250,9 +272,13 @@ arv_gc_swiss_knife_get_float_value (ArvGcSwissKnife *self, GError **error)
 {
 	ArvGcSwissKnifePrivate *priv = arv_gc_swiss_knife_get_instance_private (self);
 	GError *local_error = NULL;
+	double value;
 
 	g_return_val_if_fail (ARV_IS_GC_SWISS_KNIFE (self), 0.0);
 
+	if (arv_gc_feature_node_get_cached_double (ARV_GC_FEATURE_NODE (self), ARV_GC_FEATURE_NODE_CACHED_VALUE, &value))
+		return value;
+
 	_update_variables (self, &local_error);
 
 	if (local_error != NULL) {
@@ -261,7 +287,11 @@ arv_gc_swiss_knife_get_float_value (ArvGcSwissKnife *self, GError **error)
 		return 0.0;
 	}
 
-	return arv_evaluator_evaluate_as_double (priv->formula, NULL);
+	value = arv_evaluator_evaluate_as_double (priv->formula, NULL);
+
+	arv_gc_feature_node_set_cached_double (ARV_GC_FEATURE_NODE (self), ARV_GC_FEATURE_NODE_CACHED_VALUE, value);
+
+	return value;
 }
 
 ArvGcRepresentation
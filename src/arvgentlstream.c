@@ -295,6 +295,7 @@ _gentl_buffer_to_arv_buffer(ArvGenTLModule *gentl, DS_HANDLE datastream, BUFFER_
 
 	_gentl_buffer_info_uint64(gentl, datastream, gentl_buffer, BUFFER_INFO_FRAMEID, &frame_id);
 	arv_buffer->priv->frame_id = frame_id;
+	arv_buffer->priv->system_timestamp_ns = g_get_real_time () * 1000LL;
 
 	if (!_gentl_buffer_info_uint64(gentl, datastream, gentl_buffer, BUFFER_INFO_TIMESTAMP_NS, &timestamp)) {
 		uint64_t timestamp_ticks = 0;
@@ -483,11 +484,7 @@ _loop (ArvGenTLStreamThreadData *thread_data)
 
 			thread_data->n_transferred_bytes += arv_buffer->priv->allocated_size;
 
-			arv_stream_push_output_buffer(thread_data->stream, arv_buffer);
-			if (thread_data->callback != NULL)
-				thread_data->callback (thread_data->callback_data,
-					ARV_STREAM_CALLBACK_TYPE_BUFFER_DONE,
-					arv_buffer);
+			arv_stream_push_completed_buffer (thread_data->stream, arv_buffer);
 		} else {
                         g_critical ("[GenTL::loop] error retrieving buffer");
 		}
@@ -790,6 +787,9 @@ arv_gentl_stream_constructed (GObject *object)
 				 G_TYPE_UINT64, &priv->thread_data->n_underruns);
 	arv_stream_declare_info (stream, "n_transferred_bytes",
 				 G_TYPE_UINT64, &priv->thread_data->n_transferred_bytes);
+
+	/* The producer only gives the device timestamp of the frames, the host time of their first data is unknown */
+	arv_stream_disable_latency (stream, ARV_STREAM_LATENCY_COMPLETION);
 }
 
 static void
@@ -116,6 +116,8 @@ G_BEGIN_DECLS
 #define ARV_GVBS_TIMESTAMP_TICK_FREQUENCY_HIGH_OFFSET	0x0000093c
 #define ARV_GVBS_TIMESTAMP_TICK_FREQUENCY_LOW_OFFSET	0x00000940
 #define ARV_GVBS_TIMESTAMP_CONTROL_OFFSET		0x00000944
+#define ARV_GVBS_TIMESTAMP_CONTROL_RESET		1 << 0
+#define ARV_GVBS_TIMESTAMP_CONTROL_LATCH		1 << 1
 #define ARV_GVBS_TIMESTAMP_LATCHED_VALUE_HIGH_OFFSET	0x00000948
 #define ARV_GVBS_TIMESTAMP_LATCHED_VALUE_LOW_OFFSET	0x0000094c
 
@@ -138,6 +140,10 @@ G_BEGIN_DECLS
 
 #define ARV_GVCP_DATA_SIZE_MAX				512
 
+/* A GVCP command is at most 548 bytes long, header included */
+#define ARV_GVCP_N_READ_REGISTERS_MAX			135
+#define ARV_GVCP_N_WRITE_REGISTERS_MAX			67
+
 /**
  * ArvGvcpPacketType:
  * @ARV_GVCP_PACKET_TYPE_ACK: acknowledge packet
@@ -334,6 +340,13 @@ ArvGvcpPacket * 	arv_gvcp_packet_new_write_register_cmd 	(guint32 address, guint
 								 guint16 packet_id, size_t *packet_size);
 ArvGvcpPacket * 	arv_gvcp_packet_new_write_register_ack 	(guint32 data_index,
 								 guint16 packet_id, size_t *packet_size);
+ArvGvcpPacket * 	arv_gvcp_packet_new_read_registers_cmd 	(const guint32 *addresses, guint n_addresses,
+								 guint16 packet_id, size_t *packet_size);
+ArvGvcpPacket * 	arv_gvcp_packet_new_read_registers_ack 	(const guint32 *values, guint n_values,
+								 guint16 packet_id, size_t *packet_size);
+ArvGvcpPacket * 	arv_gvcp_packet_new_write_registers_cmd	(const guint32 *addresses, const guint32 *values,
+								 guint n_registers,
+								 guint16 packet_id, size_t *packet_size);
 ArvGvcpPacket * 	arv_gvcp_packet_new_discovery_cmd 	(gboolean allow_broadcast_discovery_ack, size_t *packet_size);
 ArvGvcpPacket * 	arv_gvcp_packet_new_discovery_ack 	(guint16 packet_id, size_t *packet_size);
 ArvGvcpPacket * 	arv_gvcp_packet_new_packet_resend_cmd 	(guint64 frame_id,
@@ -527,6 +540,67 @@ arv_gvcp_packet_get_write_register_ack_size (void)
 	return sizeof (ArvGvcpHeader) + sizeof (guint32);
 }
 
+static inline guint32
+arv_gvcp_packet_get_write_register_ack_index (const ArvGvcpPacket *packet, size_t packet_size)
+{
+	if G_UNLIKELY(packet == NULL || packet_size < arv_gvcp_packet_get_write_register_ack_size())
+		return 0;
+
+	return g_ntohl (*((guint32 *) ((char *) packet + sizeof (ArvGvcpPacket)))) & 0xffff;
+}
+
+static inline guint
+arv_gvcp_packet_get_read_registers_cmd_n_addresses (const ArvGvcpPacket *packet, size_t packet_size)
+{
+	if G_UNLIKELY(packet == NULL || packet_size < sizeof (ArvGvcpPacket))
+		return 0;
+
+	return MIN (g_ntohs (packet->header.size), packet_size - sizeof (ArvGvcpPacket)) / sizeof (guint32);
+}
+
+static inline guint32
+arv_gvcp_packet_get_read_registers_cmd_address (const ArvGvcpPacket *packet, size_t packet_size, guint index)
+{
+	if G_UNLIKELY(index >= arv_gvcp_packet_get_read_registers_cmd_n_addresses (packet, packet_size))
+		return 0;
+
+	return g_ntohl (*((guint32 *) ((char *) packet + sizeof (ArvGvcpPacket) + index * sizeof (guint32))));
+}
+
+static inline size_t
+arv_gvcp_packet_get_read_registers_ack_size (guint n_values)
+{
+	return sizeof (ArvGvcpHeader) + n_values * sizeof (guint32);
+}
+
+static inline guint
+arv_gvcp_packet_get_read_registers_ack_n_values (const ArvGvcpPacket *packet, size_t packet_size)
+{
+	return arv_gvcp_packet_get_read_registers_cmd_n_addresses (packet, packet_size);
+}
+
+static inline guint32
+arv_gvcp_packet_get_read_registers_ack_value (const ArvGvcpPacket *packet, size_t packet_size, guint index)
+{
+	return arv_gvcp_packet_get_read_registers_cmd_address (packet, packet_size, index);
+}
+
+static inline guint
+arv_gvcp_packet_get_write_registers_cmd_n_registers (const ArvGvcpPacket *packet, size_t packet_size)
+{
+	return arv_gvcp_packet_get_read_registers_cmd_n_addresses (packet, packet_size) / 2;
+}
+
+static inline void
+arv_gvcp_packet_get_write_registers_cmd_infos (const ArvGvcpPacket *packet, size_t packet_size, guint index,
+					       guint32 *address, guint32 *value)
+{
+	if (address != NULL)
+		*address = arv_gvcp_packet_get_read_registers_cmd_address (packet, packet_size, 2 * index);
+	if (value != NULL)
+		*value = arv_gvcp_packet_get_read_registers_cmd_address (packet, packet_size, 2 * index + 1);
+}
+
 static inline guint16
 arv_gvcp_next_packet_id (guint16 packet_id)
 {
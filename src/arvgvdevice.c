@@ -39,6 +39,7 @@
 #include <arvzip.h>
 #include <arvstr.h>
 #include <arvmiscprivate.h>
+#include <arvclockmodelprivate.h>
 #include <arvenumtypes.h>
 #include <string.h>
 #include <stdlib.h>
@@ -50,7 +51,8 @@ enum
 	PROP_0,
 	PROP_GV_DEVICE_INTERFACE_ADDRESS,
 	PROP_GV_DEVICE_DEVICE_ADDRESS,
-	PROP_GV_DEVICE_PACKET_SIZE_ADJUSTEMENT
+	PROP_GV_DEVICE_PACKET_SIZE_ADJUSTEMENT,
+	PROP_GV_DEVICE_GVCP_WINDOW
 };
 
 typedef struct {
@@ -68,6 +70,8 @@ typedef struct {
 
 	unsigned int gvcp_n_retries;
 	unsigned int gvcp_timeout_ms;
+	unsigned int gvcp_window;
+	unsigned int gvcp_window_max;
 
 	gboolean is_controller;
 } ArvGvDeviceIOData;
@@ -90,9 +94,14 @@ typedef struct {
 
 	gboolean is_packet_resend_supported;
 	gboolean is_write_memory_supported;
+	gboolean is_concatenation_supported;
 
 	ArvGvStreamOption stream_options;
 	ArvGvPacketSizeAdjustment packet_size_adjustment;
+	guint gvcp_window;
+
+	ArvClockModel *clock_model;
+	gint clock_synchronization;
 
 	gboolean first_stream_created;
 
@@ -134,9 +143,14 @@ arv_gvcp_error_to_device_error (ArvGvcpError code)
         return ARV_DEVICE_ERROR_PROTOCOL_ERROR;
 }
 
+/*
+ * For the register commands, @addresses holds @size / sizeof (guint32) register addresses, and @address is
+ * ignored.
+ */
+
 static gboolean
 _send_cmd_and_receive_ack (ArvGvDeviceIOData *io_data, ArvGvcpCommand command,
-			   guint64 address, size_t size, void *buffer, GError **error)
+			   guint64 address, const guint32 *addresses, size_t size, void *buffer, GError **error)
 {
 	ArvGvcpCommand expected_ack_command;
 	ArvGvcpPacket *ack_packet = io_data->buffer;
@@ -147,6 +161,9 @@ _send_cmd_and_receive_ack (ArvGvDeviceIOData *io_data, ArvGvcpCommand command,
 	unsigned int n_retries = 0;
 	gboolean success = FALSE;
 	ArvGvcpError command_error = ARV_GVCP_ERROR_NONE;
+	guint n_registers = size / sizeof (guint32);
+	guint error_index = 0;
+	guint i;
 	int count;
 
 	switch (command) {
@@ -163,7 +180,7 @@ _send_cmd_and_receive_ack (ArvGvDeviceIOData *io_data, ArvGvcpCommand command,
 		case ARV_GVCP_COMMAND_READ_REGISTER_CMD:
 			operation = "read_register";
 			expected_ack_command = ARV_GVCP_COMMAND_READ_REGISTER_ACK;
-			ack_size = arv_gvcp_packet_get_read_register_ack_size ();
+			ack_size = arv_gvcp_packet_get_read_registers_ack_size (n_registers);
 			break;
 		case ARV_GVCP_COMMAND_WRITE_REGISTER_CMD:
 			operation = "write_register";
@@ -190,12 +207,12 @@ _send_cmd_and_receive_ack (ArvGvDeviceIOData *io_data, ArvGvcpCommand command,
 								       io_data->packet_id, &packet_size);
 			break;
 		case ARV_GVCP_COMMAND_READ_REGISTER_CMD:
-			packet = arv_gvcp_packet_new_read_register_cmd (address,
-									io_data->packet_id, &packet_size);
+			packet = arv_gvcp_packet_new_read_registers_cmd (addresses, n_registers,
+									 io_data->packet_id, &packet_size);
 			break;
 		case ARV_GVCP_COMMAND_WRITE_REGISTER_CMD:
-			packet = arv_gvcp_packet_new_write_register_cmd (address, *((guint32 *) buffer),
-									 io_data->packet_id, &packet_size);
+			packet = arv_gvcp_packet_new_write_registers_cmd (addresses, buffer, n_registers,
+									  io_data->packet_id, &packet_size);
 			break;
 		default:
 			g_assert_not_reached ();
@@ -266,9 +283,17 @@ _send_cmd_and_receive_ack (ArvGvDeviceIOData *io_data, ArvGvcpCommand command,
                                                 if (!expected_answer) {
                                                         arv_info_device ("[GvDevice::%s] Unexpected answer (0x%02x)",
                                                                          operation, packet_type);
-                                                } else
+                                                } else {
                                                         command_error = arv_gvcp_packet_get_packet_flags (ack_packet,
                                                                                                           count);
+                                                        /* Index of the register the device stumbled on */
+                                                        if (command == ARV_GVCP_COMMAND_READ_REGISTER_CMD)
+                                                                error_index = arv_gvcp_packet_get_read_registers_ack_n_values
+                                                                        (ack_packet, count);
+                                                        else if (command == ARV_GVCP_COMMAND_WRITE_REGISTER_CMD)
+                                                                error_index = arv_gvcp_packet_get_write_register_ack_index
+                                                                        (ack_packet, count);
+                                                }
                                         } else  {
                                                 expected_answer = packet_type == ARV_GVCP_PACKET_TYPE_ACK &&
                                                         ack_command == expected_ack_command &&
@@ -302,8 +327,10 @@ _send_cmd_and_receive_ack (ArvGvDeviceIOData *io_data, ArvGvcpCommand command,
 					case ARV_GVCP_COMMAND_WRITE_MEMORY_CMD:
 						break;
 					case ARV_GVCP_COMMAND_READ_REGISTER_CMD:
-						*((gint32 *) buffer) =
-                                                        arv_gvcp_packet_get_read_register_ack_value (ack_packet, count);
+						for (i = 0; i < n_registers; i++)
+							((guint32 *) buffer)[i] =
+								arv_gvcp_packet_get_read_registers_ack_value (ack_packet,
+													      count, i);
 						break;
 					case ARV_GVCP_COMMAND_WRITE_REGISTER_CMD:
 						break;
@@ -334,7 +361,7 @@ _send_cmd_and_receive_ack (ArvGvDeviceIOData *io_data, ArvGvcpCommand command,
 			case ARV_GVCP_COMMAND_WRITE_MEMORY_CMD:
 				break;
 			case ARV_GVCP_COMMAND_READ_REGISTER_CMD:
-				*((guint32 *) buffer) = 0;
+				memset (buffer, 0, size);
 				break;
 			case ARV_GVCP_COMMAND_WRITE_REGISTER_CMD:
 				break;
@@ -342,7 +369,14 @@ _send_cmd_and_receive_ack (ArvGvDeviceIOData *io_data, ArvGvcpCommand command,
 				g_assert_not_reached ();
 		}
 
-                if (command_error != ARV_GVCP_ERROR_NONE)
+                if (command_error != ARV_GVCP_ERROR_NONE && n_registers > 1 &&
+                    (command == ARV_GVCP_COMMAND_READ_REGISTER_CMD ||
+                     command == ARV_GVCP_COMMAND_WRITE_REGISTER_CMD))
+                        g_set_error (error, ARV_DEVICE_ERROR, arv_gvcp_error_to_device_error (command_error),
+                                     "GigEVision %s error (%s) at register 0x%08x", operation,
+                                     arv_gvcp_error_to_string (command_error),
+                                     addresses[MIN (error_index, n_registers - 1)]);
+                else if (command_error != ARV_GVCP_ERROR_NONE)
                         g_set_error (error, ARV_DEVICE_ERROR, arv_gvcp_error_to_device_error (command_error),
                                      "GigEVision %s error (%s)", operation,
                                      arv_gvcp_error_to_string (command_error));
@@ -354,32 +388,308 @@ _send_cmd_and_receive_ack (ArvGvDeviceIOData *io_data, ArvGvcpCommand command,
 	return success;
 }
 
+/* Pipelined memory transfers */
+
+typedef struct {
+	ArvGvcpPacket *packet;
+	size_t packet_size;
+	guint16 packet_id;
+	guint32 offset;
+	guint32 size;
+	unsigned int n_retries;
+	gboolean in_flight;
+	gboolean timed_out;
+	gint64 timeout_stop_ms;
+} ArvGvDeviceGvcpRequest;
+
+static void
+_send_request (ArvGvDeviceIOData *io_data, ArvGvDeviceGvcpRequest *request, const char *operation)
+{
+	GError *local_error = NULL;
+
+	arv_gvcp_packet_debug (request->packet, ARV_DEBUG_LEVEL_TRACE);
+
+	/* A sending error is handled as a missing acknowledge */
+	if (g_socket_send_to (io_data->socket, io_data->device_address,
+			      (const char *) request->packet, request->packet_size,
+			      NULL, &local_error) < 0) {
+		arv_warning_device ("[GvDevice::%s] Command sending error: %s", operation, local_error->message);
+		g_clear_error (&local_error);
+	}
+
+	request->timeout_stop_ms = g_get_monotonic_time () / 1000 + io_data->gvcp_timeout_ms;
+	request->in_flight = TRUE;
+}
+
+static void
+_reduce_window (ArvGvDeviceIOData *io_data, const char *operation)
+{
+	if (io_data->gvcp_window > 1) {
+		io_data->gvcp_window = io_data->gvcp_window / 2;
+		arv_info_device ("[GvDevice::%s] Reduce GVCP window to %u", operation, io_data->gvcp_window);
+	}
+}
+
+/*
+ * Same as _send_cmd_and_receive_ack() for the memory commands, but with up to io_data->gvcp_window commands of
+ * ARV_GVCP_DATA_SIZE_MAX bytes in flight, matched to their acknowledges by packet id, and individually retried. The
+ * window is halved on each timeout or busy error, and grows by one each time a full window is acknowledged, up to
+ * io_data->gvcp_window_max. The commands which timed out or were rejected as busy are put aside, and sent again
+ * only when the reduced window allows it, the retry being counted at that point.
+ */
+
+static gboolean
+_send_cmds_and_receive_acks (ArvGvDeviceIOData *io_data, ArvGvcpCommand command,
+			     guint64 address, guint32 size, void *buffer, GError **error)
+{
+	ArvGvDeviceGvcpRequest requests[ARV_GV_DEVICE_GVCP_WINDOW_MAX];
+	ArvGvcpPacket *ack_packet = io_data->buffer;
+	ArvGvcpCommand expected_ack_command;
+	ArvGvcpError command_error = ARV_GVCP_ERROR_NONE;
+	const char *operation;
+	guint32 n_blocks;
+	guint32 next_block = 0;
+	guint32 n_done = 0;
+	guint n_requests = 0;
+	guint n_in_flight = 0;
+	guint n_window_acks = 0;
+	gboolean success = TRUE;
+	guint i;
+
+	switch (command) {
+		case ARV_GVCP_COMMAND_READ_MEMORY_CMD:
+			operation = "read_memory";
+			expected_ack_command = ARV_GVCP_COMMAND_READ_MEMORY_ACK;
+			break;
+		case ARV_GVCP_COMMAND_WRITE_MEMORY_CMD:
+			operation = "write_memory";
+			expected_ack_command = ARV_GVCP_COMMAND_WRITE_MEMORY_ACK;
+			break;
+		default:
+			g_assert_not_reached ();
+	}
+
+	n_blocks = (size + ARV_GVCP_DATA_SIZE_MAX - 1) / ARV_GVCP_DATA_SIZE_MAX;
+
+	g_mutex_lock (&io_data->mutex);
+
+	while (success && n_done < n_blocks) {
+		gint64 timeout_stop_ms = G_MAXINT64;
+		gint timeout_ms;
+
+		/* Send the commands put aside before the new ones */
+		for (i = 0; i < n_requests && n_in_flight < io_data->gvcp_window; i++) {
+			if (requests[i].in_flight)
+				continue;
+
+			if (requests[i].timed_out) {
+				requests[i].timed_out = FALSE;
+				if (++requests[i].n_retries >= io_data->gvcp_n_retries) {
+					success = FALSE;
+					break;
+				}
+			}
+
+			_send_request (io_data, &requests[i], operation);
+			n_in_flight++;
+		}
+
+		if (!success)
+			break;
+
+		while (n_in_flight < io_data->gvcp_window &&
+		       n_requests < ARV_GV_DEVICE_GVCP_WINDOW_MAX &&
+		       next_block < n_blocks) {
+			ArvGvDeviceGvcpRequest *request = &requests[n_requests];
+
+			io_data->packet_id = arv_gvcp_next_packet_id (io_data->packet_id);
+
+			request->packet_id = io_data->packet_id;
+			request->offset = next_block * ARV_GVCP_DATA_SIZE_MAX;
+			request->size = MIN (ARV_GVCP_DATA_SIZE_MAX, size - request->offset);
+			request->n_retries = 0;
+			request->timed_out = FALSE;
+
+			if (command == ARV_GVCP_COMMAND_READ_MEMORY_CMD)
+				request->packet = arv_gvcp_packet_new_read_memory_cmd (address + request->offset,
+										       request->size,
+										       request->packet_id,
+										       &request->packet_size);
+			else
+				request->packet = arv_gvcp_packet_new_write_memory_cmd (address + request->offset,
+											request->size,
+											((const char *) buffer) +
+											request->offset,
+											request->packet_id,
+											&request->packet_size);
+
+			_send_request (io_data, request, operation);
+
+			n_in_flight++;
+			n_requests++;
+			next_block++;
+		}
+
+		for (i = 0; i < n_requests; i++)
+			if (requests[i].in_flight)
+				timeout_stop_ms = MIN (timeout_stop_ms, requests[i].timeout_stop_ms);
+
+		timeout_ms = MAX (timeout_stop_ms - g_get_monotonic_time () / 1000, 0);
+
+		if (g_poll (&io_data->poll_in_event, 1, timeout_ms) > 0) {
+			GError *local_error = NULL;
+			ArvGvcpPacketType packet_type;
+			ArvGvcpCommand ack_command;
+			guint16 packet_id;
+			int count;
+
+			arv_gpollfd_clear_one (&io_data->poll_in_event, io_data->socket);
+			count = g_socket_receive (io_data->socket, io_data->buffer,
+						  ARV_GV_DEVICE_BUFFER_SIZE, NULL, &local_error);
+			if (count < (int) sizeof (ArvGvcpHeader)) {
+				if (local_error != NULL)
+					arv_warning_device ("[GvDevice::%s] Ack reception error: %s", operation,
+							    local_error->message);
+				g_clear_error (&local_error);
+				continue;
+			}
+
+			arv_gvcp_packet_debug (ack_packet, ARV_DEBUG_LEVEL_TRACE);
+
+			packet_type = arv_gvcp_packet_get_packet_type (ack_packet, count);
+			ack_command = arv_gvcp_packet_get_command (ack_packet, count);
+			packet_id = arv_gvcp_packet_get_packet_id (ack_packet, count);
+
+			for (i = 0; i < n_requests; i++)
+				if (requests[i].packet_id == packet_id)
+					break;
+
+			if (i == n_requests) {
+				/* Late acknowledge of a retried command */
+				arv_info_device ("[GvDevice::%s] Unexpected answer (0x%02x)", operation, packet_type);
+				continue;
+			}
+
+			if (ack_command == ARV_GVCP_COMMAND_PENDING_ACK &&
+			    count >= arv_gvcp_packet_get_pending_ack_size ()) {
+				gint64 pending_ack_timeout_ms = arv_gvcp_packet_get_pending_ack_timeout (ack_packet, count);
+
+				requests[i].timeout_stop_ms = g_get_monotonic_time () / 1000 + pending_ack_timeout_ms;
+
+				arv_debug_device ("[GvDevice::%s] Pending ack timeout = %" G_GINT64_FORMAT,
+						  operation, pending_ack_timeout_ms);
+			} else if (packet_type == ARV_GVCP_PACKET_TYPE_ERROR ||
+				   packet_type == ARV_GVCP_PACKET_TYPE_UNKNOWN_ERROR) {
+				if (ack_command != expected_ack_command) {
+					arv_info_device ("[GvDevice::%s] Unexpected answer (0x%02x)", operation, packet_type);
+					continue;
+				}
+
+				command_error = arv_gvcp_packet_get_packet_flags (ack_packet, count);
+				if (command_error == ARV_GVCP_ERROR_BUSY && !requests[i].in_flight) {
+					/* Late answer to a command already put aside */
+					command_error = ARV_GVCP_ERROR_NONE;
+				} else if (command_error == ARV_GVCP_ERROR_BUSY && n_in_flight > 1) {
+					/* The device does not accept that many outstanding commands, send this one again
+					 * once the window allows it */
+					command_error = ARV_GVCP_ERROR_NONE;
+					_reduce_window (io_data, operation);
+					n_window_acks = 0;
+					requests[i].in_flight = FALSE;
+					n_in_flight--;
+				} else
+					success = FALSE;
+			} else if (packet_type == ARV_GVCP_PACKET_TYPE_ACK &&
+				   ack_command == expected_ack_command &&
+				   count >= (command == ARV_GVCP_COMMAND_READ_MEMORY_CMD ?
+					     arv_gvcp_packet_get_read_memory_ack_size (requests[i].size) :
+					     arv_gvcp_packet_get_write_memory_ack_size ())) {
+				if (command == ARV_GVCP_COMMAND_READ_MEMORY_CMD)
+					memcpy (((char *) buffer) + requests[i].offset,
+						arv_gvcp_packet_get_read_memory_ack_data (ack_packet),
+						requests[i].size);
+
+				/* Late acknowledges of the commands put aside are valid too */
+				if (requests[i].in_flight)
+					n_in_flight--;
+				arv_gvcp_packet_free (requests[i].packet);
+				requests[i] = requests[--n_requests];
+				n_done++;
+
+				if (++n_window_acks >= io_data->gvcp_window) {
+					n_window_acks = 0;
+					if (io_data->gvcp_window < io_data->gvcp_window_max)
+						io_data->gvcp_window++;
+				}
+			} else
+				arv_info_device ("[GvDevice::%s] Unexpected answer (0x%02x)", operation, packet_type);
+		} else {
+			gint64 time_ms = g_get_monotonic_time () / 1000;
+
+			/* The timed out commands are sent again at the next iteration, within the reduced window */
+			for (i = 0; i < n_requests; i++) {
+				if (!requests[i].in_flight || requests[i].timeout_stop_ms > time_ms)
+					continue;
+
+				arv_warning_device ("[GvDevice::%s] Ack reception timeout", operation);
+
+				if (n_in_flight > 1)
+					_reduce_window (io_data, operation);
+				n_window_acks = 0;
+				requests[i].in_flight = FALSE;
+				requests[i].timed_out = TRUE;
+				n_in_flight--;
+			}
+		}
+	}
+
+	for (i = 0; i < n_requests; i++)
+		arv_gvcp_packet_free (requests[i].packet);
+
+	g_mutex_unlock (&io_data->mutex);
+
+	if (!success) {
+		if (command == ARV_GVCP_COMMAND_READ_MEMORY_CMD)
+			memset (buffer, 0, size);
+
+		if (command_error != ARV_GVCP_ERROR_NONE)
+			g_set_error (error, ARV_DEVICE_ERROR, arv_gvcp_error_to_device_error (command_error),
+				     "GigEVision %s error (%s)", operation,
+				     arv_gvcp_error_to_string (command_error));
+		else
+			g_set_error (error, ARV_DEVICE_ERROR, ARV_DEVICE_ERROR_TIMEOUT,
+				     "GigEVision %s timeout", operation);
+	}
+
+	return success;
+}
+
 static gboolean
 _read_memory (ArvGvDeviceIOData *io_data, guint64 address, guint32 size, void *buffer, GError **error)
 {
 	return _send_cmd_and_receive_ack (io_data, ARV_GVCP_COMMAND_READ_MEMORY_CMD,
-					  address, size, buffer, error);
+					  address, NULL, size, buffer, error);
 }
 
 static gboolean
 _write_memory (ArvGvDeviceIOData *io_data, guint64 address, guint32 size, void *buffer, GError **error)
 {
 	return  _send_cmd_and_receive_ack (io_data, ARV_GVCP_COMMAND_WRITE_MEMORY_CMD,
-					   address, size, buffer, error);
+					   address, NULL, size, buffer, error);
 }
 
 static gboolean
 _read_register (ArvGvDeviceIOData *io_data, guint32 address, guint32 *value_placeholder, GError **error)
 {
 	return _send_cmd_and_receive_ack (io_data, ARV_GVCP_COMMAND_READ_REGISTER_CMD,
-					  address, sizeof (guint32), value_placeholder, error);
+					  0, &address, sizeof (guint32), value_placeholder, error);
 }
 
 static gboolean
 _write_register (ArvGvDeviceIOData *io_data, guint32 address, guint32 value, GError **error)
 {
 	return _send_cmd_and_receive_ack (io_data, ARV_GVCP_COMMAND_WRITE_REGISTER_CMD,
-					  address, sizeof (guint32), &value, error);
+					  0, &address, sizeof (guint32), &value, error);
 }
 
 static gboolean
@@ -389,6 +699,18 @@ arv_gv_device_read_memory (ArvDevice *device, guint64 address, guint32 size, voi
 	int i;
 	gint32 block_size;
 
+	if (size > ARV_GVCP_DATA_SIZE_MAX && priv->io_data->gvcp_window_max > 1) {
+		for (i = 0; i < (size + ARV_GV_DEVICE_GVCP_SEGMENT_SIZE - 1) / ARV_GV_DEVICE_GVCP_SEGMENT_SIZE; i++) {
+			block_size = MIN (ARV_GV_DEVICE_GVCP_SEGMENT_SIZE, size - i * ARV_GV_DEVICE_GVCP_SEGMENT_SIZE);
+			if (!_send_cmds_and_receive_acks (priv->io_data, ARV_GVCP_COMMAND_READ_MEMORY_CMD,
+							  address + i * ARV_GV_DEVICE_GVCP_SEGMENT_SIZE, block_size,
+							  ((char *) buffer) + i * ARV_GV_DEVICE_GVCP_SEGMENT_SIZE, error))
+				return FALSE;
+		}
+
+		return TRUE;
+	}
+
 	for (i = 0; i < (size + ARV_GVCP_DATA_SIZE_MAX - 1) / ARV_GVCP_DATA_SIZE_MAX; i++) {
 		block_size = MIN (ARV_GVCP_DATA_SIZE_MAX, size - i * ARV_GVCP_DATA_SIZE_MAX);
 		if (!_read_memory (priv->io_data,
@@ -407,6 +729,18 @@ arv_gv_device_write_memory (ArvDevice *device, guint64 address, guint32 size, co
 	int i;
 	gint32 block_size;
 
+	if (size > ARV_GVCP_DATA_SIZE_MAX && priv->io_data->gvcp_window_max > 1) {
+		for (i = 0; i < (size + ARV_GV_DEVICE_GVCP_SEGMENT_SIZE - 1) / ARV_GV_DEVICE_GVCP_SEGMENT_SIZE; i++) {
+			block_size = MIN (ARV_GV_DEVICE_GVCP_SEGMENT_SIZE, size - i * ARV_GV_DEVICE_GVCP_SEGMENT_SIZE);
+			if (!_send_cmds_and_receive_acks (priv->io_data, ARV_GVCP_COMMAND_WRITE_MEMORY_CMD,
+							  address + i * ARV_GV_DEVICE_GVCP_SEGMENT_SIZE, block_size,
+							  ((char *) buffer) + i * ARV_GV_DEVICE_GVCP_SEGMENT_SIZE, error))
+				return FALSE;
+		}
+
+		return TRUE;
+	}
+
 	for (i = 0; i < (size + ARV_GVCP_DATA_SIZE_MAX - 1) / ARV_GVCP_DATA_SIZE_MAX; i++) {
 		block_size = MIN (ARV_GVCP_DATA_SIZE_MAX, size - i * ARV_GVCP_DATA_SIZE_MAX);
 		if (!_write_memory (priv->io_data,
@@ -434,6 +768,50 @@ arv_gv_device_write_register (ArvDevice *device, guint64 address, guint32 value,
 	return _write_register (priv->io_data, address, value, error);
 }
 
+static gboolean
+arv_gv_device_read_registers (ArvDevice *device, guint n_registers, const guint64 *addresses, guint32 *values,
+			      GError **error)
+{
+	ArvGvDevicePrivate *priv = arv_gv_device_get_instance_private (ARV_GV_DEVICE (device));
+	guint32 gvcp_addresses[ARV_GVCP_N_READ_REGISTERS_MAX];
+	guint n_registers_max = priv->is_concatenation_supported ? ARV_GVCP_N_READ_REGISTERS_MAX : 1;
+	guint i, j, n;
+
+	for (i = 0; i < n_registers; i += n) {
+		n = MIN (n_registers_max, n_registers - i);
+		for (j = 0; j < n; j++)
+			gvcp_addresses[j] = addresses[i + j];
+		if (!_send_cmd_and_receive_ack (priv->io_data, ARV_GVCP_COMMAND_READ_REGISTER_CMD,
+						0, gvcp_addresses, n * sizeof (guint32), &values[i], error)) {
+			memset (&values[i], 0, (n_registers - i) * sizeof (guint32));
+			return FALSE;
+		}
+	}
+
+	return TRUE;
+}
+
+static gboolean
+arv_gv_device_write_registers (ArvDevice *device, guint n_registers, const guint64 *addresses,
+			       const guint32 *values, GError **error)
+{
+	ArvGvDevicePrivate *priv = arv_gv_device_get_instance_private (ARV_GV_DEVICE (device));
+	guint32 gvcp_addresses[ARV_GVCP_N_WRITE_REGISTERS_MAX];
+	guint n_registers_max = priv->is_concatenation_supported ? ARV_GVCP_N_WRITE_REGISTERS_MAX : 1;
+	guint i, j, n;
+
+	for (i = 0; i < n_registers; i += n) {
+		n = MIN (n_registers_max, n_registers - i);
+		for (j = 0; j < n; j++)
+			gvcp_addresses[j] = addresses[i + j];
+		if (!_send_cmd_and_receive_ack (priv->io_data, ARV_GVCP_COMMAND_WRITE_REGISTER_CMD,
+						0, gvcp_addresses, n * sizeof (guint32), (void *) &values[i], error))
+			return FALSE;
+	}
+
+	return TRUE;
+}
+
 /* Heartbeat thread */
 
 typedef struct {
@@ -441,14 +819,52 @@ typedef struct {
 	ArvGvDeviceIOData *io_data;
 	int period_us;
 
+	ArvClockModel *clock_model;
+	guint64 timestamp_tick_frequency;
+	gboolean is_timestamp_latch_supported;
+
 	GCancellable *cancellable;
 } ArvGvDeviceHeartbeatData;
 
+static void
+_latch_timestamp (ArvGvDeviceHeartbeatData *thread_data)
+{
+	ArvGvDeviceIOData *io_data = thread_data->io_data;
+	GError *error = NULL;
+	guint32 timestamp_high;
+	guint32 timestamp_low;
+	gint64 before_ns;
+	gint64 after_ns;
+
+	/* The device latches its timestamp counter somewhere between the write command and its acknowledge */
+	before_ns = g_get_monotonic_time () * 1000LL;
+	if (!_write_register (io_data, ARV_GVBS_TIMESTAMP_CONTROL_OFFSET, ARV_GVBS_TIMESTAMP_CONTROL_LATCH, &error)) {
+		if (!g_error_matches (error, ARV_DEVICE_ERROR, ARV_DEVICE_ERROR_TIMEOUT)) {
+			arv_info_device ("[GvDevice::Heartbeat] Timestamp latch not supported (%s), "
+					 "clock synchronization will only use the frame arrival times", error->message);
+			thread_data->is_timestamp_latch_supported = FALSE;
+		}
+		g_clear_error (&error);
+		return;
+	}
+	after_ns = g_get_monotonic_time () * 1000LL;
+
+	if (!_read_register (io_data, ARV_GVBS_TIMESTAMP_LATCHED_VALUE_HIGH_OFFSET, &timestamp_high, NULL) ||
+	    !_read_register (io_data, ARV_GVBS_TIMESTAMP_LATCHED_VALUE_LOW_OFFSET, &timestamp_low, NULL))
+		return;
+
+	arv_clock_model_add_latch_sample (thread_data->clock_model,
+					  arv_gvsp_timestamp_to_ns (((guint64) timestamp_high << 32) | timestamp_low,
+								    thread_data->timestamp_tick_frequency),
+					  before_ns, after_ns);
+}
+
 static void *
 arv_gv_device_heartbeat_thread (void *data)
 {
 	ArvGvDeviceHeartbeatData *thread_data = data;
 	ArvGvDeviceIOData *io_data = thread_data->io_data;
+	ArvGvDevicePrivate *priv = arv_gv_device_get_instance_private (thread_data->gv_device);
 	GPollFD poll_fd;
 	gboolean use_poll;
 	GTimer *timer;
@@ -497,6 +913,12 @@ arv_gv_device_heartbeat_thread (void *data)
 			} else
 				io_data->is_controller = FALSE;
 		}
+
+		if (io_data->is_controller &&
+		    thread_data->is_timestamp_latch_supported &&
+		    g_atomic_int_get (&priv->clock_synchronization) &&
+		    !g_cancellable_is_cancelled (thread_data->cancellable))
+			_latch_timestamp (thread_data);
 	} while (!g_cancellable_is_cancelled (thread_data->cancellable));
 
 	if (use_poll)
@@ -825,6 +1247,59 @@ arv_gv_device_set_packet_size_adjustment (ArvGvDevice *gv_device, ArvGvPacketSiz
 	priv->packet_size_adjustment = adjustment;
 }
 
+/**
+ * arv_gv_device_set_clock_synchronization:
+ * @gv_device: a #ArvGvDevice
+ * @enable: enable the periodic timestamp latch
+ *
+ * The device timestamps are mapped to the host monotonic clock by a model of the offset and of the drift between
+ * the two clocks, see arv_buffer_get_host_timestamp(). By default, this model is only fitted on the frame arrival
+ * times, which include the transmission latency. When enabled, the device timestamp counter is also latched at each
+ * heartbeat, using the GevTimestampControlLatch register, which gives a much more accurate model. The latch requires
+ * the control access to the device.
+ *
+ * Since: 0.10.0
+ */
+
+void
+arv_gv_device_set_clock_synchronization (ArvGvDevice *gv_device, gboolean enable)
+{
+	ArvGvDevicePrivate *priv = arv_gv_device_get_instance_private (gv_device);
+
+	g_return_if_fail (ARV_IS_GV_DEVICE (gv_device));
+
+	g_atomic_int_set (&priv->clock_synchronization, enable ? TRUE : FALSE);
+}
+
+/**
+ * arv_gv_device_get_clock_synchronization:
+ * @gv_device: a #ArvGvDevice
+ *
+ * Returns: whether the device timestamp counter is periodically latched for the clock synchronization
+ *
+ * Since: 0.10.0
+ */
+
+gboolean
+arv_gv_device_get_clock_synchronization (ArvGvDevice *gv_device)
+{
+	ArvGvDevicePrivate *priv = arv_gv_device_get_instance_private (gv_device);
+
+	g_return_val_if_fail (ARV_IS_GV_DEVICE (gv_device), FALSE);
+
+	return g_atomic_int_get (&priv->clock_synchronization);
+}
+
+ArvClockModel *
+arv_gv_device_get_clock_model (ArvGvDevice *gv_device)
+{
+	ArvGvDevicePrivate *priv = arv_gv_device_get_instance_private (gv_device);
+
+	g_return_val_if_fail (ARV_IS_GV_DEVICE (gv_device), NULL);
+
+	return priv->clock_model;
+}
+
 /**
  * arv_gv_device_get_current_ip:
  * @gv_device: a #ArvGvDevice
@@ -2031,6 +2506,8 @@ arv_gv_device_constructed (GObject *object)
 	io_data->buffer = g_malloc (ARV_GV_DEVICE_BUFFER_SIZE);
 	io_data->gvcp_n_retries = ARV_GV_DEVICE_GVCP_N_RETRIES_DEFAULT;
 	io_data->gvcp_timeout_ms = ARV_GV_DEVICE_GVCP_TIMEOUT_MS_DEFAULT;
+	io_data->gvcp_window = priv->gvcp_window;
+	io_data->gvcp_window_max = priv->gvcp_window;
 	io_data->poll_in_event.fd = g_socket_get_fd (io_data->socket);
 	io_data->poll_in_event.events =  G_IO_IN;
 	io_data->poll_in_event.revents = 0;
@@ -2059,6 +2536,9 @@ arv_gv_device_constructed (GObject *object)
 	heartbeat_data->gv_device = gv_device;
 	heartbeat_data->io_data = io_data;
 	heartbeat_data->period_us = ARV_GV_DEVICE_HEARTBEAT_PERIOD_US;
+	heartbeat_data->clock_model = priv->clock_model;
+	heartbeat_data->timestamp_tick_frequency = arv_gv_device_get_timestamp_tick_frequency (gv_device, NULL);
+	heartbeat_data->is_timestamp_latch_supported = heartbeat_data->timestamp_tick_frequency != 0;
 	heartbeat_data->cancellable = g_cancellable_new ();
 
 	priv->heartbeat_data = heartbeat_data;
@@ -2071,10 +2551,12 @@ arv_gv_device_constructed (GObject *object)
 	arv_gv_device_read_register (ARV_DEVICE (gv_device), ARV_GVBS_GVCP_CAPABILITY_OFFSET, &capabilities, NULL);
 	priv->is_packet_resend_supported = (capabilities & ARV_GVBS_GVCP_CAPABILITY_PACKET_RESEND) != 0;
 	priv->is_write_memory_supported = (capabilities & ARV_GVBS_GVCP_CAPABILITY_WRITE_MEMORY) != 0;
+	priv->is_concatenation_supported = (capabilities & ARV_GVBS_GVCP_CAPABILITY_CONCATENATION) != 0;
 
 	arv_info_device ("[GvDevice::new] Device endianness = %s", priv->is_big_endian_device ? "big" : "little");
 	arv_info_device ("[GvDevice::new] Packet resend     = %s", priv->is_packet_resend_supported ? "yes" : "no");
 	arv_info_device ("[GvDevice::new] Write memory      = %s", priv->is_write_memory_supported ? "yes" : "no");
+	arv_info_device ("[GvDevice::new] Concatenation     = %s", priv->is_concatenation_supported ? "yes" : "no");
 
 	document = ARV_DOM_DOCUMENT (priv->genicam);
 	register_description = ARV_GC_REGISTER_DESCRIPTION_NODE (arv_dom_document_get_document_element (document));
@@ -2094,6 +2576,8 @@ arv_gv_device_init (ArvGvDevice *gv_device)
 	priv->genicam_xml = NULL;
 	priv->genicam_xml_size = 0;
 	priv->stream_options = ARV_GV_STREAM_OPTION_NONE;
+	priv->clock_model = arv_clock_model_new ();
+	priv->clock_synchronization = FALSE;
 }
 
 static void
@@ -2137,6 +2621,8 @@ arv_gv_device_finalize (GObject *object)
 	g_clear_object (&priv->genicam);
 	g_clear_pointer (&priv->genicam_xml, g_free);
 
+	g_clear_pointer (&priv->clock_model, arv_clock_model_free);
+
 	g_clear_object (&priv->interface_address);
 	g_clear_object (&priv->device_address);
 
@@ -2193,6 +2679,9 @@ arv_gv_device_set_property (GObject *self, guint prop_id, const GValue *value, G
 		case PROP_GV_DEVICE_PACKET_SIZE_ADJUSTEMENT:
 			priv->packet_size_adjustment = g_value_get_enum (value);
 			break;
+		case PROP_GV_DEVICE_GVCP_WINDOW:
+			priv->gvcp_window = g_value_get_uint (value);
+			break;
 		default:
 			G_OBJECT_WARN_INVALID_PROPERTY_ID (self, prop_id, pspec);
 			break;
@@ -2208,6 +2697,9 @@ arv_gv_device_get_property (GObject *object, guint prop_id, GValue *value, GPara
 		case PROP_GV_DEVICE_PACKET_SIZE_ADJUSTEMENT:
 			g_value_set_enum (value, priv->packet_size_adjustment);
 			break;
+		case PROP_GV_DEVICE_GVCP_WINDOW:
+			g_value_set_uint (value, priv->gvcp_window);
+			break;
 		default:
 			G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
 			break;
@@ -2232,6 +2724,8 @@ arv_gv_device_class_init (ArvGvDeviceClass *gv_device_class)
 	device_class->write_memory = arv_gv_device_write_memory;
 	device_class->read_register = arv_gv_device_read_register;
 	device_class->write_register = arv_gv_device_write_register;
+	device_class->read_registers = arv_gv_device_read_registers;
+	device_class->write_registers = arv_gv_device_write_registers;
 
 	g_object_class_install_property
 		(object_class,
@@ -2256,4 +2750,21 @@ arv_gv_device_class_init (ArvGvDeviceClass *gv_device_class)
 							    ARV_GV_PACKET_SIZE_ADJUSTMENT_DEFAULT,
 							    G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
 								G_PARAM_CONSTRUCT));
+
+	/**
+	 * ArvGvDevice:gvcp-window:
+	 *
+	 * Maximum number of GVCP commands in flight during the memory transfers larger than a single command, like
+	 * the Genicam data loading. A value of 1 restores the one command at a time transfers.
+	 *
+	 * Since: 0.10.0
+	 */
+
+	g_object_class_install_property (object_class, PROP_GV_DEVICE_GVCP_WINDOW,
+					 g_param_spec_uint ("gvcp-window", "GVCP window",
+							    "Maximum number of outstanding GVCP commands",
+							    1, ARV_GV_DEVICE_GVCP_WINDOW_MAX,
+							    ARV_GV_DEVICE_GVCP_WINDOW_DEFAULT,
+							    G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+								G_PARAM_CONSTRUCT_ONLY));
 }
@@ -87,6 +87,9 @@ ARV_API void			arv_gv_device_set_packet_size_adjustment	(ArvGvDevice *gv_device,
 										 ArvGvPacketSizeAdjustment adjustment);
 ARV_API guint			arv_gv_device_auto_packet_size			(ArvGvDevice *gv_device, GError **error);
 
+ARV_API void			arv_gv_device_set_clock_synchronization		(ArvGvDevice *gv_device, gboolean enable);
+ARV_API gboolean		arv_gv_device_get_clock_synchronization		(ArvGvDevice *gv_device);
+
 ARV_API ArvGvStreamOption	arv_gv_device_get_stream_options		(ArvGvDevice *gv_device);
 ARV_API void			arv_gv_device_set_stream_options		(ArvGvDevice *gv_device,
                                                                                  ArvGvStreamOption options);
@@ -28,6 +28,7 @@
 #endif
 
 #include <arvgvdevice.h>
+#include <arvclockmodelprivate.h>
 
 G_BEGIN_DECLS
 
@@ -47,11 +48,21 @@ G_BEGIN_DECLS
 
 #define ARV_GV_DEVICE_GVSP_PACKET_SIZE_DEFAULT	1500
 
+/* Maximum number of outstanding GVCP commands during the bulk memory transfers. The window is reduced on a
+ * timeout or a busy error, for the devices processing a single command at a time. */
+#define ARV_GV_DEVICE_GVCP_WINDOW_DEFAULT	8
+#define ARV_GV_DEVICE_GVCP_WINDOW_MAX		32
+/* Bulk transfers are split in segments of 64 commands, in order to let the heartbeat thread access the control
+ * channel */
+#define ARV_GV_DEVICE_GVCP_SEGMENT_SIZE		(64 * 512)
+
 #define ARV_GV_DEVICE_BUFFER_SIZE	1024
 
 GRegex * 		arv_gv_device_get_url_regex 			(void);
 void                    arv_gc_set_default_gv_features                  (ArvGc *genicam);
 
+ArvClockModel *		arv_gv_device_get_clock_model			(ArvGvDevice *gv_device);
+
 G_END_DECLS
 
 #endif
@@ -52,9 +52,20 @@ enum
   PROP_SERIAL_NUMBER,
   PROP_GENICAM_FILENAME,
   PROP_GVSP_LOST_PACKET_RATIO,
+  PROP_GVSP_LOST_BURST_LENGTH,
+  PROP_GVCP_LATENCY,
+  PROP_GVCP_N_PENDING_MAX,
   PROP_CM_DOMAIN
 };
 
+typedef struct {
+	GSocket *socket;
+	GSocketAddress *remote_address;
+	ArvGvcpPacket *packet;
+	size_t size;
+	gint64 time_us;
+} ArvGvFakeCameraDelayedAck;
+
 typedef struct {
 	char *interface_name;
 	char *serial_number;
@@ -78,6 +89,12 @@ typedef struct {
 	gboolean cancel;
 
 	double gvsp_lost_packet_ratio;
+	guint gvsp_lost_burst_length;
+	guint gvsp_n_burst_packets;
+
+	guint gvcp_latency_us;
+	guint gvcp_n_pending_max;
+	GQueue delayed_acks;
 } ArvGvFakeCameraPrivate;
 
 struct _ArvGvFakeCamera {
@@ -106,6 +123,56 @@ _g_inet_socket_address_is_equal (GInetSocketAddress *a, GInetSocketAddress *b)
 				     g_inet_socket_address_get_address (b));
 }
 
+static void
+_delayed_ack_free (ArvGvFakeCameraDelayedAck *delayed_ack)
+{
+	g_object_unref (delayed_ack->socket);
+	g_object_unref (delayed_ack->remote_address);
+	g_free (delayed_ack->packet);
+	g_free (delayed_ack);
+}
+
+/* Sends the acknowledges whose simulated latency has elapsed, and returns the time of the next one, or -1 */
+
+/* Data packets are lost by bursts of gvsp_lost_burst_length packets */
+
+static gboolean
+_is_data_packet_lost (ArvGvFakeCamera *gv_fake_camera)
+{
+	ArvGvFakeCameraPrivate *priv = gv_fake_camera->priv;
+
+	if (priv->gvsp_n_burst_packets > 0) {
+		priv->gvsp_n_burst_packets--;
+		return TRUE;
+	}
+
+	if (g_random_double () >= priv->gvsp_lost_packet_ratio)
+		return FALSE;
+
+	priv->gvsp_n_burst_packets = priv->gvsp_lost_burst_length > 0 ? priv->gvsp_lost_burst_length - 1 : 0;
+
+	return TRUE;
+}
+
+static gint64
+_send_delayed_acks (ArvGvFakeCamera *gv_fake_camera)
+{
+	ArvGvFakeCameraDelayedAck *delayed_ack;
+	gint64 time_us = g_get_monotonic_time ();
+
+	while ((delayed_ack = g_queue_peek_head (&gv_fake_camera->priv->delayed_acks)) != NULL) {
+		if (delayed_ack->time_us > time_us)
+			return delayed_ack->time_us;
+
+		g_queue_pop_head (&gv_fake_camera->priv->delayed_acks);
+		g_socket_send_to (delayed_ack->socket, delayed_ack->remote_address,
+				  (char *) delayed_ack->packet, delayed_ack->size, NULL, NULL);
+		_delayed_ack_free (delayed_ack);
+	}
+
+	return -1;
+}
+
 static gboolean
 _handle_control_packet (ArvGvFakeCamera *gv_fake_camera, GSocket *socket,
 			GSocketAddress *remote_address,
@@ -119,6 +186,9 @@ _handle_control_packet (ArvGvFakeCamera *gv_fake_camera, GSocket *socket,
 	guint16 packet_type;
 	guint32 register_address;
 	guint32 register_value;
+	guint32 register_values[ARV_GVCP_N_READ_REGISTERS_MAX];
+	guint n_registers;
+	guint i;
 	gboolean write_access;
 	gboolean success = FALSE;
 
@@ -146,6 +216,13 @@ _handle_control_packet (ArvGvFakeCamera *gv_fake_camera, GSocket *socket,
 
 	arv_gvcp_packet_debug (packet, ARV_DEBUG_LEVEL_DEBUG);
 
+	/* Commands received while too many acknowledges are still on their way are lost */
+	if (gv_fake_camera->priv->gvcp_n_pending_max > 0 &&
+	    g_queue_get_length (&gv_fake_camera->priv->delayed_acks) >= gv_fake_camera->priv->gvcp_n_pending_max) {
+		arv_info_device ("[GvFakeCamera::handle_control_packet] Too many pending commands, drop packet");
+		return FALSE;
+	}
+
 	packet_id = arv_gvcp_packet_get_packet_id (packet, size);
 	packet_type = arv_gvcp_packet_get_packet_type (packet, size);
 
@@ -187,30 +264,55 @@ _handle_control_packet (ArvGvFakeCamera *gv_fake_camera, GSocket *socket,
 									   &ack_packet_size);
 			break;
 		case ARV_GVCP_COMMAND_READ_REGISTER_CMD:
-			arv_gvcp_packet_get_read_register_cmd_infos (packet, size, &register_address);
-			arv_fake_camera_read_register (gv_fake_camera->priv->camera, register_address, &register_value);
-			arv_info_device ("[GvFakeCamera::handle_control_packet] Read register command %d -> %d",
-					  register_address, register_value);
-			ack_packet = arv_gvcp_packet_new_read_register_ack (register_value, packet_id,
-									    &ack_packet_size);
+			n_registers = arv_gvcp_packet_get_read_registers_cmd_n_addresses (packet, size);
+			if (n_registers < 1 || n_registers > ARV_GVCP_N_READ_REGISTERS_MAX) {
+				arv_warning_device ("[GvFakeCamera::handle_control_packet]"
+						    " Invalid read register command size (%u)", n_registers);
+				break;
+			}
 
-			if (register_address == ARV_GVBS_CONTROL_CHANNEL_PRIVILEGE_OFFSET)
-				gv_fake_camera->priv->controller_time = g_get_real_time ();
+			for (i = 0; i < n_registers; i++) {
+				register_address = arv_gvcp_packet_get_read_registers_cmd_address (packet, size, i);
+				arv_fake_camera_read_register (gv_fake_camera->priv->camera, register_address,
+							       &register_values[i]);
+				arv_info_device ("[GvFakeCamera::handle_control_packet] Read register command %d -> %d",
+						  register_address, register_values[i]);
 
+				if (register_address == ARV_GVBS_CONTROL_CHANNEL_PRIVILEGE_OFFSET)
+					gv_fake_camera->priv->controller_time = g_get_real_time ();
+			}
+
+			ack_packet = arv_gvcp_packet_new_read_registers_ack (register_values, n_registers, packet_id,
+									     &ack_packet_size);
 			break;
 		case ARV_GVCP_COMMAND_WRITE_REGISTER_CMD:
-			arv_gvcp_packet_get_write_register_cmd_infos (packet, size, &register_address, &register_value);
+			n_registers = arv_gvcp_packet_get_write_registers_cmd_n_registers (packet, size);
+			if (n_registers < 1 || n_registers > ARV_GVCP_N_WRITE_REGISTERS_MAX) {
+				arv_warning_device ("[GvFakeCamera::handle_control_packet]"
+						    " Invalid write register command size (%u)", n_registers);
+				break;
+			}
+
 			if (!write_access) {
+				arv_gvcp_packet_get_write_registers_cmd_infos (packet, size, 0,
+									       &register_address, &register_value);
 				arv_warning_device("[GvFakeCamera::handle_control_packet]"
                                                    " Ignore Write register command %d (%d) not controller",
 					register_address, register_value);
 				break;
 			}
 
-			arv_fake_camera_write_register (gv_fake_camera->priv->camera, register_address, register_value);
-			arv_info_device ("[GvFakeCamera::handle_control_packet] Write register command %d -> %d",
-					  register_address, register_value);
-			ack_packet = arv_gvcp_packet_new_write_register_ack (1, packet_id,
+			/* Registers are written in order, as required by the specification */
+			for (i = 0; i < n_registers; i++) {
+				arv_gvcp_packet_get_write_registers_cmd_infos (packet, size, i,
+									       &register_address, &register_value);
+				arv_fake_camera_write_register (gv_fake_camera->priv->camera, register_address,
+								register_value);
+				arv_info_device ("[GvFakeCamera::handle_control_packet] Write register command %d -> %d",
+						  register_address, register_value);
+			}
+
+			ack_packet = arv_gvcp_packet_new_write_register_ack (n_registers, packet_id,
 									     &ack_packet_size);
 			break;
 		default:
@@ -218,9 +320,22 @@ _handle_control_packet (ArvGvFakeCamera *gv_fake_camera, GSocket *socket,
 	}
 
 	if (ack_packet != NULL) {
-		g_socket_send_to (socket, remote_address, (char *) ack_packet, ack_packet_size, NULL, NULL);
 		arv_gvcp_packet_debug (ack_packet, ARV_DEBUG_LEVEL_DEBUG);
-		g_free (ack_packet);
+
+		if (gv_fake_camera->priv->gvcp_latency_us > 0) {
+			ArvGvFakeCameraDelayedAck *delayed_ack = g_new (ArvGvFakeCameraDelayedAck, 1);
+
+			/* The commands are still processed immediately, only the network round trip is simulated */
+			delayed_ack->socket = g_object_ref (socket);
+			delayed_ack->remote_address = g_object_ref (remote_address);
+			delayed_ack->packet = ack_packet;
+			delayed_ack->size = ack_packet_size;
+			delayed_ack->time_us = g_get_monotonic_time () + gv_fake_camera->priv->gvcp_latency_us;
+			g_queue_push_tail (&gv_fake_camera->priv->delayed_acks, delayed_ack);
+		} else {
+			g_socket_send_to (socket, remote_address, (char *) ack_packet, ack_packet_size, NULL, NULL);
+			g_free (ack_packet);
+		}
 
 		success = TRUE;
 	}
@@ -275,13 +390,18 @@ _thread (void *user_data)
 		}
 
 		do {
+			gint64 next_ack_time_us;
 			gint timeout_ms;
 
+			next_ack_time_us = _send_delayed_acks (gv_fake_camera);
+
 			timeout_ms =  (next_timestamp_us - g_get_real_time ()) / 1000LL;
 			if (timeout_ms < 0)
 				timeout_ms = 0;
 			else if (timeout_ms > 100)
 				timeout_ms = 100;
+			if (next_ack_time_us >= 0)
+				timeout_ms = MIN (timeout_ms, (next_ack_time_us - g_get_monotonic_time () + 999) / 1000);
 
 			n_events = g_poll (gv_fake_camera->priv->socket_fds, gv_fake_camera->priv->n_socket_fds, timeout_ms);
 			if (n_events > 0) {
@@ -397,7 +517,7 @@ _thread (void *user_data)
                                                                      packet_buffer, ARV_GV_FAKE_CAMERA_BUFFER_SIZE,
                                                                      &packet_size);
 
-					if (g_random_double () >= gv_fake_camera->priv->gvsp_lost_packet_ratio)
+					if (!_is_data_packet_lost (gv_fake_camera))
 						g_socket_send_to (gv_fake_camera->priv->gvsp_socket, stream_address,
 								packet_buffer, packet_size, NULL, &error);
 					else
@@ -593,6 +713,8 @@ arv_gv_fake_camera_stop (ArvGvFakeCamera *gv_fake_camera)
 		gv_fake_camera->priv->thread = NULL;
 	}
 
+	g_queue_clear_full (&gv_fake_camera->priv->delayed_acks, (GDestroyNotify) _delayed_ack_free);
+
 	arv_gpollfd_finish_all (gv_fake_camera->priv->socket_fds, gv_fake_camera->priv->n_socket_fds);
 
 	for (i = 0; i < ARV_GV_FAKE_CAMERA_N_INPUT_SOCKETS; i++) {
@@ -664,6 +786,15 @@ _set_property (GObject *object, guint prop_id, const GValue *value, GParamSpec *
 		case PROP_GVSP_LOST_PACKET_RATIO:
 			gv_fake_camera->priv->gvsp_lost_packet_ratio = g_value_get_double (value);
 			break;
+		case PROP_GVSP_LOST_BURST_LENGTH:
+			gv_fake_camera->priv->gvsp_lost_burst_length = g_value_get_uint (value);
+			break;
+		case PROP_GVCP_LATENCY:
+			gv_fake_camera->priv->gvcp_latency_us = g_value_get_uint (value);
+			break;
+		case PROP_GVCP_N_PENDING_MAX:
+			gv_fake_camera->priv->gvcp_n_pending_max = g_value_get_uint (value);
+			break;
 		default:
 			G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
 			break;
@@ -786,4 +917,32 @@ arv_gv_fake_camera_class_init (ArvGvFakeCameraClass *this_class)
 							      G_PARAM_WRITABLE | G_PARAM_CONSTRUCT |
 							      G_PARAM_STATIC_NAME | G_PARAM_STATIC_NICK |
 							      G_PARAM_STATIC_BLURB));
+	g_object_class_install_property (object_class,
+					 PROP_GVSP_LOST_BURST_LENGTH,
+					 g_param_spec_uint ("gvsp-lost-burst-length",
+							    "GVSP lost burst length",
+							    "Number of consecutive data packets lost at each GVSP data packet loss",
+							    1, G_MAXUINT, 1,
+							    G_PARAM_WRITABLE | G_PARAM_CONSTRUCT |
+							    G_PARAM_STATIC_NAME | G_PARAM_STATIC_NICK |
+							    G_PARAM_STATIC_BLURB));
+	g_object_class_install_property (object_class,
+					 PROP_GVCP_LATENCY,
+					 g_param_spec_uint ("gvcp-latency",
+							    "GVCP latency",
+							    "Simulated GVCP round trip time, in µs",
+							    0, G_MAXUINT, 0,
+							    G_PARAM_WRITABLE | G_PARAM_CONSTRUCT |
+							    G_PARAM_STATIC_NAME | G_PARAM_STATIC_NICK |
+							    G_PARAM_STATIC_BLURB));
+	g_object_class_install_property (object_class,
+					 PROP_GVCP_N_PENDING_MAX,
+					 g_param_spec_uint ("gvcp-n-pending-max",
+							    "GVCP pending commands",
+							    "Maximum number of commands waiting for their simulated round trip, "
+							    "the others being dropped, 0 for no limit",
+							    0, G_MAXUINT, 0,
+							    G_PARAM_WRITABLE | G_PARAM_CONSTRUCT |
+							    G_PARAM_STATIC_NAME | G_PARAM_STATIC_NICK |
+							    G_PARAM_STATIC_BLURB));
 }
@@ -45,7 +45,7 @@
 #include <stdio.h>
 #include <errno.h>
 
-#if ARAVIS_HAS_PACKET_SOCKET
+#if ARAVIS_HAS_PACKET_SOCKET || ARAVIS_HAS_XDP
 #include <ifaddrs.h>
 #include <netinet/udp.h>
 #include <net/if.h>
@@ -56,11 +56,43 @@
 #include <linux/filter.h>
 #include <sys/types.h>
 #include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#if ARAVIS_HAS_XDP
+#include <linux/if_xdp.h>
+#include <linux/if_link.h>
+#include <linux/bpf.h>
+#include <sys/syscall.h>
+#include <sys/socket.h>
+#endif
+
+#ifdef __linux__
+#include <sys/socket.h>
+#include <linux/filter.h>
+#endif
+
+/* Multiple sockets bound to the stream port need SO_REUSEPORT, and a socket selection program */
+#if defined (SO_REUSEPORT) && defined (SO_ATTACH_REUSEPORT_CBPF)
+#define ARV_GV_STREAM_HAS_REUSEPORT	1
+#else
+#define ARV_GV_STREAM_HAS_REUSEPORT	0
 #endif
 
 #define ARV_GV_STREAM_DISCARD_LATE_FRAME_THRESHOLD	100
 #define ARV_GV_STREAM_BUFFER_SIZE_PROTOCOL_OVERHEAD     1024 /* Some room for protocol overhead (IP + UDP + GV) */
 #define ARV_GV_STREAM_MIN_BUFFER_SIZE                   20 * 1024
+#define ARV_GV_STREAM_WORKER_RING_SIZE                  1024 /* Must be a power of 2 */
+#define ARV_GV_STREAM_WORKER_PACKET_RANGE               16   /* Number of consecutive packets handled by a worker */
+#define ARV_GV_STREAM_SOCKET_PACKET_RANGE_SHIFT         4    /* 16 consecutive packets are received by the same socket */
+#define ARV_GV_STREAM_FRAME_WINDOW                      64   /* Maximum number of frames in flight, must be a power of 2 */
+#define ARV_GV_STREAM_N_PREALLOCATED_FRAMES             4
+#define ARV_GV_STREAM_OUTPUT_BATCH_SIZE                 32   /* Completed buffers pushed to the output queue at once */
+#define ARV_GV_STREAM_RING_DURATION_US                  100000    /* Stream duration an auto sized ring can hold */
+#define ARV_GV_STREAM_RING_SIZE_MIN                     (1 << 20)
+#define ARV_GV_STREAM_RING_SIZE_MAX                     (1 << 29)
+#define ARV_GV_STREAM_RING_BLOCK_SIZE_MAX               (1 << 22)
+#define ARV_GV_STREAM_RING_N_BLOCKS_MIN                 4
 
 enum {
 	ARV_GV_STREAM_PROPERTY_0,
@@ -70,7 +102,14 @@ enum {
 	ARV_GV_STREAM_PROPERTY_PACKET_REQUEST_RATIO,
 	ARV_GV_STREAM_PROPERTY_INITIAL_PACKET_TIMEOUT,
 	ARV_GV_STREAM_PROPERTY_PACKET_TIMEOUT,
-	ARV_GV_STREAM_PROPERTY_FRAME_RETENTION
+	ARV_GV_STREAM_PROPERTY_FRAME_RETENTION,
+	ARV_GV_STREAM_PROPERTY_N_WORKERS,
+	ARV_GV_STREAM_PROPERTY_RING_BLOCK_SIZE,
+	ARV_GV_STREAM_PROPERTY_RING_BLOCK_COUNT,
+	ARV_GV_STREAM_PROPERTY_RING_FRAME_SIZE,
+	ARV_GV_STREAM_PROPERTY_RING_BLOCK_TIMEOUT,
+	ARV_GV_STREAM_PROPERTY_XDP_QUEUE,
+	ARV_GV_STREAM_PROPERTY_N_SOCKETS
 } ArvGvStreamProperties;
 
 typedef struct _ArvGvStreamThreadData ArvGvStreamThreadData;
@@ -82,6 +121,8 @@ typedef struct {
 
 	GThread *thread;
 	ArvGvStreamThreadData *thread_data;
+
+	guint n_socket_infos;
 } ArvGvStreamPrivate;
 
 struct _ArvGvStream {
@@ -96,17 +137,15 @@ G_DEFINE_TYPE_WITH_CODE (ArvGvStream, arv_gv_stream, ARV_TYPE_STREAM, G_ADD_PRIV
 
 /* Acquisition thread */
 
-typedef struct {
-	gboolean received;
-        gboolean resend_requested;
-	guint64 abs_timeout_us;
-} ArvGvStreamPacketData;
+/* Packet states are tracked in bitmaps of 64 bit words */
+#define ARV_GV_STREAM_N_BITMAP_WORDS(n_packets)		(((n_packets) + 63) / 64)
 
 typedef struct {
 	ArvBuffer *buffer;
 	guint64 frame_id;
 
         gboolean leader_received;
+	gboolean has_device_timestamp;
 
         gsize received_size;
 
@@ -117,14 +156,52 @@ typedef struct {
 	gboolean disable_resend_request;
 
 	guint n_packets;
-	ArvGvStreamPacketData *packet_data;
+	guint n_allocated_packets;
+	guint64 *packet_state;		/* Storage for the bitmaps and the timeouts below */
+	guint64 *received;		/* Bitmap of the received packets */
+	guint64 *resend_requested;	/* Bitmap of the packets for which a resend was requested */
+	guint64 *abs_timeout_us;	/* Resend timeout, only meaningful for the missing packets */
 
 	guint n_packet_resend_requests;
 	gboolean resend_ratio_reached;
 
 	gboolean extended_ids;
+
+	gint n_pending_copies;
 } ArvGvStreamFrameData;
 
+typedef struct {
+	void *destination;
+	const void *source;
+	size_t size;
+	gint *n_pending_copies;
+} ArvGvStreamCopyJob;
+
+typedef struct {
+	ArvGvStreamThreadData *thread_data;
+	GThread *thread;
+
+	ArvGvStreamCopyJob jobs[ARV_GV_STREAM_WORKER_RING_SIZE];
+	guint head;		/* Only written by the receiving thread */
+	guint tail;		/* Only written by the worker thread */
+	guint marks[2];		/* Ring head at the end of the processing of each packet buffer set */
+
+	gint sleeping;
+	gint cancelled;
+	GMutex mutex;
+	GCond cond;
+
+	guint64 n_copied_bytes;
+} ArvGvStreamWorker;
+
+typedef struct {
+	ArvGvStreamThreadData *thread_data;
+	GThread *thread;
+	GSocket *socket;
+
+	guint64 *n_received_packets;
+} ArvGvStreamReceiver;
+
 struct _ArvGvStreamThreadData {
 	GCancellable *cancellable;
 
@@ -152,15 +229,64 @@ struct _ArvGvStreamThreadData {
 	guint frame_retention_us;
 
 	guint64 timestamp_tick_frequency;
+	ArvClockModel *clock_model;
 	guint scps_packet_size;
 
 	guint16 packet_id;
 
-	GSList *frames;
+	/* Frames in flight, oldest first, also indexed by frame id modulo the window. Descriptors are recycled through
+	 * the free frame stack, so that the packet path does not allocate memory in the steady state. */
+	ArvGvStreamFrameData *frames[ARV_GV_STREAM_FRAME_WINDOW];
+	ArvGvStreamFrameData *frame_index[ARV_GV_STREAM_FRAME_WINDOW];
+	guint first_frame;
+	guint n_frames;
+	ArvGvStreamFrameData *free_frames[ARV_GV_STREAM_FRAME_WINDOW];
+	guint n_free_frames;
+	guint n_allocated_frames;
+	guint64 payload_size;
+	double frame_rate;
+
 	gboolean first_packet;
 	guint64 last_frame_id;
 
 	gboolean use_packet_socket;
+	gboolean use_zero_copy;
+	gboolean use_xdp;
+	gboolean xdp_requested;
+	guint xdp_queue;
+
+	/* Packet socket ring geometry, 0 means automatic */
+	guint ring_block_size;
+	guint ring_block_count;
+	guint ring_frame_size;
+	guint ring_block_timeout_ms;
+
+	guint n_workers;		/* Atomic, set from the application thread */
+	guint n_running_workers;
+	ArvGvStreamWorker *workers;
+
+	/* Signaled on copy progress when the receiving thread waits for pending copies */
+	gint n_copy_waiters;
+	GMutex copy_mutex;
+	GCond copy_cond;
+
+	/* Additional sockets bound to the stream port, each one serviced by its own thread. The mutex serializes the
+	 * access to the reassembly state, the payload copies of the additional receivers being deferred after its
+	 * release. */
+	guint n_sockets;
+	guint n_receivers;
+	ArvGvStreamReceiver *receivers;
+	guint64 n_socket_received_packets[ARV_GV_STREAM_N_SOCKETS_MAX];
+	GMutex mutex;
+	ArvGvStreamCopyJob *deferred_copies;
+	guint n_deferred_copies;
+
+	/* Completed buffers, pushed to the stream output queue at the end of each receive batch */
+	ArvBuffer *output_buffers[ARV_GV_STREAM_OUTPUT_BATCH_SIZE];
+	guint n_output_buffers;
+
+	guint64 zero_copy_frame_id;
+	guint32 zero_copy_packet_id;
 
 	/* Statistics */
 
@@ -178,6 +304,7 @@ struct _ArvGvStreamThreadData {
 	guint64 n_error_packets;
 	guint64 n_ignored_packets;
 	guint64 n_resend_requests;
+	guint64 n_resend_commands;
 	guint64 n_resent_packets;
 	guint64 n_resend_ratio_reached;
         guint64 n_resend_disabled;
@@ -185,6 +312,13 @@ struct _ArvGvStreamThreadData {
 
         guint64 n_transferred_bytes;
         guint64 n_ignored_bytes;
+        guint64 n_zero_copy_bytes;
+        guint64 n_offloaded_bytes;	/* Copied by the copy workers or the additional receivers */
+
+        guint64 n_ring_drops;
+        guint64 n_ring_freezes;
+
+        guint64 n_xdp_fallbacks;
 
 	ArvHistogram *histogram;
 	guint32 statistic_count;
@@ -251,8 +385,13 @@ _update_socket (ArvGvStreamThreadData *thread_data, ArvBuffer *buffer)
 
 	if (buffer_size != thread_data->current_socket_buffer_size) {
 		gboolean result;
+		guint i;
 
 		result = arv_socket_set_recv_buffer_size (fd, buffer_size);
+		for (i = 0; i < thread_data->n_receivers; i++)
+			if (!arv_socket_set_recv_buffer_size (g_socket_get_fd (thread_data->receivers[i].socket),
+							      buffer_size))
+				result = FALSE;
 		if (result) {
 			thread_data->current_socket_buffer_size = buffer_size;
 			arv_info_stream_thread ("[GvStream::update_socket] Socket buffer size set to %d", buffer_size);
@@ -322,6 +461,206 @@ _compute_n_expected_packets (const ArvGvspPacket *packet, size_t allocated_size,
         return 0;
 }
 
+static ArvGvStreamFrameData *
+_get_frame (ArvGvStreamThreadData *thread_data, guint index)
+{
+	return thread_data->frames[(thread_data->first_frame + index) & (ARV_GV_STREAM_FRAME_WINDOW - 1)];
+}
+
+static ArvGvStreamFrameData *
+_lookup_frame (ArvGvStreamThreadData *thread_data, guint64 frame_id)
+{
+	ArvGvStreamFrameData *frame;
+
+	frame = thread_data->frame_index[frame_id & (ARV_GV_STREAM_FRAME_WINDOW - 1)];
+	if (frame != NULL && frame->frame_id == frame_id)
+		return frame;
+
+	return NULL;
+}
+
+static inline guint
+_bitmap_ctz (guint64 word)
+{
+#if defined (__GNUC__)
+	return __builtin_ctzll (word);
+#else
+	guint n = 0;
+
+	while ((word & 1) == 0) {
+		word >>= 1;
+		n++;
+	}
+
+	return n;
+#endif
+}
+
+static inline gboolean
+_bitmap_get (const guint64 *bitmap, guint32 index)
+{
+	return (bitmap[index / 64] >> (index % 64)) & 1;
+}
+
+static inline void
+_bitmap_set (guint64 *bitmap, guint32 index)
+{
+	bitmap[index / 64] |= G_GUINT64_CONSTANT (1) << (index % 64);
+}
+
+/* Returns the id of the first packet not received yet in [first, last), or last if there is none */
+
+static guint32
+_find_first_missing_packet (const ArvGvStreamFrameData *frame, guint32 first, guint32 last)
+{
+	guint32 word_index;
+	guint64 missing;
+
+	if (first >= last)
+		return last;
+
+	word_index = first / 64;
+	missing = ~frame->received[word_index] & (G_MAXUINT64 << (first % 64));
+
+	while (missing == 0) {
+		word_index++;
+		if (word_index * 64 >= last)
+			return last;
+		missing = ~frame->received[word_index];
+	}
+
+	return MIN (word_index * 64 + _bitmap_ctz (missing), last);
+}
+
+static void
+_set_packet_state_layout (ArvGvStreamFrameData *frame)
+{
+	guint n_words = ARV_GV_STREAM_N_BITMAP_WORDS (frame->n_allocated_packets);
+
+	frame->received = frame->packet_state;
+	frame->resend_requested = frame->packet_state + n_words;
+	frame->abs_timeout_us = frame->packet_state + 2 * n_words;
+}
+
+static void
+_allocate_packet_state (ArvGvStreamFrameData *frame, guint n_packets)
+{
+	g_free (frame->packet_state);
+
+	frame->packet_state = g_new0 (guint64, 2 * ARV_GV_STREAM_N_BITMAP_WORDS (n_packets) + n_packets);
+	frame->n_allocated_packets = n_packets;
+	_set_packet_state_layout (frame);
+}
+
+static void
+_preallocate_frames (ArvGvStreamThreadData *thread_data)
+{
+	guint n_packets = 0;
+	guint i;
+
+	if (thread_data->payload_size > 0) {
+		size_t block_size;
+
+		block_size = thread_data->scps_packet_size - ARV_GVSP_MULTIPART_PACKET_PROTOCOL_OVERHEAD (TRUE);
+		n_packets = (thread_data->payload_size + block_size - 1) / block_size + (2 /* leader + trailer */);
+	}
+
+	for (i = 0; i < ARV_GV_STREAM_N_PREALLOCATED_FRAMES; i++) {
+		ArvGvStreamFrameData *frame;
+
+		frame = g_new0 (ArvGvStreamFrameData, 1);
+		_allocate_packet_state (frame, n_packets);
+
+		thread_data->free_frames[thread_data->n_free_frames++] = frame;
+		thread_data->n_allocated_frames++;
+	}
+
+	arv_info_stream_thread ("[GvStream::preallocate_frames] %u frame(s) of %u packet(s)",
+				ARV_GV_STREAM_N_PREALLOCATED_FRAMES, n_packets);
+}
+
+static void
+_free_frames (ArvGvStreamThreadData *thread_data)
+{
+	guint i;
+
+	/* All the frames must have been closed */
+	for (i = 0; i < thread_data->n_free_frames; i++) {
+		g_free (thread_data->free_frames[i]->packet_state);
+		g_free (thread_data->free_frames[i]);
+	}
+
+	thread_data->n_free_frames = 0;
+	thread_data->n_allocated_frames = 0;
+}
+
+static ArvGvStreamFrameData *
+_new_frame (ArvGvStreamThreadData *thread_data, guint n_packets)
+{
+	ArvGvStreamFrameData *frame;
+	guint64 *packet_state;
+	guint n_allocated_packets;
+
+	if (thread_data->n_free_frames > 0) {
+		frame = thread_data->free_frames[--thread_data->n_free_frames];
+	} else {
+		frame = g_new0 (ArvGvStreamFrameData, 1);
+		thread_data->n_allocated_frames++;
+		arv_debug_stream_thread ("[GvStream::new_frame] %u frame(s) allocated",
+					 thread_data->n_allocated_frames);
+	}
+
+	if (n_packets > frame->n_allocated_packets || frame->packet_state == NULL) {
+		_allocate_packet_state (frame, n_packets);
+	} else {
+		guint n_words = ARV_GV_STREAM_N_BITMAP_WORDS (n_packets);
+
+		memset (frame->received, 0, n_words * sizeof (guint64));
+		memset (frame->resend_requested, 0, n_words * sizeof (guint64));
+		memset (frame->abs_timeout_us, 0, n_packets * sizeof (guint64));
+	}
+
+	/* Only keep the packet state storage */
+	packet_state = frame->packet_state;
+	n_allocated_packets = frame->n_allocated_packets;
+
+	memset (frame, 0, sizeof (ArvGvStreamFrameData));
+
+	frame->packet_state = packet_state;
+	frame->n_allocated_packets = n_allocated_packets;
+	_set_packet_state_layout (frame);
+	frame->n_packets = n_packets;
+
+	return frame;
+}
+
+static void
+_close_frame (ArvGvStreamThreadData *thread_data,
+              guint64 time_us,
+              ArvGvStreamFrameData *frame);
+
+static void
+_flush_output_buffers (ArvGvStreamThreadData *thread_data)
+{
+	if (thread_data->n_output_buffers == 0)
+		return;
+
+	/* The buffer done callback is called by the stream, after the processing stages */
+	arv_stream_push_completed_buffers (thread_data->stream, thread_data->output_buffers,
+					   thread_data->n_output_buffers);
+
+	thread_data->n_output_buffers = 0;
+}
+
+static void
+_queue_output_buffer (ArvGvStreamThreadData *thread_data, ArvBuffer *buffer)
+{
+	if (thread_data->n_output_buffers >= ARV_GV_STREAM_OUTPUT_BATCH_SIZE)
+		_flush_output_buffers (thread_data);
+
+	thread_data->output_buffers[thread_data->n_output_buffers++] = buffer;
+}
+
 static ArvGvStreamFrameData *
 _find_frame_data (ArvGvStreamThreadData *thread_data,
 		  const ArvGvspPacket *packet,
@@ -333,22 +672,19 @@ _find_frame_data (ArvGvStreamThreadData *thread_data,
 {
 	ArvGvStreamFrameData *frame = NULL;
 	ArvBuffer *buffer;
-	GSList *iter;
 	guint n_packets = 0;
 	gint64 frame_id_inc;
         gboolean extended_ids;
 
 	extended_ids = arv_gvsp_packet_has_extended_ids (packet, packet_size);
 
-	for (iter = thread_data->frames; iter != NULL; iter = iter->next) {
-		frame = iter->data;
-		if (frame->frame_id == frame_id) {
-                        arv_histogram_fill (thread_data->histogram, 1, time_us - frame->first_packet_time_us);
-                        arv_histogram_fill (thread_data->histogram, 2, time_us - frame->last_packet_time_us);
+	frame = _lookup_frame (thread_data, frame_id);
+	if (frame != NULL) {
+                arv_histogram_fill (thread_data->histogram, 1, time_us - frame->first_packet_time_us);
+                arv_histogram_fill (thread_data->histogram, 2, time_us - frame->last_packet_time_us);
 
-			frame->last_packet_time_us = time_us;
-			return frame;
-		}
+		frame->last_packet_time_us = time_us;
+		return frame;
 	}
 
 	if (extended_ids) {
@@ -383,15 +719,20 @@ _find_frame_data (ArvGvStreamThreadData *thread_data,
                                                  thread_data->scps_packet_size);
         if (n_packets < 1) {
 	        buffer->priv->status = ARV_BUFFER_STATUS_PAYLOAD_NOT_SUPPORTED;
-                arv_stream_push_output_buffer(thread_data->stream, buffer);
-                if (thread_data->callback != NULL)
-                        thread_data->callback (thread_data->callback_data,
-                                               ARV_STREAM_CALLBACK_TYPE_BUFFER_DONE,
-                                               buffer);
+                _queue_output_buffer (thread_data, buffer);
                 return NULL;
         }
 
-	frame = g_new0 (ArvGvStreamFrameData, 1);
+	/* The window slot is still used by an older frame, give up on the frames up to this one */
+	while (thread_data->frame_index[frame_id & (ARV_GV_STREAM_FRAME_WINDOW - 1)] != NULL) {
+		frame = _get_frame (thread_data, 0);
+		frame->buffer->priv->status = ARV_BUFFER_STATUS_MISSING_PACKETS;
+		arv_info_stream_thread ("[GvStream::find_frame_data] Frame window full, drop frame %" G_GUINT64_FORMAT,
+					frame->frame_id);
+		_close_frame (thread_data, time_us, frame);
+	}
+
+	frame = _new_frame (thread_data, n_packets);
 
 	frame->disable_resend_request = FALSE;
 
@@ -405,9 +746,6 @@ _find_frame_data (ArvGvStreamThreadData *thread_data,
 	frame->first_packet_time_us = time_us;
 	frame->last_packet_time_us = time_us;
 
-	frame->packet_data = g_new0 (ArvGvStreamPacketData, n_packets);
-	frame->n_packets = n_packets;
-
 	if (thread_data->callback != NULL &&
 	    frame->buffer != NULL)
 		thread_data->callback (thread_data->callback_data,
@@ -423,7 +761,9 @@ _find_frame_data (ArvGvStreamThreadData *thread_data,
                                          frame_id_inc - 1, frame_id);
 	}
 
-	thread_data->frames = g_slist_append (thread_data->frames, frame);
+	thread_data->frames[(thread_data->first_frame + thread_data->n_frames) & (ARV_GV_STREAM_FRAME_WINDOW - 1)] = frame;
+	thread_data->frame_index[frame_id & (ARV_GV_STREAM_FRAME_WINDOW - 1)] = frame;
+	thread_data->n_frames++;
 
 	arv_debug_stream_thread ("[GvStream::find_frame_data] Start frame %" G_GUINT64_FORMAT, frame_id);
 
@@ -434,6 +774,244 @@ _find_frame_data (ArvGvStreamThreadData *thread_data,
 	return frame;
 }
 
+/* Copy workers
+ *
+ * When enabled, the receiving thread still does all the packet bookkeeping, but the payload copies are dispatched to
+ * worker threads, each of them being fed by a single producer / single consumer ring. Payload packets are sharded
+ * by packet id ranges. The receiving thread must wait for the completion of the pending copies before closing a frame,
+ * or before reusing the memory the packets were received into. */
+
+static void
+_notify_copy_progress (ArvGvStreamThreadData *thread_data)
+{
+	if (g_atomic_int_get (&thread_data->n_copy_waiters) > 0) {
+		g_mutex_lock (&thread_data->copy_mutex);
+		g_cond_broadcast (&thread_data->copy_cond);
+		g_mutex_unlock (&thread_data->copy_mutex);
+	}
+}
+
+static void *
+_worker_thread (void *data)
+{
+	ArvGvStreamWorker *worker = data;
+
+	while (!g_atomic_int_get (&worker->cancelled)) {
+		guint head = g_atomic_int_get (&worker->head);
+		guint tail = worker->tail;
+
+		if (head == tail) {
+			g_mutex_lock (&worker->mutex);
+			g_atomic_int_set (&worker->sleeping, TRUE);
+			while (g_atomic_int_get (&worker->head) == worker->tail &&
+			       !g_atomic_int_get (&worker->cancelled))
+				g_cond_wait (&worker->cond, &worker->mutex);
+			g_atomic_int_set (&worker->sleeping, FALSE);
+			g_mutex_unlock (&worker->mutex);
+			continue;
+		}
+
+		while (tail != head) {
+			ArvGvStreamCopyJob *job = &worker->jobs[tail & (ARV_GV_STREAM_WORKER_RING_SIZE - 1)];
+
+			memcpy (job->destination, job->source, job->size);
+			worker->n_copied_bytes += job->size;
+			g_atomic_int_add (job->n_pending_copies, -1);
+
+			tail++;
+			g_atomic_int_set (&worker->tail, tail);
+
+			_notify_copy_progress (worker->thread_data);
+		}
+	}
+
+	return NULL;
+}
+
+static void
+_start_workers (ArvGvStreamThreadData *thread_data)
+{
+	guint i;
+
+	thread_data->n_running_workers = g_atomic_int_get (&thread_data->n_workers);
+	if (thread_data->n_running_workers == 0)
+		return;
+
+	thread_data->workers = g_new0 (ArvGvStreamWorker, thread_data->n_running_workers);
+
+	for (i = 0; i < thread_data->n_running_workers; i++) {
+		ArvGvStreamWorker *worker = &thread_data->workers[i];
+
+		worker->thread_data = thread_data;
+		g_mutex_init (&worker->mutex);
+		g_cond_init (&worker->cond);
+		worker->thread = g_thread_new ("arv_gv_stream_worker", _worker_thread, worker);
+	}
+
+	arv_info_stream_thread ("[GvStream::start_workers] %u copy worker(s) started", thread_data->n_running_workers);
+}
+
+static void
+_stop_workers (ArvGvStreamThreadData *thread_data)
+{
+	guint i;
+
+	for (i = 0; i < thread_data->n_running_workers; i++) {
+		ArvGvStreamWorker *worker = &thread_data->workers[i];
+
+		g_mutex_lock (&worker->mutex);
+		g_atomic_int_set (&worker->cancelled, TRUE);
+		g_cond_signal (&worker->cond);
+		g_mutex_unlock (&worker->mutex);
+
+		g_thread_join (worker->thread);
+		g_mutex_clear (&worker->mutex);
+		g_cond_clear (&worker->cond);
+
+		arv_info_stream_thread ("[GvStream::stop_workers] Worker %u copied %" G_GUINT64_FORMAT " bytes",
+					i, worker->n_copied_bytes);
+	}
+
+	g_clear_pointer (&thread_data->workers, g_free);
+	thread_data->n_running_workers = 0;
+}
+
+static void
+_update_workers (ArvGvStreamThreadData *thread_data)
+{
+	/* The worker count is only changed between frames, when no copy can be pending */
+	if (thread_data->n_frames > 0 ||
+	    (guint) g_atomic_int_get (&thread_data->n_workers) == thread_data->n_running_workers)
+		return;
+
+	_stop_workers (thread_data);
+	_start_workers (thread_data);
+}
+
+static void
+_run_copy_jobs (ArvGvStreamThreadData *thread_data, const ArvGvStreamCopyJob *jobs, guint n_jobs)
+{
+	guint i;
+
+	for (i = 0; i < n_jobs; i++) {
+		memcpy (jobs[i].destination, jobs[i].source, jobs[i].size);
+		g_atomic_int_add (jobs[i].n_pending_copies, -1);
+	}
+
+	if (n_jobs > 0)
+		_notify_copy_progress (thread_data);
+}
+
+/* Waits until the tail of the worker ring reaches @target */
+
+static void
+_wait_for_worker_tail (ArvGvStreamThreadData *thread_data, ArvGvStreamWorker *worker, guint target)
+{
+	if ((gint) ((guint) g_atomic_int_get (&worker->tail) - target) >= 0)
+		return;
+
+	g_mutex_lock (&thread_data->copy_mutex);
+	g_atomic_int_inc (&thread_data->n_copy_waiters);
+	while ((gint) ((guint) g_atomic_int_get (&worker->tail) - target) < 0)
+		g_cond_wait (&thread_data->copy_cond, &thread_data->copy_mutex);
+	g_atomic_int_add (&thread_data->n_copy_waiters, -1);
+	g_mutex_unlock (&thread_data->copy_mutex);
+}
+
+static void
+_run_deferred_copies (ArvGvStreamThreadData *thread_data)
+{
+	_run_copy_jobs (thread_data, thread_data->deferred_copies, thread_data->n_deferred_copies);
+	thread_data->n_deferred_copies = 0;
+}
+
+static void
+_copy_block (ArvGvStreamThreadData *thread_data,
+	     ArvGvStreamFrameData *frame,
+	     guint32 packet_id,
+	     void *destination,
+	     const void *source,
+	     size_t size)
+{
+	ArvGvStreamWorker *worker;
+	ArvGvStreamCopyJob *job;
+	guint head;
+
+	/* Copies of the additional receivers are done after the release of the reassembly lock */
+	if (thread_data->deferred_copies != NULL) {
+		g_atomic_int_inc (&frame->n_pending_copies);
+
+		job = &thread_data->deferred_copies[thread_data->n_deferred_copies++];
+		job->destination = destination;
+		job->source = source;
+		job->size = size;
+		job->n_pending_copies = &frame->n_pending_copies;
+		thread_data->n_offloaded_bytes += size;
+		return;
+	}
+
+	if (thread_data->n_running_workers == 0) {
+		memcpy (destination, source, size);
+		return;
+	}
+
+	worker = &thread_data->workers[(packet_id / ARV_GV_STREAM_WORKER_PACKET_RANGE) %
+				       thread_data->n_running_workers];
+	head = worker->head;
+
+	/* Wait for a free slot if the ring is full */
+	_wait_for_worker_tail (thread_data, worker, head - ARV_GV_STREAM_WORKER_RING_SIZE + 1);
+
+	g_atomic_int_inc (&frame->n_pending_copies);
+
+	job = &worker->jobs[head & (ARV_GV_STREAM_WORKER_RING_SIZE - 1)];
+	job->destination = destination;
+	job->source = source;
+	job->size = size;
+	job->n_pending_copies = &frame->n_pending_copies;
+	thread_data->n_offloaded_bytes += size;
+
+	g_atomic_int_set (&worker->head, head + 1);
+
+	if (g_atomic_int_get (&worker->sleeping)) {
+		g_mutex_lock (&worker->mutex);
+		g_cond_signal (&worker->cond);
+		g_mutex_unlock (&worker->mutex);
+	}
+}
+
+static void
+_wait_for_frame_copies (ArvGvStreamThreadData *thread_data, ArvGvStreamFrameData *frame)
+{
+	if (g_atomic_int_get (&frame->n_pending_copies) <= 0)
+		return;
+
+	g_mutex_lock (&thread_data->copy_mutex);
+	g_atomic_int_inc (&thread_data->n_copy_waiters);
+	while (g_atomic_int_get (&frame->n_pending_copies) > 0)
+		g_cond_wait (&thread_data->copy_cond, &thread_data->copy_mutex);
+	g_atomic_int_add (&thread_data->n_copy_waiters, -1);
+	g_mutex_unlock (&thread_data->copy_mutex);
+}
+
+static void
+_set_worker_marks (ArvGvStreamThreadData *thread_data, guint set)
+{
+	guint i;
+
+	for (i = 0; i < thread_data->n_running_workers; i++)
+		thread_data->workers[i].marks[set] = thread_data->workers[i].head;
+}
+
+static void
+_wait_for_worker_marks (ArvGvStreamThreadData *thread_data, guint set)
+{
+	guint i;
+
+	for (i = 0; i < thread_data->n_running_workers; i++)
+		_wait_for_worker_tail (thread_data, &thread_data->workers[i], thread_data->workers[i].marks[set]);
+}
+
 static void
 _process_data_leader (ArvGvStreamThreadData *thread_data,
 		      ArvGvStreamFrameData *frame,
@@ -529,7 +1107,13 @@ _process_data_leader (ArvGvStreamThreadData *thread_data,
                 frame->buffer->priv->timestamp_ns = frame->buffer->priv->system_timestamp_ns;
         }
 
-	if (frame->packet_data[packet_id].resend_requested) {
+	frame->has_device_timestamp = thread_data->timestamp_tick_frequency != 0 &&
+		(frame->buffer->priv->payload_type == ARV_BUFFER_PAYLOAD_TYPE_IMAGE ||
+		 frame->buffer->priv->payload_type == ARV_BUFFER_PAYLOAD_TYPE_EXTENDED_CHUNK_DATA ||
+		 frame->buffer->priv->payload_type == ARV_BUFFER_PAYLOAD_TYPE_CHUNK_DATA ||
+		 frame->buffer->priv->payload_type == ARV_BUFFER_PAYLOAD_TYPE_MULTIPART);
+
+	if (_bitmap_get (frame->resend_requested, packet_id)) {
 		thread_data->n_resent_packets++;
 		arv_debug_stream_thread ("[GvStream::process_data_leader] Received resent packet %u for frame %" G_GUINT64_FORMAT,
 				       packet_id, frame->frame_id);
@@ -541,12 +1125,15 @@ _process_payload_block (ArvGvStreamThreadData *thread_data,
 		     ArvGvStreamFrameData *frame,
 		     const ArvGvspPacket *packet,
                      size_t packet_size,
-		     guint32 packet_id)
+		     guint32 packet_id,
+                     const void *in_place_data)
 {
 	size_t block_size;
 	ptrdiff_t block_offset;
 	ptrdiff_t block_end;
 	gboolean extended_ids;
+        const void *block_data;
+        void *block_destination;
 
 	if (frame->buffer->priv->status != ARV_BUFFER_STATUS_FILLING)
 		return;
@@ -575,13 +1162,25 @@ _process_payload_block (ArvGvStreamThreadData *thread_data,
 		block_size = block_end - block_offset;
 	}
 
-	memcpy (((char *) frame->buffer->priv->data) + block_offset,
-                arv_gvsp_packet_get_data (packet, packet_size),
-                block_size);
+        block_data = in_place_data != NULL ? in_place_data : arv_gvsp_packet_get_data (packet, packet_size);
+        block_destination = ((char *) frame->buffer->priv->data) + block_offset;
+
+        /* Payload may already be at its final location if it was scattered there by the zero copy receive */
+        if (block_data == block_destination)
+                thread_data->n_zero_copy_bytes += block_size;
+        else
+                _copy_block (thread_data, frame, packet_id, block_destination, block_data, block_size);
 
         frame->received_size += block_size;
 
-	if (frame->packet_data[packet_id].resend_requested) {
+        if (frame->frame_id != thread_data->zero_copy_frame_id) {
+                thread_data->zero_copy_frame_id = frame->frame_id;
+                thread_data->zero_copy_packet_id = packet_id + 1;
+        } else if (packet_id + 1 > thread_data->zero_copy_packet_id) {
+                thread_data->zero_copy_packet_id = packet_id + 1;
+        }
+
+	if (_bitmap_get (frame->resend_requested, packet_id)) {
 		thread_data->n_resent_packets++;
 		arv_debug_stream_thread ("[GvStream::process_data_block] Received resent packet %u for frame %" G_GUINT64_FORMAT,
 				       packet_id, frame->frame_id);
@@ -620,7 +1219,8 @@ _process_multipart_block (ArvGvStreamThreadData *thread_data,
                 }
 
                 data = arv_gvsp_multipart_packet_get_data (packet, packet_size);
-                memcpy ((char *) frame->buffer->priv->data + block_offset, data, block_size);
+                _copy_block (thread_data, frame, packet_id,
+                             (char *) frame->buffer->priv->data + block_offset, data, block_size);
 
                 frame->received_size += block_size;
         }
@@ -646,7 +1246,7 @@ _process_data_trailer (ArvGvStreamThreadData *thread_data,
                 frame->n_packets = packet_id + 1;
         }
 
-	if (frame->packet_data[packet_id].resend_requested) {
+	if (_bitmap_get (frame->resend_requested, packet_id)) {
 		thread_data->n_resent_packets++;
 		arv_debug_stream_thread ("[GvStream::process_data_trailer] Received resent packet %u for frame %"
                                          G_GUINT64_FORMAT,
@@ -654,13 +1254,75 @@ _process_data_trailer (ArvGvStreamThreadData *thread_data,
         }
 }
 
+/* Returns FALSE if the maximum number of resend requests for the frame is reached */
+
+static gboolean
+_request_packet_resend (ArvGvStreamThreadData *thread_data,
+			ArvGvStreamFrameData *frame,
+			guint32 first_missing,
+			guint32 last_missing,
+			guint64 time_us)
+{
+	guint32 n_missing_packets;
+	guint32 j;
+
+	n_missing_packets = last_missing - first_missing + 1;
+
+	if (frame->n_packet_resend_requests + n_missing_packets >
+	    (frame->n_packets * thread_data->packet_request_ratio)) {
+		frame->n_packet_resend_requests += n_missing_packets;
+
+		arv_info_stream_thread ("[GvStream::missing_packet_check]"
+					 " Maximum number of requests "
+					 "reached at dt = %" G_GINT64_FORMAT
+					 ", n_packet_requests = %u (%u packets/frame), frame_id = %"
+					 G_GUINT64_FORMAT,
+					 time_us - frame->first_packet_time_us,
+					 frame->n_packet_resend_requests, frame->n_packets,
+					 frame->frame_id);
+
+		thread_data->n_resend_ratio_reached++;
+		frame->resend_ratio_reached = TRUE;
+
+		return FALSE;
+	}
+
+	arv_debug_stream_thread ("[GvStream::missing_packet_check]"
+			       " Resend request at dt = %" G_GINT64_FORMAT
+			       ", packets %u to %u (%u packets/frame)",
+			       time_us - frame->first_packet_time_us,
+			       first_missing, last_missing, frame->n_packets);
+
+	_send_packet_request (thread_data,
+			      frame->frame_id,
+			      first_missing,
+			      last_missing,
+			      frame->extended_ids);
+
+	for (j = first_missing; j <= last_missing; j++) {
+		frame->abs_timeout_us[j] = time_us + thread_data->packet_timeout_us;
+		_bitmap_set (frame->resend_requested, j);
+	}
+
+	thread_data->n_resend_requests += n_missing_packets;
+	thread_data->n_resend_commands++;
+
+	return TRUE;
+}
+
+/* Only the missing packets are visited, the received ones being skipped a bitmap word at a time. Consecutive
+ * missing packets whose timeout expired are coalesced into a single PACKETRESEND command. */
+
 static void
 _missing_packet_check (ArvGvStreamThreadData *thread_data,
 		       ArvGvStreamFrameData *frame,
 		       guint32 packet_id,
 		       guint64 time_us)
 {
-	int i;
+	guint32 first_missing = 0;
+	guint32 last_missing = 0;
+	gboolean has_missing = FALSE;
+	guint32 i;
 
 	if (thread_data->packet_resend == ARV_GV_STREAM_PACKET_RESEND_NEVER ||
 	    frame->disable_resend_request ||
@@ -670,78 +1332,40 @@ _missing_packet_check (ArvGvStreamThreadData *thread_data,
 	if ((int) (frame->n_packets * thread_data->packet_request_ratio) <= 0)
 		return;
 
-	if (packet_id < frame->n_packets) {
-		int first_missing = -1;
-
-		for (i = frame->last_valid_packet + 1; i <= packet_id + 1; i++) {
-			gboolean need_resend;
-
-			if (i <= packet_id && !frame->packet_data[i].received) {
-                                if (frame->packet_data[i].abs_timeout_us == 0)
-                                        frame->packet_data[i].abs_timeout_us = time_us +
-                                                thread_data->initial_packet_timeout_us;
-                                need_resend = time_us > frame->packet_data[i].abs_timeout_us;
-                        } else
-                                need_resend = FALSE;
+	if (packet_id >= frame->n_packets)
+		return;
 
-			if (need_resend) {
-				if (first_missing < 0)
-					first_missing = i;
+	for (i = _find_first_missing_packet (frame, frame->last_valid_packet + 1, packet_id + 1);
+	     i <= packet_id;
+	     i = _find_first_missing_packet (frame, i + 1, packet_id + 1)) {
+		if (frame->abs_timeout_us[i] == 0)
+			frame->abs_timeout_us[i] = time_us + thread_data->initial_packet_timeout_us;
+
+		if (time_us <= frame->abs_timeout_us[i]) {
+			if (has_missing) {
+				if (!_request_packet_resend (thread_data, frame, first_missing, last_missing, time_us))
+					return;
+				has_missing = FALSE;
 			}
+			continue;
+		}
 
-			if (i > packet_id || !need_resend) {
-				if (first_missing >= 0) {
-					int last_missing;
-					int n_missing_packets;
-					int j;
-
-					last_missing = i - 1;
-					n_missing_packets = last_missing - first_missing + 1;
-
-					if (frame->n_packet_resend_requests + n_missing_packets >
-					    (frame->n_packets * thread_data->packet_request_ratio)) {
-						frame->n_packet_resend_requests += n_missing_packets;
-
-						arv_info_stream_thread ("[GvStream::missing_packet_check]"
-									 " Maximum number of requests "
-									 "reached at dt = %" G_GINT64_FORMAT
-									 ", n_packet_requests = %u (%u packets/frame), frame_id = %"
-									 G_GUINT64_FORMAT,
-									 time_us - frame->first_packet_time_us,
-									 frame->n_packet_resend_requests, frame->n_packets,
-									 frame->frame_id);
-
-						thread_data->n_resend_ratio_reached++;
-						frame->resend_ratio_reached = TRUE;
-
-						return;
-					}
-
-					arv_debug_stream_thread ("[GvStream::missing_packet_check]"
-							       " Resend request at dt = %" G_GINT64_FORMAT
-							       ", packet id = %u (%u packets/frame)",
-							       time_us - frame->first_packet_time_us,
-							       packet_id, frame->n_packets);
-
-					_send_packet_request (thread_data,
-							      frame->frame_id,
-							      first_missing,
-							      last_missing,
-							      frame->extended_ids);
-
-					for (j = first_missing; j <= last_missing; j++) {
-						frame->packet_data[j].abs_timeout_us = time_us +
-                                                        thread_data->packet_timeout_us;
-                                                frame->packet_data[j].resend_requested = TRUE;
-                                        }
-
-					thread_data->n_resend_requests += n_missing_packets;
-
-					first_missing = -1;
-				}
-			}
+		if (has_missing && i == last_missing + 1) {
+			last_missing = i;
+			continue;
 		}
+
+		if (has_missing &&
+		    !_request_packet_resend (thread_data, frame, first_missing, last_missing, time_us))
+			return;
+
+		first_missing = i;
+		last_missing = i;
+		has_missing = TRUE;
 	}
+
+	if (has_missing)
+		_request_packet_resend (thread_data, frame, first_missing, last_missing, time_us);
 }
 
 static void
@@ -749,6 +1373,10 @@ _close_frame (ArvGvStreamThreadData *thread_data,
               guint64 time_us,
               ArvGvStreamFrameData *frame)
 {
+	/* The copies deferred by the current receiver would never complete otherwise */
+	_run_deferred_copies (thread_data);
+	_wait_for_frame_copies (thread_data, frame);
+
 	if (frame->buffer->priv->status == ARV_BUFFER_STATUS_SUCCESS)
 		thread_data->n_completed_buffers++;
 	else
@@ -765,22 +1393,36 @@ _close_frame (ArvGvStreamThreadData *thread_data,
 	    frame->buffer->priv->status != ARV_BUFFER_STATUS_ABORTED)
 		thread_data->n_missing_packets += (int) frame->n_packets - (frame->last_valid_packet + 1);
 
-	arv_stream_push_output_buffer (thread_data->stream, frame->buffer);
-	if (thread_data->callback != NULL)
-		thread_data->callback (thread_data->callback_data,
-				       ARV_STREAM_CALLBACK_TYPE_BUFFER_DONE,
-				       frame->buffer);
+	frame->buffer->priv->host_timestamp_ns = 0;
+	if (frame->has_device_timestamp && thread_data->clock_model != NULL) {
+		gint64 host_timestamp_ns;
+
+		/* The first packet arrival is the closest to the acquisition */
+		arv_clock_model_add_frame_sample (thread_data->clock_model, frame->buffer->priv->timestamp_ns,
+						  frame->first_packet_time_us * 1000LL);
+		if (arv_clock_model_to_host (thread_data->clock_model, frame->buffer->priv->timestamp_ns,
+					     &host_timestamp_ns) &&
+		    host_timestamp_ns > 0)
+			frame->buffer->priv->host_timestamp_ns = host_timestamp_ns;
+	}
+
+	_queue_output_buffer (thread_data, frame->buffer);
 
         arv_histogram_fill (thread_data->histogram, 0,
                             time_us - frame->first_packet_time_us);
 
 	arv_debug_stream_thread ("[GvStream::close_frame] Close frame %" G_GUINT64_FORMAT, frame->frame_id);
 
+	/* Frames are always closed in order */
+	thread_data->frame_index[frame->frame_id & (ARV_GV_STREAM_FRAME_WINDOW - 1)] = NULL;
+	thread_data->frames[thread_data->first_frame] = NULL;
+	thread_data->first_frame = (thread_data->first_frame + 1) & (ARV_GV_STREAM_FRAME_WINDOW - 1);
+	thread_data->n_frames--;
+
 	frame->buffer = NULL;
 	frame->frame_id = 0;
 
-	g_free (frame->packet_data);
-	g_free (frame);
+	thread_data->free_frames[thread_data->n_free_frames++] = frame;
 }
 
 static void
@@ -788,23 +1430,21 @@ _check_frame_completion (ArvGvStreamThreadData *thread_data,
 			 guint64 time_us,
 			 ArvGvStreamFrameData *current_frame)
 {
-	GSList *iter;
 	ArvGvStreamFrameData *frame;
 	gboolean can_close_frame = TRUE;
+	guint i;
 
-	for (iter = thread_data->frames; iter != NULL;) {
-		frame = iter->data;
+	for (i = 0; i < thread_data->n_frames;) {
+		frame = _get_frame (thread_data, i);
 
+		/* Frames can only be closed from the head of the window, with i == 0 */
 		if (can_close_frame &&
 		    thread_data->packet_resend == ARV_GV_STREAM_PACKET_RESEND_NEVER &&
-		    iter->next != NULL) {
+		    thread_data->n_frames > 1) {
 			frame->buffer->priv->status = ARV_BUFFER_STATUS_MISSING_PACKETS;
 			arv_info_stream_thread ("[GvStream::check_frame_completion] Incomplete frame %" G_GUINT64_FORMAT,
 						 frame->frame_id);
 			_close_frame (thread_data, time_us, frame);
-			thread_data->frames = iter->next;
-			g_slist_free_1 (iter);
-			iter = thread_data->frames;
 			continue;
 		}
 
@@ -821,9 +1461,6 @@ _check_frame_completion (ArvGvStreamThreadData *thread_data,
 			arv_debug_stream_thread ("[GvStream::check_frame_completion] Completed frame %" G_GUINT64_FORMAT,
 					       frame->frame_id);
 			_close_frame (thread_data, time_us, frame);
-			thread_data->frames = iter->next;
-			g_slist_free_1 (iter);
-			iter = thread_data->frames;
 			continue;
 		}
 
@@ -844,15 +1481,12 @@ _check_frame_completion (ArvGvStreamThreadData *thread_data,
 				arv_debug_stream_thread ("last_valid_packet = %d", frame->last_valid_packet);
 				for (i = 0; i < frame->n_packets; i++) {
 					arv_debug_stream_thread ("%d - time = %Lu%s", i,
-							       frame->packet_data[i].time_us,
-							       frame->packet_data[i].received ? " - OK" : "");
+							       frame->abs_timeout_us[i],
+							       _bitmap_get (frame->received, i) ? " - OK" : "");
 				}
 			}
 #endif
 			_close_frame (thread_data, time_us, frame);
-			thread_data->frames = iter->next;
-			g_slist_free_1 (iter);
-			iter = thread_data->frames;
 			continue;
 		}
 
@@ -861,11 +1495,11 @@ _check_frame_completion (ArvGvStreamThreadData *thread_data,
 		if (frame != current_frame &&
 		    time_us - frame->last_packet_time_us >= thread_data->packet_timeout_us) {
 			_missing_packet_check (thread_data, frame, frame->n_packets - 1, time_us);
-			iter = iter->next;
+			i++;
 			continue;
 		}
 
-		iter = iter->next;
+		i++;
 	}
 }
 
@@ -873,27 +1507,27 @@ static void
 _flush_frames (ArvGvStreamThreadData *thread_data,
                guint64 time_us)
 {
-	GSList *iter;
 	ArvGvStreamFrameData *frame;
 
-	for (iter = thread_data->frames; iter != NULL; iter = iter->next) {
-		frame = iter->data;
+	while (thread_data->n_frames > 0) {
+		frame = _get_frame (thread_data, 0);
 		frame->buffer->priv->status = ARV_BUFFER_STATUS_ABORTED;
 		_close_frame (thread_data, time_us, frame);
 	}
 
-	g_slist_free (thread_data->frames);
-	thread_data->frames = NULL;
+	thread_data->first_frame = 0;
+
+	_flush_output_buffers (thread_data);
 }
 
 static ArvGvStreamFrameData *
-_process_packet (ArvGvStreamThreadData *thread_data, const ArvGvspPacket *packet, size_t packet_size, guint64 time_us)
+_process_packet (ArvGvStreamThreadData *thread_data, const ArvGvspPacket *packet, size_t packet_size,
+                 const void *in_place_data, guint64 time_us)
 
 {
 	ArvGvStreamFrameData *frame;
 	guint32 packet_id;
 	guint64 frame_id;
-	int i;
 
 	thread_data->n_received_packets++;
 
@@ -928,7 +1562,7 @@ _process_packet (ArvGvStreamThreadData *thread_data, const ArvGvspPacket *packet
 			thread_data->n_error_packets++;
                         thread_data->n_transferred_bytes += packet_size;
 		} else if (packet_id < frame->n_packets &&
-		           frame->packet_data[packet_id].received) {
+		           _bitmap_get (frame->received, packet_id)) {
 			/* Ignore duplicate packet */
 			thread_data->n_duplicated_packets++;
 			arv_debug_stream_thread ("[GvStream::process_packet] Duplicated packet %d for frame %" G_GUINT64_FORMAT,
@@ -940,14 +1574,19 @@ _process_packet (ArvGvStreamThreadData *thread_data, const ArvGvspPacket *packet
 			ArvGvspContentType content_type;
 
                         if (packet_id < frame->n_packets) {
-                                frame->packet_data[packet_id].received = TRUE;
+                                _bitmap_set (frame->received, packet_id);
+
+                                /* The timeout of a requested packet is set relatively to the request time */
+                                if (_bitmap_get (frame->resend_requested, packet_id))
+                                        arv_stream_fill_latency (thread_data->stream, ARV_STREAM_LATENCY_RESEND,
+                                                                 (gint64) (time_us + thread_data->packet_timeout_us -
+                                                                           frame->abs_timeout_us[packet_id]));
                         }
 
                         /* Keep track of last packet of a continuous block starting from packet 0 */
-                        for (i = frame->last_valid_packet + 1; i < frame->n_packets; i++)
-                                if (!frame->packet_data[i].received)
-                                        break;
-                        frame->last_valid_packet = i - 1;
+                        frame->last_valid_packet = (gint32) _find_first_missing_packet (frame,
+                                                                                        frame->last_valid_packet + 1,
+                                                                                        frame->n_packets) - 1;
 
                         content_type = arv_gvsp_packet_get_content_type (packet, packet_size);
 
@@ -963,7 +1602,8 @@ _process_packet (ArvGvStreamThreadData *thread_data, const ArvGvspPacket *packet
                                         thread_data->n_transferred_bytes += packet_size;
                                         break;
                                 case ARV_GVSP_CONTENT_TYPE_PAYLOAD:
-                                        _process_payload_block (thread_data, frame, packet, packet_size, packet_id);
+                                        _process_payload_block (thread_data, frame, packet, packet_size, packet_id,
+                                                                in_place_data);
                                         thread_data->n_transferred_bytes += packet_size;
                                         break;
                                 case ARV_GVSP_CONTENT_TYPE_MULTIPART:
@@ -990,21 +1630,182 @@ _process_packet (ArvGvStreamThreadData *thread_data, const ArvGvspPacket *packet
 	return frame;
 }
 
+typedef struct {
+        char *data;
+        size_t size;
+        size_t header_size;
+        gboolean extended_ids;
+        guint64 frame_id;
+        guint32 packet_id;
+} ArvGvStreamZeroCopySlot;
+
+static ArvGvStreamFrameData *
+_find_zero_copy_frame (ArvGvStreamThreadData *thread_data, guint32 *packet_id)
+{
+	ArvGvStreamFrameData *frame;
+
+	if (thread_data->n_frames == 0)
+		return NULL;
+
+	frame = _lookup_frame (thread_data, thread_data->zero_copy_frame_id);
+	if (frame != NULL) {
+		*packet_id = MAX (thread_data->zero_copy_packet_id, frame->last_valid_packet + 1);
+		return frame;
+	}
+
+	/* No payload received yet for the frames in progress, start with the most recent one */
+	frame = _get_frame (thread_data, thread_data->n_frames - 1);
+	*packet_id = frame->last_valid_packet + 1;
+
+	return frame;
+}
+
+static void
+_prepare_zero_copy_messages (ArvGvStreamThreadData *thread_data,
+                             char *packet_buffers,
+                             guint packet_buffer_size,
+                             GInputVector *packet_iv,
+                             GInputMessage *packet_im,
+                             ArvGvStreamZeroCopySlot *slots,
+                             guint n_messages)
+{
+	ArvGvStreamFrameData *frame;
+	gboolean can_predict;
+	size_t header_size = 0;
+	size_t block_size = 0;
+	guint32 packet_id = 0;
+	guint i;
+
+	frame = _find_zero_copy_frame (thread_data, &packet_id);
+
+	/* Only single part payloads have their block offset computable from the packet id */
+	can_predict = frame != NULL &&
+		frame->leader_received &&
+		frame->buffer->priv->status == ARV_BUFFER_STATUS_FILLING &&
+		(frame->buffer->priv->payload_type == ARV_BUFFER_PAYLOAD_TYPE_IMAGE ||
+		 frame->buffer->priv->payload_type == ARV_BUFFER_PAYLOAD_TYPE_EXTENDED_CHUNK_DATA ||
+		 frame->buffer->priv->payload_type == ARV_BUFFER_PAYLOAD_TYPE_CHUNK_DATA);
+
+	if (can_predict) {
+		header_size = ARV_GVSP_PAYLOAD_PACKET_PROTOCOL_OVERHEAD (frame->extended_ids) -
+			ARV_GVSP_PACKET_UDP_OVERHEAD;
+		block_size = packet_buffer_size - header_size;
+		packet_id = MAX (packet_id, 1);
+	}
+
+	for (i = 0; i < n_messages; i++) {
+		char *scratch = packet_buffers + i * packet_buffer_size;
+		GInputVector *iv = &packet_iv[3 * i];
+
+		slots[i].data = NULL;
+
+		if (can_predict) {
+			ptrdiff_t block_offset;
+
+			if (packet_id + 1 < frame->n_packets)
+				packet_id = _find_first_missing_packet (frame, packet_id, frame->n_packets - 1);
+
+			block_offset = (ptrdiff_t) (packet_id - 1) * block_size;
+
+			if (packet_id + 1 < frame->n_packets && block_offset < frame->buffer->priv->allocated_size) {
+				slots[i].data = (char *) frame->buffer->priv->data + block_offset;
+				slots[i].size = MIN (block_size, frame->buffer->priv->allocated_size - block_offset);
+				slots[i].header_size = header_size;
+				slots[i].extended_ids = frame->extended_ids;
+				slots[i].frame_id = frame->frame_id;
+				slots[i].packet_id = packet_id;
+				packet_id++;
+			} else {
+				can_predict = FALSE;
+			}
+		}
+
+		if (slots[i].data != NULL) {
+			/* GVSP header in the scratch area, payload at its final location in the buffer, and anything
+			 * unexpected at the end of the scratch area */
+			iv[0].buffer = scratch;
+			iv[0].size = header_size;
+			iv[1].buffer = slots[i].data;
+			iv[1].size = slots[i].size;
+			iv[2].buffer = scratch + header_size + slots[i].size;
+			iv[2].size = packet_buffer_size - header_size - slots[i].size;
+			packet_im[i].num_vectors = 3;
+		} else {
+			iv[0].buffer = scratch;
+			iv[0].size = packet_buffer_size;
+			packet_im[i].num_vectors = 1;
+		}
+
+		packet_im[i].vectors = iv;
+	}
+}
+
+static const void *
+_resolve_zero_copy_message (const ArvGvStreamZeroCopySlot *slot, char *scratch, size_t packet_size)
+{
+	const ArvGvspPacket *packet = (const ArvGvspPacket *) scratch;
+	size_t payload_size;
+
+	if (slot->data == NULL || packet_size <= slot->header_size)
+		return NULL;
+
+	payload_size = packet_size - slot->header_size;
+
+	if (arv_gvsp_packet_has_extended_ids (packet, slot->header_size) == slot->extended_ids &&
+	    payload_size <= slot->size &&
+	    !arv_gvsp_packet_status_is_error (arv_gvsp_packet_get_status (packet, packet_size)) &&
+	    arv_gvsp_packet_get_content_type (packet, packet_size) == ARV_GVSP_CONTENT_TYPE_PAYLOAD &&
+	    arv_gvsp_packet_get_frame_id (packet, packet_size) == slot->frame_id &&
+	    arv_gvsp_packet_get_packet_id (packet, packet_size) == slot->packet_id)
+		return slot->data;
+
+	/* Misprediction, rebuild a contiguous packet in the scratch area. This must be done for all the messages of a
+	 * batch before any of them is processed, as processing may overwrite the area used by another message. */
+	memcpy (scratch + slot->header_size, slot->data, MIN (payload_size, slot->size));
+
+	return NULL;
+}
+
+/* The reassembly state is only shared with the additional receivers. Their number does not change while the main
+ * loop runs, and without them the lock is skipped. */
+
+static void
+_lock_reassembly (ArvGvStreamThreadData *thread_data)
+{
+	if (thread_data->n_receivers > 0)
+		g_mutex_lock (&thread_data->mutex);
+}
+
+static void
+_unlock_reassembly (ArvGvStreamThreadData *thread_data)
+{
+	if (thread_data->n_receivers > 0)
+		g_mutex_unlock (&thread_data->mutex);
+}
+
 static void
 _loop (ArvGvStreamThreadData *thread_data)
 {
 	ArvGvStreamFrameData *frame;
-	ArvGvspPacket *packet_buffers;
+	char *packet_buffers;
 	GPollFD poll_fd[2];
 	guint64 time_us;
 	gboolean use_poll;
 	int i;
-	GInputVector packet_iv[ARV_GV_STREAM_NUM_BUFFERS] = { {NULL, 0}, };
+	GInputVector packet_iv[3 * ARV_GV_STREAM_NUM_BUFFERS] = { {NULL, 0}, };
 	GInputMessage packet_im[ARV_GV_STREAM_NUM_BUFFERS] = { {NULL, NULL, 0, 0, 0, NULL, NULL}, };
+	ArvGvStreamZeroCopySlot slots[ARV_GV_STREAM_NUM_BUFFERS];
+	const void *in_place_data[ARV_GV_STREAM_NUM_BUFFERS] = { NULL, };
 	// we don't need to consider the IP and UDP header size
 	guint packet_buffer_size = thread_data->scps_packet_size - 20 - 8;
+	/* With copy workers, packets are received in a set while the copies from the other one may still be pending */
+	guint n_sets = 2;
+	guint set = 0;
 
-	arv_info_stream ("[GvStream::loop] Standard socket method");
+	if (thread_data->use_zero_copy)
+		arv_info_stream ("[GvStream::loop] Standard socket method, zero copy");
+	else
+		arv_info_stream ("[GvStream::loop] Standard socket method");
 
 	poll_fd[0].fd = g_socket_get_fd (thread_data->socket);
 	poll_fd[0].events =  G_IO_IN;
@@ -1012,13 +1813,14 @@ _loop (ArvGvStreamThreadData *thread_data)
 
 	arv_gpollfd_prepare_all(poll_fd,1);
 
-	packet_buffers = g_malloc0 (packet_buffer_size * ARV_GV_STREAM_NUM_BUFFERS);
+	packet_buffers = g_malloc0 (packet_buffer_size * ARV_GV_STREAM_NUM_BUFFERS * n_sets);
 
 	for (i = 0; i < ARV_GV_STREAM_NUM_BUFFERS; i++) {
-		packet_iv[i].buffer = (char *) packet_buffers + i * packet_buffer_size;
-		packet_iv[i].size = packet_buffer_size;
-		packet_im[i].vectors = &packet_iv[i];
+		packet_iv[3 * i].buffer = packet_buffers + i * packet_buffer_size;
+		packet_iv[3 * i].size = packet_buffer_size;
+		packet_im[i].vectors = &packet_iv[3 * i];
 		packet_im[i].num_vectors = 1;
+		slots[i].data = NULL;
 	}
 
 	use_poll = g_cancellable_make_pollfd (thread_data->cancellable, &poll_fd[1]);
@@ -1033,11 +1835,17 @@ _loop (ArvGvStreamThreadData *thread_data)
 		int n_events;
 		int errsv;
 
-		if (thread_data->frames != NULL)
+		_lock_reassembly (thread_data);
+
+		_update_workers (thread_data);
+
+		if (thread_data->n_frames > 0)
 			timeout_ms = thread_data->packet_timeout_us / 1000;
 		else
 			timeout_ms = ARV_GV_STREAM_POLL_TIMEOUT_US / 1000;
 
+		_unlock_reassembly (thread_data);
+
 		do {
 			poll_fd[0].revents = 0;
 			n_events = g_poll (poll_fd, use_poll ?  2 : 1, timeout_ms);
@@ -1047,8 +1855,20 @@ _loop (ArvGvStreamThreadData *thread_data)
 
 		if (poll_fd[0].revents != 0) {
                         GError *error = NULL;
+                        char *set_buffers;
                         int n_msgs;
 
+			set_buffers = packet_buffers + set * packet_buffer_size * ARV_GV_STREAM_NUM_BUFFERS;
+
+			_wait_for_worker_marks (thread_data, set);
+
+			if (thread_data->use_zero_copy)
+				_prepare_zero_copy_messages (thread_data, set_buffers, packet_buffer_size,
+							     packet_iv, packet_im, slots, ARV_GV_STREAM_NUM_BUFFERS);
+			else if (thread_data->n_running_workers > 0)
+				for (i = 0; i < ARV_GV_STREAM_NUM_BUFFERS; i++)
+					packet_iv[3 * i].buffer = set_buffers + i * packet_buffer_size;
+
 			arv_gpollfd_clear_one (&poll_fd[0], thread_data->socket);
 			n_msgs = g_socket_receive_messages (thread_data->socket,
 		 					    packet_im,
@@ -1058,22 +1878,46 @@ _loop (ArvGvStreamThreadData *thread_data)
 		 					    &error);
 
                         if (G_LIKELY(n_msgs > 0)) {
+                                thread_data->n_socket_received_packets[0] += n_msgs;
+
+                                if (thread_data->use_zero_copy)
+                                        for (i = 0; i < n_msgs; i++)
+                                                in_place_data[i] =
+                                                        _resolve_zero_copy_message (&slots[i],
+                                                                                    set_buffers +
+                                                                                    i * packet_buffer_size,
+                                                                                    packet_im[i].bytes_received);
+
+                                _lock_reassembly (thread_data);
+                                /* Time is read under the lock, so that it never goes backward for the frames */
                                 time_us = g_get_monotonic_time ();
                                 for (i = 0; i < n_msgs; i++) {
                                         frame = _process_packet (thread_data,
-                                                                 packet_iv[i].buffer,
+                                                                 (ArvGvspPacket *) (set_buffers +
+                                                                                    i * packet_buffer_size),
                                                                  packet_im[i].bytes_received,
+                                                                 in_place_data[i],
                                                                  time_us);
                                         _check_frame_completion (thread_data, time_us, frame);
                                 }
+                                _flush_output_buffers (thread_data);
+                                _unlock_reassembly (thread_data);
+
+                                if (thread_data->n_running_workers > 0) {
+                                        _set_worker_marks (thread_data, set);
+                                        set = (set + 1) % n_sets;
+                                }
                         } else {
                                 arv_warning_stream_thread ("[GvStream::loop] receive_messages failed: %s",
                                                            error != NULL ? error->message : "Unknown reason");
                                 g_clear_error (&error);
                         }
                 } else {
+                        _lock_reassembly (thread_data);
                         time_us = g_get_monotonic_time ();
                         _check_frame_completion (thread_data, time_us, NULL);
+                        _flush_output_buffers (thread_data);
+                        _unlock_reassembly (thread_data);
                 }
 
 	} while (!g_cancellable_is_cancelled (thread_data->cancellable));
@@ -1081,10 +1925,257 @@ _loop (ArvGvStreamThreadData *thread_data)
 	if (use_poll)
 		g_cancellable_release_fd (thread_data->cancellable);
 
-	arv_gpollfd_finish_all (poll_fd,1);
-	g_free (packet_buffers);
+	arv_gpollfd_finish_all (poll_fd,1);
+	g_free (packet_buffers);
+}
+
+#if ARV_GV_STREAM_HAS_REUSEPORT
+
+/* Multiple socket receive
+ *
+ * Additional sockets are bound to the stream port using SO_REUSEPORT, each of them being serviced by its own thread.
+ * A classic BPF program attached to the socket group selects the receiving socket from the GVSP packet id, by ranges
+ * of consecutive packets. As the leader and the first payload packets of a frame always land on the primary socket,
+ * frames are still started in order. The additional receivers do the packet bookkeeping under the reassembly lock,
+ * but their payload copies are done after its release. */
+
+static gboolean
+_attach_reuseport_program (int fd, guint n_sockets)
+{
+	/* The program is run with the packet data starting at the UDP payload. A value greater than the number of
+	 * sockets of the group makes the kernel fall back to the default hash based selection. */
+	struct sock_filter code[] = {
+		/* Extended id flag, in the first byte of the packet infos */
+		BPF_STMT (BPF_LD | BPF_B | BPF_ABS, 4),
+		BPF_JUMP (BPF_JMP | BPF_JSET | BPF_K, 0x80, 3, 0),
+		/* Standard ids, 24 bit packet id in the packet infos */
+		BPF_STMT (BPF_LD | BPF_W | BPF_ABS, 4),
+		BPF_STMT (BPF_ALU | BPF_AND | BPF_K, ARV_GVSP_PACKET_ID_MASK),
+		BPF_JUMP (BPF_JMP | BPF_JA, 1, 0, 0),
+		/* Extended ids, 32 bit packet id after the 64 bit frame id */
+		BPF_STMT (BPF_LD | BPF_W | BPF_ABS, 16),
+		BPF_STMT (BPF_ALU | BPF_RSH | BPF_K, ARV_GV_STREAM_SOCKET_PACKET_RANGE_SHIFT),
+		BPF_STMT (BPF_ALU | BPF_MOD | BPF_K, n_sockets),
+		BPF_STMT (BPF_RET | BPF_A, 0),
+	};
+	struct sock_fprog program = {
+		.len = G_N_ELEMENTS (code),
+		.filter = code
+	};
+
+	return setsockopt (fd, SOL_SOCKET, SO_ATTACH_REUSEPORT_CBPF, &program, sizeof (program)) == 0;
+}
+
+static void *
+_receiver_thread (void *data)
+{
+	ArvGvStreamReceiver *receiver = data;
+	ArvGvStreamThreadData *thread_data = receiver->thread_data;
+	GInputVector packet_iv[ARV_GV_STREAM_NUM_BUFFERS];
+	GInputMessage packet_im[ARV_GV_STREAM_NUM_BUFFERS] = { {NULL, NULL, 0, 0, 0, NULL, NULL}, };
+	ArvGvStreamCopyJob copy_jobs[ARV_GV_STREAM_NUM_BUFFERS];
+	guint packet_buffer_size = thread_data->scps_packet_size - 20 - 8;
+	char *packet_buffers;
+	GPollFD poll_fd[2];
+	gboolean use_poll;
+	int i;
+
+	packet_buffers = g_malloc0 (packet_buffer_size * ARV_GV_STREAM_NUM_BUFFERS);
+
+	for (i = 0; i < ARV_GV_STREAM_NUM_BUFFERS; i++) {
+		packet_iv[i].buffer = packet_buffers + i * packet_buffer_size;
+		packet_iv[i].size = packet_buffer_size;
+		packet_im[i].vectors = &packet_iv[i];
+		packet_im[i].num_vectors = 1;
+	}
+
+	poll_fd[0].fd = g_socket_get_fd (receiver->socket);
+	poll_fd[0].events =  G_IO_IN;
+	poll_fd[0].revents = 0;
+
+	arv_gpollfd_prepare_all (poll_fd, 1);
+
+	use_poll = g_cancellable_make_pollfd (thread_data->cancellable, &poll_fd[1]);
+
+	do {
+		int n_events;
+		int errsv;
+
+		do {
+			poll_fd[0].revents = 0;
+			n_events = g_poll (poll_fd, use_poll ?  2 : 1, ARV_GV_STREAM_POLL_TIMEOUT_US / 1000);
+			errsv = errno;
+		} while (n_events < 0 && errsv == EINTR);
+
+		if (poll_fd[0].revents != 0) {
+			GError *error = NULL;
+			guint n_copy_jobs;
+			int n_msgs;
+
+			arv_gpollfd_clear_one (&poll_fd[0], receiver->socket);
+			n_msgs = g_socket_receive_messages (receiver->socket, packet_im, ARV_GV_STREAM_NUM_BUFFERS,
+							    G_SOCKET_MSG_NONE, NULL, &error);
+
+			if (G_LIKELY (n_msgs > 0)) {
+				guint64 time_us;
+
+				g_mutex_lock (&thread_data->mutex);
+
+				time_us = g_get_monotonic_time ();
+				thread_data->deferred_copies = copy_jobs;
+
+				for (i = 0; i < n_msgs; i++) {
+					ArvGvStreamFrameData *frame;
+
+					frame = _process_packet (thread_data,
+								 (ArvGvspPacket *) (packet_buffers + i * packet_buffer_size),
+								 packet_im[i].bytes_received, NULL, time_us);
+					_check_frame_completion (thread_data, time_us, frame);
+				}
+
+				n_copy_jobs = thread_data->n_deferred_copies;
+				thread_data->deferred_copies = NULL;
+				thread_data->n_deferred_copies = 0;
+
+				_flush_output_buffers (thread_data);
+
+				g_mutex_unlock (&thread_data->mutex);
+
+				_run_copy_jobs (thread_data, copy_jobs, n_copy_jobs);
+
+				*receiver->n_received_packets += n_msgs;
+			} else {
+				arv_warning_stream_thread ("[GvStream::receiver_thread] receive_messages failed: %s",
+							   error != NULL ? error->message : "Unknown reason");
+				g_clear_error (&error);
+			}
+		}
+	} while (!g_cancellable_is_cancelled (thread_data->cancellable));
+
+	if (use_poll)
+		g_cancellable_release_fd (thread_data->cancellable);
+
+	arv_gpollfd_finish_all (poll_fd, 1);
+	g_free (packet_buffers);
+
+	return NULL;
+}
+
+static void
+_start_receivers (ArvGvStreamThreadData *thread_data)
+{
+	GSocketAddress *socket_address;
+	GError *error = NULL;
+	guint n_receivers = 0;
+	guint i;
+
+	if (thread_data->n_sockets < 2)
+		return;
+
+	/* Zero copy receive predicts the packet destinations from the reassembly state of a single socket */
+	if (thread_data->use_zero_copy) {
+		arv_info_stream_thread ("[GvStream::start_receivers] Multiple sockets are not used with zero copy receive");
+		return;
+	}
+
+	/* The option is set after the bind of the primary socket, which lets it join the socket group of the next
+	 * bound socket */
+	if (!g_socket_set_option (thread_data->socket, SOL_SOCKET, SO_REUSEPORT, 1, &error)) {
+		arv_warning_stream_thread ("[GvStream::start_receivers] Failed to allow port reuse (%s)", error->message);
+		g_clear_error (&error);
+		return;
+	}
+
+	socket_address = g_inet_socket_address_new (thread_data->interface_address, thread_data->stream_port);
+	thread_data->receivers = g_new0 (ArvGvStreamReceiver, thread_data->n_sockets - 1);
+
+	for (i = 0; i < thread_data->n_sockets - 1; i++) {
+		ArvGvStreamReceiver *receiver = &thread_data->receivers[n_receivers];
+
+		receiver->socket = g_socket_new (G_SOCKET_FAMILY_IPV4, G_SOCKET_TYPE_DATAGRAM, G_SOCKET_PROTOCOL_UDP,
+						 &error);
+		/* allow_reuse sets SO_REUSEPORT on datagram sockets */
+		if (receiver->socket == NULL ||
+		    !g_socket_bind (receiver->socket, socket_address, TRUE, &error)) {
+			arv_warning_stream_thread ("[GvStream::start_receivers] Failed to bind additional socket (%s)",
+						   error != NULL ? error->message : "Unknown reason");
+			g_clear_error (&error);
+			g_clear_object (&receiver->socket);
+			break;
+		}
+
+		g_socket_set_blocking (receiver->socket, FALSE);
+		if (thread_data->current_socket_buffer_size > 0)
+			arv_socket_set_recv_buffer_size (g_socket_get_fd (receiver->socket),
+							 thread_data->current_socket_buffer_size);
+
+		receiver->thread_data = thread_data;
+		receiver->n_received_packets = &thread_data->n_socket_received_packets[n_receivers + 1];
+		n_receivers++;
+	}
+
+	g_object_unref (socket_address);
+
+	if (n_receivers > 0 &&
+	    !_attach_reuseport_program (g_socket_get_fd (thread_data->socket), n_receivers + 1)) {
+		arv_warning_stream_thread ("[GvStream::start_receivers] Failed to attach socket selection program (%s)",
+					   strerror (errno));
+		for (i = 0; i < n_receivers; i++)
+			g_clear_object (&thread_data->receivers[i].socket);
+		n_receivers = 0;
+	}
+
+	if (n_receivers == 0) {
+		g_clear_pointer (&thread_data->receivers, g_free);
+		return;
+	}
+
+	thread_data->n_receivers = n_receivers;
+
+	for (i = 0; i < n_receivers; i++)
+		thread_data->receivers[i].thread = g_thread_new ("arv_gv_stream_receiver", _receiver_thread,
+								 &thread_data->receivers[i]);
+
+	arv_info_stream_thread ("[GvStream::start_receivers] %u additional socket(s) bound to port %u",
+				n_receivers, thread_data->stream_port);
+}
+
+static void
+_stop_receivers (ArvGvStreamThreadData *thread_data)
+{
+	guint i;
+
+	/* Receiver threads exit on the stream cancellation */
+	for (i = 0; i < thread_data->n_receivers; i++) {
+		ArvGvStreamReceiver *receiver = &thread_data->receivers[i];
+
+		g_thread_join (receiver->thread);
+		g_clear_object (&receiver->socket);
+
+		arv_info_stream_thread ("[GvStream::stop_receivers] Socket %u received %" G_GUINT64_FORMAT " packets",
+					i + 1, *receiver->n_received_packets);
+	}
+
+	g_clear_pointer (&thread_data->receivers, g_free);
+	thread_data->n_receivers = 0;
+}
+
+#else
+
+static void
+_start_receivers (ArvGvStreamThreadData *thread_data)
+{
+	if (thread_data->n_sockets > 1)
+		arv_info_stream_thread ("[GvStream::start_receivers] Multiple sockets are not supported on this platform");
+}
+
+static void
+_stop_receivers (ArvGvStreamThreadData *thread_data)
+{
 }
 
+#endif /* ARV_GV_STREAM_HAS_REUSEPORT */
+
 
 #if ARAVIS_HAS_PACKET_SOCKET
 
@@ -1187,6 +2278,10 @@ _set_socket_filter (int socket, guint32 source_ip, guint32 source_port, guint32
 		arv_warning_stream_thread ("[GvStream::set_socket_filter] Failed to attach Beckerley Packet Filter to stream socket");
 }
 
+#endif /* ARAVIS_HAS_PACKET_SOCKET */
+
+#if ARAVIS_HAS_PACKET_SOCKET || ARAVIS_HAS_XDP
+
 static unsigned
 _interface_index_from_address (guint32 ip)
 {
@@ -1216,12 +2311,87 @@ _interface_index_from_address (guint32 ip)
     return index;
 }
 
+#endif
+
+#if ARAVIS_HAS_PACKET_SOCKET
+
 typedef struct {
 	guint32 version;
 	guint32 offset_to_priv;
 	struct tpacket_hdr_v1 h1;
 } ArvGvStreamBlockDescriptor;
 
+static void
+_compute_ring_geometry (ArvGvStreamThreadData *thread_data, struct tpacket_req3 *req)
+{
+	guint64 page_size = sysconf (_SC_PAGESIZE);
+	guint64 packet_footprint;
+	guint64 frame_footprint;
+	guint64 ring_size;
+	guint64 block_size;
+	guint64 frame_size;
+
+	/* Room taken in a block by a packet, including the ring header and the ethernet, IP and UDP headers */
+	packet_footprint = TPACKET_ALIGN (TPACKET3_HDRLEN + ETH_HLEN + thread_data->scps_packet_size);
+
+	frame_size = thread_data->ring_frame_size > 0 ?
+		TPACKET_ALIGN (MAX (thread_data->ring_frame_size, TPACKET3_HDRLEN)) : packet_footprint;
+
+	if (thread_data->payload_size > 0) {
+		guint64 n_packets;
+
+		n_packets = thread_data->payload_size /
+			(thread_data->scps_packet_size - ARV_GVSP_PAYLOAD_PACKET_PROTOCOL_OVERHEAD (FALSE)) +
+			(3 /* leader + trailer + last partial packet */);
+		frame_footprint = n_packets * packet_footprint;
+	} else
+		frame_footprint = ARV_GV_STREAM_RING_SIZE_MIN;
+
+	/* Room for at least two frames, and for the data received during ARV_GV_STREAM_RING_DURATION_US if the frame
+	 * rate is known */
+	ring_size = 2 * frame_footprint;
+	if (thread_data->frame_rate > 0.0)
+		ring_size = MAX (ring_size, frame_footprint * thread_data->frame_rate *
+				 ARV_GV_STREAM_RING_DURATION_US / 1000000.0);
+	ring_size = CLAMP (ring_size, ARV_GV_STREAM_RING_SIZE_MIN, ARV_GV_STREAM_RING_SIZE_MAX);
+
+	if (thread_data->ring_block_size > 0) {
+		block_size = thread_data->ring_block_size;
+	} else {
+		block_size = page_size;
+		while (block_size < ring_size / ARV_GV_STREAM_RING_N_BLOCKS_MIN / 2 &&
+		       block_size < ARV_GV_STREAM_RING_BLOCK_SIZE_MAX)
+			block_size *= 2;
+	}
+
+	/* The kernel wants blocks made of whole pages, large enough for at least one frame */
+	block_size = MAX (block_size, frame_size);
+	block_size = (block_size + page_size - 1) / page_size * page_size;
+
+	req->tp_block_size = block_size;
+	req->tp_block_nr = thread_data->ring_block_count > 0 ?
+		thread_data->ring_block_count :
+		MAX ((ring_size + block_size - 1) / block_size, ARV_GV_STREAM_RING_N_BLOCKS_MIN);
+	req->tp_frame_size = frame_size;
+	req->tp_frame_nr = (block_size / frame_size) * req->tp_block_nr;
+	req->tp_sizeof_priv = 0;
+	req->tp_retire_blk_tov = thread_data->ring_block_timeout_ms;
+	req->tp_feature_req_word = TP_FT_REQ_FILL_RXHASH;
+}
+
+static void
+_update_ring_statistics (ArvGvStreamThreadData *thread_data, int fd)
+{
+	struct tpacket_stats_v3 stats;
+	socklen_t size = sizeof (stats);
+
+	/* The kernel resets its counters at each read */
+	if (getsockopt (fd, SOL_PACKET, PACKET_STATISTICS, &stats, &size) == 0) {
+		thread_data->n_ring_drops += stats.tp_drops;
+		thread_data->n_ring_freezes += stats.tp_freeze_q_cnt;
+	}
+}
+
 static void
 _ring_buffer_loop (ArvGvStreamThreadData *thread_data)
 {
@@ -1251,19 +2421,18 @@ _ring_buffer_loop (ArvGvStreamThreadData *thread_data)
 		goto socket_option_error;
 	}
 
-	req.tp_block_size = 1 << 21;
-	req.tp_frame_size = 1024;
-	req.tp_block_nr = 16;
-	req.tp_frame_nr = (req.tp_block_size * req.tp_block_nr) / req.tp_frame_size;
-	req.tp_sizeof_priv = 0;
-	req.tp_retire_blk_tov = 5;
-	req.tp_feature_req_word = TP_FT_REQ_FILL_RXHASH;
+	_compute_ring_geometry (thread_data, &req);
+
+	arv_info_stream ("[GvStream::loop] Ring of %u blocks of %u bytes (frame size: %u, timeout: %u ms)",
+			 req.tp_block_nr, req.tp_block_size, req.tp_frame_size, req.tp_retire_blk_tov);
+
 	if (setsockopt (fd, SOL_PACKET, PACKET_RX_RING, &req, sizeof(req)) < 0) {
-		arv_warning_stream_thread ("[GvStream::loop] Failed to set packet rx ring");
+		arv_warning_stream_thread ("[GvStream::loop] Failed to set packet rx ring (%u blocks of %u bytes)",
+					   req.tp_block_nr, req.tp_block_size);
 		goto socket_option_error;
 	}
 
-	buffer = mmap (NULL, req.tp_block_size * req.tp_block_nr, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, 0);
+	buffer = mmap (NULL, (size_t) req.tp_block_size * req.tp_block_nr, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, 0);
 	if (buffer == MAP_FAILED) {
 		arv_warning_stream_thread ("[GvStream::loop] Failed to map ring buffer");
 		goto map_error;
@@ -1305,15 +2474,18 @@ _ring_buffer_loop (ArvGvStreamThreadData *thread_data)
 
 		time_us = g_get_monotonic_time ();
 
-		descriptor = (void *) (buffer + block_id * req.tp_block_size);
+		descriptor = (void *) (buffer + (size_t) block_id * req.tp_block_size);
 		if ((descriptor->h1.block_status & TP_STATUS_USER) == 0) {
                         int timeout_ms;
 			int n_events;
 			int errsv;
 
 			_check_frame_completion (thread_data, time_us, NULL);
+			_flush_output_buffers (thread_data);
+			_update_workers (thread_data);
+			_update_ring_statistics (thread_data, fd);
 
-                        if (thread_data->frames != NULL)
+                        if (thread_data->n_frames > 0)
                                 timeout_ms = thread_data->packet_timeout_us / 1000;
                         else
                                 timeout_ms = ARV_GV_STREAM_POLL_TIMEOUT_US / 1000;
@@ -1338,23 +2510,34 @@ _ring_buffer_loop (ArvGvStreamThreadData *thread_data)
 				packet = (void *) (((char *) ip) + sizeof (struct iphdr) + sizeof (struct udphdr));
 				size = g_ntohs (ip->tot_len) -  sizeof (struct iphdr) - sizeof (struct udphdr);
 
-				frame = _process_packet (thread_data, packet, size, time_us);
+				frame = _process_packet (thread_data, packet, size, NULL, time_us);
 
 				_check_frame_completion (thread_data, time_us, frame);
 
 				header = (void *) (((char *) header) + header->tp_next_offset);
 			}
 
+			_flush_output_buffers (thread_data);
+
+			/* Copy workers read from the block, wait for them before giving it back to the kernel */
+			_set_worker_marks (thread_data, 0);
+			_wait_for_worker_marks (thread_data, 0);
+
 			descriptor->h1.block_status = TP_STATUS_KERNEL;
 			block_id = (block_id + 1) % req.tp_block_nr;
+
+			if (block_id == 0)
+				_update_ring_statistics (thread_data, fd);
 		}
 	} while (!g_cancellable_is_cancelled (thread_data->cancellable));
 
+	_update_ring_statistics (thread_data, fd);
+
 	if (use_poll)
 		g_cancellable_release_fd (thread_data->cancellable);
 
 bind_error:
-	munmap (buffer, req.tp_block_size * req.tp_block_nr);
+	munmap (buffer, (size_t) req.tp_block_size * req.tp_block_nr);
 socket_option_error:
 map_error:
 	close (fd);
@@ -1367,30 +2550,466 @@ af_packet_error:
 
 #endif /* ARAVIS_HAS_PACKET_SOCKET */
 
+#if ARAVIS_HAS_XDP
+
+/* AF_XDP receive path
+ *
+ * A small XDP program redirects the UDP packets sent to the stream port to an AF_XDP socket bound to one queue of the
+ * interface, all the other packets continuing their way through the kernel network stack. The packets are received
+ * in a UMEM region shared with the kernel, without any socket buffer allocation. The program is attached through a
+ * BPF link, which is automatically detached when the stream thread closes it, or if the process dies. */
+
+#define ARV_GV_STREAM_XDP_N_FRAMES	4096	/* Must be a power of 2 */
+#define ARV_GV_STREAM_XDP_FRAME_SIZE	4096
+#ifndef XDP_PACKET_HEADROOM
+#define XDP_PACKET_HEADROOM		256
+#endif
+/* The kernel reserves XDP_PACKET_HEADROOM bytes in front of each packet, in addition to the UMEM headroom */
+#define ARV_GV_STREAM_XDP_MAX_FRAME_LENGTH	(ARV_GV_STREAM_XDP_FRAME_SIZE - XDP_PACKET_HEADROOM)
+#define ARV_GV_STREAM_XDP_CQ_SIZE	64
+
+typedef struct {
+	guint32 *producer;
+	guint32 *consumer;
+	void *descriptors;
+	guint32 mask;
+	void *map;
+	size_t map_size;
+} ArvGvStreamXdpRing;
+
+static int
+_bpf (int command, union bpf_attr *attr)
+{
+	return syscall (__NR_bpf, command, attr, sizeof (*attr));
+}
+
+static int
+_xdp_load_program (int map_fd, guint16 stream_port)
+{
+/*
+ *  0: r6 = r1
+ *  1: r2 = *(u32 *)(r6 + data)
+ *  2: r3 = *(u32 *)(r6 + data_end)
+ *  3: r4 = r2
+ *  4: r4 += 42                                 Ethernet + IP + UDP headers
+ *  5: if r4 > r3 goto 20
+ *  6: r4 = *(u16 *)(r2 + 12)
+ *  7: if r4 != htons (ETH_P_IP) goto 20
+ *  8: r4 = *(u8 *)(r2 + 14)
+ *  9: if r4 != 0x45 goto 20                    IPv4 without options
+ * 10: r4 = *(u8 *)(r2 + 23)
+ * 11: if r4 != IPPROTO_UDP goto 20
+ * 12: r4 = *(u16 *)(r2 + 36)
+ * 13: if r4 != htons (stream_port) goto 20     Destination port
+ * 14: r2 = *(u32 *)(r6 + rx_queue_index)
+ * 15: r1 = map_fd ll
+ * 17: r3 = XDP_PASS                            Action if there is no socket for this queue
+ * 18: call bpf_redirect_map
+ * 19: exit
+ * 20: r0 = XDP_PASS
+ * 21: exit
+ */
+	struct bpf_insn program[] = {
+		{ 0xbf, 6, 1, 0, 0 },
+		{ 0x61, 2, 6, offsetof (struct xdp_md, data), 0 },
+		{ 0x61, 3, 6, offsetof (struct xdp_md, data_end), 0 },
+		{ 0xbf, 4, 2, 0, 0 },
+		{ 0x07, 4, 0, 0, 42 },
+		{ 0x2d, 4, 3, 14, 0 },
+		{ 0x69, 4, 2, 12, 0 },
+		{ 0x55, 4, 0, 12, g_htons (ETH_P_IP) },
+		{ 0x71, 4, 2, 14, 0 },
+		{ 0x55, 4, 0, 10, 0x45 },
+		{ 0x71, 4, 2, 23, 0 },
+		{ 0x55, 4, 0, 8, IPPROTO_UDP },
+		{ 0x69, 4, 2, 36, 0 },
+		{ 0x55, 4, 0, 6, g_htons (stream_port) },
+		{ 0x61, 2, 6, offsetof (struct xdp_md, rx_queue_index), 0 },
+		{ 0x18, 1, BPF_PSEUDO_MAP_FD, 0, map_fd },
+		{ 0x00, 0, 0, 0, 0 },
+		{ 0xb7, 3, 0, 0, XDP_PASS },
+		{ 0x85, 0, 0, 0, BPF_FUNC_redirect_map },
+		{ 0x95, 0, 0, 0, 0 },
+		{ 0xb7, 0, 0, 0, XDP_PASS },
+		{ 0x95, 0, 0, 0, 0 }
+	};
+	union bpf_attr attr;
+
+	memset (&attr, 0, sizeof (attr));
+	attr.prog_type = BPF_PROG_TYPE_XDP;
+	attr.expected_attach_type = BPF_XDP;
+	attr.insns = (guint64) (gsize) program;
+	attr.insn_cnt = G_N_ELEMENTS (program);
+	attr.license = (guint64) (gsize) "GPL";
+
+	return _bpf (BPF_PROG_LOAD, &attr);
+}
+
+static gboolean
+_xdp_map_ring (int fd, ArvGvStreamXdpRing *ring, const struct xdp_ring_offset *offset,
+	       off_t page_offset, guint32 size, size_t descriptor_size)
+{
+	ring->map_size = offset->desc + size * descriptor_size;
+	ring->map = mmap (NULL, ring->map_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, page_offset);
+	if (ring->map == MAP_FAILED) {
+		ring->map = NULL;
+		return FALSE;
+	}
+
+	ring->producer = (void *) ((char *) ring->map + offset->producer);
+	ring->consumer = (void *) ((char *) ring->map + offset->consumer);
+	ring->descriptors = (char *) ring->map + offset->desc;
+	ring->mask = size - 1;
+
+	return TRUE;
+}
+
+static void
+_xdp_unmap_ring (ArvGvStreamXdpRing *ring)
+{
+	if (ring->map != NULL)
+		munmap (ring->map, ring->map_size);
+	ring->map = NULL;
+}
+
+static void
+_update_xdp_statistics (ArvGvStreamThreadData *thread_data, int fd, guint64 n_drops_base)
+{
+	struct xdp_statistics stats;
+	socklen_t size = sizeof (stats);
+
+	memset (&stats, 0, sizeof (stats));
+
+	/* Unlike the packet socket ones, these counters are cumulative */
+	if (getsockopt (fd, SOL_XDP, XDP_STATISTICS, &stats, &size) == 0)
+		thread_data->n_ring_drops = n_drops_base + stats.rx_dropped + stats.rx_ring_full +
+			stats.rx_fill_ring_empty_descs;
+}
+
+/* Returns FALSE if the AF_XDP socket could not be setup, in which case the caller should fall back to another receive
+ * method. */
+
+static gboolean
+_xdp_loop (ArvGvStreamThreadData *thread_data)
+{
+	ArvGvStreamXdpRing fill_ring = {0};
+	ArvGvStreamXdpRing completion_ring = {0};
+	ArvGvStreamXdpRing rx_ring = {0};
+	struct xdp_umem_reg umem_reg = {0};
+	struct xdp_mmap_offsets offsets;
+	struct sockaddr_xdp address = {0};
+	union bpf_attr attr;
+	socklen_t offsets_size = sizeof (offsets);
+	GPollFD poll_fd[2];
+	const guint8 *bytes;
+	char *umem = MAP_FAILED;
+	size_t umem_size = (size_t) ARV_GV_STREAM_XDP_N_FRAMES * ARV_GV_STREAM_XDP_FRAME_SIZE;
+	guint32 ring_size = ARV_GV_STREAM_XDP_N_FRAMES;
+	guint32 completion_ring_size = ARV_GV_STREAM_XDP_CQ_SIZE;
+	guint32 fill_producer;
+	guint32 queue_id = thread_data->xdp_queue;
+	guint64 n_drops_base = thread_data->n_ring_drops;
+	unsigned interface_index;
+	int xsk_fd = -1;
+	int map_fd = -1;
+	int program_fd = -1;
+	int link_fd = -1;
+	gboolean use_poll;
+	gboolean success = FALSE;
+	guint32 i;
+
+	if (thread_data->scps_packet_size + ETH_HLEN > ARV_GV_STREAM_XDP_MAX_FRAME_LENGTH) {
+		arv_warning_stream_thread ("[GvStream::xdp_loop] Packet size too large for AF_XDP "
+					   "(%u bytes, maximum is %u bytes)",
+					   thread_data->scps_packet_size,
+					   ARV_GV_STREAM_XDP_MAX_FRAME_LENGTH - ETH_HLEN);
+		return FALSE;
+	}
+
+	bytes = g_inet_address_to_bytes (thread_data->interface_address);
+	interface_index = _interface_index_from_address (g_ntohl (*((guint32 *) bytes)));
+	if (interface_index == 0) {
+		arv_warning_stream_thread ("[GvStream::xdp_loop] Failed to find interface index");
+		return FALSE;
+	}
+
+	xsk_fd = socket (AF_XDP, SOCK_RAW, 0);
+	if (xsk_fd < 0) {
+		arv_warning_stream_thread ("[GvStream::xdp_loop] Failed to create AF_XDP socket (%s)",
+					   g_strerror (errno));
+		goto error;
+	}
+
+	umem = mmap (NULL, umem_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (umem == MAP_FAILED) {
+		arv_warning_stream_thread ("[GvStream::xdp_loop] Failed to allocate UMEM");
+		goto error;
+	}
+
+	umem_reg.addr = (guint64) (gsize) umem;
+	umem_reg.len = umem_size;
+	umem_reg.chunk_size = ARV_GV_STREAM_XDP_FRAME_SIZE;
+	umem_reg.headroom = 0;
+
+	if (setsockopt (xsk_fd, SOL_XDP, XDP_UMEM_REG, &umem_reg, sizeof (umem_reg)) < 0 ||
+	    setsockopt (xsk_fd, SOL_XDP, XDP_UMEM_FILL_RING, &ring_size, sizeof (ring_size)) < 0 ||
+	    setsockopt (xsk_fd, SOL_XDP, XDP_UMEM_COMPLETION_RING,
+			&completion_ring_size, sizeof (completion_ring_size)) < 0 ||
+	    setsockopt (xsk_fd, SOL_XDP, XDP_RX_RING, &ring_size, sizeof (ring_size)) < 0) {
+		arv_warning_stream_thread ("[GvStream::xdp_loop] Failed to setup UMEM (%s)", g_strerror (errno));
+		goto error;
+	}
+
+	if (getsockopt (xsk_fd, SOL_XDP, XDP_MMAP_OFFSETS, &offsets, &offsets_size) < 0 ||
+	    !_xdp_map_ring (xsk_fd, &fill_ring, &offsets.fr, XDP_UMEM_PGOFF_FILL_RING,
+			    ring_size, sizeof (guint64)) ||
+	    !_xdp_map_ring (xsk_fd, &completion_ring, &offsets.cr, XDP_UMEM_PGOFF_COMPLETION_RING,
+			    completion_ring_size, sizeof (guint64)) ||
+	    !_xdp_map_ring (xsk_fd, &rx_ring, &offsets.rx, XDP_PGOFF_RX_RING,
+			    ring_size, sizeof (struct xdp_desc))) {
+		arv_warning_stream_thread ("[GvStream::xdp_loop] Failed to map rings (%s)", g_strerror (errno));
+		goto error;
+	}
+
+	/* Hand all the UMEM frames to the kernel */
+	for (i = 0; i < ARV_GV_STREAM_XDP_N_FRAMES; i++)
+		((guint64 *) fill_ring.descriptors)[i] = (guint64) i * ARV_GV_STREAM_XDP_FRAME_SIZE;
+	fill_producer = ARV_GV_STREAM_XDP_N_FRAMES;
+	g_atomic_int_set ((gint *) fill_ring.producer, fill_producer);
+
+	address.sxdp_family = AF_XDP;
+	address.sxdp_ifindex = interface_index;
+	address.sxdp_queue_id = queue_id;
+	address.sxdp_flags = 0;
+	if (bind (xsk_fd, (struct sockaddr *) &address, sizeof (address)) < 0) {
+		/* Driver without zero copy support */
+		address.sxdp_flags = XDP_COPY;
+		if (bind (xsk_fd, (struct sockaddr *) &address, sizeof (address)) < 0) {
+			arv_warning_stream_thread ("[GvStream::xdp_loop] Failed to bind AF_XDP socket to queue %u (%s)",
+						   queue_id, g_strerror (errno));
+			goto error;
+		}
+	}
+
+	memset (&attr, 0, sizeof (attr));
+	attr.map_type = BPF_MAP_TYPE_XSKMAP;
+	attr.key_size = sizeof (guint32);
+	attr.value_size = sizeof (guint32);
+	attr.max_entries = ARV_GV_STREAM_XDP_N_QUEUES_MAX;
+	map_fd = _bpf (BPF_MAP_CREATE, &attr);
+	if (map_fd < 0) {
+		arv_warning_stream_thread ("[GvStream::xdp_loop] Failed to create XSK map (%s)", g_strerror (errno));
+		goto error;
+	}
+
+	memset (&attr, 0, sizeof (attr));
+	attr.map_fd = map_fd;
+	attr.key = (guint64) (gsize) &queue_id;
+	attr.value = (guint64) (gsize) &xsk_fd;
+	if (_bpf (BPF_MAP_UPDATE_ELEM, &attr) < 0) {
+		arv_warning_stream_thread ("[GvStream::xdp_loop] Failed to update XSK map (%s)", g_strerror (errno));
+		goto error;
+	}
+
+	program_fd = _xdp_load_program (map_fd, thread_data->stream_port);
+	if (program_fd < 0) {
+		arv_warning_stream_thread ("[GvStream::xdp_loop] Failed to load XDP program (%s)", g_strerror (errno));
+		goto error;
+	}
+
+	/* Let the kernel choose the XDP mode, then fall back to the generic mode, which works with any interface */
+	memset (&attr, 0, sizeof (attr));
+	attr.link_create.prog_fd = program_fd;
+	attr.link_create.target_ifindex = interface_index;
+	attr.link_create.attach_type = BPF_XDP;
+	link_fd = _bpf (BPF_LINK_CREATE, &attr);
+	if (link_fd < 0) {
+		attr.link_create.flags = XDP_FLAGS_SKB_MODE;
+		link_fd = _bpf (BPF_LINK_CREATE, &attr);
+	}
+	if (link_fd < 0) {
+		arv_warning_stream_thread ("[GvStream::xdp_loop] Failed to attach XDP program (%s)", g_strerror (errno));
+		goto error;
+	}
+
+	arv_info_stream ("[GvStream::loop] AF_XDP socket method (queue %u, %s mode)", queue_id,
+			 (address.sxdp_flags & XDP_COPY) != 0 ? "copy" : "zero copy");
+
+	poll_fd[0].fd = xsk_fd;
+	poll_fd[0].events = G_IO_IN;
+	poll_fd[0].revents = 0;
+
+	use_poll = g_cancellable_make_pollfd (thread_data->cancellable, &poll_fd[1]);
+
+        g_mutex_lock (&thread_data->thread_started_mutex);
+        thread_data->thread_started = TRUE;
+        g_cond_signal (&thread_data->thread_started_cond);
+        g_mutex_unlock (&thread_data->thread_started_mutex);
+
+	success = TRUE;
+
+	do {
+		guint32 rx_producer;
+		guint32 rx_consumer;
+		guint32 n_descriptors;
+		guint64 time_us;
+
+		rx_consumer = *rx_ring.consumer;
+		rx_producer = g_atomic_int_get ((gint *) rx_ring.producer);
+		n_descriptors = rx_producer - rx_consumer;
+
+		if (n_descriptors == 0) {
+			int timeout_ms;
+			int n_events;
+			int errsv;
+
+			time_us = g_get_monotonic_time ();
+
+			_check_frame_completion (thread_data, time_us, NULL);
+			_flush_output_buffers (thread_data);
+			_update_workers (thread_data);
+			_update_xdp_statistics (thread_data, xsk_fd, n_drops_base);
+
+			if (thread_data->n_frames > 0)
+				timeout_ms = thread_data->packet_timeout_us / 1000;
+			else
+				timeout_ms = ARV_GV_STREAM_POLL_TIMEOUT_US / 1000;
+
+			do {
+				poll_fd[0].revents = 0;
+				n_events = g_poll (poll_fd, use_poll ? 2 : 1, timeout_ms);
+				errsv = errno;
+			} while (n_events < 0 && errsv == EINTR);
+
+			continue;
+		}
+
+		time_us = g_get_monotonic_time ();
+
+		for (i = 0; i < n_descriptors; i++) {
+			const struct xdp_desc *descriptor;
+			const struct iphdr *ip;
+			const ArvGvspPacket *packet;
+			ArvGvStreamFrameData *frame;
+			size_t ip_header_size;
+			size_t size;
+
+			descriptor = &((struct xdp_desc *) rx_ring.descriptors)[(rx_consumer + i) & rx_ring.mask];
+
+			ip = (void *) (umem + descriptor->addr + ETH_HLEN);
+			ip_header_size = ip->ihl * 4;
+			size = g_ntohs (ip->tot_len);
+
+			if (size < ip_header_size + sizeof (struct udphdr) ||
+			    size + ETH_HLEN > descriptor->len) {
+				thread_data->n_ignored_packets++;
+				continue;
+			}
+
+			packet = (void *) (((char *) ip) + ip_header_size + sizeof (struct udphdr));
+			size -= ip_header_size + sizeof (struct udphdr);
+
+			frame = _process_packet (thread_data, packet, size, NULL, time_us);
+
+			_check_frame_completion (thread_data, time_us, frame);
+		}
+
+		_flush_output_buffers (thread_data);
+
+		/* Copy workers read from the UMEM frames, wait for them before recycling the frames */
+		_set_worker_marks (thread_data, 0);
+		_wait_for_worker_marks (thread_data, 0);
+
+		/* All the UMEM frames are either owned by the kernel or in the rx ring, there is always room in the fill
+		 * ring for the received ones */
+		for (i = 0; i < n_descriptors; i++) {
+			const struct xdp_desc *descriptor;
+
+			descriptor = &((struct xdp_desc *) rx_ring.descriptors)[(rx_consumer + i) & rx_ring.mask];
+			((guint64 *) fill_ring.descriptors)[(fill_producer + i) & fill_ring.mask] =
+				descriptor->addr & ~((guint64) ARV_GV_STREAM_XDP_FRAME_SIZE - 1);
+		}
+
+		fill_producer += n_descriptors;
+		g_atomic_int_set ((gint *) fill_ring.producer, fill_producer);
+		g_atomic_int_set ((gint *) rx_ring.consumer, rx_consumer + n_descriptors);
+	} while (!g_cancellable_is_cancelled (thread_data->cancellable));
+
+	_update_xdp_statistics (thread_data, xsk_fd, n_drops_base);
+
+	if (use_poll)
+		g_cancellable_release_fd (thread_data->cancellable);
+
+error:
+	if (link_fd >= 0)
+		close (link_fd);
+	if (program_fd >= 0)
+		close (program_fd);
+	if (map_fd >= 0)
+		close (map_fd);
+	_xdp_unmap_ring (&rx_ring);
+	_xdp_unmap_ring (&completion_ring);
+	_xdp_unmap_ring (&fill_ring);
+	if (xsk_fd >= 0)
+		close (xsk_fd);
+	if (umem != MAP_FAILED)
+		munmap (umem, umem_size);
+
+	return success;
+}
+
+#endif /* ARAVIS_HAS_XDP */
+
 static void *
 arv_gv_stream_thread (void *data)
 {
 	ArvGvStreamThreadData *thread_data = data;
+	gboolean loop_done = FALSE;
 #if ARAVIS_HAS_PACKET_SOCKET
 	int fd;
 #endif
 
-	thread_data->frames = NULL;
+	thread_data->first_frame = 0;
+	thread_data->n_frames = 0;
 	thread_data->last_frame_id = 0;
 	thread_data->first_packet = TRUE;
+	thread_data->zero_copy_frame_id = 0;
+	thread_data->zero_copy_packet_id = 0;
 
 	if (thread_data->callback != NULL)
 		thread_data->callback (thread_data->callback_data, ARV_STREAM_CALLBACK_TYPE_INIT, NULL);
 
+	_start_workers (thread_data);
+	_preallocate_frames (thread_data);
+
+#if ARAVIS_HAS_XDP
+	if (thread_data->use_xdp)
+		loop_done = _xdp_loop (thread_data);
+#endif
+
+	if (thread_data->xdp_requested && !loop_done) {
+		thread_data->n_xdp_fallbacks++;
+		arv_info_stream_thread ("[GvStream::thread] AF_XDP socket not available, fall back to the socket receive");
+	}
+
+	if (!loop_done) {
 #if ARAVIS_HAS_PACKET_SOCKET
-	if (thread_data->use_packet_socket && (fd = socket (PF_PACKET, SOCK_RAW, g_htons (ETH_P_ALL))) >= 0) {
-		close (fd);
-		_ring_buffer_loop (thread_data);
-	} else
+		if (thread_data->use_packet_socket && (fd = socket (PF_PACKET, SOCK_RAW, g_htons (ETH_P_ALL))) >= 0) {
+			close (fd);
+			_ring_buffer_loop (thread_data);
+		} else
 #endif
-		_loop (thread_data);
+		{
+			_start_receivers (thread_data);
+			_loop (thread_data);
+			_stop_receivers (thread_data);
+		}
+	}
 
 	_flush_frames (thread_data, g_get_monotonic_time ());
+	_free_frames (thread_data);
+
+	_stop_workers (thread_data);
 
 	if (thread_data->callback != NULL)
 		thread_data->callback (thread_data->callback_data, ARV_STREAM_CALLBACK_TYPE_EXIT, NULL);
@@ -1410,17 +3029,56 @@ arv_gv_stream_get_port (ArvGvStream *gv_stream)
 	return priv->thread_data->stream_port;
 }
 
+static gint
+arv_gv_stream_get_numa_node (ArvStream *stream)
+{
+	ArvGvStreamPrivate *priv = arv_gv_stream_get_instance_private (ARV_GV_STREAM (stream));
+	char *address;
+	gint numa_node;
+
+	if (priv->thread_data == NULL || priv->thread_data->interface_address == NULL)
+		return -1;
+
+	address = g_inet_address_to_string (priv->thread_data->interface_address);
+	numa_node = arv_network_get_interface_numa_node (address);
+	g_free (address);
+
+	return numa_node;
+}
+
 static gboolean
 arv_gv_stream_start_acquisition (ArvStream *stream, GError **error)
 {
 	ArvGvStreamPrivate *priv = arv_gv_stream_get_instance_private (ARV_GV_STREAM (stream));
 	ArvGvStreamThreadData *thread_data;
+	GError *local_error = NULL;
 
 	g_return_val_if_fail (priv->thread == NULL, FALSE);
 	g_return_val_if_fail (priv->thread_data != NULL, FALSE);
 
 	thread_data = priv->thread_data;
 
+	/* Used for the preallocation of the packet arrays, which are grown on demand if needed */
+	thread_data->payload_size = arv_device_get_integer_feature_value (ARV_DEVICE (priv->gv_device),
+									  "PayloadSize", &local_error);
+	if (local_error != NULL) {
+		arv_info_stream ("[GvStream::start_acquisition] Failed to read payload size: %s",
+				 local_error->message);
+		thread_data->payload_size = 0;
+		g_clear_error (&local_error);
+	}
+
+	/* Used for the automatic sizing of the packet socket ring */
+	thread_data->frame_rate = 0.0;
+	if (thread_data->use_packet_socket) {
+		thread_data->frame_rate = arv_device_get_float_feature_value (ARV_DEVICE (priv->gv_device),
+									      "AcquisitionFrameRate", &local_error);
+		if (local_error != NULL) {
+			thread_data->frame_rate = 0.0;
+			g_clear_error (&local_error);
+		}
+	}
+
         thread_data->thread_started = FALSE;
 	thread_data->cancellable = g_cancellable_new ();
 	priv->thread = g_thread_new ("arv_gv_stream", arv_gv_stream_thread, priv->thread_data);
@@ -1533,6 +3191,37 @@ arv_gv_stream_set_property (GObject * object, guint prop_id,
 		case ARV_GV_STREAM_PROPERTY_FRAME_RETENTION:
 			thread_data->frame_retention_us = g_value_get_uint (value);
 			break;
+		case ARV_GV_STREAM_PROPERTY_N_WORKERS:
+			g_atomic_int_set (&thread_data->n_workers, g_value_get_uint (value));
+			break;
+		case ARV_GV_STREAM_PROPERTY_RING_BLOCK_SIZE:
+			thread_data->ring_block_size = g_value_get_uint (value);
+			break;
+		case ARV_GV_STREAM_PROPERTY_RING_BLOCK_COUNT:
+			thread_data->ring_block_count = g_value_get_uint (value);
+			break;
+		case ARV_GV_STREAM_PROPERTY_RING_FRAME_SIZE:
+			thread_data->ring_frame_size = g_value_get_uint (value);
+			break;
+		case ARV_GV_STREAM_PROPERTY_RING_BLOCK_TIMEOUT:
+			thread_data->ring_block_timeout_ms = g_value_get_uint (value);
+			break;
+		case ARV_GV_STREAM_PROPERTY_XDP_QUEUE:
+			thread_data->xdp_queue = g_value_get_uint (value);
+			break;
+		case ARV_GV_STREAM_PROPERTY_N_SOCKETS:
+			thread_data->n_sockets = g_value_get_uint (value);
+			/* The counters of the stream infos are never removed, only the missing ones are declared */
+			if (thread_data->n_sockets > 1) {
+				for (; priv->n_socket_infos < thread_data->n_sockets; priv->n_socket_infos++) {
+					char *name = g_strdup_printf ("n_received_packets_socket_%u", priv->n_socket_infos);
+
+					arv_stream_declare_info (ARV_STREAM (object), name, G_TYPE_UINT64,
+								 &thread_data->n_socket_received_packets[priv->n_socket_infos]);
+					g_free (name);
+				}
+			}
+			break;
 		default:
 			G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
 			break;
@@ -1570,6 +3259,27 @@ arv_gv_stream_get_property (GObject * object, guint prop_id,
 		case ARV_GV_STREAM_PROPERTY_FRAME_RETENTION:
 			g_value_set_uint (value, thread_data->frame_retention_us);
 			break;
+		case ARV_GV_STREAM_PROPERTY_N_WORKERS:
+			g_value_set_uint (value, g_atomic_int_get (&thread_data->n_workers));
+			break;
+		case ARV_GV_STREAM_PROPERTY_RING_BLOCK_SIZE:
+			g_value_set_uint (value, thread_data->ring_block_size);
+			break;
+		case ARV_GV_STREAM_PROPERTY_RING_BLOCK_COUNT:
+			g_value_set_uint (value, thread_data->ring_block_count);
+			break;
+		case ARV_GV_STREAM_PROPERTY_RING_FRAME_SIZE:
+			g_value_set_uint (value, thread_data->ring_frame_size);
+			break;
+		case ARV_GV_STREAM_PROPERTY_RING_BLOCK_TIMEOUT:
+			g_value_set_uint (value, thread_data->ring_block_timeout_ms);
+			break;
+		case ARV_GV_STREAM_PROPERTY_XDP_QUEUE:
+			g_value_set_uint (value, thread_data->xdp_queue);
+			break;
+		case ARV_GV_STREAM_PROPERTY_N_SOCKETS:
+			g_value_set_uint (value, thread_data->n_sockets);
+			break;
 		default:
 			G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
 			break;
@@ -1641,8 +3351,16 @@ arv_gv_stream_constructed (GObject *object)
 		      NULL);
 
 	priv->thread_data->timestamp_tick_frequency = timestamp_tick_frequency;
+	priv->thread_data->clock_model = arv_gv_device_get_clock_model (priv->gv_device);
 	priv->thread_data->scps_packet_size = packet_size;
-	priv->thread_data->use_packet_socket = (options & ARV_GV_STREAM_OPTION_PACKET_SOCKET_DISABLED) == 0;
+	priv->thread_data->use_zero_copy = (options & ARV_GV_STREAM_OPTION_ZERO_COPY_ENABLED) != 0;
+	priv->thread_data->xdp_requested = (options & ARV_GV_STREAM_OPTION_XDP_ENABLED) != 0;
+	priv->thread_data->use_xdp = ARAVIS_HAS_XDP && priv->thread_data->xdp_requested;
+	priv->thread_data->use_packet_socket = (options & ARV_GV_STREAM_OPTION_PACKET_SOCKET_DISABLED) == 0 &&
+		!priv->thread_data->use_zero_copy && !priv->thread_data->use_xdp;
+
+	if (priv->thread_data->xdp_requested && !priv->thread_data->use_xdp)
+		arv_warning_stream ("[GvStream::stream_new] Aravis is compiled without XDP support");
 
 	priv->thread_data->packet_id = 65300;
 
@@ -1705,6 +3423,8 @@ arv_gv_stream_constructed (GObject *object)
                                  G_TYPE_UINT64, &priv->thread_data->n_ignored_packets);
         arv_stream_declare_info (ARV_STREAM (gv_stream), "n_resend_requests",
                                  G_TYPE_UINT64, &priv->thread_data->n_resend_requests);
+        arv_stream_declare_info (ARV_STREAM (gv_stream), "n_resend_commands",
+                                 G_TYPE_UINT64, &priv->thread_data->n_resend_commands);
         arv_stream_declare_info (ARV_STREAM (gv_stream), "n_resent_packets",
                                  G_TYPE_UINT64, &priv->thread_data->n_resent_packets);
         arv_stream_declare_info (ARV_STREAM (gv_stream), "n_resend_ratio_reached",
@@ -1717,6 +3437,16 @@ arv_gv_stream_constructed (GObject *object)
                                  G_TYPE_UINT64, &priv->thread_data->n_transferred_bytes);
         arv_stream_declare_info (ARV_STREAM (gv_stream), "n_ignored_bytes",
                                  G_TYPE_UINT64, &priv->thread_data->n_ignored_bytes);
+        arv_stream_declare_info (ARV_STREAM (gv_stream), "n_zero_copy_bytes",
+                                 G_TYPE_UINT64, &priv->thread_data->n_zero_copy_bytes);
+        arv_stream_declare_info (ARV_STREAM (gv_stream), "n_offloaded_bytes",
+                                 G_TYPE_UINT64, &priv->thread_data->n_offloaded_bytes);
+        arv_stream_declare_info (ARV_STREAM (gv_stream), "n_ring_drops",
+                                 G_TYPE_UINT64, &priv->thread_data->n_ring_drops);
+        arv_stream_declare_info (ARV_STREAM (gv_stream), "n_ring_freezes",
+                                 G_TYPE_UINT64, &priv->thread_data->n_ring_freezes);
+        arv_stream_declare_info (ARV_STREAM (gv_stream), "n_xdp_fallbacks",
+                                 G_TYPE_UINT64, &priv->thread_data->n_xdp_fallbacks);
 }
 
 static void
@@ -1775,6 +3505,8 @@ arv_gv_stream_finalize (GObject *object)
 
 		arv_info_stream ("[GvStream::finalize] n_resend_requests      = %" G_GUINT64_FORMAT,
 				  thread_data->n_resend_requests);
+		arv_info_stream ("[GvStream::finalize] n_resend_commands      = %" G_GUINT64_FORMAT,
+				  thread_data->n_resend_commands);
 		arv_info_stream ("[GvStream::finalize] n_resent_packets       = %" G_GUINT64_FORMAT,
 				  thread_data->n_resent_packets);
 		arv_info_stream ("[GvStream::finalize] n_resend_ratio_reached = %" G_GUINT64_FORMAT,
@@ -1788,6 +3520,17 @@ arv_gv_stream_finalize (GObject *object)
 				  thread_data->n_transferred_bytes);
 		arv_info_stream ("[GvStream::finalize] n_ignored_bytes        = %" G_GUINT64_FORMAT,
 				  thread_data->n_ignored_bytes);
+		arv_info_stream ("[GvStream::finalize] n_zero_copy_bytes      = %" G_GUINT64_FORMAT,
+				  thread_data->n_zero_copy_bytes);
+		arv_info_stream ("[GvStream::finalize] n_offloaded_bytes      = %" G_GUINT64_FORMAT,
+				  thread_data->n_offloaded_bytes);
+
+		arv_info_stream ("[GvStream::finalize] n_ring_drops           = %" G_GUINT64_FORMAT,
+				  thread_data->n_ring_drops);
+		arv_info_stream ("[GvStream::finalize] n_ring_freezes         = %" G_GUINT64_FORMAT,
+				  thread_data->n_ring_freezes);
+		arv_info_stream ("[GvStream::finalize] n_xdp_fallbacks        = %" G_GUINT64_FORMAT,
+				  thread_data->n_xdp_fallbacks);
 
 		g_clear_object (&thread_data->device_address);
 		g_clear_object (&thread_data->interface_address);
@@ -1816,6 +3559,7 @@ arv_gv_stream_class_init (ArvGvStreamClass *gv_stream_class)
 
 	stream_class->start_acquisition = arv_gv_stream_start_acquisition;
 	stream_class->stop_acquisition = arv_gv_stream_stop_acquisition;
+	stream_class->get_numa_node = arv_gv_stream_get_numa_node;
 
         /**
          * ArvGvStream:socket-buffer:
@@ -1917,4 +3661,135 @@ arv_gv_stream_class_init (ArvGvStreamClass *gv_stream_class)
 				   ARV_GV_STREAM_FRAME_RETENTION_US_DEFAULT,
 				   G_PARAM_CONSTRUCT | G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)
 		);
+        /**
+         * ArvGvStream:n-workers:
+         *
+         * Number of worker threads used for the copy of the payload data into the buffers. With the default value of
+         * 0, the copies are done by the stream receiving thread. Packets are dispatched to the workers by packet id
+         * ranges, which helps when a single core is not able to keep up with the link bandwidth. The value is taken
+         * into account as soon as no frame is being received.
+         *
+         * Since: 0.10.0
+         */
+	g_object_class_install_property (
+		object_class, ARV_GV_STREAM_PROPERTY_N_WORKERS,
+		g_param_spec_uint ("n-workers", "Number of workers",
+				   "Number of payload copy worker threads",
+				   0,
+				   ARV_GV_STREAM_N_WORKERS_MAX,
+				   0,
+				   G_PARAM_CONSTRUCT | G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)
+		);
+        /**
+         * ArvGvStream:ring-block-size:
+         *
+         * Size of the blocks of the packet socket receive ring, in bytes. It is rounded up to a multiple of the page
+         * size. With the default value of 0, it is derived from the size of the ring, which itself depends on the
+         * payload size, the frame rate and the packet size. The value is taken into account at the next acquisition
+         * start.
+         *
+         * Since: 0.10.0
+         */
+	g_object_class_install_property (
+		object_class, ARV_GV_STREAM_PROPERTY_RING_BLOCK_SIZE,
+		g_param_spec_uint ("ring-block-size", "Ring block size",
+				   "Packet socket ring block size, in bytes, 0 for automatic",
+				   0,
+				   G_MAXUINT,
+				   0,
+				   G_PARAM_CONSTRUCT | G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)
+		);
+        /**
+         * ArvGvStream:ring-block-count:
+         *
+         * Number of blocks of the packet socket receive ring. With the default value of 0, the ring is sized to hold
+         * at least two frames, and 100 ms of stream data when the frame rate is known.
+         *
+         * Since: 0.10.0
+         */
+	g_object_class_install_property (
+		object_class, ARV_GV_STREAM_PROPERTY_RING_BLOCK_COUNT,
+		g_param_spec_uint ("ring-block-count", "Ring block count",
+				   "Packet socket ring block count, 0 for automatic",
+				   0,
+				   G_MAXUINT,
+				   0,
+				   G_PARAM_CONSTRUCT | G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)
+		);
+        /**
+         * ArvGvStream:ring-frame-size:
+         *
+         * Frame size of the packet socket receive ring, in bytes. With the default value of 0, it is derived from the
+         * packet size.
+         *
+         * Since: 0.10.0
+         */
+	g_object_class_install_property (
+		object_class, ARV_GV_STREAM_PROPERTY_RING_FRAME_SIZE,
+		g_param_spec_uint ("ring-frame-size", "Ring frame size",
+				   "Packet socket ring frame size, in bytes, 0 for automatic",
+				   0,
+				   G_MAXUINT,
+				   0,
+				   G_PARAM_CONSTRUCT | G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)
+		);
+        /**
+         * ArvGvStream:ring-block-timeout:
+         *
+         * Delay after which a partially filled block of the packet socket receive ring is handed to the stream
+         * thread.
+         *
+         * Since: 0.10.0
+         */
+	g_object_class_install_property (
+		object_class, ARV_GV_STREAM_PROPERTY_RING_BLOCK_TIMEOUT,
+		g_param_spec_uint ("ring-block-timeout", "Ring block timeout",
+				   "Packet socket ring block retire timeout, in ms",
+				   0,
+				   G_MAXUINT,
+				   ARV_GV_STREAM_RING_BLOCK_TIMEOUT_MS_DEFAULT,
+				   G_PARAM_CONSTRUCT | G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)
+		);
+        /**
+         * ArvGvStream:xdp-queue:
+         *
+         * Interface receive queue the AF_XDP socket is bound to, when enabled by %ARV_GV_STREAM_OPTION_XDP_ENABLED.
+         * Stream packets arriving on the other queues are not seen by the AF_XDP socket, the stream traffic must be
+         * steered to this queue on multiqueue network interfaces, for example using ethtool flow rules. The value is
+         * taken into account at the next acquisition start.
+         *
+         * Since: 0.10.0
+         */
+	g_object_class_install_property (
+		object_class, ARV_GV_STREAM_PROPERTY_XDP_QUEUE,
+		g_param_spec_uint ("xdp-queue", "XDP queue",
+				   "Interface receive queue used by the AF_XDP socket",
+				   0,
+				   ARV_GV_STREAM_XDP_N_QUEUES_MAX - 1,
+				   0,
+				   G_PARAM_CONSTRUCT | G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)
+		);
+        /**
+         * ArvGvStream:n-sockets:
+         *
+         * Number of sockets bound to the stream port, each one serviced by its own thread, in order to spread the
+         * reception of a high bandwidth stream over several cores. Packets are distributed to the sockets by ranges
+         * of packet ids. Buffer completion callbacks may then be called from any of these threads. This is only
+         * supported on Linux, with the standard socket receive method. The value is ignored with zero copy receive,
+         * which only uses the primary socket. It is taken into account at the next acquisition start.
+         *
+         * When more than one socket is requested, the number of packets received by each socket is available as
+         * the n_received_packets_socket_<index> stream infos, the primary socket having the index 0.
+         *
+         * Since: 0.10.0
+         */
+	g_object_class_install_property (
+		object_class, ARV_GV_STREAM_PROPERTY_N_SOCKETS,
+		g_param_spec_uint ("n-sockets", "Number of sockets",
+				   "Number of sockets bound to the stream port, ignored with zero copy receive",
+				   1,
+				   ARV_GV_STREAM_N_SOCKETS_MAX,
+				   1,
+				   G_PARAM_CONSTRUCT | G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)
+		);
 }
@@ -37,11 +37,18 @@ G_BEGIN_DECLS
  * ArvGvStreamOption:
  * @ARV_GV_STREAM_OPTION_NONE: no option specified
  * @ARV_GV_STREAM_OPTION_PACKET_SOCKET_DISABLED: use of packet socket is disabled
+ * @ARV_GV_STREAM_OPTION_ZERO_COPY_ENABLED: payload data is received directly into the buffer memory, without intermediate
+ * copy. This implies the use of the standard socket receive method. (Since: 0.10.0)
+ * @ARV_GV_STREAM_OPTION_XDP_ENABLED: packets are received using an AF_XDP socket, if aravis is compiled with XDP
+ * support. This requires the CAP_NET_ADMIN and CAP_BPF capabilities. If the AF_XDP socket can not be setup, the
+ * standard socket receive method is used, and the n_xdp_fallbacks stream info is incremented. (Since: 0.10.0)
  */
 
 typedef enum {
 	ARV_GV_STREAM_OPTION_NONE =                             0,
 	ARV_GV_STREAM_OPTION_PACKET_SOCKET_DISABLED =           1 << 0,
+	ARV_GV_STREAM_OPTION_ZERO_COPY_ENABLED =                1 << 1,
+	ARV_GV_STREAM_OPTION_XDP_ENABLED =                      1 << 2,
 } ArvGvStreamOption;
 
 /**
@@ -34,6 +34,10 @@ G_BEGIN_DECLS
 #define ARV_GV_STREAM_PACKET_TIMEOUT_US_DEFAULT		20000
 #define ARV_GV_STREAM_FRAME_RETENTION_US_DEFAULT	100000
 #define ARV_GV_STREAM_PACKET_REQUEST_RATIO_DEFAULT	0.25
+#define ARV_GV_STREAM_N_WORKERS_MAX			16
+#define ARV_GV_STREAM_N_SOCKETS_MAX			16
+#define ARV_GV_STREAM_RING_BLOCK_TIMEOUT_MS_DEFAULT	5
+#define ARV_GV_STREAM_XDP_N_QUEUES_MAX			64
 
 ArvStream * 	arv_gv_stream_new		(ArvGvDevice *gv_device, ArvStreamCallback callback, void *callback_data, GDestroyNotify destroy, GError **error);
 
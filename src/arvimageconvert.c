@@ -0,0 +1,1612 @@
+/* Aravis - Digital camera library
+ *
+ * Copyright © 2009-2025 Emmanuel Pacaud <emmanuel.pacaud@free.fr>
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: Emmanuel Pacaud <emmanuel.pacaud@free.fr>
+ */
+
+/*
+ * Unpacking of the packed pixel formats to 8 or 16 bit per sample, and demosaicing of the Bayer formats.
+ *
+ * Two packing schemes exist: the GigE Vision "Packed" formats, where 2 samples are stored in 3 bytes, the most
+ * significant bits first, and the PFNC "p" formats, which are a little endian bit stream of 10, 12 or 14 bit samples.
+ *
+ * Each packing has a scalar reference implementation. SSE4.1 and AVX2 variants are selected at runtime on x86 if the
+ * CPU supports them, NEON is always used on aarch64. The vector variants convert blocks of 8 samples, which always
+ * start on a byte boundary, the remaining samples being handled by the scalar code.
+ */
+
+#include <arvimageconvertprivate.h>
+#include <arvbufferprivate.h>
+#include <arvdebugprivate.h>
+#include <string.h>
+
+#if defined (__GNUC__) && (defined (__x86_64__) || defined (__i386__))
+#define ARV_IMAGE_CONVERT_HAS_X86 1
+#include <immintrin.h>
+#define ARV_TARGET_SSE4_1	__attribute__ ((target ("sse4.1")))
+#define ARV_TARGET_AVX2		__attribute__ ((target ("avx2")))
+#define ARV_ALWAYS_INLINE	inline __attribute__ ((always_inline))
+#endif
+
+#if defined (__aarch64__) && defined (__ARM_NEON)
+#define ARV_IMAGE_CONVERT_HAS_NEON 1
+#include <arm_neon.h>
+#endif
+
+GQuark
+arv_image_convert_error_quark (void)
+{
+	return g_quark_from_static_string ("arv-image-convert-error-quark");
+}
+
+typedef enum {
+	ARV_IMAGE_PACKING_GV_10,
+	ARV_IMAGE_PACKING_GV_12,
+	ARV_IMAGE_PACKING_P_10,
+	ARV_IMAGE_PACKING_P_12,
+	ARV_IMAGE_PACKING_P_14
+} ArvImagePacking;
+
+/* Sample depth, stored bits per sample, and size of a block of 8 samples */
+
+static const struct {
+	guint depth;
+	guint stored_bits;
+	guint block_size;
+} packings[] = {
+	[ARV_IMAGE_PACKING_GV_10] =	{ 10, 12, 12 },
+	[ARV_IMAGE_PACKING_GV_12] =	{ 12, 12, 12 },
+	[ARV_IMAGE_PACKING_P_10] =	{ 10, 10, 10 },
+	[ARV_IMAGE_PACKING_P_12] =	{ 12, 12, 12 },
+	[ARV_IMAGE_PACKING_P_14] =	{ 14, 14, 14 }
+};
+
+typedef struct {
+	ArvPixelFormat pixel_format;
+	ArvImagePacking packing;
+	guint n_components;
+	ArvPixelFormat unpacked_16;
+	ArvPixelFormat unpacked_8;
+} ArvImagePackedFormat;
+
+static const ArvImagePackedFormat packed_formats[] = {
+	{ ARV_PIXEL_FORMAT_MONO_10_PACKED,	ARV_IMAGE_PACKING_GV_10, 1,
+		ARV_PIXEL_FORMAT_MONO_10,		ARV_PIXEL_FORMAT_MONO_8 },
+	{ ARV_PIXEL_FORMAT_MONO_12_PACKED,	ARV_IMAGE_PACKING_GV_12, 1,
+		ARV_PIXEL_FORMAT_MONO_12,		ARV_PIXEL_FORMAT_MONO_8 },
+	{ ARV_PIXEL_FORMAT_MONO_10P,		ARV_IMAGE_PACKING_P_10, 1,
+		ARV_PIXEL_FORMAT_MONO_10,		ARV_PIXEL_FORMAT_MONO_8 },
+	{ ARV_PIXEL_FORMAT_MONO_12P,		ARV_IMAGE_PACKING_P_12, 1,
+		ARV_PIXEL_FORMAT_MONO_12,		ARV_PIXEL_FORMAT_MONO_8 },
+	{ ARV_PIXEL_FORMAT_MONO_14P,		ARV_IMAGE_PACKING_P_14, 1,
+		ARV_PIXEL_FORMAT_MONO_14,		ARV_PIXEL_FORMAT_MONO_8 },
+
+	{ ARV_PIXEL_FORMAT_BAYER_GR_10_PACKED,	ARV_IMAGE_PACKING_GV_10, 1,
+		ARV_PIXEL_FORMAT_BAYER_GR_10,		ARV_PIXEL_FORMAT_BAYER_GR_8 },
+	{ ARV_PIXEL_FORMAT_BAYER_RG_10_PACKED,	ARV_IMAGE_PACKING_GV_10, 1,
+		ARV_PIXEL_FORMAT_BAYER_RG_10,		ARV_PIXEL_FORMAT_BAYER_RG_8 },
+	{ ARV_PIXEL_FORMAT_BAYER_GB_10_PACKED,	ARV_IMAGE_PACKING_GV_10, 1,
+		ARV_PIXEL_FORMAT_BAYER_GB_10,		ARV_PIXEL_FORMAT_BAYER_GB_8 },
+	{ ARV_PIXEL_FORMAT_BAYER_BG_10_PACKED,	ARV_IMAGE_PACKING_GV_10, 1,
+		ARV_PIXEL_FORMAT_BAYER_BG_10,		ARV_PIXEL_FORMAT_BAYER_BG_8 },
+
+	{ ARV_PIXEL_FORMAT_BAYER_GR_12_PACKED,	ARV_IMAGE_PACKING_GV_12, 1,
+		ARV_PIXEL_FORMAT_BAYER_GR_12,		ARV_PIXEL_FORMAT_BAYER_GR_8 },
+	{ ARV_PIXEL_FORMAT_BAYER_RG_12_PACKED,	ARV_IMAGE_PACKING_GV_12, 1,
+		ARV_PIXEL_FORMAT_BAYER_RG_12,		ARV_PIXEL_FORMAT_BAYER_RG_8 },
+	{ ARV_PIXEL_FORMAT_BAYER_GB_12_PACKED,	ARV_IMAGE_PACKING_GV_12, 1,
+		ARV_PIXEL_FORMAT_BAYER_GB_12,		ARV_PIXEL_FORMAT_BAYER_GB_8 },
+	{ ARV_PIXEL_FORMAT_BAYER_BG_12_PACKED,	ARV_IMAGE_PACKING_GV_12, 1,
+		ARV_PIXEL_FORMAT_BAYER_BG_12,		ARV_PIXEL_FORMAT_BAYER_BG_8 },
+
+	{ ARV_PIXEL_FORMAT_BAYER_GR_10P,	ARV_IMAGE_PACKING_P_10, 1,
+		ARV_PIXEL_FORMAT_BAYER_GR_10,		ARV_PIXEL_FORMAT_BAYER_GR_8 },
+	{ ARV_PIXEL_FORMAT_BAYER_RG_10P,	ARV_IMAGE_PACKING_P_10, 1,
+		ARV_PIXEL_FORMAT_BAYER_RG_10,		ARV_PIXEL_FORMAT_BAYER_RG_8 },
+	{ ARV_PIXEL_FORMAT_BAYER_GB_10P,	ARV_IMAGE_PACKING_P_10, 1,
+		ARV_PIXEL_FORMAT_BAYER_GB_10,		ARV_PIXEL_FORMAT_BAYER_GB_8 },
+	{ ARV_PIXEL_FORMAT_BAYER_BG_10P,	ARV_IMAGE_PACKING_P_10, 1,
+		ARV_PIXEL_FORMAT_BAYER_BG_10,		ARV_PIXEL_FORMAT_BAYER_BG_8 },
+
+	{ ARV_PIXEL_FORMAT_BAYER_GR_12P,	ARV_IMAGE_PACKING_P_12, 1,
+		ARV_PIXEL_FORMAT_BAYER_GR_12,		ARV_PIXEL_FORMAT_BAYER_GR_8 },
+	{ ARV_PIXEL_FORMAT_BAYER_RG_12P,	ARV_IMAGE_PACKING_P_12, 1,
+		ARV_PIXEL_FORMAT_BAYER_RG_12,		ARV_PIXEL_FORMAT_BAYER_RG_8 },
+	{ ARV_PIXEL_FORMAT_BAYER_GB_12P,	ARV_IMAGE_PACKING_P_12, 1,
+		ARV_PIXEL_FORMAT_BAYER_GB_12,		ARV_PIXEL_FORMAT_BAYER_GB_8 },
+	{ ARV_PIXEL_FORMAT_BAYER_BG_12P,	ARV_IMAGE_PACKING_P_12, 1,
+		ARV_PIXEL_FORMAT_BAYER_BG_12,		ARV_PIXEL_FORMAT_BAYER_BG_8 },
+
+	{ ARV_PIXEL_FORMAT_COORD3D_ABC_10P,	ARV_IMAGE_PACKING_P_10, 3,
+		ARV_PIXEL_FORMAT_COORD3D_ABC_16,	ARV_PIXEL_FORMAT_COORD3D_ABC_8 },
+	{ ARV_PIXEL_FORMAT_COORD3D_ABC_12P,	ARV_IMAGE_PACKING_P_12, 3,
+		ARV_PIXEL_FORMAT_COORD3D_ABC_16,	ARV_PIXEL_FORMAT_COORD3D_ABC_8 },
+	{ ARV_PIXEL_FORMAT_COORD3D_AC_10P,	ARV_IMAGE_PACKING_P_10, 2,
+		ARV_PIXEL_FORMAT_COORD3D_AC_16,		ARV_PIXEL_FORMAT_COORD3D_AC_8 },
+	{ ARV_PIXEL_FORMAT_COORD3D_AC_12P,	ARV_IMAGE_PACKING_P_12, 2,
+		ARV_PIXEL_FORMAT_COORD3D_AC_16,		ARV_PIXEL_FORMAT_COORD3D_AC_8 },
+	{ ARV_PIXEL_FORMAT_COORD3D_A_10P,	ARV_IMAGE_PACKING_P_10, 1,
+		ARV_PIXEL_FORMAT_COORD3D_A_16,		ARV_PIXEL_FORMAT_COORD3D_A_8 },
+	{ ARV_PIXEL_FORMAT_COORD3D_A_12P,	ARV_IMAGE_PACKING_P_12, 1,
+		ARV_PIXEL_FORMAT_COORD3D_A_16,		ARV_PIXEL_FORMAT_COORD3D_A_8 },
+	{ ARV_PIXEL_FORMAT_COORD3D_B_10P,	ARV_IMAGE_PACKING_P_10, 1,
+		ARV_PIXEL_FORMAT_COORD3D_B_16,		ARV_PIXEL_FORMAT_COORD3D_B_8 },
+	{ ARV_PIXEL_FORMAT_COORD3D_B_12P,	ARV_IMAGE_PACKING_P_12, 1,
+		ARV_PIXEL_FORMAT_COORD3D_B_16,		ARV_PIXEL_FORMAT_COORD3D_B_8 },
+	{ ARV_PIXEL_FORMAT_COORD3D_C_10P,	ARV_IMAGE_PACKING_P_10, 1,
+		ARV_PIXEL_FORMAT_COORD3D_C_16,		ARV_PIXEL_FORMAT_COORD3D_C_8 },
+	{ ARV_PIXEL_FORMAT_COORD3D_C_12P,	ARV_IMAGE_PACKING_P_12, 1,
+		ARV_PIXEL_FORMAT_COORD3D_C_16,		ARV_PIXEL_FORMAT_COORD3D_C_8 }
+};
+
+static const ArvImagePackedFormat *
+_find_packed_format (ArvPixelFormat pixel_format)
+{
+	unsigned int i;
+
+	for (i = 0; i < G_N_ELEMENTS (packed_formats); i++)
+		if (packed_formats[i].pixel_format == pixel_format)
+			return &packed_formats[i];
+
+	return NULL;
+}
+
+/* Scalar reference implementation */
+
+static inline guint
+_scalar_read_sample (ArvImagePacking packing, const guint8 *input, size_t index)
+{
+	const guint8 *group;
+	size_t bit;
+	guint32 value;
+	guint shift;
+
+	switch (packing) {
+		case ARV_IMAGE_PACKING_GV_10:
+			group = input + (index >> 1) * 3;
+			if (index & 1)
+				return (group[2] << 2) | ((group[1] >> 4) & 0x3);
+			return (group[0] << 2) | (group[1] & 0x3);
+		case ARV_IMAGE_PACKING_GV_12:
+			group = input + (index >> 1) * 3;
+			if (index & 1)
+				return (group[2] << 4) | (group[1] >> 4);
+			return (group[0] << 4) | (group[1] & 0xf);
+		default:
+			bit = index * packings[packing].stored_bits;
+			group = input + (bit >> 3);
+			shift = bit & 0x7;
+			value = group[0] | (group[1] << 8);
+			if (shift + packings[packing].depth > 16)
+				value |= group[2] << 16;
+			return (value >> shift) & ((1 << packings[packing].depth) - 1);
+	}
+}
+
+static size_t
+_unpack_scalar (ArvImagePacking packing, const guint8 *input,
+		size_t first_sample, size_t n_samples, guint output_bits, void *output)
+{
+	guint shift = packings[packing].depth - 8;
+	size_t i;
+
+	if (output_bits == 8) {
+		guint8 *output_8 = output;
+
+		for (i = first_sample; i < n_samples; i++)
+			output_8[i] = _scalar_read_sample (packing, input, i) >> shift;
+	} else {
+		guint16 *output_16 = output;
+
+		for (i = first_sample; i < n_samples; i++)
+			output_16[i] = _scalar_read_sample (packing, input, i);
+	}
+
+	return n_samples;
+}
+
+/* Number of blocks of 8 samples which can be read as 16 byte vectors without going past the end of the input */
+
+static inline size_t
+_get_n_vector_blocks (ArvImagePacking packing, size_t input_size, size_t n_samples, guint n_blocks_per_load)
+{
+	size_t block_size = packings[packing].block_size;
+	size_t load_size = (n_blocks_per_load - 1) * block_size + 16;
+	size_t n_loads;
+
+	if (input_size < load_size)
+		return 0;
+
+	n_loads = MIN ((input_size - load_size) / (block_size * n_blocks_per_load) + 1,
+		       n_samples / (8 * n_blocks_per_load));
+
+	return n_loads * n_blocks_per_load;
+}
+
+#ifdef ARV_IMAGE_CONVERT_HAS_X86
+
+/* Each 16 bit lane receives the two bytes holding a sample, then the sample bits are isolated */
+
+static ARV_ALWAYS_INLINE ARV_TARGET_SSE4_1 __m128i
+_sse4_1_unpack_block (ArvImagePacking packing, __m128i v)
+{
+	__m128i x, lo, hi;
+
+	switch (packing) {
+		case ARV_IMAGE_PACKING_GV_10:
+			x = _mm_shuffle_epi8 (v, _mm_setr_epi8 (1, 0, 1, 2, 4, 3, 4, 5, 7, 6, 7, 8, 10, 9, 10, 11));
+			hi = _mm_and_si128 (_mm_srli_epi16 (x, 6), _mm_set1_epi16 (0x3fc));
+			lo = _mm_mullo_epi16 (x, _mm_setr_epi16 (16, 1, 16, 1, 16, 1, 16, 1));
+			lo = _mm_and_si128 (_mm_srli_epi16 (lo, 4), _mm_set1_epi16 (0x3));
+			return _mm_or_si128 (hi, lo);
+		case ARV_IMAGE_PACKING_GV_12:
+			x = _mm_shuffle_epi8 (v, _mm_setr_epi8 (1, 0, 1, 2, 4, 3, 4, 5, 7, 6, 7, 8, 10, 9, 10, 11));
+			hi = _mm_and_si128 (_mm_srli_epi16 (x, 4),
+					    _mm_setr_epi16 (0xff0, 0xfff, 0xff0, 0xfff, 0xff0, 0xfff, 0xff0, 0xfff));
+			lo = _mm_and_si128 (x, _mm_setr_epi16 (0xf, 0, 0xf, 0, 0xf, 0, 0xf, 0));
+			return _mm_or_si128 (hi, lo);
+		case ARV_IMAGE_PACKING_P_10:
+			/* Left shift by a multiplication, in order to align all the samples on the most significant bit */
+			x = _mm_shuffle_epi8 (v, _mm_setr_epi8 (0, 1, 1, 2, 2, 3, 3, 4, 5, 6, 6, 7, 7, 8, 8, 9));
+			x = _mm_mullo_epi16 (x, _mm_setr_epi16 (64, 16, 4, 1, 64, 16, 4, 1));
+			return _mm_srli_epi16 (x, 6);
+		case ARV_IMAGE_PACKING_P_12:
+			x = _mm_shuffle_epi8 (v, _mm_setr_epi8 (0, 1, 1, 2, 3, 4, 4, 5, 6, 7, 7, 8, 9, 10, 10, 11));
+			lo = _mm_and_si128 (x, _mm_set1_epi16 (0xfff));
+			hi = _mm_srli_epi16 (x, 4);
+			return _mm_blend_epi16 (lo, hi, 0xaa);
+		case ARV_IMAGE_PACKING_P_14:
+		default:
+			/* 14 bit samples may span 3 bytes, use 32 bit lanes */
+			lo = _mm_shuffle_epi8 (v, _mm_setr_epi8 (0, 1, 2, -1, 1, 2, 3, -1, 3, 4, 5, -1, 5, 6, 7, -1));
+			hi = _mm_shuffle_epi8 (v, _mm_setr_epi8 (7, 8, 9, -1, 8, 9, 10, -1, 10, 11, 12, -1, 12, 13, -1, -1));
+			lo = _mm_srli_epi32 (_mm_mullo_epi32 (lo, _mm_setr_epi32 (1 << 18, 1 << 12, 1 << 14, 1 << 16)), 18);
+			hi = _mm_srli_epi32 (_mm_mullo_epi32 (hi, _mm_setr_epi32 (1 << 18, 1 << 12, 1 << 14, 1 << 16)), 18);
+			return _mm_packus_epi32 (lo, hi);
+	}
+}
+
+static ARV_ALWAYS_INLINE ARV_TARGET_SSE4_1 size_t
+_sse4_1_unpack_loop (ArvImagePacking packing, guint output_bits,
+		     const guint8 *input, size_t input_size, size_t n_samples, void *output)
+{
+	size_t block_size = packings[packing].block_size;
+	size_t n_blocks = _get_n_vector_blocks (packing, input_size, n_samples, 1);
+	size_t i;
+
+	for (i = 0; i < n_blocks; i++) {
+		__m128i v;
+
+		v = _sse4_1_unpack_block (packing, _mm_loadu_si128 ((const __m128i *) (input + i * block_size)));
+
+		if (output_bits == 8) {
+			v = _mm_srli_epi16 (v, packings[packing].depth - 8);
+			_mm_storel_epi64 ((__m128i *) ((guint8 *) output + i * 8), _mm_packus_epi16 (v, v));
+		} else
+			_mm_storeu_si128 ((__m128i *) ((guint16 *) output + i * 8), v);
+	}
+
+	return n_blocks * 8;
+}
+
+static ARV_TARGET_SSE4_1 size_t
+_unpack_sse4_1 (ArvImagePacking packing, const guint8 *input, size_t input_size,
+		size_t n_samples, guint output_bits, void *output)
+{
+	/* Constant arguments, for the specialization of the inlined loop */
+	switch (packing) {
+		case ARV_IMAGE_PACKING_GV_10:
+			return output_bits == 8 ?
+				_sse4_1_unpack_loop (ARV_IMAGE_PACKING_GV_10, 8, input, input_size, n_samples, output) :
+				_sse4_1_unpack_loop (ARV_IMAGE_PACKING_GV_10, 16, input, input_size, n_samples, output);
+		case ARV_IMAGE_PACKING_GV_12:
+			return output_bits == 8 ?
+				_sse4_1_unpack_loop (ARV_IMAGE_PACKING_GV_12, 8, input, input_size, n_samples, output) :
+				_sse4_1_unpack_loop (ARV_IMAGE_PACKING_GV_12, 16, input, input_size, n_samples, output);
+		case ARV_IMAGE_PACKING_P_10:
+			return output_bits == 8 ?
+				_sse4_1_unpack_loop (ARV_IMAGE_PACKING_P_10, 8, input, input_size, n_samples, output) :
+				_sse4_1_unpack_loop (ARV_IMAGE_PACKING_P_10, 16, input, input_size, n_samples, output);
+		case ARV_IMAGE_PACKING_P_12:
+			return output_bits == 8 ?
+				_sse4_1_unpack_loop (ARV_IMAGE_PACKING_P_12, 8, input, input_size, n_samples, output) :
+				_sse4_1_unpack_loop (ARV_IMAGE_PACKING_P_12, 16, input, input_size, n_samples, output);
+		case ARV_IMAGE_PACKING_P_14:
+			return output_bits == 8 ?
+				_sse4_1_unpack_loop (ARV_IMAGE_PACKING_P_14, 8, input, input_size, n_samples, output) :
+				_sse4_1_unpack_loop (ARV_IMAGE_PACKING_P_14, 16, input, input_size, n_samples, output);
+	}
+
+	return 0;
+}
+
+/* Same kernels as SSE4.1, on two consecutive blocks, one per 128 bit lane */
+
+static ARV_ALWAYS_INLINE ARV_TARGET_AVX2 __m256i
+_avx2_shuffle (__m256i v, __m128i indices)
+{
+	return _mm256_shuffle_epi8 (v, _mm256_broadcastsi128_si256 (indices));
+}
+
+static ARV_ALWAYS_INLINE ARV_TARGET_AVX2 __m256i
+_avx2_unpack_blocks (ArvImagePacking packing, __m256i v)
+{
+	__m256i x, lo, hi;
+
+	switch (packing) {
+		case ARV_IMAGE_PACKING_GV_10:
+			x = _avx2_shuffle (v, _mm_setr_epi8 (1, 0, 1, 2, 4, 3, 4, 5, 7, 6, 7, 8, 10, 9, 10, 11));
+			hi = _mm256_and_si256 (_mm256_srli_epi16 (x, 6), _mm256_set1_epi16 (0x3fc));
+			lo = _mm256_mullo_epi16 (x, _mm256_set1_epi32 (0x00010010));
+			lo = _mm256_and_si256 (_mm256_srli_epi16 (lo, 4), _mm256_set1_epi16 (0x3));
+			return _mm256_or_si256 (hi, lo);
+		case ARV_IMAGE_PACKING_GV_12:
+			x = _avx2_shuffle (v, _mm_setr_epi8 (1, 0, 1, 2, 4, 3, 4, 5, 7, 6, 7, 8, 10, 9, 10, 11));
+			hi = _mm256_and_si256 (_mm256_srli_epi16 (x, 4), _mm256_set1_epi32 (0x0fff0ff0));
+			lo = _mm256_and_si256 (x, _mm256_set1_epi32 (0x0000000f));
+			return _mm256_or_si256 (hi, lo);
+		case ARV_IMAGE_PACKING_P_10:
+			x = _avx2_shuffle (v, _mm_setr_epi8 (0, 1, 1, 2, 2, 3, 3, 4, 5, 6, 6, 7, 7, 8, 8, 9));
+			x = _mm256_mullo_epi16 (x, _mm256_set1_epi64x (0x0001000400100040));
+			return _mm256_srli_epi16 (x, 6);
+		case ARV_IMAGE_PACKING_P_12:
+			x = _avx2_shuffle (v, _mm_setr_epi8 (0, 1, 1, 2, 3, 4, 4, 5, 6, 7, 7, 8, 9, 10, 10, 11));
+			lo = _mm256_and_si256 (x, _mm256_set1_epi16 (0xfff));
+			hi = _mm256_srli_epi16 (x, 4);
+			return _mm256_blend_epi16 (lo, hi, 0xaa);
+		case ARV_IMAGE_PACKING_P_14:
+		default:
+			lo = _avx2_shuffle (v, _mm_setr_epi8 (0, 1, 2, -1, 1, 2, 3, -1, 3, 4, 5, -1, 5, 6, 7, -1));
+			hi = _avx2_shuffle (v, _mm_setr_epi8 (7, 8, 9, -1, 8, 9, 10, -1, 10, 11, 12, -1, 12, 13, -1, -1));
+			lo = _mm256_srlv_epi32 (lo, _mm256_setr_epi32 (0, 6, 4, 2, 0, 6, 4, 2));
+			hi = _mm256_srlv_epi32 (hi, _mm256_setr_epi32 (0, 6, 4, 2, 0, 6, 4, 2));
+			lo = _mm256_and_si256 (lo, _mm256_set1_epi32 (0x3fff));
+			hi = _mm256_and_si256 (hi, _mm256_set1_epi32 (0x3fff));
+			return _mm256_packus_epi32 (lo, hi);
+	}
+}
+
+static ARV_ALWAYS_INLINE ARV_TARGET_AVX2 size_t
+_avx2_unpack_loop (ArvImagePacking packing, guint output_bits,
+		   const guint8 *input, size_t input_size, size_t n_samples, void *output)
+{
+	size_t block_size = packings[packing].block_size;
+	size_t n_blocks = _get_n_vector_blocks (packing, input_size, n_samples, 2);
+	size_t i;
+
+	for (i = 0; i < n_blocks; i += 2) {
+		const guint8 *block = input + i * block_size;
+		__m256i v;
+
+		v = _mm256_inserti128_si256 (_mm256_castsi128_si256 (_mm_loadu_si128 ((const __m128i *) block)),
+					     _mm_loadu_si128 ((const __m128i *) (block + block_size)), 1);
+		v = _avx2_unpack_blocks (packing, v);
+
+		if (output_bits == 8) {
+			v = _mm256_srli_epi16 (v, packings[packing].depth - 8);
+			v = _mm256_permute4x64_epi64 (_mm256_packus_epi16 (v, v), _MM_SHUFFLE (3, 1, 2, 0));
+			_mm_storeu_si128 ((__m128i *) ((guint8 *) output + i * 8), _mm256_castsi256_si128 (v));
+		} else
+			_mm256_storeu_si256 ((__m256i *) ((guint16 *) output + i * 8), v);
+	}
+
+	return n_blocks * 8;
+}
+
+static ARV_TARGET_AVX2 size_t
+_unpack_avx2 (ArvImagePacking packing, const guint8 *input, size_t input_size,
+	      size_t n_samples, guint output_bits, void *output)
+{
+	switch (packing) {
+		case ARV_IMAGE_PACKING_GV_10:
+			return output_bits == 8 ?
+				_avx2_unpack_loop (ARV_IMAGE_PACKING_GV_10, 8, input, input_size, n_samples, output) :
+				_avx2_unpack_loop (ARV_IMAGE_PACKING_GV_10, 16, input, input_size, n_samples, output);
+		case ARV_IMAGE_PACKING_GV_12:
+			return output_bits == 8 ?
+				_avx2_unpack_loop (ARV_IMAGE_PACKING_GV_12, 8, input, input_size, n_samples, output) :
+				_avx2_unpack_loop (ARV_IMAGE_PACKING_GV_12, 16, input, input_size, n_samples, output);
+		case ARV_IMAGE_PACKING_P_10:
+			return output_bits == 8 ?
+				_avx2_unpack_loop (ARV_IMAGE_PACKING_P_10, 8, input, input_size, n_samples, output) :
+				_avx2_unpack_loop (ARV_IMAGE_PACKING_P_10, 16, input, input_size, n_samples, output);
+		case ARV_IMAGE_PACKING_P_12:
+			return output_bits == 8 ?
+				_avx2_unpack_loop (ARV_IMAGE_PACKING_P_12, 8, input, input_size, n_samples, output) :
+				_avx2_unpack_loop (ARV_IMAGE_PACKING_P_12, 16, input, input_size, n_samples, output);
+		case ARV_IMAGE_PACKING_P_14:
+			return output_bits == 8 ?
+				_avx2_unpack_loop (ARV_IMAGE_PACKING_P_14, 8, input, input_size, n_samples, output) :
+				_avx2_unpack_loop (ARV_IMAGE_PACKING_P_14, 16, input, input_size, n_samples, output);
+	}
+
+	return 0;
+}
+
+#endif
+
+#ifdef ARV_IMAGE_CONVERT_HAS_NEON
+
+static inline uint16x8_t
+_neon_shuffle_16 (uint8x16_t v, const guint8 indices[16])
+{
+	return vreinterpretq_u16_u8 (vqtbl1q_u8 (v, vld1q_u8 (indices)));
+}
+
+static inline uint16x8_t
+_neon_unpack_block (ArvImagePacking packing, uint8x16_t v)
+{
+	static const guint8 gv_indices[16] =	{1, 0, 1, 2, 4, 3, 4, 5, 7, 6, 7, 8, 10, 9, 10, 11};
+	static const guint8 p10_indices[16] =	{0, 1, 1, 2, 2, 3, 3, 4, 5, 6, 6, 7, 7, 8, 8, 9};
+	static const guint8 p12_indices[16] =	{0, 1, 1, 2, 3, 4, 4, 5, 6, 7, 7, 8, 9, 10, 10, 11};
+	static const guint8 p14_lo_indices[16] = {0, 1, 2, 255, 1, 2, 3, 255, 3, 4, 5, 255, 5, 6, 7, 255};
+	static const guint8 p14_hi_indices[16] = {7, 8, 9, 255, 8, 9, 10, 255, 10, 11, 12, 255, 12, 13, 255, 255};
+	static const gint16 gv_10_shifts[8] =	{0, -4, 0, -4, 0, -4, 0, -4};
+	static const guint16 gv_12_hi_masks[8] = {0xff0, 0xfff, 0xff0, 0xfff, 0xff0, 0xfff, 0xff0, 0xfff};
+	static const guint16 gv_12_lo_masks[8] = {0xf, 0, 0xf, 0, 0xf, 0, 0xf, 0};
+	static const gint16 p10_shifts[8] =	{0, -2, -4, -6, 0, -2, -4, -6};
+	static const gint16 p12_shifts[8] =	{0, -4, 0, -4, 0, -4, 0, -4};
+	static const gint32 p14_shifts[4] =	{0, -6, -4, -2};
+	uint16x8_t x, lo, hi;
+	uint32x4_t lo_32, hi_32;
+
+	switch (packing) {
+		case ARV_IMAGE_PACKING_GV_10:
+			x = _neon_shuffle_16 (v, gv_indices);
+			hi = vandq_u16 (vshrq_n_u16 (x, 6), vdupq_n_u16 (0x3fc));
+			lo = vandq_u16 (vshlq_u16 (x, vld1q_s16 (gv_10_shifts)), vdupq_n_u16 (0x3));
+			return vorrq_u16 (hi, lo);
+		case ARV_IMAGE_PACKING_GV_12:
+			x = _neon_shuffle_16 (v, gv_indices);
+			hi = vandq_u16 (vshrq_n_u16 (x, 4), vld1q_u16 (gv_12_hi_masks));
+			lo = vandq_u16 (x, vld1q_u16 (gv_12_lo_masks));
+			return vorrq_u16 (hi, lo);
+		case ARV_IMAGE_PACKING_P_10:
+			x = _neon_shuffle_16 (v, p10_indices);
+			return vandq_u16 (vshlq_u16 (x, vld1q_s16 (p10_shifts)), vdupq_n_u16 (0x3ff));
+		case ARV_IMAGE_PACKING_P_12:
+			x = _neon_shuffle_16 (v, p12_indices);
+			return vandq_u16 (vshlq_u16 (x, vld1q_s16 (p12_shifts)), vdupq_n_u16 (0xfff));
+		case ARV_IMAGE_PACKING_P_14:
+		default:
+			lo_32 = vreinterpretq_u32_u8 (vqtbl1q_u8 (v, vld1q_u8 (p14_lo_indices)));
+			hi_32 = vreinterpretq_u32_u8 (vqtbl1q_u8 (v, vld1q_u8 (p14_hi_indices)));
+			lo_32 = vandq_u32 (vshlq_u32 (lo_32, vld1q_s32 (p14_shifts)), vdupq_n_u32 (0x3fff));
+			hi_32 = vandq_u32 (vshlq_u32 (hi_32, vld1q_s32 (p14_shifts)), vdupq_n_u32 (0x3fff));
+			return vcombine_u16 (vmovn_u32 (lo_32), vmovn_u32 (hi_32));
+	}
+}
+
+static size_t
+_unpack_neon (ArvImagePacking packing, const guint8 *input, size_t input_size,
+	      size_t n_samples, guint output_bits, void *output)
+{
+	size_t block_size = packings[packing].block_size;
+	size_t n_blocks = _get_n_vector_blocks (packing, input_size, n_samples, 1);
+	int16x8_t shift_8 = vdupq_n_s16 (8 - (int) packings[packing].depth);
+	size_t i;
+
+	for (i = 0; i < n_blocks; i++) {
+		uint16x8_t v;
+
+		v = _neon_unpack_block (packing, vld1q_u8 (input + i * block_size));
+
+		if (output_bits == 8)
+			vst1_u8 ((guint8 *) output + i * 8, vmovn_u16 (vshlq_u16 (v, shift_8)));
+		else
+			vst1q_u16 ((guint16 *) output + i * 8, v);
+	}
+
+	return n_blocks * 8;
+}
+
+#endif
+
+typedef size_t (*ArvImageUnpackFunc) (ArvImagePacking packing, const guint8 *input, size_t input_size,
+				      size_t n_samples, guint output_bits, void *output);
+
+static gboolean
+_is_implementation_supported (ArvImageConvertImplementation implementation)
+{
+	switch (implementation) {
+		case ARV_IMAGE_CONVERT_IMPLEMENTATION_SCALAR:
+			return TRUE;
+#ifdef ARV_IMAGE_CONVERT_HAS_X86
+		case ARV_IMAGE_CONVERT_IMPLEMENTATION_SSE4_1:
+			return __builtin_cpu_supports ("sse4.1");
+		case ARV_IMAGE_CONVERT_IMPLEMENTATION_AVX2:
+			return __builtin_cpu_supports ("avx2");
+#endif
+#ifdef ARV_IMAGE_CONVERT_HAS_NEON
+		case ARV_IMAGE_CONVERT_IMPLEMENTATION_NEON:
+			return TRUE;
+#endif
+		default:
+			return FALSE;
+	}
+}
+
+static ArvImageUnpackFunc
+_get_unpack_func (ArvImageConvertImplementation implementation)
+{
+	switch (implementation) {
+#ifdef ARV_IMAGE_CONVERT_HAS_X86
+		case ARV_IMAGE_CONVERT_IMPLEMENTATION_SSE4_1:
+			return _unpack_sse4_1;
+		case ARV_IMAGE_CONVERT_IMPLEMENTATION_AVX2:
+			return _unpack_avx2;
+#endif
+#ifdef ARV_IMAGE_CONVERT_HAS_NEON
+		case ARV_IMAGE_CONVERT_IMPLEMENTATION_NEON:
+			return _unpack_neon;
+#endif
+		default:
+			return NULL;
+	}
+}
+
+static ArvImageConvertImplementation
+_select_implementation (void)
+{
+	static const ArvImageConvertImplementation preferred[] = {
+		ARV_IMAGE_CONVERT_IMPLEMENTATION_AVX2,
+		ARV_IMAGE_CONVERT_IMPLEMENTATION_NEON,
+		ARV_IMAGE_CONVERT_IMPLEMENTATION_SSE4_1
+	};
+	unsigned int i;
+
+	for (i = 0; i < G_N_ELEMENTS (preferred); i++)
+		if (_is_implementation_supported (preferred[i]))
+			return preferred[i];
+
+	return ARV_IMAGE_CONVERT_IMPLEMENTATION_SCALAR;
+}
+
+static gint forced_implementation = ARV_IMAGE_CONVERT_IMPLEMENTATION_AUTO;
+
+static ArvImageConvertImplementation
+_get_implementation (void)
+{
+	static gsize selected_implementation = 0;
+	ArvImageConvertImplementation implementation;
+
+	implementation = g_atomic_int_get (&forced_implementation);
+	if (implementation != ARV_IMAGE_CONVERT_IMPLEMENTATION_AUTO)
+		return implementation;
+
+	if (g_once_init_enter (&selected_implementation)) {
+		implementation = _select_implementation ();
+		arv_info_misc ("[ImageConvert] Use %s implementation",
+			       arv_image_convert_implementation_to_string (implementation));
+		g_once_init_leave (&selected_implementation, implementation);
+	}
+
+	return selected_implementation;
+}
+
+/**
+ * arv_image_convert_set_implementation:
+ * @implementation: a #ArvImageConvertImplementation
+ *
+ * Forces the use of an implementation, #ARV_IMAGE_CONVERT_IMPLEMENTATION_AUTO restoring the runtime selection.
+ *
+ * Returns: %FALSE if @implementation is not supported by the CPU or was not built in.
+ */
+
+gboolean
+arv_image_convert_set_implementation (ArvImageConvertImplementation implementation)
+{
+	if (implementation != ARV_IMAGE_CONVERT_IMPLEMENTATION_AUTO &&
+	    !_is_implementation_supported (implementation))
+		return FALSE;
+
+	g_atomic_int_set (&forced_implementation, implementation);
+
+	return TRUE;
+}
+
+ArvImageConvertImplementation
+arv_image_convert_get_implementation (void)
+{
+	return _get_implementation ();
+}
+
+const char *
+arv_image_convert_implementation_to_string (ArvImageConvertImplementation implementation)
+{
+	switch (implementation) {
+		case ARV_IMAGE_CONVERT_IMPLEMENTATION_AUTO:	return "auto";
+		case ARV_IMAGE_CONVERT_IMPLEMENTATION_SCALAR:	return "scalar";
+		case ARV_IMAGE_CONVERT_IMPLEMENTATION_SSE4_1:	return "sse4.1";
+		case ARV_IMAGE_CONVERT_IMPLEMENTATION_AVX2:	return "avx2";
+		case ARV_IMAGE_CONVERT_IMPLEMENTATION_NEON:	return "neon";
+		default:					return "unknown";
+	}
+}
+
+static void
+_unpack_samples (ArvImageUnpackFunc unpack, ArvImagePacking packing,
+		 const guint8 *input, size_t input_size, size_t n_samples, guint output_bits, void *output)
+{
+	size_t n_unpacked = 0;
+
+	if (unpack != NULL)
+		n_unpacked = unpack (packing, input, input_size, n_samples, output_bits, output);
+
+	_unpack_scalar (packing, input, n_unpacked, n_samples, output_bits, output);
+}
+
+/**
+ * arv_image_get_unpacked_pixel_format:
+ * @pixel_format: a packed pixel format
+ * @output_bits: bits per sample of the unpacked data, 8 or 16
+ *
+ * Returns: the pixel format of the data written by arv_image_unpack(), 0 if @pixel_format can not be unpacked.
+ *
+ * Since: 0.10.0
+ */
+
+ArvPixelFormat
+arv_image_get_unpacked_pixel_format (ArvPixelFormat pixel_format, guint output_bits)
+{
+	const ArvImagePackedFormat *format;
+
+	format = _find_packed_format (pixel_format);
+	if (format == NULL || (output_bits != 8 && output_bits != 16))
+		return 0;
+
+	return output_bits == 8 ? format->unpacked_8 : format->unpacked_16;
+}
+
+/**
+ * arv_image_get_unpacked_size:
+ * @pixel_format: a packed pixel format
+ * @width: image width, in pixels
+ * @height: image height, in pixels
+ * @output_bits: bits per sample of the unpacked data, 8 or 16
+ *
+ * Returns: the size of the unpacked image, 0 if @pixel_format can not be unpacked.
+ *
+ * Since: 0.10.0
+ */
+
+size_t
+arv_image_get_unpacked_size (ArvPixelFormat pixel_format, guint width, guint height, guint output_bits)
+{
+	const ArvImagePackedFormat *format;
+
+	format = _find_packed_format (pixel_format);
+	if (format == NULL || (output_bits != 8 && output_bits != 16))
+		return 0;
+
+	return (size_t) width * height * format->n_components * (output_bits / 8);
+}
+
+/**
+ * arv_image_unpack:
+ * @pixel_format: pixel format of @input
+ * @input: (array length=input_size) (element-type guint8): packed image data
+ * @input_size: size of @input, in bytes
+ * @width: image width, in pixels
+ * @height: image height, in pixels
+ * @x_padding: number of bytes at the end of each line of @input
+ * @output_bits: bits per sample of the unpacked data, 8 or 16
+ * @output: (array length=output_size) (element-type guint8): unpacked image data placeholder
+ * @output_size: size of @output, in bytes
+ * @error: a #GError placeholder, %NULL to ignore
+ *
+ * Unpacks an image using one of the GigE Vision packed pixel formats (Mono10Packed, Mono12Packed, BayerXX10Packed,
+ * BayerXX12Packed) or of the PFNC "p" formats (Mono10p, Mono12p, Mono14p, BayerXX10p, BayerXX12p, Coord3D_XX10p,
+ * Coord3D_XX12p).
+ *
+ * With a 16 bit output, the samples keep their original depth, like in the corresponding unpacked pixel formats. With
+ * a 8 bit output, only their 8 most significant bits are kept. arv_image_get_unpacked_pixel_format() returns the
+ * pixel format of the output.
+ *
+ * Without line padding, the lines are expected to be contiguous, even if they don't end on a byte boundary.
+ *
+ * Returns: the size of the unpacked data, 0 on error.
+ *
+ * Since: 0.10.0
+ */
+
+size_t
+arv_image_unpack (ArvPixelFormat pixel_format,
+		  const void *input, size_t input_size,
+		  guint width, guint height, guint x_padding,
+		  guint output_bits, void *output, size_t output_size,
+		  GError **error)
+{
+	const ArvImagePackedFormat *format;
+	ArvImageUnpackFunc unpack;
+	guint stored_bits;
+	size_t n_line_samples;
+	size_t line_size;
+	size_t unpacked_size;
+	size_t packed_size;
+	guint i;
+
+	g_return_val_if_fail (input != NULL, 0);
+	g_return_val_if_fail (output != NULL, 0);
+
+	format = _find_packed_format (pixel_format);
+	if (format == NULL) {
+		g_set_error (error, ARV_IMAGE_CONVERT_ERROR, ARV_IMAGE_CONVERT_ERROR_PIXEL_FORMAT_NOT_SUPPORTED,
+			     "Pixel format 0x%08x can not be unpacked", pixel_format);
+		return 0;
+	}
+
+	if (output_bits != 8 && output_bits != 16) {
+		g_set_error (error, ARV_IMAGE_CONVERT_ERROR, ARV_IMAGE_CONVERT_ERROR_INVALID_PARAMETER,
+			     "Invalid output sample size (%u bits)", output_bits);
+		return 0;
+	}
+
+	stored_bits = packings[format->packing].stored_bits;
+	n_line_samples = (size_t) width * format->n_components;
+	line_size = (n_line_samples * stored_bits + 7) / 8;
+
+	if (x_padding == 0)
+		packed_size = ((size_t) height * n_line_samples * stored_bits + 7) / 8;
+	else
+		packed_size = (size_t) height * (line_size + x_padding) - x_padding;
+
+	unpacked_size = arv_image_get_unpacked_size (pixel_format, width, height, output_bits);
+
+	if (input_size < packed_size || output_size < unpacked_size) {
+		g_set_error (error, ARV_IMAGE_CONVERT_ERROR, ARV_IMAGE_CONVERT_ERROR_BUFFER_TOO_SMALL,
+			     "Data too small for a %ux%u image (input %" G_GSIZE_FORMAT "/%" G_GSIZE_FORMAT
+			     ", output %" G_GSIZE_FORMAT "/%" G_GSIZE_FORMAT ")",
+			     width, height, input_size, packed_size, output_size, unpacked_size);
+		return 0;
+	}
+
+	unpack = _get_unpack_func (_get_implementation ());
+
+	if (x_padding == 0) {
+		_unpack_samples (unpack, format->packing, input, input_size,
+				 (size_t) height * n_line_samples, output_bits, output);
+	} else {
+		/* The vector code may read the padding of the current line, never past the end of the input */
+		for (i = 0; i < height; i++) {
+			size_t offset = (size_t) i * (line_size + x_padding);
+
+			_unpack_samples (unpack, format->packing, (const guint8 *) input + offset, input_size - offset,
+					 n_line_samples, output_bits,
+					 (guint8 *) output + (size_t) i * n_line_samples * (output_bits / 8));
+		}
+	}
+
+	return unpacked_size;
+}
+
+static gboolean
+_get_image_part (ArvBuffer *buffer, guint part_id,
+		 const void **data, size_t *size, gint *width, gint *height, gint *x_padding,
+		 GError **error)
+{
+	ArvBufferPartDataType data_type;
+
+	if (arv_buffer_get_status (buffer) != ARV_BUFFER_STATUS_SUCCESS ||
+	    part_id >= arv_buffer_get_n_parts (buffer)) {
+		g_set_error (error, ARV_IMAGE_CONVERT_ERROR, ARV_IMAGE_CONVERT_ERROR_INVALID_PARAMETER,
+			     "No valid part %u in buffer", part_id);
+		return FALSE;
+	}
+
+	data_type = arv_buffer_get_part_data_type (buffer, part_id);
+	if (data_type < ARV_BUFFER_PART_DATA_TYPE_2D_IMAGE ||
+	    data_type > ARV_BUFFER_PART_DATA_TYPE_CONFIDENCE_MAP) {
+		g_set_error (error, ARV_IMAGE_CONVERT_ERROR, ARV_IMAGE_CONVERT_ERROR_INVALID_PARAMETER,
+			     "Part %u is not an image", part_id);
+		return FALSE;
+	}
+
+	*data = arv_buffer_get_part_data (buffer, part_id, size);
+	arv_buffer_get_part_region (buffer, part_id, NULL, NULL, width, height);
+	arv_buffer_get_part_padding (buffer, part_id, x_padding, NULL);
+
+	if (*data == NULL || *width < 0 || *height < 0 || *x_padding < 0) {
+		g_set_error (error, ARV_IMAGE_CONVERT_ERROR, ARV_IMAGE_CONVERT_ERROR_INVALID_PARAMETER,
+			     "Invalid image part %u", part_id);
+		return FALSE;
+	}
+
+	return TRUE;
+}
+
+/**
+ * arv_image_unpack_buffer_part:
+ * @buffer: a #ArvBuffer
+ * @part_id: an image part id
+ * @output_bits: bits per sample of the unpacked data, 8 or 16
+ * @output: (array length=output_size) (element-type guint8): unpacked image data placeholder
+ * @output_size: size of @output, in bytes
+ * @error: a #GError placeholder, %NULL to ignore
+ *
+ * Unpacks the data of an image part, using its pixel format, size and line padding. See arv_image_unpack().
+ *
+ * Returns: the size of the unpacked data, 0 on error.
+ *
+ * Since: 0.10.0
+ */
+
+size_t
+arv_image_unpack_buffer_part (ArvBuffer *buffer, guint part_id,
+			      guint output_bits, void *output, size_t output_size,
+			      GError **error)
+{
+	const void *data;
+	size_t size;
+	gint width, height;
+	gint x_padding;
+
+	g_return_val_if_fail (ARV_IS_BUFFER (buffer), 0);
+
+	if (!_get_image_part (buffer, part_id, &data, &size, &width, &height, &x_padding, error))
+		return 0;
+
+	return arv_image_unpack (arv_buffer_get_part_pixel_format (buffer, part_id),
+				 data, size, width, height, x_padding,
+				 output_bits, output, output_size, error);
+}
+
+/**
+ * arv_image_unpack_buffer:
+ * @buffer: a #ArvBuffer
+ * @output_bits: bits per sample of the unpacked data, 8 or 16
+ *
+ * Unpacks the single image part of @buffer into the unused end of the buffer memory, and updates the part data
+ * offset, size and pixel format. The raw data returned by arv_buffer_get_data() is left untouched.
+ *
+ * Returns: %TRUE if the buffer was converted, %FALSE if it does not contain a packed image, or if the allocated size
+ * is too small.
+ */
+
+gboolean
+arv_image_unpack_buffer (ArvBuffer *buffer, guint output_bits)
+{
+	ArvBufferPrivate *priv;
+	ArvBufferPartInfos *part;
+	ptrdiff_t output_offset;
+	size_t output_size;
+
+	g_return_val_if_fail (ARV_IS_BUFFER (buffer), FALSE);
+
+	priv = buffer->priv;
+
+	if (priv->status != ARV_BUFFER_STATUS_SUCCESS ||
+	    priv->payload_type != ARV_BUFFER_PAYLOAD_TYPE_IMAGE ||
+	    priv->n_parts != 1)
+		return FALSE;
+
+	part = &priv->parts[0];
+	if (_find_packed_format (part->pixel_format) == NULL)
+		return FALSE;
+
+	output_offset = (MAX (priv->received_size, part->data_offset + part->size) + 63) & ~((ptrdiff_t) 63);
+	output_size = arv_image_get_unpacked_size (part->pixel_format, part->width, part->height, output_bits);
+
+	if (output_size == 0 || output_offset + output_size > priv->allocated_size)
+		return FALSE;
+
+	if (arv_image_unpack (part->pixel_format, priv->data + part->data_offset, part->size,
+			      part->width, part->height, part->x_padding,
+			      output_bits, priv->data + output_offset, output_size, NULL) == 0)
+		return FALSE;
+
+	part->data_offset = output_offset;
+	part->size = output_size;
+	part->pixel_format = arv_image_get_unpacked_pixel_format (part->pixel_format, output_bits);
+	part->x_padding = 0;
+
+	return TRUE;
+}
+
+/*
+ * Bayer demosaicing
+ *
+ * The bilinear method interpolates each missing color from its nearest neighbours. The edge aware method
+ * interpolates the green channel of the red and blue sites along the direction of the smallest gradient, which
+ * limits the zipper artifacts on the edges. The borders are handled by mirroring, which keeps the Bayer phase.
+ *
+ * The averages are rounded up, the same way as the SIMD average instructions, so the vector kernels give the same
+ * result as the scalar code. Images are split in bands of lines, converted in parallel by a shared thread pool.
+ */
+
+typedef struct {
+	ArvPixelFormat pixel_format;
+	guint red_x;
+	guint red_y;
+	guint depth;
+} ArvImageBayerFormat;
+
+static const ArvImageBayerFormat bayer_formats[] = {
+	{ ARV_PIXEL_FORMAT_BAYER_RG_8,	0, 0, 8 },
+	{ ARV_PIXEL_FORMAT_BAYER_GR_8,	1, 0, 8 },
+	{ ARV_PIXEL_FORMAT_BAYER_GB_8,	0, 1, 8 },
+	{ ARV_PIXEL_FORMAT_BAYER_BG_8,	1, 1, 8 },
+	{ ARV_PIXEL_FORMAT_BAYER_RG_10,	0, 0, 10 },
+	{ ARV_PIXEL_FORMAT_BAYER_GR_10,	1, 0, 10 },
+	{ ARV_PIXEL_FORMAT_BAYER_GB_10,	0, 1, 10 },
+	{ ARV_PIXEL_FORMAT_BAYER_BG_10,	1, 1, 10 },
+	{ ARV_PIXEL_FORMAT_BAYER_RG_12,	0, 0, 12 },
+	{ ARV_PIXEL_FORMAT_BAYER_GR_12,	1, 0, 12 },
+	{ ARV_PIXEL_FORMAT_BAYER_GB_12,	0, 1, 12 },
+	{ ARV_PIXEL_FORMAT_BAYER_BG_12,	1, 1, 12 },
+	{ ARV_PIXEL_FORMAT_BAYER_RG_16,	0, 0, 16 },
+	{ ARV_PIXEL_FORMAT_BAYER_GR_16,	1, 0, 16 },
+	{ ARV_PIXEL_FORMAT_BAYER_GB_16,	0, 1, 16 },
+	{ ARV_PIXEL_FORMAT_BAYER_BG_16,	1, 1, 16 }
+};
+
+#define ARV_DEMOSAIC_MIN_BAND_HEIGHT	32
+
+static const ArvImageBayerFormat *
+_find_bayer_format (ArvPixelFormat pixel_format)
+{
+	unsigned int i;
+
+	for (i = 0; i < G_N_ELEMENTS (bayer_formats); i++)
+		if (bayer_formats[i].pixel_format == pixel_format)
+			return &bayer_formats[i];
+
+	return NULL;
+}
+
+typedef struct {
+	const guint8 *north;
+	const guint8 *center;
+	const guint8 *south;
+	guint width;
+	gboolean is_16;
+	guint site_parity;
+	gboolean is_red_row;
+	gboolean edge_aware;
+	gboolean output_16;
+	guint output_shift;
+	guint8 *output;
+} ArvDemosaicRow;
+
+static inline guint
+_avg (guint a, guint b)
+{
+	return (a + b + 1) >> 1;
+}
+
+static inline guint
+_read_sample (const guint8 *row, gboolean is_16, guint x)
+{
+	return is_16 ? ((const guint16 *) row)[x] : row[x];
+}
+
+static void
+_demosaic_row_scalar (const ArvDemosaicRow *row, guint first_x, guint last_x)
+{
+	guint x;
+
+	for (x = first_x; x < last_x; x++) {
+		guint xw = x == 0 ? 1 : x - 1;
+		guint xe = x == row->width - 1 ? row->width - 2 : x + 1;
+		guint c = _read_sample (row->center, row->is_16, x);
+		guint w = _read_sample (row->center, row->is_16, xw);
+		guint e = _read_sample (row->center, row->is_16, xe);
+		guint n = _read_sample (row->north, row->is_16, x);
+		guint s = _read_sample (row->south, row->is_16, x);
+		guint h2 = _avg (w, e);
+		guint v2 = _avg (n, s);
+		guint own, other, g;
+
+		if ((x & 1) == row->site_parity) {
+			guint dh = w > e ? w - e : e - w;
+			guint dv = n > s ? n - s : s - n;
+
+			g = _avg (h2, v2);
+			if (row->edge_aware && dh < dv)
+				g = h2;
+			else if (row->edge_aware && dv < dh)
+				g = v2;
+
+			own = c;
+			other = _avg (_avg (_read_sample (row->north, row->is_16, xw),
+					    _read_sample (row->north, row->is_16, xe)),
+				      _avg (_read_sample (row->south, row->is_16, xw),
+					    _read_sample (row->south, row->is_16, xe)));
+		} else {
+			own = h2;
+			other = v2;
+			g = c;
+		}
+
+		if (row->output_16) {
+			guint16 *output = (guint16 *) row->output + 3 * x;
+
+			output[0] = row->is_red_row ? own : other;
+			output[1] = g;
+			output[2] = row->is_red_row ? other : own;
+		} else {
+			guint8 *output = row->output + 3 * x;
+
+			output[0] = (row->is_red_row ? own : other) >> row->output_shift;
+			output[1] = g >> row->output_shift;
+			output[2] = (row->is_red_row ? other : own) >> row->output_shift;
+		}
+	}
+}
+
+#ifdef ARV_IMAGE_CONVERT_HAS_X86
+
+/* Interleaving of 16 pixels of 8 bit planar channels into 48 bytes of RGB */
+
+static ARV_ALWAYS_INLINE ARV_TARGET_AVX2 void
+_avx2_store_rgb_8 (guint8 *output, __m128i r, __m128i g, __m128i b)
+{
+	__m128i v;
+
+	v = _mm_or_si128 (_mm_or_si128 (
+		_mm_shuffle_epi8 (r, _mm_setr_epi8 (0, -1, -1, 1, -1, -1, 2, -1, -1, 3, -1, -1, 4, -1, -1, 5)),
+		_mm_shuffle_epi8 (g, _mm_setr_epi8 (-1, 0, -1, -1, 1, -1, -1, 2, -1, -1, 3, -1, -1, 4, -1, -1))),
+		_mm_shuffle_epi8 (b, _mm_setr_epi8 (-1, -1, 0, -1, -1, 1, -1, -1, 2, -1, -1, 3, -1, -1, 4, -1)));
+	_mm_storeu_si128 ((__m128i *) output, v);
+
+	v = _mm_or_si128 (_mm_or_si128 (
+		_mm_shuffle_epi8 (r, _mm_setr_epi8 (-1, -1, 6, -1, -1, 7, -1, -1, 8, -1, -1, 9, -1, -1, 10, -1)),
+		_mm_shuffle_epi8 (g, _mm_setr_epi8 (5, -1, -1, 6, -1, -1, 7, -1, -1, 8, -1, -1, 9, -1, -1, 10))),
+		_mm_shuffle_epi8 (b, _mm_setr_epi8 (-1, 5, -1, -1, 6, -1, -1, 7, -1, -1, 8, -1, -1, 9, -1, -1)));
+	_mm_storeu_si128 ((__m128i *) (output + 16), v);
+
+	v = _mm_or_si128 (_mm_or_si128 (
+		_mm_shuffle_epi8 (r, _mm_setr_epi8 (-1, 11, -1, -1, 12, -1, -1, 13, -1, -1, 14, -1, -1, 15, -1, -1)),
+		_mm_shuffle_epi8 (g, _mm_setr_epi8 (-1, -1, 11, -1, -1, 12, -1, -1, 13, -1, -1, 14, -1, -1, 15, -1))),
+		_mm_shuffle_epi8 (b, _mm_setr_epi8 (10, -1, -1, 11, -1, -1, 12, -1, -1, 13, -1, -1, 14, -1, -1, 15)));
+	_mm_storeu_si128 ((__m128i *) (output + 32), v);
+}
+
+/* Interleaving of 8 pixels of 16 bit planar channels into 48 bytes of RGB */
+
+static ARV_ALWAYS_INLINE ARV_TARGET_AVX2 void
+_avx2_store_rgb_16 (guint8 *output, __m128i r, __m128i g, __m128i b)
+{
+	__m128i v;
+
+	v = _mm_or_si128 (_mm_or_si128 (
+		_mm_shuffle_epi8 (r, _mm_setr_epi8 (0, 1, -1, -1, -1, -1, 2, 3, -1, -1, -1, -1, 4, 5, -1, -1)),
+		_mm_shuffle_epi8 (g, _mm_setr_epi8 (-1, -1, 0, 1, -1, -1, -1, -1, 2, 3, -1, -1, -1, -1, 4, 5))),
+		_mm_shuffle_epi8 (b, _mm_setr_epi8 (-1, -1, -1, -1, 0, 1, -1, -1, -1, -1, 2, 3, -1, -1, -1, -1)));
+	_mm_storeu_si128 ((__m128i *) output, v);
+
+	v = _mm_or_si128 (_mm_or_si128 (
+		_mm_shuffle_epi8 (r, _mm_setr_epi8 (-1, -1, 6, 7, -1, -1, -1, -1, 8, 9, -1, -1, -1, -1, 10, 11)),
+		_mm_shuffle_epi8 (g, _mm_setr_epi8 (-1, -1, -1, -1, 6, 7, -1, -1, -1, -1, 8, 9, -1, -1, -1, -1))),
+		_mm_shuffle_epi8 (b, _mm_setr_epi8 (4, 5, -1, -1, -1, -1, 6, 7, -1, -1, -1, -1, 8, 9, -1, -1)));
+	_mm_storeu_si128 ((__m128i *) (output + 16), v);
+
+	v = _mm_or_si128 (_mm_or_si128 (
+		_mm_shuffle_epi8 (r, _mm_setr_epi8 (-1, -1, -1, -1, 12, 13, -1, -1, -1, -1, 14, 15, -1, -1, -1, -1)),
+		_mm_shuffle_epi8 (g, _mm_setr_epi8 (10, 11, -1, -1, -1, -1, 12, 13, -1, -1, -1, -1, 14, 15, -1, -1))),
+		_mm_shuffle_epi8 (b, _mm_setr_epi8 (-1, -1, 10, 11, -1, -1, -1, -1, 12, 13, -1, -1, -1, -1, 14, 15)));
+	_mm_storeu_si128 ((__m128i *) (output + 32), v);
+}
+
+/* Converts the pixels from 1 to the last full vector before the right border, returns the first pixel left */
+
+static ARV_TARGET_AVX2 guint
+_demosaic_row_avx2_8 (const ArvDemosaicRow *row)
+{
+	__m256i even_sites = _mm256_set1_epi16 (0x00ff);
+	guint x;
+
+	for (x = 1; x + 33 <= row->width; x += 32) {
+		__m256i c, w, e, n, s, h2, v2, x4, gi, site, own, other, g, r, b;
+
+		c = _mm256_loadu_si256 ((const __m256i *) (row->center + x));
+		w = _mm256_loadu_si256 ((const __m256i *) (row->center + x - 1));
+		e = _mm256_loadu_si256 ((const __m256i *) (row->center + x + 1));
+		n = _mm256_loadu_si256 ((const __m256i *) (row->north + x));
+		s = _mm256_loadu_si256 ((const __m256i *) (row->south + x));
+
+		h2 = _mm256_avg_epu8 (w, e);
+		v2 = _mm256_avg_epu8 (n, s);
+		x4 = _mm256_avg_epu8 (_mm256_avg_epu8 (_mm256_loadu_si256 ((const __m256i *) (row->north + x - 1)),
+						       _mm256_loadu_si256 ((const __m256i *) (row->north + x + 1))),
+				      _mm256_avg_epu8 (_mm256_loadu_si256 ((const __m256i *) (row->south + x - 1)),
+						       _mm256_loadu_si256 ((const __m256i *) (row->south + x + 1))));
+		gi = _mm256_avg_epu8 (h2, v2);
+
+		if (row->edge_aware) {
+			__m256i dh = _mm256_or_si256 (_mm256_subs_epu8 (w, e), _mm256_subs_epu8 (e, w));
+			__m256i dv = _mm256_or_si256 (_mm256_subs_epu8 (n, s), _mm256_subs_epu8 (s, n));
+			__m256i max = _mm256_max_epu8 (dh, dv);
+			__m256i ones = _mm256_set1_epi8 (-1);
+
+			gi = _mm256_blendv_epi8 (gi, h2, _mm256_xor_si256 (_mm256_cmpeq_epi8 (max, dh), ones));
+			gi = _mm256_blendv_epi8 (gi, v2, _mm256_xor_si256 (_mm256_cmpeq_epi8 (max, dv), ones));
+		}
+
+		site = (x & 1) == row->site_parity ? even_sites : _mm256_slli_epi16 (even_sites, 8);
+		own = _mm256_blendv_epi8 (h2, c, site);
+		other = _mm256_blendv_epi8 (v2, x4, site);
+		g = _mm256_blendv_epi8 (c, gi, site);
+		r = row->is_red_row ? own : other;
+		b = row->is_red_row ? other : own;
+
+		_avx2_store_rgb_8 (row->output + 3 * x,
+				   _mm256_castsi256_si128 (r), _mm256_castsi256_si128 (g), _mm256_castsi256_si128 (b));
+		_avx2_store_rgb_8 (row->output + 3 * x + 48,
+				   _mm256_extracti128_si256 (r, 1),
+				   _mm256_extracti128_si256 (g, 1),
+				   _mm256_extracti128_si256 (b, 1));
+	}
+
+	return x;
+}
+
+static ARV_TARGET_AVX2 guint
+_demosaic_row_avx2_16 (const ArvDemosaicRow *row)
+{
+	const guint16 *center = (const guint16 *) row->center;
+	const guint16 *north = (const guint16 *) row->north;
+	const guint16 *south = (const guint16 *) row->south;
+	__m256i even_sites = _mm256_set1_epi32 (0x0000ffff);
+	guint x;
+
+	for (x = 1; x + 17 <= row->width; x += 16) {
+		__m256i c, w, e, n, s, h2, v2, x4, gi, site, own, other, g, r, b;
+
+		c = _mm256_loadu_si256 ((const __m256i *) (center + x));
+		w = _mm256_loadu_si256 ((const __m256i *) (center + x - 1));
+		e = _mm256_loadu_si256 ((const __m256i *) (center + x + 1));
+		n = _mm256_loadu_si256 ((const __m256i *) (north + x));
+		s = _mm256_loadu_si256 ((const __m256i *) (south + x));
+
+		h2 = _mm256_avg_epu16 (w, e);
+		v2 = _mm256_avg_epu16 (n, s);
+		x4 = _mm256_avg_epu16 (_mm256_avg_epu16 (_mm256_loadu_si256 ((const __m256i *) (north + x - 1)),
+							 _mm256_loadu_si256 ((const __m256i *) (north + x + 1))),
+				       _mm256_avg_epu16 (_mm256_loadu_si256 ((const __m256i *) (south + x - 1)),
+							 _mm256_loadu_si256 ((const __m256i *) (south + x + 1))));
+		gi = _mm256_avg_epu16 (h2, v2);
+
+		if (row->edge_aware) {
+			__m256i dh = _mm256_or_si256 (_mm256_subs_epu16 (w, e), _mm256_subs_epu16 (e, w));
+			__m256i dv = _mm256_or_si256 (_mm256_subs_epu16 (n, s), _mm256_subs_epu16 (s, n));
+			__m256i max = _mm256_max_epu16 (dh, dv);
+			__m256i ones = _mm256_set1_epi8 (-1);
+
+			gi = _mm256_blendv_epi8 (gi, h2, _mm256_xor_si256 (_mm256_cmpeq_epi16 (max, dh), ones));
+			gi = _mm256_blendv_epi8 (gi, v2, _mm256_xor_si256 (_mm256_cmpeq_epi16 (max, dv), ones));
+		}
+
+		site = (x & 1) == row->site_parity ? even_sites : _mm256_slli_epi32 (even_sites, 16);
+		own = _mm256_blendv_epi8 (h2, c, site);
+		other = _mm256_blendv_epi8 (v2, x4, site);
+		g = _mm256_blendv_epi8 (c, gi, site);
+		r = row->is_red_row ? own : other;
+		b = row->is_red_row ? other : own;
+
+		if (row->output_16) {
+			_avx2_store_rgb_16 (row->output + 6 * x,
+					    _mm256_castsi256_si128 (r),
+					    _mm256_castsi256_si128 (g),
+					    _mm256_castsi256_si128 (b));
+			_avx2_store_rgb_16 (row->output + 6 * x + 48,
+					    _mm256_extracti128_si256 (r, 1),
+					    _mm256_extracti128_si256 (g, 1),
+					    _mm256_extracti128_si256 (b, 1));
+		} else {
+			__m128i shift = _mm_cvtsi32_si128 (row->output_shift);
+
+			r = _mm256_srl_epi16 (r, shift);
+			g = _mm256_srl_epi16 (g, shift);
+			b = _mm256_srl_epi16 (b, shift);
+			_avx2_store_rgb_8 (row->output + 3 * x,
+					   _mm_packus_epi16 (_mm256_castsi256_si128 (r), _mm256_extracti128_si256 (r, 1)),
+					   _mm_packus_epi16 (_mm256_castsi256_si128 (g), _mm256_extracti128_si256 (g, 1)),
+					   _mm_packus_epi16 (_mm256_castsi256_si128 (b), _mm256_extracti128_si256 (b, 1)));
+		}
+	}
+
+	return x;
+}
+
+#endif
+
+typedef struct {
+	const ArvImageBayerFormat *format;
+	const guint8 *input;
+	size_t input_stride;
+	guint width;
+	guint height;
+	gboolean edge_aware;
+	gboolean output_16;
+	guint8 *output;
+	gboolean use_avx2;
+
+	gint n_pending_bands;
+	GMutex mutex;
+	GCond cond;
+} ArvDemosaicJob;
+
+typedef struct {
+	ArvDemosaicJob *job;
+	guint first_line;
+	guint last_line;
+} ArvDemosaicBand;
+
+static void
+_demosaic_band (ArvDemosaicJob *job, guint first_line, guint last_line)
+{
+	gboolean is_16 = job->format->depth > 8;
+	size_t output_stride = (size_t) job->width * 3 * (job->output_16 ? 2 : 1);
+	guint y;
+
+	for (y = first_line; y < last_line; y++) {
+		ArvDemosaicRow row;
+		guint x = 1;
+
+		row.center = job->input + y * job->input_stride;
+		row.north = job->input + (y == 0 ? 1 : y - 1) * job->input_stride;
+		row.south = job->input + (y == job->height - 1 ? job->height - 2 : y + 1) * job->input_stride;
+		row.width = job->width;
+		row.is_16 = is_16;
+		row.is_red_row = (y & 1) == job->format->red_y;
+		row.site_parity = row.is_red_row ? job->format->red_x : 1 - job->format->red_x;
+		row.edge_aware = job->edge_aware;
+		row.output_16 = job->output_16;
+		row.output_shift = job->output_16 ? 0 : job->format->depth - 8;
+		row.output = job->output + y * output_stride;
+
+		_demosaic_row_scalar (&row, 0, 1);
+#ifdef ARV_IMAGE_CONVERT_HAS_X86
+		if (job->use_avx2)
+			x = is_16 ? _demosaic_row_avx2_16 (&row) : _demosaic_row_avx2_8 (&row);
+#endif
+		_demosaic_row_scalar (&row, x, job->width);
+	}
+}
+
+static void
+_demosaic_band_func (gpointer data, gpointer user_data)
+{
+	ArvDemosaicBand *band = data;
+	ArvDemosaicJob *job = band->job;
+
+	_demosaic_band (job, band->first_line, band->last_line);
+
+	g_mutex_lock (&job->mutex);
+	job->n_pending_bands--;
+	if (job->n_pending_bands == 0)
+		g_cond_signal (&job->cond);
+	g_mutex_unlock (&job->mutex);
+}
+
+static GMutex thread_pool_mutex;
+static GThreadPool *thread_pool = NULL;
+
+static GThreadPool *
+_get_thread_pool (void)
+{
+	GThreadPool *pool;
+
+	g_mutex_lock (&thread_pool_mutex);
+
+	if (thread_pool == NULL)
+		thread_pool = g_thread_pool_new (_demosaic_band_func, NULL,
+						 MAX (1, (gint) g_get_num_processors () - 1), FALSE, NULL);
+	pool = thread_pool;
+
+	g_mutex_unlock (&thread_pool_mutex);
+
+	return pool;
+}
+
+/**
+ * arv_image_convert_cleanup:
+ *
+ * Stops the conversion threads. Called by arv_shutdown().
+ */
+
+void
+arv_image_convert_cleanup (void)
+{
+	g_mutex_lock (&thread_pool_mutex);
+
+	if (thread_pool != NULL) {
+		g_thread_pool_free (thread_pool, FALSE, TRUE);
+		thread_pool = NULL;
+	}
+
+	g_mutex_unlock (&thread_pool_mutex);
+}
+
+static void
+_demosaic (ArvDemosaicJob *job, guint n_threads)
+{
+	ArvDemosaicBand *bands;
+	GThreadPool *pool;
+	guint n_bands;
+	guint i;
+
+	if (n_threads == 0)
+		n_threads = g_get_num_processors ();
+	n_bands = CLAMP (job->height / ARV_DEMOSAIC_MIN_BAND_HEIGHT, 1, n_threads);
+
+	if (n_bands == 1) {
+		_demosaic_band (job, 0, job->height);
+		return;
+	}
+
+	pool = _get_thread_pool ();
+
+	bands = g_new (ArvDemosaicBand, n_bands);
+	g_mutex_init (&job->mutex);
+	g_cond_init (&job->cond);
+	job->n_pending_bands = n_bands - 1;
+
+	for (i = 0; i < n_bands; i++) {
+		bands[i].job = job;
+		bands[i].first_line = (guint64) job->height * i / n_bands;
+		bands[i].last_line = (guint64) job->height * (i + 1) / n_bands;
+	}
+
+	/* The calling thread converts the first band */
+	for (i = 1; i < n_bands; i++)
+		g_thread_pool_push (pool, &bands[i], NULL);
+
+	_demosaic_band (job, bands[0].first_line, bands[0].last_line);
+
+	g_mutex_lock (&job->mutex);
+	while (job->n_pending_bands > 0)
+		g_cond_wait (&job->cond, &job->mutex);
+	g_mutex_unlock (&job->mutex);
+
+	g_mutex_clear (&job->mutex);
+	g_cond_clear (&job->cond);
+	g_free (bands);
+}
+
+/**
+ * arv_image_get_demosaiced_pixel_format:
+ * @pixel_format: a Bayer pixel format
+ * @output_bits: bits per channel of the demosaiced data, 8 or 16
+ *
+ * Returns: the RGB pixel format of the data written by arv_image_demosaic(), 0 if @pixel_format can not be
+ * demosaiced.
+ *
+ * Since: 0.10.0
+ */
+
+ArvPixelFormat
+arv_image_get_demosaiced_pixel_format (ArvPixelFormat pixel_format, guint output_bits)
+{
+	const ArvImageBayerFormat *format;
+
+	format = _find_bayer_format (pixel_format);
+	if (format == NULL || (output_bits != 8 && output_bits != 16) || (output_bits == 16 && format->depth == 8))
+		return 0;
+
+	if (output_bits == 8)
+		return ARV_PIXEL_FORMAT_RGB_8_PACKED;
+
+	switch (format->depth) {
+		case 10: return ARV_PIXEL_FORMAT_RGB_10_PACKED;
+		case 12: return ARV_PIXEL_FORMAT_RGB_12_PACKED;
+		default: return ARV_PIXEL_FORMAT_RGB_16_PACKED;
+	}
+}
+
+/**
+ * arv_image_get_demosaiced_size:
+ * @pixel_format: a Bayer pixel format
+ * @width: image width, in pixels
+ * @height: image height, in pixels
+ * @output_bits: bits per channel of the demosaiced data, 8 or 16
+ *
+ * Returns: the size of the demosaiced image, 0 if @pixel_format can not be demosaiced.
+ *
+ * Since: 0.10.0
+ */
+
+size_t
+arv_image_get_demosaiced_size (ArvPixelFormat pixel_format, guint width, guint height, guint output_bits)
+{
+	if (arv_image_get_demosaiced_pixel_format (pixel_format, output_bits) == 0)
+		return 0;
+
+	return (size_t) width * height * 3 * (output_bits / 8);
+}
+
+/**
+ * arv_image_demosaic:
+ * @pixel_format: Bayer pixel format of @input
+ * @input: (array length=input_size) (element-type guint8): Bayer image data
+ * @input_size: size of @input, in bytes
+ * @width: image width, in pixels
+ * @height: image height, in pixels
+ * @x_padding: number of bytes at the end of each line of @input
+ * @method: interpolation method
+ * @output_bits: bits per channel of the demosaiced data, 8 or 16
+ * @output: (array length=output_size) (element-type guint8): RGB image data placeholder
+ * @output_size: size of @output, in bytes
+ * @n_threads: maximum number of threads, 0 for the number of processors
+ * @error: a #GError placeholder, %NULL to ignore
+ *
+ * Converts an image using a 8, 10, 12 or 16 bit Bayer pixel format to RGB. With a 16 bit output, the channels keep the
+ * depth of the Bayer data. A 16 bit output is not allowed for 8 bit Bayer formats.
+ * arv_image_get_demosaiced_pixel_format() returns the pixel format of the output.
+ *
+ * Large images are split in bands of lines converted in parallel, by at most @n_threads threads, including the
+ * calling one.
+ *
+ * Returns: the size of the RGB data, 0 on error.
+ *
+ * Since: 0.10.0
+ */
+
+size_t
+arv_image_demosaic (ArvPixelFormat pixel_format,
+		    const void *input, size_t input_size,
+		    guint width, guint height, guint x_padding,
+		    ArvDemosaicMethod method,
+		    guint output_bits, void *output, size_t output_size,
+		    guint n_threads, GError **error)
+{
+	ArvDemosaicJob job;
+	size_t output_image_size;
+	size_t line_size;
+
+	g_return_val_if_fail (input != NULL, 0);
+	g_return_val_if_fail (output != NULL, 0);
+
+	job.format = _find_bayer_format (pixel_format);
+	if (job.format == NULL) {
+		g_set_error (error, ARV_IMAGE_CONVERT_ERROR, ARV_IMAGE_CONVERT_ERROR_PIXEL_FORMAT_NOT_SUPPORTED,
+			     "Pixel format 0x%08x can not be demosaiced", pixel_format);
+		return 0;
+	}
+
+	if (arv_image_get_demosaiced_pixel_format (pixel_format, output_bits) == 0 ||
+	    method == ARV_DEMOSAIC_METHOD_NONE ||
+	    width < 2 || height < 2) {
+		g_set_error (error, ARV_IMAGE_CONVERT_ERROR, ARV_IMAGE_CONVERT_ERROR_INVALID_PARAMETER,
+			     "Invalid demosaicing parameters (%ux%u image, method %d, %u bit output)",
+			     width, height, method, output_bits);
+		return 0;
+	}
+
+	line_size = (size_t) width * (job.format->depth > 8 ? 2 : 1);
+	output_image_size = arv_image_get_demosaiced_size (pixel_format, width, height, output_bits);
+
+	if (input_size < (size_t) height * (line_size + x_padding) - x_padding || output_size < output_image_size) {
+		g_set_error (error, ARV_IMAGE_CONVERT_ERROR, ARV_IMAGE_CONVERT_ERROR_BUFFER_TOO_SMALL,
+			     "Data too small for a %ux%u image", width, height);
+		return 0;
+	}
+
+	job.input = input;
+	job.input_stride = line_size + x_padding;
+	job.width = width;
+	job.height = height;
+	job.edge_aware = method == ARV_DEMOSAIC_METHOD_EDGE_AWARE;
+	job.output_16 = output_bits == 16;
+	job.output = output;
+	job.use_avx2 = _get_implementation () == ARV_IMAGE_CONVERT_IMPLEMENTATION_AVX2;
+
+	_demosaic (&job, n_threads);
+
+	return output_image_size;
+}
+
+/**
+ * arv_image_demosaic_buffer_part:
+ * @buffer: a #ArvBuffer
+ * @part_id: an image part id
+ * @method: interpolation method
+ * @output_bits: bits per channel of the demosaiced data, 8 or 16
+ * @output: (array length=output_size) (element-type guint8): RGB image data placeholder
+ * @output_size: size of @output, in bytes
+ * @n_threads: maximum number of threads, 0 for the number of processors
+ * @error: a #GError placeholder, %NULL to ignore
+ *
+ * Demosaics the data of an image part, using its pixel format, size and line padding. See arv_image_demosaic().
+ *
+ * Returns: the size of the RGB data, 0 on error.
+ *
+ * Since: 0.10.0
+ */
+
+size_t
+arv_image_demosaic_buffer_part (ArvBuffer *buffer, guint part_id,
+				ArvDemosaicMethod method,
+				guint output_bits, void *output, size_t output_size,
+				guint n_threads, GError **error)
+{
+	const void *data;
+	size_t size;
+	gint width, height;
+	gint x_padding;
+
+	g_return_val_if_fail (ARV_IS_BUFFER (buffer), 0);
+
+	if (!_get_image_part (buffer, part_id, &data, &size, &width, &height, &x_padding, error))
+		return 0;
+
+	return arv_image_demosaic (arv_buffer_get_part_pixel_format (buffer, part_id),
+				   data, size, width, height, x_padding, method,
+				   output_bits, output, output_size, n_threads, error);
+}
+
+/**
+ * arv_image_demosaic_buffer:
+ * @buffer: a #ArvBuffer
+ * @method: interpolation method
+ * @n_threads: maximum number of threads, 0 for the number of processors
+ *
+ * Demosaics the single image part of @buffer into the unused end of the buffer memory, and updates the part data
+ * offset, size and pixel format. The channels keep the depth of the Bayer data. The raw data returned by
+ * arv_buffer_get_data() is left untouched.
+ *
+ * Returns: %TRUE if the buffer was converted, %FALSE if it does not contain a Bayer image, or if the allocated size is
+ * too small.
+ */
+
+gboolean
+arv_image_demosaic_buffer (ArvBuffer *buffer, ArvDemosaicMethod method, guint n_threads)
+{
+	ArvBufferPrivate *priv;
+	ArvBufferPartInfos *part;
+	const ArvImageBayerFormat *format;
+	ptrdiff_t output_offset;
+	size_t output_size;
+	guint output_bits;
+
+	g_return_val_if_fail (ARV_IS_BUFFER (buffer), FALSE);
+
+	priv = buffer->priv;
+
+	if (method == ARV_DEMOSAIC_METHOD_NONE ||
+	    priv->status != ARV_BUFFER_STATUS_SUCCESS ||
+	    priv->payload_type != ARV_BUFFER_PAYLOAD_TYPE_IMAGE ||
+	    priv->n_parts != 1)
+		return FALSE;
+
+	part = &priv->parts[0];
+	format = _find_bayer_format (part->pixel_format);
+	if (format == NULL || part->width < 2 || part->height < 2)
+		return FALSE;
+
+	output_bits = format->depth > 8 ? 16 : 8;
+	output_offset = (MAX (priv->received_size, part->data_offset + part->size) + 63) & ~((ptrdiff_t) 63);
+	output_size = arv_image_get_demosaiced_size (part->pixel_format, part->width, part->height, output_bits);
+
+	if (output_offset + output_size > priv->allocated_size)
+		return FALSE;
+
+	if (arv_image_demosaic (part->pixel_format, priv->data + part->data_offset, part->size,
+				part->width, part->height, part->x_padding, method,
+				output_bits, priv->data + output_offset, output_size, n_threads, NULL) == 0)
+		return FALSE;
+
+	part->data_offset = output_offset;
+	part->size = output_size;
+	part->pixel_format = arv_image_get_demosaiced_pixel_format (part->pixel_format, output_bits);
+	part->x_padding = 0;
+
+	return TRUE;
+}
@@ -0,0 +1,101 @@
+/* Aravis - Digital camera library
+ *
+ * Copyright © 2009-2025 Emmanuel Pacaud <emmanuel.pacaud@free.fr>
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: Emmanuel Pacaud <emmanuel.pacaud@free.fr>
+ */
+
+#ifndef ARV_IMAGE_CONVERT_H
+#define ARV_IMAGE_CONVERT_H
+
+#if !defined (ARV_H_INSIDE) && !defined (ARAVIS_COMPILATION)
+#error "Only <arv.h> can be included directly."
+#endif
+
+#include <arvapi.h>
+#include <arvtypes.h>
+#include <arvbuffer.h>
+
+G_BEGIN_DECLS
+
+#define ARV_IMAGE_CONVERT_ERROR arv_image_convert_error_quark()
+
+ARV_API GQuark		arv_image_convert_error_quark		(void);
+
+/**
+ * ArvImageConvertError:
+ * @ARV_IMAGE_CONVERT_ERROR_INVALID_PARAMETER: invalid parameter
+ * @ARV_IMAGE_CONVERT_ERROR_PIXEL_FORMAT_NOT_SUPPORTED: pixel format not supported
+ * @ARV_IMAGE_CONVERT_ERROR_BUFFER_TOO_SMALL: input or output data too small for the image size
+ *
+ * Since: 0.10.0
+ */
+
+typedef enum {
+	ARV_IMAGE_CONVERT_ERROR_INVALID_PARAMETER,
+	ARV_IMAGE_CONVERT_ERROR_PIXEL_FORMAT_NOT_SUPPORTED,
+	ARV_IMAGE_CONVERT_ERROR_BUFFER_TOO_SMALL
+} ArvImageConvertError;
+
+/**
+ * ArvDemosaicMethod:
+ * @ARV_DEMOSAIC_METHOD_NONE: no demosaicing
+ * @ARV_DEMOSAIC_METHOD_BILINEAR: bilinear interpolation
+ * @ARV_DEMOSAIC_METHOD_EDGE_AWARE: bilinear interpolation, except for the green channel of the red and blue sites,
+ * interpolated along the direction of the smallest gradient
+ *
+ * Since: 0.10.0
+ */
+
+typedef enum {
+	ARV_DEMOSAIC_METHOD_NONE,
+	ARV_DEMOSAIC_METHOD_BILINEAR,
+	ARV_DEMOSAIC_METHOD_EDGE_AWARE
+} ArvDemosaicMethod;
+
+ARV_API ArvPixelFormat	arv_image_get_unpacked_pixel_format	(ArvPixelFormat pixel_format, guint output_bits);
+ARV_API size_t		arv_image_get_unpacked_size		(ArvPixelFormat pixel_format,
+								 guint width, guint height, guint output_bits);
+
+ARV_API size_t		arv_image_unpack			(ArvPixelFormat pixel_format,
+								 const void *input, size_t input_size,
+								 guint width, guint height, guint x_padding,
+								 guint output_bits, void *output, size_t output_size,
+								 GError **error);
+ARV_API size_t		arv_image_unpack_buffer_part		(ArvBuffer *buffer, guint part_id,
+								 guint output_bits, void *output, size_t output_size,
+								 GError **error);
+
+ARV_API ArvPixelFormat	arv_image_get_demosaiced_pixel_format	(ArvPixelFormat pixel_format, guint output_bits);
+ARV_API size_t		arv_image_get_demosaiced_size		(ArvPixelFormat pixel_format,
+								 guint width, guint height, guint output_bits);
+
+ARV_API size_t		arv_image_demosaic			(ArvPixelFormat pixel_format,
+								 const void *input, size_t input_size,
+								 guint width, guint height, guint x_padding,
+								 ArvDemosaicMethod method,
+								 guint output_bits, void *output, size_t output_size,
+								 guint n_threads, GError **error);
+ARV_API size_t		arv_image_demosaic_buffer_part		(ArvBuffer *buffer, guint part_id,
+								 ArvDemosaicMethod method,
+								 guint output_bits, void *output, size_t output_size,
+								 guint n_threads, GError **error);
+
+G_END_DECLS
+
+#endif
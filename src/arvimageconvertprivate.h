@@ -0,0 +1,55 @@
+/* Aravis - Digital camera library
+ *
+ * Copyright © 2009-2025 Emmanuel Pacaud <emmanuel.pacaud@free.fr>
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: Emmanuel Pacaud <emmanuel.pacaud@free.fr>
+ */
+
+#ifndef ARV_IMAGE_CONVERT_PRIVATE_H
+#define ARV_IMAGE_CONVERT_PRIVATE_H
+
+#include <arvimageconvert.h>
+
+G_BEGIN_DECLS
+
+typedef enum {
+	ARV_IMAGE_CONVERT_IMPLEMENTATION_AUTO,
+	ARV_IMAGE_CONVERT_IMPLEMENTATION_SCALAR,
+	ARV_IMAGE_CONVERT_IMPLEMENTATION_SSE4_1,
+	ARV_IMAGE_CONVERT_IMPLEMENTATION_AVX2,
+	ARV_IMAGE_CONVERT_IMPLEMENTATION_NEON,
+	ARV_IMAGE_CONVERT_IMPLEMENTATION_N_ELEMENTS
+} ArvImageConvertImplementation;
+
+/* Forcing an implementation is only meant for the tests and the benchmark */
+
+ARV_API gboolean				arv_image_convert_set_implementation	(ArvImageConvertImplementation implementation);
+ARV_API ArvImageConvertImplementation	arv_image_convert_get_implementation	(void);
+ARV_API const char *			arv_image_convert_implementation_to_string
+										(ArvImageConvertImplementation implementation);
+
+ARV_API gboolean			arv_image_unpack_buffer			(ArvBuffer *buffer, guint output_bits);
+ARV_API gboolean			arv_image_demosaic_buffer		(ArvBuffer *buffer,
+										 ArvDemosaicMethod method,
+										 guint n_threads);
+
+void					arv_image_convert_cleanup		(void);
+
+G_END_DECLS
+
+#endif
@@ -371,6 +371,157 @@ arv_histogram_to_string (const ArvHistogram *histogram)
         return arv_g_string_free_and_steal(string);
 }
 
+/*
+ * Log bucketed histogram, with a relative resolution of 1/16, the values below 32 being exactly counted. The counters
+ * are atomically updated, which allows to fill the histogram from several threads, and to compute the percentiles at
+ * any time, without any lock.
+ */
+
+#define ARV_LOG_HISTOGRAM_SUB_BUCKET_BITS	4
+#define ARV_LOG_HISTOGRAM_N_SUB_BUCKETS		(1 << ARV_LOG_HISTOGRAM_SUB_BUCKET_BITS)
+#define ARV_LOG_HISTOGRAM_N_BINS		((64 - ARV_LOG_HISTOGRAM_SUB_BUCKET_BITS + 1) * \
+						 ARV_LOG_HISTOGRAM_N_SUB_BUCKETS)
+
+#if defined (_MSC_VER)
+#include <intrin.h>
+#define _atomic_uint64_inc(p)	_InterlockedIncrement64 ((volatile __int64 *) (p))
+#define _atomic_uint64_get(p)	((guint64) _InterlockedCompareExchange64 ((volatile __int64 *) (p), 0, 0))
+#else
+#define _atomic_uint64_inc(p)	__atomic_fetch_add ((p), 1, __ATOMIC_RELAXED)
+#define _atomic_uint64_get(p)	__atomic_load_n ((p), __ATOMIC_RELAXED)
+#endif
+
+struct _ArvLogHistogram {
+	guint64 bins[ARV_LOG_HISTOGRAM_N_BINS];
+};
+
+static guint
+_log_histogram_get_bin (guint64 value)
+{
+	guint64 v = value;
+	guint msb = 0;
+	guint shift;
+
+	if (value < 2 * ARV_LOG_HISTOGRAM_N_SUB_BUCKETS)
+		return value;
+
+	if (v >> 32) { msb += 32; v >>= 32; }
+	if (v >> 16) { msb += 16; v >>= 16; }
+	if (v >> 8) { msb += 8; v >>= 8; }
+	if (v >> 4) { msb += 4; v >>= 4; }
+	if (v >> 2) { msb += 2; v >>= 2; }
+	if (v >> 1) { msb += 1; }
+
+	/* value >> shift is in [N_SUB_BUCKETS, 2 * N_SUB_BUCKETS[ */
+	shift = msb - ARV_LOG_HISTOGRAM_SUB_BUCKET_BITS;
+
+	return shift * ARV_LOG_HISTOGRAM_N_SUB_BUCKETS + (guint) (value >> shift);
+}
+
+/* Highest value counted in a bin */
+
+static guint64
+_log_histogram_get_bin_maximum (guint bin)
+{
+	guint shift;
+	guint64 top;
+
+	if (bin < 2 * ARV_LOG_HISTOGRAM_N_SUB_BUCKETS)
+		return bin;
+
+	shift = bin / ARV_LOG_HISTOGRAM_N_SUB_BUCKETS - 1;
+	top = bin % ARV_LOG_HISTOGRAM_N_SUB_BUCKETS + ARV_LOG_HISTOGRAM_N_SUB_BUCKETS;
+
+	/* Wraps to G_MAXUINT64 for the last bin */
+	return ((top + 1) << shift) - 1;
+}
+
+/**
+ * arv_log_histogram_new: (skip)
+ *
+ * Return value: a new log bucketed histogram, for positive values, typically latencies.
+ */
+
+ArvLogHistogram *
+arv_log_histogram_new (void)
+{
+	return g_new0 (ArvLogHistogram, 1);
+}
+
+void
+arv_log_histogram_free (ArvLogHistogram *histogram)
+{
+	g_free (histogram);
+}
+
+/**
+ * arv_log_histogram_fill: (skip)
+ * @histogram: a #ArvLogHistogram
+ * @value: a new sample, negative values being counted as 0
+ *
+ * This function is thread safe.
+ */
+
+void
+arv_log_histogram_fill (ArvLogHistogram *histogram, gint64 value)
+{
+	g_return_if_fail (histogram != NULL);
+
+	_atomic_uint64_inc (&histogram->bins[_log_histogram_get_bin (value > 0 ? value : 0)]);
+}
+
+guint64
+arv_log_histogram_get_count (const ArvLogHistogram *histogram)
+{
+	guint64 count = 0;
+	guint i;
+
+	g_return_val_if_fail (histogram != NULL, 0);
+
+	for (i = 0; i < ARV_LOG_HISTOGRAM_N_BINS; i++)
+		count += _atomic_uint64_get (&histogram->bins[i]);
+
+	return count;
+}
+
+/**
+ * arv_log_histogram_get_percentile: (skip)
+ * @histogram: a #ArvLogHistogram
+ * @percentile: a percentile, between 0 and 100
+ *
+ * Computes a percentile from a snapshot of the histogram, which can be filled at the same time.
+ *
+ * Returns: the highest value equivalent to the requested percentile, within the histogram resolution, 0 if the
+ * histogram is empty.
+ */
+
+guint64
+arv_log_histogram_get_percentile (const ArvLogHistogram *histogram, double percentile)
+{
+	guint64 count;
+	guint64 rank;
+	guint64 sum = 0;
+	guint i;
+
+	g_return_val_if_fail (histogram != NULL, 0);
+
+	count = arv_log_histogram_get_count (histogram);
+	if (count == 0)
+		return 0;
+
+	rank = (guint64) ceil (CLAMP (percentile, 0.0, 100.0) * count / 100.0);
+	rank = CLAMP (rank, 1, count);
+
+	/* The bins can only grow since the count computation, the rank is still reached */
+	for (i = 0; i < ARV_LOG_HISTOGRAM_N_BINS; i++) {
+		sum += _atomic_uint64_get (&histogram->bins[i]);
+		if (sum >= rank)
+			return _log_histogram_get_bin_maximum (i);
+	}
+
+	return G_MAXUINT64;
+}
+
 ArvValue *
 arv_value_new_double (double v_double)
 {
@@ -42,6 +42,15 @@ void 			arv_histogram_set_variable_name	(ArvHistogram *histogram, guint histogra
 
 char *			arv_histogram_to_string 	(const ArvHistogram *histogram);
 
+typedef struct _ArvLogHistogram ArvLogHistogram;
+
+ARV_API ArvLogHistogram *	arv_log_histogram_new			(void);
+ARV_API void			arv_log_histogram_free			(ArvLogHistogram *histogram);
+ARV_API void			arv_log_histogram_fill			(ArvLogHistogram *histogram, gint64 value);
+ARV_API guint64			arv_log_histogram_get_count		(const ArvLogHistogram *histogram);
+ARV_API guint64			arv_log_histogram_get_percentile	(const ArvLogHistogram *histogram,
+									 double percentile);
+
 struct _ArvValue {
 	GType type;
 	union {
@@ -586,6 +586,42 @@ arv_network_get_interface_by_address (const char* addr)
 	return ret;
 }
 
+/*
+ * arv_network_get_interface_numa_node:
+ * @addr: interface IP address
+ *
+ * Returns: the NUMA node the network adapter owning @addr is attached to, -1 if unknown
+ */
+
+gint
+arv_network_get_interface_numa_node (const char *addr)
+{
+#ifdef __linux__
+	ArvNetworkInterface *iface;
+	char *filename;
+	char *content = NULL;
+	gint numa_node = -1;
+
+	iface = arv_network_get_interface_by_address (addr);
+	if (iface == NULL)
+		return -1;
+
+	/* Virtual interfaces have no device, and a single node system reports -1 */
+	filename = g_build_filename ("/sys/class/net", arv_network_interface_get_name (iface), "device", "numa_node",
+				     NULL);
+	if (g_file_get_contents (filename, &content, NULL, NULL))
+		numa_node = g_ascii_strtoll (content, NULL, 10);
+
+	g_free (content);
+	g_free (filename);
+	arv_network_interface_free (iface);
+
+	return MAX (numa_node, -1);
+#else
+	return -1;
+#endif
+}
+
 ArvNetworkInterface*
 arv_network_get_fake_ipv4_loopback (void)
 {
@@ -97,6 +97,7 @@ ARV_API GList *		arv_enumerate_network_interfaces	(void);
 ArvNetworkInterface*	arv_network_get_interface_by_name	(const char* name);
 ArvNetworkInterface*	arv_network_get_interface_by_address	(const char* addr);
 ArvNetworkInterface*	arv_network_get_fake_ipv4_loopback	(void);
+gint			arv_network_get_interface_numa_node	(const char *addr);
 
 /* private, but used by tests */
 ARV_API void 			arv_network_interface_free		(ArvNetworkInterface *a);
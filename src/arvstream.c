@@ -31,9 +31,15 @@
  */
 
 #include <arvstreamprivate.h>
-#include <arvbuffer.h>
+#include <arvbufferqueueprivate.h>
+#include <arvwakeupprivate.h>
+#include <arvbufferprivate.h>
+#include <arvbufferpool.h>
+#include <arvimageconvertprivate.h>
 #include <arvdevice.h>
+#include <arvenumtypes.h>
 #include <arvdebugprivate.h>
+#include <arvmiscprivate.h>
 #include <gio/gio.h>
 
 typedef struct {
@@ -41,8 +47,23 @@ typedef struct {
         char *description;
         GType type;
         gpointer data;
+        /* Computed on request from a latency histogram, the sample count for a negative percentile */
+        ArvLogHistogram *histogram;
+        double percentile;
 } ArvStreamInfo;
 
+typedef struct {
+        ArvStreamProcessingFunc func;
+        void *user_data;
+        GDestroyNotify destroy_func;
+} ArvStreamProcessingStage;
+
+typedef struct {
+        ArvBuffer *buffer;
+        gboolean notify;
+        gboolean done;
+} ArvStreamProcessingJob;
+
 enum {
 	ARV_STREAM_SIGNAL_NEW_BUFFER,
 	ARV_STREAM_SIGNAL_LAST
@@ -56,13 +77,22 @@ enum {
 	ARV_STREAM_PROPERTY_DEVICE,
 	ARV_STREAM_PROPERTY_CALLBACK,
 	ARV_STREAM_PROPERTY_CALLBACK_DATA,
-	ARV_STREAM_PROPERTY_DESTROY_NOTIFY
+	ARV_STREAM_PROPERTY_DESTROY_NOTIFY,
+	ARV_STREAM_PROPERTY_BUFFER_POOL_FLAGS,
+	ARV_STREAM_PROPERTY_NUMA_NODE,
+	ARV_STREAM_PROPERTY_DEMOSAIC,
+	ARV_STREAM_PROPERTY_UNPACK_BITS,
+	ARV_STREAM_PROPERTY_N_PROCESSING_THREADS
 } ArvStreamProperties;
 
 typedef struct {
-	GAsyncQueue *input_queue;
-	GAsyncQueue *output_queue;
+	ArvBufferQueue *input_queue;
+	ArvBufferQueue *output_queue;
         gint n_buffer_filling;
+
+        /* Pollable output queue state, created on demand by arv_stream_get_fd() */
+        ArvWakeup *output_wakeup;
+        gint output_signaled;
 	GRecMutex mutex;
 	gboolean emit_signals;
 
@@ -74,14 +104,92 @@ typedef struct {
 	GError *init_error;
 
         GPtrArray *infos;
+
+        /* Memory of the buffers allocated by arv_stream_create_buffers() */
+        ArvBufferPoolFlags buffer_pool_flags;
+        gint numa_node;
+        gboolean buffer_pool_infos_declared;
+        guint64 buffer_pool_size;
+        guint64 buffer_pool_locked_size;
+        guint64 buffer_pool_page_size;
+
+        /* Optional conversions of the packed and Bayer images, before they are pushed to the output queue */
+        gint demosaic_method;
+        guint unpack_bits;
+
+        /* Post acquisition processing. Jobs are queued in arrival order, and leave the queue in the same order. */
+        GPtrArray *processing_stages;
+        guint n_processing_threads;
+        GThreadPool *processing_pool;
+        GMutex processing_mutex;
+        GCond processing_cond;
+        GQueue processing_jobs;
+        guint64 processing_sequence;            /* Batches of processed buffers taken from the job queue */
+
+        /* Output of the processed buffers, in the order of their batch sequence, outside of processing_mutex */
+        GMutex processing_output_mutex;
+        GCond processing_output_cond;
+        guint64 processing_output_sequence;
+
+        ArvLogHistogram *latencies[ARV_STREAM_LATENCY_N_ELEMENTS];
+        guint disabled_latencies;
+        gboolean latency_infos_declared;
+        guint64 last_frame_time_ns;
+        gint64 last_frame_interval_ns;
 } ArvStreamPrivate;
 
 static void arv_stream_initable_iface_init (GInitableIface *iface);
+static void _declare_latency_infos (ArvStream *stream);
 
 G_DEFINE_ABSTRACT_TYPE_WITH_CODE (ArvStream, arv_stream, G_TYPE_OBJECT,
 				  G_ADD_PRIVATE (ArvStream)
 				  G_IMPLEMENT_INTERFACE (G_TYPE_INITABLE, arv_stream_initable_iface_init))
 
+static void
+_signal_output (ArvStreamPrivate *priv)
+{
+        ArvWakeup *wakeup = g_atomic_pointer_get (&priv->output_wakeup);
+
+        if (wakeup != NULL && g_atomic_int_compare_and_exchange (&priv->output_signaled, FALSE, TRUE))
+                arv_wakeup_signal (wakeup);
+}
+
+static void
+_fill_output_latencies (ArvStreamPrivate *priv, ArvBuffer **buffers, guint n_buffers)
+{
+        gint64 time_us;
+        guint i;
+
+        if (n_buffers == 0)
+                return;
+
+        time_us = g_get_monotonic_time ();
+        for (i = 0; i < n_buffers; i++)
+                arv_log_histogram_fill (priv->latencies[ARV_STREAM_LATENCY_OUTPUT],
+                                        time_us - buffers[i]->priv->output_time_us);
+}
+
+static ArvBuffer *
+_output_popped (ArvStreamPrivate *priv, ArvBuffer *buffer)
+{
+        ArvWakeup *wakeup = g_atomic_pointer_get (&priv->output_wakeup);
+
+        if (buffer != NULL)
+                _fill_output_latencies (priv, &buffer, 1);
+
+        if (wakeup == NULL || arv_buffer_queue_get_length (priv->output_queue) > 0)
+                return buffer;
+
+        arv_wakeup_acknowledge (wakeup);
+        g_atomic_int_set (&priv->output_signaled, FALSE);
+
+        /* A buffer may have been pushed before the acknowledgement, while the wakeup was still signaled */
+        if (arv_buffer_queue_get_length (priv->output_queue) > 0)
+                _signal_output (priv);
+
+        return buffer;
+}
+
 /**
  * arv_stream_push_buffer:
  * @stream: a #ArvStream
@@ -103,7 +211,7 @@ arv_stream_push_buffer (ArvStream *stream, ArvBuffer *buffer)
 	g_return_if_fail (ARV_IS_STREAM (stream));
 	g_return_if_fail (ARV_IS_BUFFER (buffer));
 
-	g_async_queue_push (priv->input_queue, buffer);
+	arv_buffer_queue_push (priv->input_queue, buffer);
 }
 
 /**
@@ -128,7 +236,7 @@ arv_stream_pop_buffer (ArvStream *stream)
 
 	g_return_val_if_fail (ARV_IS_STREAM (stream), NULL);
 
-	return g_async_queue_pop (priv->output_queue);
+	return _output_popped (priv, arv_buffer_queue_pop (priv->output_queue));
 }
 
 /**
@@ -153,7 +261,7 @@ arv_stream_try_pop_buffer (ArvStream *stream)
 
 	g_return_val_if_fail (ARV_IS_STREAM (stream), NULL);
 
-	return g_async_queue_try_pop (priv->output_queue);
+	return _output_popped (priv, arv_buffer_queue_try_pop (priv->output_queue));
 }
 
 /**
@@ -178,7 +286,124 @@ arv_stream_timeout_pop_buffer (ArvStream *stream, guint64 timeout)
 
 	g_return_val_if_fail (ARV_IS_STREAM (stream), NULL);
 
-	return g_async_queue_timeout_pop (priv->output_queue, timeout);
+	return _output_popped (priv, arv_buffer_queue_timeout_pop (priv->output_queue, timeout));
+}
+
+/**
+ * arv_stream_push_buffers:
+ * @stream: a #ArvStream
+ * @buffers: (array length=n_buffers) (transfer full): buffers to push
+ * @n_buffers: number of buffers
+ *
+ * Pushes several #ArvBuffer to the @stream thread, in order. It is equivalent to calling
+ * [method@Aravis.Stream.push_buffer] for each buffer, but with a single access to the stream queue. The @stream
+ * takes ownership of the buffers.
+ *
+ * This method is thread safe.
+ *
+ * Since: 0.10.0
+ */
+
+void
+arv_stream_push_buffers (ArvStream *stream, ArvBuffer **buffers, guint n_buffers)
+{
+	ArvStreamPrivate *priv = arv_stream_get_instance_private (stream);
+	guint i;
+
+	g_return_if_fail (ARV_IS_STREAM (stream));
+	g_return_if_fail (buffers != NULL || n_buffers == 0);
+
+	for (i = 0; i < n_buffers; i++)
+		g_return_if_fail (ARV_IS_BUFFER (buffers[i]));
+
+	arv_buffer_queue_push_many (priv->input_queue, buffers, n_buffers);
+}
+
+/**
+ * arv_stream_pop_buffers:
+ * @stream: a #ArvStream
+ * @buffers: (out caller-allocates) (array length=max_buffers) (transfer full): array receiving the buffers
+ * @max_buffers: size of @buffers
+ * @timeout: timeout, in µs
+ *
+ * Pops up to @max_buffers buffers from the output queue of @stream, in a single access to the queue. If the queue
+ * is empty, waits no more than @timeout for a buffer, a 0 timeout making the call non blocking. The retrieved
+ * buffers may contain an invalid image. Caller should check the buffer status before using them.
+ *
+ * This method is thread safe.
+ *
+ * Returns: the number of buffers stored in @buffers, 0 if no buffer is available until the timeout occurs.
+ *
+ * Since: 0.10.0
+ */
+
+guint
+arv_stream_pop_buffers (ArvStream *stream, ArvBuffer **buffers, guint max_buffers, guint64 timeout)
+{
+	ArvStreamPrivate *priv = arv_stream_get_instance_private (stream);
+	guint n_buffers;
+
+	g_return_val_if_fail (ARV_IS_STREAM (stream), 0);
+	g_return_val_if_fail (buffers != NULL || max_buffers == 0, 0);
+
+	if (timeout == 0)
+		n_buffers = arv_buffer_queue_try_pop_many (priv->output_queue, buffers, max_buffers);
+	else
+		n_buffers = arv_buffer_queue_timeout_pop_many (priv->output_queue, buffers, max_buffers, timeout);
+
+        _fill_output_latencies (priv, buffers, n_buffers);
+	_output_popped (priv, NULL);
+
+	return n_buffers;
+}
+
+/**
+ * arv_stream_get_fd:
+ * @stream: a #ArvStream
+ *
+ * Returns a file descriptor which polls readable as long as the output queue of @stream is not empty. It allows to
+ * integrate the buffer reception in an event loop, or to wait for several streams using a single poll() or
+ * epoll_wait() call. When it becomes readable, the buffers should be popped using
+ * [method@Aravis.Stream.try_pop_buffer] until it returns %NULL. The file descriptor must not be read or closed, it
+ * is owned by @stream.
+ *
+ * On Linux, it is an eventfd, on the other Unix systems the read end of a pipe. This function is not available on
+ * Windows.
+ *
+ * This method is thread safe.
+ *
+ * Returns: a file descriptor, -1 on error
+ *
+ * Since: 0.10.0
+ */
+
+int
+arv_stream_get_fd (ArvStream *stream)
+{
+	ArvStreamPrivate *priv = arv_stream_get_instance_private (stream);
+        GPollFD poll_fd;
+
+	g_return_val_if_fail (ARV_IS_STREAM (stream), -1);
+
+#ifdef G_OS_WIN32
+        return -1;
+#else
+	g_rec_mutex_lock (&priv->mutex);
+
+        if (priv->output_wakeup == NULL) {
+                g_atomic_pointer_set (&priv->output_wakeup, arv_wakeup_new ());
+
+                /* Buffers pushed before the wakeup creation were not signaled */
+                if (arv_buffer_queue_get_length (priv->output_queue) > 0)
+                        _signal_output (priv);
+        }
+
+        arv_wakeup_get_pollfd (priv->output_wakeup, &poll_fd);
+
+	g_rec_mutex_unlock (&priv->mutex);
+
+        return poll_fd.fd;
+#endif
 }
 
 /**
@@ -194,57 +419,445 @@ ArvBuffer *
 arv_stream_pop_input_buffer (ArvStream *stream)
 {
 	ArvStreamPrivate *priv = arv_stream_get_instance_private (stream);
-        void *data;
+        ArvBuffer *buffer;
 
 	g_return_val_if_fail (ARV_IS_STREAM (stream), NULL);
 
-        g_async_queue_lock(priv->input_queue);
-	data = g_async_queue_try_pop_unlocked (priv->input_queue);
-        if (data != NULL)
-                priv->n_buffer_filling++;
-        g_async_queue_unlock(priv->input_queue);
+	buffer = arv_buffer_queue_try_pop (priv->input_queue);
+        if (buffer != NULL)
+                g_atomic_int_inc (&priv->n_buffer_filling);
 
-        return data;
+        return buffer;
+}
+
+/**
+ * arv_stream_timeout_pop_input_buffers: (skip)
+ * @stream: a #ArvStream
+ * @buffers: array receiving the buffers
+ * @max_buffers: size of @buffers
+ * @timeout: timeout, in µs
+ *
+ * Pops up to @max_buffers buffers from the input queue of @stream, waiting no more than @timeout if it is empty.
+ *
+ * Returns: the number of popped buffers
+ */
+
+guint
+arv_stream_timeout_pop_input_buffers (ArvStream *stream, ArvBuffer **buffers, guint max_buffers, guint64 timeout)
+{
+	ArvStreamPrivate *priv = arv_stream_get_instance_private (stream);
+        guint n_buffers;
+
+	g_return_val_if_fail (ARV_IS_STREAM (stream), 0);
+
+	n_buffers = arv_buffer_queue_timeout_pop_many (priv->input_queue, buffers, max_buffers, timeout);
+        g_atomic_int_add (&priv->n_buffer_filling, n_buffers);
+
+        return n_buffers;
 }
 
 ArvBuffer *
 arv_stream_timeout_pop_input_buffer (ArvStream *stream, guint64 timeout)
 {
 	ArvStreamPrivate *priv = arv_stream_get_instance_private (stream);
-        void *data;
+        ArvBuffer *buffer;
 
 	g_return_val_if_fail (ARV_IS_STREAM (stream), NULL);
 
-        g_async_queue_lock(priv->input_queue);
-	data = g_async_queue_timeout_pop_unlocked (priv->input_queue, timeout);
-        if (data != NULL)
-                priv->n_buffer_filling++;
-        g_async_queue_unlock(priv->input_queue);
+	buffer = arv_buffer_queue_timeout_pop (priv->input_queue, timeout);
+        if (buffer != NULL)
+                g_atomic_int_inc (&priv->n_buffer_filling);
 
-        return data;
+        return buffer;
 }
 
 void
 arv_stream_push_output_buffer (ArvStream *stream, ArvBuffer *buffer)
+{
+	g_return_if_fail (ARV_IS_BUFFER (buffer));
+
+        arv_stream_push_output_buffers (stream, &buffer, 1);
+}
+
+static void
+_push_output (ArvStream *stream, ArvBuffer **buffers, guint n_buffers)
 {
 	ArvStreamPrivate *priv = arv_stream_get_instance_private (stream);
+        gint64 time_us = g_get_monotonic_time ();
+        guint i;
 
-	g_return_if_fail (ARV_IS_STREAM (stream));
-	g_return_if_fail (ARV_IS_BUFFER (buffer));
+        for (i = 0; i < n_buffers; i++)
+                buffers[i]->priv->output_time_us = time_us;
+
+        g_atomic_int_add (&priv->n_buffer_filling, - (gint) n_buffers);
+	arv_buffer_queue_push_many (priv->output_queue, buffers, n_buffers);
 
-        g_async_queue_lock (priv->output_queue);
-	g_async_queue_push_unlocked (priv->output_queue, buffer);
-        priv->n_buffer_filling--;
-        g_async_queue_unlock(priv->output_queue);
+        _signal_output (priv);
+}
+
+static void
+_emit_new_buffer (ArvStream *stream, guint n_buffers)
+{
+	ArvStreamPrivate *priv = arv_stream_get_instance_private (stream);
+        guint i;
+
+	/* The mutex is only taken when signals are enabled. It still ensures no signal is emitted once
+	 * arv_stream_set_emit_signals (stream, FALSE) has returned. */
+	if (!g_atomic_int_get (&priv->emit_signals))
+		return;
 
 	g_rec_mutex_lock (&priv->mutex);
 
-	if (priv->emit_signals)
+        for (i = 0; i < n_buffers && priv->emit_signals; i++)
 		g_signal_emit (stream, arv_stream_signals[ARV_STREAM_SIGNAL_NEW_BUFFER], 0);
 
 	g_rec_mutex_unlock (&priv->mutex);
 }
 
+static void
+_emit_buffer_done (ArvStream *stream, ArvBuffer **buffers, guint n_buffers)
+{
+	ArvStreamPrivate *priv = arv_stream_get_instance_private (stream);
+        guint i;
+
+        if (priv->callback == NULL)
+                return;
+
+        for (i = 0; i < n_buffers; i++)
+                priv->callback (priv->callback_data, ARV_STREAM_CALLBACK_TYPE_BUFFER_DONE, buffers[i]);
+}
+
+static gboolean
+_has_processing (ArvStreamPrivate *priv)
+{
+        return priv->processing_stages->len > 0 ||
+                g_atomic_int_get (&priv->unpack_bits) != 0 ||
+                g_atomic_int_get (&priv->demosaic_method) != ARV_DEMOSAIC_METHOD_NONE;
+}
+
+static void
+_process_buffer (ArvStream *stream, ArvBuffer *buffer)
+{
+	ArvStreamPrivate *priv = arv_stream_get_instance_private (stream);
+        ArvDemosaicMethod demosaic_method;
+        guint unpack_bits;
+        guint i;
+
+        unpack_bits = g_atomic_int_get (&priv->unpack_bits);
+        if (unpack_bits != 0)
+                arv_image_unpack_buffer (buffer, unpack_bits);
+
+        demosaic_method = g_atomic_int_get (&priv->demosaic_method);
+        if (demosaic_method != ARV_DEMOSAIC_METHOD_NONE)
+                arv_image_demosaic_buffer (buffer, demosaic_method, priv->processing_pool != NULL ? 1 : 0);
+
+        for (i = 0; i < priv->processing_stages->len; i++) {
+                ArvStreamProcessingStage *stage = g_ptr_array_index (priv->processing_stages, i);
+
+                stage->func (buffer, stage->user_data);
+        }
+}
+
+static void
+_processing_thread_func (gpointer data, gpointer user_data)
+{
+        ArvStreamProcessingJob *job = data;
+        ArvStream *stream = user_data;
+	ArvStreamPrivate *priv = arv_stream_get_instance_private (stream);
+        ArvBuffer *buffers[32];
+        gboolean notify[32];
+        guint64 sequence;
+        guint n_buffers;
+        guint i;
+
+        _process_buffer (stream, job->buffer);
+
+        g_mutex_lock (&priv->processing_mutex);
+
+        job->done = TRUE;
+
+        /* Take the buffers at the head of the queue whose processing is over, which keeps the frame order */
+        for (;;) {
+                for (n_buffers = 0; n_buffers < G_N_ELEMENTS (buffers); n_buffers++) {
+                        job = g_queue_peek_head (&priv->processing_jobs);
+                        if (job == NULL || !job->done)
+                                break;
+
+                        buffers[n_buffers] = job->buffer;
+                        notify[n_buffers] = job->notify;
+                        g_queue_pop_head (&priv->processing_jobs);
+                        g_free (job);
+                }
+
+                if (n_buffers == 0)
+                        break;
+
+                sequence = priv->processing_sequence++;
+
+                g_mutex_unlock (&priv->processing_mutex);
+
+                /* The output and the buffer done callbacks happen outside of processing_mutex, which is also taken
+                 * by the stream receiving thread. The batches are serialized by their sequence number, which keeps
+                 * the callbacks in order, as without processing threads. */
+                g_mutex_lock (&priv->processing_output_mutex);
+                while (priv->processing_output_sequence != sequence)
+                        g_cond_wait (&priv->processing_output_cond, &priv->processing_output_mutex);
+                g_mutex_unlock (&priv->processing_output_mutex);
+
+                _push_output (stream, buffers, n_buffers);
+                for (i = 0; i < n_buffers; i++)
+                        if (notify[i])
+                                _emit_buffer_done (stream, &buffers[i], 1);
+                _emit_new_buffer (stream, n_buffers);
+
+                g_mutex_lock (&priv->processing_output_mutex);
+                priv->processing_output_sequence++;
+                g_cond_broadcast (&priv->processing_output_cond);
+                g_mutex_unlock (&priv->processing_output_mutex);
+
+                g_mutex_lock (&priv->processing_mutex);
+        }
+
+        if (g_queue_is_empty (&priv->processing_jobs))
+                g_cond_broadcast (&priv->processing_cond);
+
+        g_mutex_unlock (&priv->processing_mutex);
+}
+
+static void
+_processing_drain (ArvStreamPrivate *priv)
+{
+        guint64 sequence;
+
+        g_mutex_lock (&priv->processing_mutex);
+        while (!g_queue_is_empty (&priv->processing_jobs))
+                g_cond_wait (&priv->processing_cond, &priv->processing_mutex);
+        sequence = priv->processing_sequence;
+        g_mutex_unlock (&priv->processing_mutex);
+
+        /* The last batches may still be on their way to the output queue */
+        g_mutex_lock (&priv->processing_output_mutex);
+        while (priv->processing_output_sequence != sequence)
+                g_cond_wait (&priv->processing_output_cond, &priv->processing_output_mutex);
+        g_mutex_unlock (&priv->processing_output_mutex);
+}
+
+/* Called from the stream receiving thread, or with its frame reassembly serialized */
+
+static void
+_fill_frame_latencies (ArvStreamPrivate *priv, ArvBuffer **buffers, guint n_buffers)
+{
+        guint64 time_ns = g_get_real_time () * 1000LL;
+        guint i;
+
+        for (i = 0; i < n_buffers; i++) {
+                guint64 frame_time_ns = buffers[i]->priv->system_timestamp_ns;
+
+                if (buffers[i]->priv->status != ARV_BUFFER_STATUS_SUCCESS || frame_time_ns == 0)
+                        continue;
+
+                if ((priv->disabled_latencies & (1 << ARV_STREAM_LATENCY_COMPLETION)) == 0)
+                        arv_log_histogram_fill (priv->latencies[ARV_STREAM_LATENCY_COMPLETION],
+                                                ((gint64) (time_ns - frame_time_ns)) / 1000);
+
+                if (priv->last_frame_time_ns != 0 && frame_time_ns > priv->last_frame_time_ns) {
+                        gint64 interval_ns = frame_time_ns - priv->last_frame_time_ns;
+
+                        if (priv->last_frame_interval_ns != 0)
+                                arv_log_histogram_fill (priv->latencies[ARV_STREAM_LATENCY_FRAME_JITTER],
+                                                        ABS (interval_ns - priv->last_frame_interval_ns) / 1000);
+                        priv->last_frame_interval_ns = interval_ns;
+                }
+                priv->last_frame_time_ns = frame_time_ns;
+        }
+}
+
+/**
+ * arv_stream_fill_latency:
+ * @stream: a #ArvStream
+ * @latency: latency type
+ * @value_us: latency value, in µs
+ *
+ * Adds a sample to a latency histogram of @stream. This function is thread safe.
+ */
+
+void
+arv_stream_fill_latency (ArvStream *stream, ArvStreamLatency latency, gint64 value_us)
+{
+	ArvStreamPrivate *priv = arv_stream_get_instance_private (stream);
+
+	g_return_if_fail (ARV_IS_STREAM (stream));
+	g_return_if_fail (latency < ARV_STREAM_LATENCY_N_ELEMENTS);
+
+        arv_log_histogram_fill (priv->latencies[latency], value_us);
+}
+
+/**
+ * arv_stream_disable_latency:
+ * @stream: a #ArvStream
+ * @latency: latency type
+ *
+ * Disables a latency histogram the stream implementation can not fill with meaningful values, for example the
+ * completion latency when the time of the first data of a frame is unknown. The histogram is not filled, and its
+ * infos are not declared. Must be called before the acquisition start, typically from the constructed method.
+ */
+
+void
+arv_stream_disable_latency (ArvStream *stream, ArvStreamLatency latency)
+{
+	ArvStreamPrivate *priv = arv_stream_get_instance_private (stream);
+
+	g_return_if_fail (ARV_IS_STREAM (stream));
+	g_return_if_fail (latency < ARV_STREAM_LATENCY_N_ELEMENTS);
+        g_return_if_fail (!priv->latency_infos_declared);
+
+        priv->disabled_latencies |= 1 << latency;
+}
+
+static void
+_push_output_buffers (ArvStream *stream, ArvBuffer **buffers, guint n_buffers, gboolean notify)
+{
+	ArvStreamPrivate *priv = arv_stream_get_instance_private (stream);
+        GThreadPool *pool;
+        guint i;
+
+        if (n_buffers == 0)
+                return;
+
+        _fill_frame_latencies (priv, buffers, n_buffers);
+
+        pool = g_atomic_pointer_get (&priv->processing_pool);
+        if (pool == NULL && g_atomic_int_get (&priv->n_processing_threads) > 0 && _has_processing (priv)) {
+                g_mutex_lock (&priv->processing_mutex);
+                if (priv->processing_pool == NULL)
+                        g_atomic_pointer_set (&priv->processing_pool,
+                                              g_thread_pool_new (_processing_thread_func, stream,
+                                                                 MAX (1, g_atomic_int_get (&priv->n_processing_threads)),
+                                                                 FALSE, NULL));
+                pool = priv->processing_pool;
+                g_mutex_unlock (&priv->processing_mutex);
+        }
+
+        if (pool == NULL) {
+                for (i = 0; i < n_buffers; i++)
+                        _process_buffer (stream, buffers[i]);
+
+                _push_output (stream, buffers, n_buffers);
+                _emit_new_buffer (stream, n_buffers);
+                if (notify)
+                        _emit_buffer_done (stream, buffers, n_buffers);
+
+                return;
+        }
+
+        g_mutex_lock (&priv->processing_mutex);
+
+        for (i = 0; i < n_buffers; i++) {
+                ArvStreamProcessingJob *job = g_new0 (ArvStreamProcessingJob, 1);
+
+                job->buffer = buffers[i];
+                job->notify = notify;
+                g_queue_push_tail (&priv->processing_jobs, job);
+                g_thread_pool_push (pool, job, NULL);
+        }
+
+        g_mutex_unlock (&priv->processing_mutex);
+}
+
+/**
+ * arv_stream_push_output_buffers: (skip)
+ * @stream: a #ArvStream
+ * @buffers: buffers
+ * @n_buffers: number of buffers
+ *
+ * Pushes buffers to the output queue of @stream, with a single wakeup of the consumers. The new-buffer signal is
+ * still emitted once per buffer. The stream callback is not called, see arv_stream_push_completed_buffers().
+ *
+ * The processing stages are run first, either in the calling thread, or in the processing threads if the
+ * n-processing-threads property is not 0. In the latter case, the buffers reach the output queue later, but in the
+ * same order.
+ */
+
+void
+arv_stream_push_output_buffers (ArvStream *stream, ArvBuffer **buffers, guint n_buffers)
+{
+	g_return_if_fail (ARV_IS_STREAM (stream));
+
+        _push_output_buffers (stream, buffers, n_buffers, FALSE);
+}
+
+/**
+ * arv_stream_push_completed_buffers: (skip)
+ * @stream: a #ArvStream
+ * @buffers: buffers whose acquisition is over, successfully or not
+ * @n_buffers: number of buffers
+ *
+ * Same as arv_stream_push_output_buffers(), but the stream callback is also called with
+ * %ARV_STREAM_CALLBACK_TYPE_BUFFER_DONE for each buffer, once its processing stages are over.
+ */
+
+void
+arv_stream_push_completed_buffers (ArvStream *stream, ArvBuffer **buffers, guint n_buffers)
+{
+	g_return_if_fail (ARV_IS_STREAM (stream));
+
+        _push_output_buffers (stream, buffers, n_buffers, TRUE);
+}
+
+void
+arv_stream_push_completed_buffer (ArvStream *stream, ArvBuffer *buffer)
+{
+	g_return_if_fail (ARV_IS_BUFFER (buffer));
+
+        arv_stream_push_completed_buffers (stream, &buffer, 1);
+}
+
+/**
+ * arv_stream_add_processing_stage:
+ * @stream: a #ArvStream
+ * @func: (scope notified) (closure user_data) (destroy destroy_func): processing function
+ * @user_data: user data passed to @func
+ * @destroy_func: (nullable): function called on @user_data when the stream is destroyed
+ *
+ * Appends a processing stage to the chain run on each buffer before it is pushed to the output queue. The stages are
+ * run in the order they were added, after the optional unpacking and demosaicing. The stream callback is called with
+ * %ARV_STREAM_CALLBACK_TYPE_BUFFER_DONE after the last stage.
+ *
+ * By default, the stages are run in the stream receiving thread, which delays the reception of the following data. If
+ * the n-processing-threads property is not 0, different buffers are processed in parallel in a pool of worker
+ * threads, and are still pushed to the output queue in the order of their reception.
+ *
+ * Stages must be added before the acquisition is started.
+ *
+ * Since: 0.10.0
+ */
+
+void
+arv_stream_add_processing_stage (ArvStream *stream, ArvStreamProcessingFunc func,
+                                 void *user_data, GDestroyNotify destroy_func)
+{
+	ArvStreamPrivate *priv = arv_stream_get_instance_private (stream);
+        ArvStreamProcessingStage *stage;
+
+	g_return_if_fail (ARV_IS_STREAM (stream));
+	g_return_if_fail (func != NULL);
+
+        stage = g_new0 (ArvStreamProcessingStage, 1);
+        stage->func = func;
+        stage->user_data = user_data;
+        stage->destroy_func = destroy_func;
+
+        g_ptr_array_add (priv->processing_stages, stage);
+}
+
+static void
+arv_stream_processing_stage_free (ArvStreamProcessingStage *stage)
+{
+        if (stage->destroy_func != NULL)
+                stage->destroy_func (stage->user_data);
+        g_free (stage);
+}
+
 /**
  * arv_stream_get_n_owned_buffers:
  * @stream: a #ArvStream
@@ -272,16 +885,12 @@ arv_stream_get_n_owned_buffers (ArvStream *stream, gint *n_input_buffers, gint *
 		return;
 	}
 
-        g_async_queue_lock (priv->input_queue);
-        g_async_queue_lock (priv->output_queue);
 	if (n_input_buffers != NULL)
-		*n_input_buffers = g_async_queue_length_unlocked (priv->input_queue);
+		*n_input_buffers = arv_buffer_queue_get_length (priv->input_queue);
 	if (n_output_buffers != NULL)
-		*n_output_buffers = g_async_queue_length_unlocked (priv->output_queue);
+		*n_output_buffers = arv_buffer_queue_get_length (priv->output_queue);
         if (n_buffer_filling != NULL)
-                *n_buffer_filling = priv->n_buffer_filling;
-        g_async_queue_unlock (priv->output_queue);
-        g_async_queue_unlock (priv->input_queue);
+                *n_buffer_filling = g_atomic_int_get (&priv->n_buffer_filling);
 }
 
 /**
@@ -299,6 +908,7 @@ arv_stream_get_n_owned_buffers (ArvStream *stream, gint *n_input_buffers, gint *
 gboolean
 arv_stream_start_acquisition (ArvStream *stream, GError **error)
 {
+	ArvStreamPrivate *priv = arv_stream_get_instance_private (stream);
 	ArvStreamClass *stream_class;
         GError *local_error = NULL;
         gboolean success;
@@ -308,6 +918,17 @@ arv_stream_start_acquisition (ArvStream *stream, GError **error)
 	stream_class = ARV_STREAM_GET_CLASS (stream);
 	g_return_val_if_fail (stream_class->start_acquisition != NULL, FALSE);
 
+        /* Declared after the infos of the stream implementation, which keeps their ids */
+	g_rec_mutex_lock (&priv->mutex);
+        if (!priv->latency_infos_declared) {
+                _declare_latency_infos (stream);
+                priv->latency_infos_declared = TRUE;
+        }
+	g_rec_mutex_unlock (&priv->mutex);
+
+        priv->last_frame_time_ns = 0;
+        priv->last_frame_interval_ns = 0;
+
 	success = stream_class->start_acquisition (stream, &local_error);
         if (!success) {
                 if (local_error != NULL)
@@ -348,6 +969,9 @@ arv_stream_stop_acquisition (ArvStream *stream, GError **error)
 
 	success = stream_class->stop_acquisition (stream, error);
 
+        /* Wait for the buffers still in the processing threads */
+        _processing_drain (priv);
+
         if (success && priv->n_buffer_filling != 0) {
                 g_critical ("Buffer filling count must be 0 after acquisition stop (was %d)", priv->n_buffer_filling);
         }
@@ -380,16 +1004,13 @@ arv_stream_delete_buffers (ArvStream *stream)
 
         g_return_val_if_fail (ARV_IS_STREAM(stream), 0);
 
-	g_async_queue_lock (priv->input_queue);
-	g_async_queue_lock (priv->output_queue);
-
-	arv_info_stream ("[Stream::delete_buffers] Delete %d buffer[s] in input queue",
-                         g_async_queue_length_unlocked(priv->input_queue));
-	arv_info_stream ("[Stream::delete_buffers] Delete %d buffer[s] in output queue",
-                         g_async_queue_length_unlocked(priv->output_queue));
+	arv_info_stream ("[Stream::delete_buffers] Delete %u buffer[s] in input queue",
+                         arv_buffer_queue_get_length (priv->input_queue));
+	arv_info_stream ("[Stream::delete_buffers] Delete %u buffer[s] in output queue",
+                         arv_buffer_queue_get_length (priv->output_queue));
 
 	do {
-		buffer = g_async_queue_try_pop_unlocked (priv->input_queue);
+		buffer = arv_buffer_queue_try_pop (priv->input_queue);
 		if (ARV_IS_BUFFER(buffer)) {
 			g_object_unref (buffer);
 			n_deleted++;
@@ -397,16 +1018,13 @@ arv_stream_delete_buffers (ArvStream *stream)
 	} while (buffer != NULL);
 
 	do {
-		buffer = g_async_queue_try_pop_unlocked (priv->output_queue);
+		buffer = _output_popped (priv, arv_buffer_queue_try_pop (priv->output_queue));
 		if (ARV_IS_BUFFER(buffer)) {
 			g_object_unref (buffer);
 			n_deleted++;
 		}
 	} while (buffer != NULL);
 
-	g_async_queue_unlock (priv->output_queue);
-	g_async_queue_unlock (priv->input_queue);
-
 	return n_deleted;
 }
 
@@ -463,7 +1081,7 @@ arv_stream_set_emit_signals (ArvStream *stream, gboolean emit_signals)
 
 	g_rec_mutex_lock (&priv->mutex);
 
-	priv->emit_signals = emit_signals;
+	g_atomic_int_set (&priv->emit_signals, emit_signals);
 
 	g_rec_mutex_unlock (&priv->mutex);
 }
@@ -524,6 +1142,57 @@ arv_stream_declare_info (ArvStream *stream, const char *name, GType type, gpoint
         g_ptr_array_add (priv->infos, info);
 }
 
+static void
+_declare_latency_infos (ArvStream *stream)
+{
+        static const char *latency_names[ARV_STREAM_LATENCY_N_ELEMENTS] = {
+                "completion_latency",
+                "output_latency",
+                "resend_rtt",
+                "frame_jitter"
+        };
+        static const struct {
+                const char *suffix;
+                double percentile;
+        } statistics[] = {
+                { "count",      -1.0 },
+                { "p50",        50.0 },
+                { "p99",        99.0 },
+                { "p999",       99.9 }
+        };
+        ArvStreamPrivate *priv = arv_stream_get_instance_private (stream);
+        guint i, j;
+
+        for (i = 0; i < ARV_STREAM_LATENCY_N_ELEMENTS; i++) {
+                if ((priv->disabled_latencies & (1 << i)) != 0)
+                        continue;
+
+                for (j = 0; j < G_N_ELEMENTS (statistics); j++) {
+                        ArvStreamInfo *info;
+
+                        info = g_new0 (ArvStreamInfo, 1);
+                        info->name = g_strdup_printf ("%s_%s", latency_names[i], statistics[j].suffix);
+                        info->type = G_TYPE_UINT64;
+                        info->histogram = priv->latencies[i];
+                        info->percentile = statistics[j].percentile;
+
+                        g_ptr_array_add (priv->infos, info);
+                }
+        }
+}
+
+static guint64
+_get_info_uint64 (const ArvStreamInfo *info)
+{
+        if (info->histogram == NULL)
+                return *((guint64 *) (info->data));
+
+        if (info->percentile < 0.0)
+                return arv_log_histogram_get_count (info->histogram);
+
+        return arv_log_histogram_get_percentile (info->histogram, info->percentile);
+}
+
 /**
  * arv_stream_get_n_infos:
  * @stream: a #ArvStream
@@ -619,10 +1288,7 @@ arv_stream_get_info_uint64 (ArvStream *stream, guint id)
 
         g_return_val_if_fail (info->type == G_TYPE_UINT64, 0);
 
-        if (info != NULL)
-                return *((guint64 *) (info->data));
-
-        return 0;
+        return _get_info_uint64 (info);
 }
 
 /**
@@ -693,7 +1359,7 @@ arv_stream_get_info_uint64_by_name (ArvStream *stream, const char *name)
         g_return_val_if_fail (info != NULL, 0);
         g_return_val_if_fail (info->type == G_TYPE_UINT64, 0);
 
-        return *((guint64 *) (info->data));
+        return _get_info_uint64 (info);
 }
 
 /**
@@ -729,8 +1395,13 @@ arv_stream_create_buffers (ArvStream *stream, unsigned int n_buffers,
 {
 	ArvStreamClass *stream_class;
 	ArvStreamPrivate *priv = arv_stream_get_instance_private (stream);
+        ArvBufferPool *pool;
+        GError *local_error = NULL;
         gboolean success;
         size_t payload_size;
+        size_t buffer_size;
+        size_t image_size;
+        gint numa_node;
         unsigned int i;
 
 	g_return_val_if_fail (ARV_IS_STREAM (stream), FALSE);
@@ -741,10 +1412,12 @@ arv_stream_create_buffers (ArvStream *stream, unsigned int n_buffers,
         if (payload_size < 1)
                 return FALSE;
 
+        /* Size the lock free part of the queues, the buffers being either queued or filled */
+        arv_buffer_queue_reserve (priv->input_queue, n_buffers);
+        arv_buffer_queue_reserve (priv->output_queue, n_buffers);
+
 	stream_class = ARV_STREAM_GET_CLASS (stream);
         if (stream_class->create_buffers != NULL) {
-                GError *local_error = NULL;
-
                 success = stream_class->create_buffers (stream, n_buffers, payload_size,
                                                         user_data, user_data_destroy_func, &local_error);
                 if (!success) {
@@ -760,9 +1433,58 @@ arv_stream_create_buffers (ArvStream *stream, unsigned int n_buffers,
                 return success;
         }
 
+        /* Room for the unpacked data and for the RGB data, after the raw data. Unpacking at most doubles the image
+         * size (10 bit samples to 16 bit). */
+        buffer_size = payload_size;
+        image_size = payload_size;
+        if (g_atomic_int_get (&priv->unpack_bits) != 0) {
+                image_size = 2 * payload_size;
+                buffer_size += image_size + 64;
+        }
+        if (g_atomic_int_get (&priv->demosaic_method) != ARV_DEMOSAIC_METHOD_NONE)
+                buffer_size += 3 * image_size + 64;
+
+        numa_node = priv->numa_node;
+        if (numa_node == ARV_BUFFER_POOL_NUMA_NODE_AUTO)
+                numa_node = stream_class->get_numa_node != NULL ? stream_class->get_numa_node (stream) : -1;
+
+        pool = arv_buffer_pool_new (buffer_size, n_buffers, 0,
+                                    numa_node >= 0 ? numa_node : ARV_BUFFER_POOL_NUMA_NODE_NONE,
+                                    priv->buffer_pool_flags, &local_error);
+        if (pool == NULL) {
+                arv_warning_stream ("Failed to create buffer pool, fallback to individual allocations: %s",
+                                    local_error->message);
+                g_clear_error (&local_error);
+
+                for (i = 0; i < n_buffers; i++)
+                        arv_stream_push_buffer (stream, arv_buffer_new_full (buffer_size, NULL,
+                                                                             user_data, user_data_destroy_func));
+
+                return TRUE;
+        }
+
         for (i = 0; i < n_buffers; i++)
-                arv_stream_push_buffer (stream, arv_buffer_new_full (payload_size, NULL,
-                                                                     user_data, user_data_destroy_func));
+                arv_stream_push_buffer (stream, arv_buffer_pool_new_buffer (pool, user_data,
+                                                                            user_data_destroy_func));
+
+	g_rec_mutex_lock (&priv->mutex);
+
+        priv->buffer_pool_size += arv_buffer_pool_get_size (pool);
+        priv->buffer_pool_locked_size += arv_buffer_pool_get_locked_size (pool);
+        priv->buffer_pool_page_size = arv_buffer_pool_get_page_size (pool);
+
+        if (!priv->buffer_pool_infos_declared) {
+                arv_stream_declare_info (stream, "buffer_pool_size", G_TYPE_UINT64, &priv->buffer_pool_size);
+                arv_stream_declare_info (stream, "buffer_pool_locked_size", G_TYPE_UINT64,
+                                         &priv->buffer_pool_locked_size);
+                arv_stream_declare_info (stream, "buffer_pool_page_size", G_TYPE_UINT64,
+                                         &priv->buffer_pool_page_size);
+                priv->buffer_pool_infos_declared = TRUE;
+        }
+
+	g_rec_mutex_unlock (&priv->mutex);
+
+        g_object_unref (pool);
 
         return TRUE;
 }
@@ -791,6 +1513,30 @@ arv_stream_set_property (GObject * object, guint prop_id,
 		case ARV_STREAM_PROPERTY_DESTROY_NOTIFY:
 			priv->destroy_notify = g_value_get_pointer (value);
 			break;
+		case ARV_STREAM_PROPERTY_BUFFER_POOL_FLAGS:
+			priv->buffer_pool_flags = g_value_get_flags (value);
+			break;
+		case ARV_STREAM_PROPERTY_NUMA_NODE:
+			priv->numa_node = g_value_get_int (value);
+			break;
+		case ARV_STREAM_PROPERTY_DEMOSAIC:
+			g_atomic_int_set (&priv->demosaic_method, g_value_get_enum (value));
+			break;
+		case ARV_STREAM_PROPERTY_UNPACK_BITS:
+			if (g_value_get_uint (value) == 0 || g_value_get_uint (value) == 8 ||
+			    g_value_get_uint (value) == 16)
+				g_atomic_int_set (&priv->unpack_bits, g_value_get_uint (value));
+			else
+				arv_warning_stream ("Invalid unpacked sample size (%u bits)", g_value_get_uint (value));
+			break;
+		case ARV_STREAM_PROPERTY_N_PROCESSING_THREADS:
+			g_atomic_int_set (&priv->n_processing_threads, g_value_get_uint (value));
+			g_mutex_lock (&priv->processing_mutex);
+			if (priv->processing_pool != NULL)
+				g_thread_pool_set_max_threads (priv->processing_pool,
+							       MAX (1, priv->n_processing_threads), NULL);
+			g_mutex_unlock (&priv->processing_mutex);
+			break;
 		default:
 			G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
 			break;
@@ -817,6 +1563,21 @@ arv_stream_get_property (GObject * object, guint prop_id,
 		case ARV_STREAM_PROPERTY_CALLBACK_DATA:
 			g_value_set_pointer (value, priv->callback_data);
 			break;
+		case ARV_STREAM_PROPERTY_BUFFER_POOL_FLAGS:
+			g_value_set_flags (value, priv->buffer_pool_flags);
+			break;
+		case ARV_STREAM_PROPERTY_NUMA_NODE:
+			g_value_set_int (value, priv->numa_node);
+			break;
+		case ARV_STREAM_PROPERTY_DEMOSAIC:
+			g_value_set_enum (value, g_atomic_int_get (&priv->demosaic_method));
+			break;
+		case ARV_STREAM_PROPERTY_UNPACK_BITS:
+			g_value_set_uint (value, g_atomic_int_get (&priv->unpack_bits));
+			break;
+		case ARV_STREAM_PROPERTY_N_PROCESSING_THREADS:
+			g_value_set_uint (value, g_atomic_int_get (&priv->n_processing_threads));
+			break;
 		default:
 			G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
 			break;
@@ -838,14 +1599,29 @@ static void
 arv_stream_init (ArvStream *stream)
 {
 	ArvStreamPrivate *priv = arv_stream_get_instance_private (stream);
+        guint i;
 
-	priv->input_queue = g_async_queue_new ();
-	priv->output_queue = g_async_queue_new ();
+	priv->input_queue = arv_buffer_queue_new ();
+	priv->output_queue = arv_buffer_queue_new ();
 
 	priv->emit_signals = FALSE;
 
         priv->infos = g_ptr_array_new ();
 
+        priv->buffer_pool_flags = ARV_BUFFER_POOL_FLAGS_NONE;
+        priv->numa_node = ARV_BUFFER_POOL_NUMA_NODE_AUTO;
+        priv->demosaic_method = ARV_DEMOSAIC_METHOD_NONE;
+
+        priv->processing_stages = g_ptr_array_new_with_free_func ((GDestroyNotify) arv_stream_processing_stage_free);
+        g_mutex_init (&priv->processing_mutex);
+        g_cond_init (&priv->processing_cond);
+        g_queue_init (&priv->processing_jobs);
+        g_mutex_init (&priv->processing_output_mutex);
+        g_cond_init (&priv->processing_output_cond);
+
+        for (i = 0; i < ARV_STREAM_LATENCY_N_ELEMENTS; i++)
+                priv->latencies[i] = arv_log_histogram_new ();
+
 	g_rec_mutex_init (&priv->mutex);
 }
 
@@ -854,16 +1630,27 @@ arv_stream_finalize (GObject *object)
 {
 	ArvStream *stream = ARV_STREAM (object);
 	ArvStreamPrivate *priv = arv_stream_get_instance_private (stream);
+        guint i;
 
 	if (priv->emit_signals) {
 		g_warning ("Stream finalized with 'new-buffer' signal enabled");
 		g_warning ("Please call arv_stream_set_emit_signals (stream, FALSE) before ArvStream object finalization");
 	}
 
+        /* Waits for the end of the pending processing jobs */
+        if (priv->processing_pool != NULL)
+                g_thread_pool_free (priv->processing_pool, FALSE, TRUE);
+        g_clear_pointer (&priv->processing_stages, g_ptr_array_unref);
+        g_mutex_clear (&priv->processing_mutex);
+        g_cond_clear (&priv->processing_cond);
+        g_mutex_clear (&priv->processing_output_mutex);
+        g_cond_clear (&priv->processing_output_cond);
+
         arv_stream_delete_buffers (stream);
 
-	g_async_queue_unref (priv->input_queue);
-	g_async_queue_unref (priv->output_queue);
+	arv_buffer_queue_free (priv->input_queue);
+	arv_buffer_queue_free (priv->output_queue);
+        g_clear_pointer (&priv->output_wakeup, arv_wakeup_free);
 
 	g_rec_mutex_clear (&priv->mutex);
 
@@ -874,6 +1661,9 @@ arv_stream_finalize (GObject *object)
         g_ptr_array_foreach (priv->infos, (GFunc) arv_stream_info_free, NULL);
         g_clear_pointer (&priv->infos, g_ptr_array_unref);
 
+        for (i = 0; i < ARV_STREAM_LATENCY_N_ELEMENTS; i++)
+                g_clear_pointer (&priv->latencies[i], arv_log_histogram_free);
+
 	if (priv->destroy_notify != NULL) {
 		priv->destroy_notify(priv->callback_data);
 	}
@@ -950,6 +1740,111 @@ arv_stream_class_init (ArvStreamClass *node_class)
 				       "Destroy notify",
 				       "Optional destroy notify",
 				       G_PARAM_READWRITE | G_PARAM_CONSTRUCT_ONLY));
+
+	/**
+	 * ArvStream:buffer-pool-flags:
+	 *
+	 * Allocation flags of the buffer pool used by [method@Aravis.Stream.create_buffers].
+	 *
+	 * Since: 0.10.0
+	 */
+
+	g_object_class_install_property
+		(object_class,
+		 ARV_STREAM_PROPERTY_BUFFER_POOL_FLAGS,
+		 g_param_spec_flags ("buffer-pool-flags",
+				     "Buffer pool flags",
+				     "Buffer pool allocation flags",
+				     ARV_TYPE_BUFFER_POOL_FLAGS,
+				     ARV_BUFFER_POOL_FLAGS_NONE,
+				     G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+	/**
+	 * ArvStream:numa-node:
+	 *
+	 * NUMA node the memory of the buffers created by [method@Aravis.Stream.create_buffers] is bound to.
+	 * %ARV_BUFFER_POOL_NUMA_NODE_AUTO selects the node of the network adapter, if known, and
+	 * %ARV_BUFFER_POOL_NUMA_NODE_NONE disables the binding.
+	 *
+	 * Since: 0.10.0
+	 */
+
+	g_object_class_install_property
+		(object_class,
+		 ARV_STREAM_PROPERTY_NUMA_NODE,
+		 g_param_spec_int ("numa-node",
+				   "NUMA node",
+				   "Buffer memory NUMA node",
+				   ARV_BUFFER_POOL_NUMA_NODE_NONE, G_MAXINT,
+				   ARV_BUFFER_POOL_NUMA_NODE_AUTO,
+				   G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+	/**
+	 * ArvStream:demosaic:
+	 *
+	 * Demosaicing method applied to the Bayer images, before they are pushed to the output queue. The RGB data
+	 * is written after the Bayer data, in the same buffer, and the image part is updated accordingly. The buffers
+	 * created by [method@Aravis.Stream.create_buffers] after this property is set are large enough, other Bayer
+	 * buffers are left untouched if they are too small.
+	 *
+	 * The conversion is run after the optional unpacking, before the other processing stages, in the stream
+	 * receiving thread, helped by a pool of worker threads, or in the processing threads, see
+	 * [property@Aravis.Stream:n-processing-threads].
+	 *
+	 * Since: 0.10.0
+	 */
+
+	g_object_class_install_property
+		(object_class,
+		 ARV_STREAM_PROPERTY_DEMOSAIC,
+		 g_param_spec_enum ("demosaic",
+				    "Demosaic",
+				    "Bayer demosaicing method",
+				    ARV_TYPE_DEMOSAIC_METHOD,
+				    ARV_DEMOSAIC_METHOD_NONE,
+				    G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+	/**
+	 * ArvStream:unpack-bits:
+	 *
+	 * Sample size of the unpacked images, 8 or 16, or 0 for disabling the unpacking. Images using a packed pixel
+	 * format (Mono10p, Mono12Packed, BayerRG10p...) are unpacked before they are pushed to the output queue, see
+	 * arv_image_unpack(). The unpacked data is written after the raw data, in the same buffer, and the image part is
+	 * updated accordingly. The buffers created by [method@Aravis.Stream.create_buffers] after this property is set
+	 * are large enough, other buffers are left untouched if they are too small.
+	 *
+	 * The unpacking is the first processing stage, followed by the optional demosaicing.
+	 *
+	 * Since: 0.10.0
+	 */
+
+	g_object_class_install_property
+		(object_class,
+		 ARV_STREAM_PROPERTY_UNPACK_BITS,
+		 g_param_spec_uint ("unpack-bits",
+				    "Unpack bits",
+				    "Sample size of the unpacked images",
+				    0, 16, 0,
+				    G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+	/**
+	 * ArvStream:n-processing-threads:
+	 *
+	 * Number of worker threads running the processing stages and the demosaicing, 0 for running them in the
+	 * stream receiving thread. With worker threads, the buffers are still pushed to the output queue in their
+	 * reception order.
+	 *
+	 * Since: 0.10.0
+	 */
+
+	g_object_class_install_property
+		(object_class,
+		 ARV_STREAM_PROPERTY_N_PROCESSING_THREADS,
+		 g_param_spec_uint ("n-processing-threads",
+				    "Number of processing threads",
+				    "Number of threads running the processing stages",
+				    0, 64, 0,
+				    G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 }
 
 static gboolean
@@ -66,8 +66,10 @@ struct _ArvStreamClass {
 	/* signals */
 	void        	(*new_buffer)   	(ArvStream *stream);
 
+        gint            (*get_numa_node)        (ArvStream *stream);
+
         /* Padding for future expansion */
-        gpointer padding[10];
+        gpointer padding[9];
 };
 
 /**
@@ -87,14 +89,35 @@ struct _ArvStreamClass {
  * instance, except if you take care to protect the instance access from concurrent access. It also means all the time
  * spent in the callback is less time available for the incoming data handling. CPU intensive image processing should
  * happen elsewhere.
+ *
+ * @ARV_STREAM_CALLBACK_TYPE_BUFFER_DONE is called after the processing stages, when the buffer is pushed to the
+ * output queue. If [property@Aravis.Stream:n-processing-threads] is not 0, it is called from a processing thread,
+ * still once at a time and in the frame order.
  */
 
 typedef void (*ArvStreamCallback)	(void *user_data, ArvStreamCallbackType type, ArvBuffer *buffer);
 
+/**
+ * ArvStreamProcessingFunc:
+ * @buffer: a [class@ArvBuffer] object, successfully filled or not
+ * @user_data: (closure): a pointer to user data associated to this processing stage
+ *
+ * This is the signature of a processing stage added by [method@Aravis.Stream.add_processing_stage]. It is called for
+ * each buffer, before it is pushed to the stream output queue.
+ *
+ * Since: 0.10.0
+ */
+
+typedef void (*ArvStreamProcessingFunc)	(ArvBuffer *buffer, void *user_data);
+
 ARV_API void		arv_stream_push_buffer			(ArvStream *stream, ArvBuffer *buffer);
 ARV_API ArvBuffer *	arv_stream_pop_buffer			(ArvStream *stream);
 ARV_API ArvBuffer *	arv_stream_try_pop_buffer		(ArvStream *stream);
 ARV_API ArvBuffer *	arv_stream_timeout_pop_buffer		(ArvStream *stream, guint64 timeout);
+ARV_API void		arv_stream_push_buffers			(ArvStream *stream, ArvBuffer **buffers, guint n_buffers);
+ARV_API guint		arv_stream_pop_buffers			(ArvStream *stream, ArvBuffer **buffers, guint max_buffers,
+								 guint64 timeout);
+ARV_API int		arv_stream_get_fd			(ArvStream *stream);
 ARV_API void		arv_stream_get_n_owned_buffers		(ArvStream *stream,
 								 gint *n_input_buffers,
 								 gint *n_output_buffers,
@@ -119,6 +142,9 @@ ARV_API double		arv_stream_get_info_double		(ArvStream *stream, guint id);
 ARV_API guint64		arv_stream_get_info_uint64_by_name	(ArvStream *stream, const char *name);
 ARV_API double		arv_stream_get_info_double_by_name	(ArvStream *stream, const char *name);
 
+ARV_API void		arv_stream_add_processing_stage		(ArvStream *stream, ArvStreamProcessingFunc func,
+								 void *user_data, GDestroyNotify destroy_func);
+
 ARV_API void		arv_stream_set_emit_signals		(ArvStream *stream, gboolean emit_signals);
 ARV_API gboolean	arv_stream_get_emit_signals		(ArvStream *stream);
 
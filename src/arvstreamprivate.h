@@ -31,13 +31,34 @@
 
 G_BEGIN_DECLS
 
+/*
+ * Latency histograms, common to all the stream types, in µs. The completion, output and frame jitter latencies are
+ * filled by ArvStream itself.
+ */
+
+typedef enum {
+	ARV_STREAM_LATENCY_COMPLETION,		/* First data of a frame to buffer completion */
+	ARV_STREAM_LATENCY_OUTPUT,		/* Buffer completion to buffer pop */
+	ARV_STREAM_LATENCY_RESEND,		/* Packet resend request to resent packet reception */
+	ARV_STREAM_LATENCY_FRAME_JITTER,	/* Variation of the interval between the first data of two frames */
+	ARV_STREAM_LATENCY_N_ELEMENTS
+} ArvStreamLatency;
+
 ArvBuffer *	arv_stream_pop_input_buffer		(ArvStream *stream);
 ArvBuffer *     arv_stream_timeout_pop_input_buffer     (ArvStream *stream, guint64 timeout);
+guint		arv_stream_timeout_pop_input_buffers	(ArvStream *stream, ArvBuffer **buffers, guint max_buffers,
+							 guint64 timeout);
 void		arv_stream_push_output_buffer		(ArvStream *stream, ArvBuffer *buffer);
+void		arv_stream_push_output_buffers		(ArvStream *stream, ArvBuffer **buffers, guint n_buffers);
+void		arv_stream_push_completed_buffer	(ArvStream *stream, ArvBuffer *buffer);
+void		arv_stream_push_completed_buffers	(ArvStream *stream, ArvBuffer **buffers, guint n_buffers);
 void		arv_stream_take_init_error		(ArvStream *device, GError *error);
 
 void            arv_stream_declare_info                 (ArvStream *stream, const char *name, GType type, gpointer data);
 
+void		arv_stream_fill_latency			(ArvStream *stream, ArvStreamLatency latency, gint64 value_us);
+void		arv_stream_disable_latency		(ArvStream *stream, ArvStreamLatency latency);
+
 G_END_DECLS
 
 #endif
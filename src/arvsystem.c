@@ -36,6 +36,7 @@
 #include <string.h>
 #include <arvmisc.h>
 #include <arvdomimplementation.h>
+#include <arvimageconvertprivate.h>
 
 static GMutex arv_system_mutex;
 
@@ -593,6 +594,7 @@ arv_shutdown (void)
 		interfaces[i].destroy_interface_instance ();
 
 	arv_dom_implementation_cleanup ();
+	arv_image_convert_cleanup ();
 
 	g_mutex_unlock (&arv_system_mutex);
 }
@@ -38,6 +38,7 @@
 
 #define ARV_UV_STREAM_POP_INPUT_BUFFER_TIMEOUT_MS       10
 #define ARV_UV_STREAM_TRANSFER_WAIT_TIMEOUT_MS          10
+#define ARV_UV_STREAM_INPUT_BATCH_SIZE                  8
 
 enum {
        ARV_UV_STREAM_PROPERTY_0,
@@ -361,11 +362,7 @@ void LIBUSB_CALL arv_uv_stream_trailer_cb (struct libusb_transfer *transfer)
                         }
                 }
 
-                arv_stream_push_output_buffer (ctx->stream, ctx->buffer);
-                if (ctx->callback != NULL)
-                        ctx->callback (ctx->callback_data,
-                                       ARV_STREAM_CALLBACK_TYPE_BUFFER_DONE,
-                                       ctx->buffer);
+                arv_stream_push_completed_buffer (ctx->stream, ctx->buffer);
                 g_atomic_int_dec_and_test(ctx->n_buffer_in_use);
                 ctx->buffer = NULL;
         }
@@ -454,11 +451,7 @@ arv_uv_stream_buffer_context_free (gpointer data)
 
         if (ctx->buffer != NULL) {
                 ctx->buffer->priv->status = ARV_BUFFER_STATUS_ABORTED;
-                arv_stream_push_output_buffer (ctx->stream, ctx->buffer);
-                if (ctx->callback != NULL)
-                        ctx->callback (ctx->callback_data,
-                                       ARV_STREAM_CALLBACK_TYPE_BUFFER_DONE,
-                                       ctx->buffer);
+                arv_stream_push_completed_buffer (ctx->stream, ctx->buffer);
                 g_atomic_int_dec_and_test(ctx->n_buffer_in_use);
                 ctx->buffer = NULL;
         }
@@ -554,7 +547,7 @@ static void *
 arv_uv_stream_thread_async (void *data)
 {
 	ArvUvStreamThreadData *thread_data = data;
-	ArvBuffer *buffer = NULL;
+	ArvBuffer *buffers[ARV_UV_STREAM_INPUT_BATCH_SIZE];
 	GHashTable *ctx_lookup;
 	gint total_submitted_bytes = 0;
 
@@ -576,31 +569,41 @@ arv_uv_stream_thread_async (void *data)
 
 	while (!g_atomic_int_get (&thread_data->cancel) &&
                arv_uv_device_is_connected (thread_data->uv_device)) {
-		ArvUvStreamBufferContext* ctx;
+                guint n_buffers;
+                guint i;
 
-                buffer = arv_stream_timeout_pop_input_buffer (thread_data->stream,
-                                                              ARV_UV_STREAM_POP_INPUT_BUFFER_TIMEOUT_MS * 1000);
+                /* Recycled buffers are taken from the input queue in batches */
+                n_buffers = arv_stream_timeout_pop_input_buffers (thread_data->stream,
+                                                                  buffers, ARV_UV_STREAM_INPUT_BATCH_SIZE,
+                                                                  ARV_UV_STREAM_POP_INPUT_BUFFER_TIMEOUT_MS * 1000);
 
-		if( buffer == NULL ) {
+		if (n_buffers == 0) {
                         if (thread_data->n_buffer_in_use == 0)
                                 thread_data->statistics.n_underruns += 1;
                         /* NOTE: n_ignored_bytes is not accumulated because it doesn't submit next USB transfer if
                          * buffer is shortage. It means back pressure might be hanlded by USB slave side. */
 			continue;
-		} else {
+		}
+
+                /* On cancellation, the buffers of the batch are still attached to a context, which returns them as
+                 * aborted when freed */
+                for (i = 0; i < n_buffers; i++) {
+                        ArvUvStreamBufferContext* ctx;
+
                         g_atomic_int_inc(&thread_data->n_buffer_in_use);
-                }
 
-		ctx = g_hash_table_lookup( ctx_lookup, buffer );
-		if (!ctx) {
-			arv_debug_stream_thread ("Stream buffer context not found for buffer %p, creating...", buffer);
+                        ctx = g_hash_table_lookup( ctx_lookup, buffers[i] );
+                        if (!ctx) {
+                                arv_debug_stream_thread ("Stream buffer context not found for buffer %p, creating...",
+                                                         buffers[i]);
 
-			ctx = arv_uv_stream_buffer_context_new (buffer, thread_data, &total_submitted_bytes);
+                                ctx = arv_uv_stream_buffer_context_new (buffers[i], thread_data, &total_submitted_bytes);
 
-			g_hash_table_insert (ctx_lookup, buffer, ctx);
-		}
+                                g_hash_table_insert (ctx_lookup, buffers[i], ctx);
+                        }
 
-                arv_uv_stream_buffer_context_submit (ctx, buffer, thread_data);
+                        arv_uv_stream_buffer_context_submit (ctx, buffers[i], thread_data);
+                }
 	}
 
 	g_hash_table_foreach (ctx_lookup, arv_uv_stream_buffer_context_cancel, NULL);
@@ -726,11 +729,7 @@ arv_uv_stream_thread_sync (void *data)
 					if (buffer != NULL) {
 						arv_info_stream_thread ("New leader received while a buffer is still open");
 						buffer->priv->status = ARV_BUFFER_STATUS_MISSING_PACKETS;
-						arv_stream_push_output_buffer (thread_data->stream, buffer);
-						if (thread_data->callback != NULL)
-							thread_data->callback (thread_data->callback_data,
-									       ARV_STREAM_CALLBACK_TYPE_BUFFER_DONE,
-									       buffer);
+						arv_stream_push_completed_buffer (thread_data->stream, buffer);
 						thread_data->statistics.n_failures++;
                                                 g_atomic_int_dec_and_test(&thread_data->n_buffer_in_use);
 						buffer = NULL;
@@ -787,11 +786,7 @@ arv_uv_stream_thread_sync (void *data)
                                                                                 offset, thread_data->expected_size);
 
                                                        buffer->priv->status = ARV_BUFFER_STATUS_SIZE_MISMATCH;
-                                                       arv_stream_push_output_buffer (thread_data->stream, buffer);
-                                                       if (thread_data->callback != NULL)
-                                                               thread_data->callback (thread_data->callback_data,
-                                                                                      ARV_STREAM_CALLBACK_TYPE_BUFFER_DONE,
-                                                                                      buffer);
+                                                       arv_stream_push_completed_buffer (thread_data->stream, buffer);
                                                        thread_data->statistics.n_failures++;
                                                        thread_data->statistics.n_ignored_bytes += transferred;
                                                         g_atomic_int_dec_and_test(&thread_data->n_buffer_in_use);
@@ -800,11 +795,7 @@ arv_uv_stream_thread_sync (void *data)
                                                         buffer->priv->status = ARV_BUFFER_STATUS_SUCCESS;
                                                         buffer->priv->received_size = offset;
                                                         buffer->priv->parts[0].size = offset;
-                                                        arv_stream_push_output_buffer (thread_data->stream, buffer);
-                                                        if (thread_data->callback != NULL)
-                                                                thread_data->callback (thread_data->callback_data,
-                                                                                       ARV_STREAM_CALLBACK_TYPE_BUFFER_DONE,
-                                                                                       buffer);
+                                                        arv_stream_push_completed_buffer (thread_data->stream, buffer);
                                                         thread_data->statistics.n_completed_buffers++;
                                                         thread_data->statistics.n_transferred_bytes += transferred;
                                                         g_atomic_int_dec_and_test(&thread_data->n_buffer_in_use);
@@ -842,11 +833,7 @@ arv_uv_stream_thread_sync (void *data)
         if (buffer != NULL) {
 		buffer->priv->status = ARV_BUFFER_STATUS_ABORTED;
                 thread_data->statistics.n_aborted++;
-		arv_stream_push_output_buffer (thread_data->stream, buffer);
-		if (thread_data->callback != NULL)
-			thread_data->callback (thread_data->callback_data,
-					       ARV_STREAM_CALLBACK_TYPE_BUFFER_DONE,
-					       buffer);
+		arv_stream_push_completed_buffer (thread_data->stream, buffer);
                 g_atomic_int_dec_and_test(&thread_data->n_buffer_in_use);
 	}
 
@@ -216,7 +216,15 @@ arv_v4l2_stream_thread (void *data)
                          * (V4L2_BUF_FLAG_TSTAMP_SRC_SOE | V4L2_BUF_FLAG_TIMESTAMP_MONOTONIC ) */
                         arv_buffer->priv->timestamp_ns = 1000000000L * bufd.timestamp.tv_sec +
                                 1000L * bufd.timestamp.tv_usec;
-                        arv_buffer->priv->system_timestamp_ns = g_get_real_time () * 1000;
+                        /* The driver timestamp, taken at the start of exposure or at the end of the frame capture
+                         * (V4L2_BUF_FLAG_TSTAMP_SRC_SOE or _EOF), is the closest to the first data time, which is
+                         * the reference of the completion latency. Converted to the real time clock. */
+                        if ((bufd.flags & V4L2_BUF_FLAG_TIMESTAMP_MASK) == V4L2_BUF_FLAG_TIMESTAMP_MONOTONIC &&
+                            arv_buffer->priv->timestamp_ns != 0)
+                                arv_buffer->priv->system_timestamp_ns = arv_buffer->priv->timestamp_ns +
+                                        (g_get_real_time () - g_get_monotonic_time ()) * 1000;
+                        else
+                                arv_buffer->priv->system_timestamp_ns = g_get_real_time () * 1000;
                         arv_buffer->priv->frame_id = thread_data->frame_id++;
                         arv_buffer->priv->received_size = bufd.bytesused;
 
@@ -237,11 +245,7 @@ arv_v4l2_stream_thread (void *data)
 
                         thread_data->n_completed_buffers++;
                         thread_data->n_transferred_bytes += bufd.length;
-                        arv_stream_push_output_buffer (thread_data->stream, arv_buffer);
-                        if (thread_data->callback != NULL)
-                                thread_data->callback (thread_data->callback_data,
-                                                       ARV_STREAM_CALLBACK_TYPE_BUFFER_DONE,
-                                                       arv_buffer);
+                        arv_stream_push_completed_buffer (thread_data->stream, arv_buffer);
                 } else
                         arv_warning_stream_thread("buffer for index %d not found", bufd.index);
         }
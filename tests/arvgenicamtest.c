@@ -5,6 +5,7 @@
 
 static char **arv_option_filenames = NULL;
 static char *arv_option_debug_domains = NULL;
+static int arv_option_benchmark = 0;
 
 static const GOptionEntry arv_option_entries[] =
 {
@@ -12,9 +13,72 @@ static const GOptionEntry arv_option_entries[] =
 		&arv_option_filenames,		NULL, NULL},
 	{ "debug", 		'd', 0, G_OPTION_ARG_STRING,
 		&arv_option_debug_domains, 	"Debug mode", NULL },
+	{ "benchmark",		'b', 0, G_OPTION_ARG_INT,
+		&arv_option_benchmark,		"Feature read benchmark iterations", NULL },
 	{ NULL }
 };
 
+static void
+_collect_features (ArvDomNode *node, GPtrArray *features)
+{
+	ArvDomNode *iter;
+
+	if (ARV_IS_GC_INTEGER (node) || ARV_IS_GC_FLOAT (node)) {
+		GError *error = NULL;
+
+		/* Only keep the features readable without a device */
+		if (ARV_IS_GC_INTEGER (node))
+			arv_gc_integer_get_value (ARV_GC_INTEGER (node), &error);
+		else
+			arv_gc_float_get_value (ARV_GC_FLOAT (node), &error);
+
+		if (error == NULL)
+			g_ptr_array_add (features, node);
+		else
+			g_clear_error (&error);
+	}
+
+	for (iter = arv_dom_node_get_first_child (node); iter != NULL; iter = arv_dom_node_get_next_sibling (iter))
+		_collect_features (iter, features);
+}
+
+static void
+_benchmark (ArvGc *genicam, int n_iterations)
+{
+	GPtrArray *features;
+	gint64 start;
+	gint64 n_reads = 0;
+	unsigned int i;
+	int j;
+
+	features = g_ptr_array_new ();
+	_collect_features (ARV_DOM_NODE (genicam), features);
+
+	start = g_get_monotonic_time ();
+	for (j = 0; j < n_iterations; j++) {
+		for (i = 0; i < features->len; i++) {
+			ArvGcNode *node = g_ptr_array_index (features, i);
+
+			if (ARV_IS_GC_INTEGER (node)) {
+				arv_gc_integer_get_value (ARV_GC_INTEGER (node), NULL);
+				arv_gc_integer_get_min (ARV_GC_INTEGER (node), NULL);
+				arv_gc_integer_get_max (ARV_GC_INTEGER (node), NULL);
+			} else {
+				arv_gc_float_get_value (ARV_GC_FLOAT (node), NULL);
+				arv_gc_float_get_min (ARV_GC_FLOAT (node), NULL);
+				arv_gc_float_get_max (ARV_GC_FLOAT (node), NULL);
+			}
+			n_reads += 3;
+		}
+	}
+
+	if (n_reads > 0)
+		g_print ("%u features, %" G_GINT64_FORMAT " reads, %.1f ns per read\n", features->len, n_reads,
+			 1000.0 * (g_get_monotonic_time () - start) / n_reads);
+
+	g_ptr_array_unref (features);
+}
+
 int
 main (int argc, char **argv)
 {
@@ -73,6 +137,9 @@ main (int argc, char **argv)
 					 arv_gc_float_get_value (ARV_GC_FLOAT (node), NULL));
 			}
 
+			if (arv_option_benchmark > 0)
+				_benchmark (genicam, arv_option_benchmark);
+
 			g_free (xml);
 
 			g_object_unref (genicam);
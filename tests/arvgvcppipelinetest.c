@@ -0,0 +1,138 @@
+/* SPDX-License-Identifier:Unlicense */
+
+#include <arv.h>
+#include <stdlib.h>
+#include <stdio.h>
+
+static char *arv_option_genicam_filename = NULL;
+static int arv_option_latency_us = 500;
+static int arv_option_size = 65536;
+static int arv_option_max_window = 32;
+static char *arv_option_debug_domains = NULL;
+
+static const GOptionEntry arv_option_entries[] =
+{
+	{ "genicam",		'g', 0, G_OPTION_ARG_STRING,
+		&arv_option_genicam_filename,	"XML Genicam file to use", "<filename>"},
+	{ "latency",		'l', 0, G_OPTION_ARG_INT,
+		&arv_option_latency_us,		"Simulated GVCP round trip time", "<µs>"},
+	{ "size",		's', 0, G_OPTION_ARG_INT,
+		&arv_option_size,		"Size of the memory transfers", "<bytes>"},
+	{ "max-window",		'w', 0, G_OPTION_ARG_INT,
+		&arv_option_max_window,		"Maximum number of outstanding commands", "<n_commands>"},
+	{ "debug",		'd', 0, G_OPTION_ARG_STRING,
+		&arv_option_debug_domains,	"Debug output selection", "{<category>[:<level>][,...]}"},
+	{ NULL }
+};
+
+static void
+run (GInetAddress *address, guint window)
+{
+	ArvDevice *device;
+	GError *error = NULL;
+	void *data;
+	gint64 start_time;
+	double connection_s;
+	double read_s;
+	double write_s;
+	guint32 size;
+
+	start_time = g_get_monotonic_time ();
+
+	/* The construction includes the Genicam data loading */
+	device = g_initable_new (ARV_TYPE_GV_DEVICE, NULL, &error,
+				 "interface-address", address,
+				 "device-address", address,
+				 "gvcp-window", window,
+				 NULL);
+	if (!ARV_IS_DEVICE (device)) {
+		printf ("Failed to open device: %s\n", error != NULL ? error->message : "unknown error");
+		g_clear_error (&error);
+		return;
+	}
+
+	connection_s = (double) (g_get_monotonic_time () - start_time) / G_TIME_SPAN_SECOND;
+
+	/* Unused fake camera register space, before the Genicam data */
+	size = MIN (arv_option_size, 0x8000);
+	data = g_malloc0 (arv_option_size);
+
+	start_time = g_get_monotonic_time ();
+	arv_device_read_memory (device, 0, arv_option_size, data, &error);
+	read_s = (double) (g_get_monotonic_time () - start_time) / G_TIME_SPAN_SECOND;
+
+	if (error == NULL) {
+		start_time = g_get_monotonic_time ();
+		arv_device_write_memory (device, 0x8000, size, data, &error);
+		write_s = (double) (g_get_monotonic_time () - start_time) / G_TIME_SPAN_SECOND;
+	}
+
+	if (error == NULL)
+		printf ("window %2u: connection %8.3f s, read %8.1f kB/s, write %8.1f kB/s\n",
+			window, connection_s, arv_option_size / read_s / 1e3, size / write_s / 1e3);
+	else
+		printf ("window %2u: %s\n", window, error->message);
+
+	g_clear_error (&error);
+	g_free (data);
+	g_object_unref (device);
+}
+
+int
+main (int argc, char **argv)
+{
+	ArvGvFakeCamera *gv_fake_camera;
+	GInetAddress *address;
+	GOptionContext *context;
+	GError *error = NULL;
+	size_t genicam_size;
+	int window;
+
+	context = g_option_context_new (NULL);
+	g_option_context_set_summary (context, "Measure GVCP memory transfer rates against the number of outstanding "
+				      "commands.");
+	g_option_context_add_main_entries (context, arv_option_entries, NULL);
+
+	if (!g_option_context_parse (context, &argc, &argv, &error)) {
+		g_option_context_free (context);
+		g_print ("Option parsing failed: %s\n", error->message);
+		g_error_free (error);
+		return EXIT_FAILURE;
+	}
+
+	g_option_context_free (context);
+
+	if (!arv_debug_enable (arv_option_debug_domains)) {
+		printf ("Invalid debug selection\n");
+		return EXIT_FAILURE;
+	}
+
+	gv_fake_camera = arv_gv_fake_camera_new_full ("127.0.0.1", "GvcpTest", arv_option_genicam_filename);
+	if (!arv_gv_fake_camera_is_running (gv_fake_camera)) {
+		printf ("Failed to start fake camera\n");
+		g_object_unref (gv_fake_camera);
+		return EXIT_FAILURE;
+	}
+
+	g_object_set (gv_fake_camera, "gvcp-latency", arv_option_latency_us, NULL);
+
+	arv_fake_camera_get_genicam_xml (arv_gv_fake_camera_get_fake_camera (gv_fake_camera), &genicam_size);
+
+	/* Fake camera registers followed by the Genicam data */
+	arv_option_size = CLAMP (arv_option_size, 1, 0x10000 + (int) genicam_size - 1);
+
+	printf ("Round trip time: %d µs, transfer size: %d bytes, Genicam data: %" G_GSIZE_FORMAT " bytes\n",
+		arv_option_latency_us, arv_option_size, genicam_size);
+
+	address = g_inet_address_new_from_string ("127.0.0.1");
+
+	for (window = 1; window <= CLAMP (arv_option_max_window, 1, 32); window *= 2)
+		run (address, window);
+
+	g_object_unref (address);
+	g_object_unref (gv_fake_camera);
+
+	arv_shutdown ();
+
+	return EXIT_SUCCESS;
+}
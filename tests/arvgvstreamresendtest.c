@@ -0,0 +1,157 @@
+/* SPDX-License-Identifier:Unlicense */
+
+#include <arv.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <time.h>
+
+#define N_BUFFERS	20
+
+static char *arv_option_genicam_filename = NULL;
+static int arv_option_duration_s = 5;
+static int arv_option_width = 2048;
+static int arv_option_height = 2048;
+static double arv_option_frame_rate = 100.0;
+static double arv_option_lost_ratio = 0.001;
+static char *arv_option_debug_domains = NULL;
+
+static const GOptionEntry arv_option_entries[] =
+{
+	{ "genicam",		'g', 0, G_OPTION_ARG_STRING,
+		&arv_option_genicam_filename,	"XML Genicam file to use", "<filename>"},
+	{ "duration",		't', 0, G_OPTION_ARG_INT,
+		&arv_option_duration_s,		"Duration of the run", "<s>"},
+	{ "width",		'w', 0, G_OPTION_ARG_INT,
+		&arv_option_width,		"Width", "<n_pixels>"},
+	{ "height",		'h', 0, G_OPTION_ARG_INT,
+		&arv_option_height,		"Height", "<n_pixels>"},
+	{ "frequency",		'f', 0, G_OPTION_ARG_DOUBLE,
+		&arv_option_frame_rate,		"Acquisition frequency", "<Hz>"},
+	{ "lost-ratio",		'l', 0, G_OPTION_ARG_DOUBLE,
+		&arv_option_lost_ratio,		"Ratio of packets dropped by the fake camera", "<ratio>"},
+	{ "debug",		'd', 0, G_OPTION_ARG_STRING,
+		&arv_option_debug_domains,	"Debug output selection", "{<category>[:<level>][,...]}"},
+	{ NULL }
+};
+
+static double
+_get_cpu_time_s (void)
+{
+	struct timespec ts;
+
+	clock_gettime (CLOCK_PROCESS_CPUTIME_ID, &ts);
+
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+int
+main (int argc, char **argv)
+{
+	ArvGvFakeCamera *gv_fake_camera;
+	ArvCamera *camera;
+	ArvStream *stream;
+	GOptionContext *context;
+	GError *error = NULL;
+	guint64 n_completed_buffers = 0;
+	guint64 n_failures = 0;
+	gint64 start_time;
+	gint64 end_time;
+	double start_cpu_s;
+	double elapsed_s;
+	double cpu_s;
+
+	context = g_option_context_new (NULL);
+	g_option_context_set_summary (context, "Measure the GigE Vision stream missing packet handling cost, "
+				      "against a fake camera dropping packets.");
+	g_option_context_add_main_entries (context, arv_option_entries, NULL);
+
+	if (!g_option_context_parse (context, &argc, &argv, &error)) {
+		g_option_context_free (context);
+		g_print ("Option parsing failed: %s\n", error->message);
+		g_error_free (error);
+		return EXIT_FAILURE;
+	}
+
+	g_option_context_free (context);
+
+	if (!arv_debug_enable (arv_option_debug_domains)) {
+		printf ("Invalid debug selection\n");
+		return EXIT_FAILURE;
+	}
+
+	gv_fake_camera = arv_gv_fake_camera_new_full ("127.0.0.1", "ResendTest", arv_option_genicam_filename);
+	if (!arv_gv_fake_camera_is_running (gv_fake_camera)) {
+		printf ("Failed to start fake camera\n");
+		g_object_unref (gv_fake_camera);
+		return EXIT_FAILURE;
+	}
+
+	g_object_set (gv_fake_camera, "gvsp-lost-ratio", arv_option_lost_ratio, NULL);
+
+	camera = arv_camera_new ("Aravis-Fake-ResendTest", &error);
+	if (!ARV_IS_CAMERA (camera)) {
+		printf ("Failed to open camera: %s\n", error != NULL ? error->message : "unknown error");
+		g_clear_error (&error);
+		g_object_unref (gv_fake_camera);
+		return EXIT_FAILURE;
+	}
+
+	arv_camera_set_region (camera, 0, 0, arv_option_width, arv_option_height, NULL);
+	arv_camera_set_frame_rate (camera, arv_option_frame_rate, NULL);
+	arv_camera_set_acquisition_mode (camera, ARV_ACQUISITION_MODE_CONTINUOUS, NULL);
+
+	printf ("Payload: %u bytes, frame rate: %g Hz, lost ratio: %g\n",
+		arv_camera_get_payload (camera, NULL),
+		arv_camera_get_frame_rate (camera, NULL),
+		arv_option_lost_ratio);
+
+	stream = arv_camera_create_stream (camera, NULL, NULL, NULL, &error);
+	if (!ARV_IS_STREAM (stream)) {
+		printf ("Failed to create stream: %s\n", error != NULL ? error->message : "unknown error");
+		g_clear_error (&error);
+		g_object_unref (camera);
+		g_object_unref (gv_fake_camera);
+		return EXIT_FAILURE;
+	}
+
+	g_object_set (stream, "packet-resend", ARV_GV_STREAM_PACKET_RESEND_ALWAYS, NULL);
+
+	arv_stream_create_buffers (stream, N_BUFFERS, NULL, NULL, NULL);
+
+	arv_camera_start_acquisition (camera, NULL);
+
+	start_cpu_s = _get_cpu_time_s ();
+	start_time = g_get_monotonic_time ();
+	end_time = start_time + (gint64) arv_option_duration_s * G_TIME_SPAN_SECOND;
+
+	while (g_get_monotonic_time () < end_time) {
+		ArvBuffer *buffer;
+
+		buffer = arv_stream_timeout_pop_buffer (stream, 100000);
+		if (buffer != NULL)
+			arv_stream_push_buffer (stream, buffer);
+	}
+
+	elapsed_s = (double) (g_get_monotonic_time () - start_time) / G_TIME_SPAN_SECOND;
+	cpu_s = _get_cpu_time_s () - start_cpu_s;
+
+	arv_camera_stop_acquisition (camera, NULL);
+
+	arv_stream_get_statistics (stream, &n_completed_buffers, &n_failures, NULL);
+
+	/* The process CPU time includes the fake camera threads, whose cost does not depend on the stream code */
+	printf ("%8.1f frames/s, %" G_GUINT64_FORMAT " completed, %" G_GUINT64_FORMAT " failures\n",
+		n_completed_buffers / elapsed_s, n_completed_buffers, n_failures);
+	printf ("missing packets: %" G_GUINT64_FORMAT ", resend requests: %" G_GUINT64_FORMAT "\n",
+		arv_stream_get_info_uint64_by_name (stream, "n_missing_packets"),
+		arv_stream_get_info_uint64_by_name (stream, "n_resend_requests"));
+	printf ("process CPU time: %.3f s (%.1f %%)\n", cpu_s, 100.0 * cpu_s / elapsed_s);
+
+	g_object_unref (stream);
+	g_object_unref (camera);
+	g_object_unref (gv_fake_camera);
+
+	arv_shutdown ();
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,171 @@
+/* SPDX-License-Identifier:Unlicense */
+
+#include <arv.h>
+#include <stdlib.h>
+#include <stdio.h>
+
+#define N_BUFFERS	20
+
+static char *arv_option_genicam_filename = NULL;
+static int arv_option_max_workers = 4;
+static int arv_option_max_sockets = 4;
+static int arv_option_duration_s = 5;
+static int arv_option_width = 2048;
+static int arv_option_height = 2048;
+static double arv_option_frame_rate = 1000.0;
+static char *arv_option_debug_domains = NULL;
+
+static const GOptionEntry arv_option_entries[] =
+{
+	{ "genicam",		'g', 0, G_OPTION_ARG_STRING,
+		&arv_option_genicam_filename,	"XML Genicam file to use", "<filename>"},
+	{ "max-workers",	'n', 0, G_OPTION_ARG_INT,
+		&arv_option_max_workers,	"Maximum number of copy workers", "<n_workers>"},
+	{ "max-sockets",	's', 0, G_OPTION_ARG_INT,
+		&arv_option_max_sockets,	"Maximum number of receive sockets", "<n_sockets>"},
+	{ "duration",		't', 0, G_OPTION_ARG_INT,
+		&arv_option_duration_s,		"Duration of each run", "<s>"},
+	{ "width",		'w', 0, G_OPTION_ARG_INT,
+		&arv_option_width,		"Width", "<n_pixels>"},
+	{ "height",		'h', 0, G_OPTION_ARG_INT,
+		&arv_option_height,		"Height", "<n_pixels>"},
+	{ "frequency",		'f', 0, G_OPTION_ARG_DOUBLE,
+		&arv_option_frame_rate,		"Acquisition frequency", "<Hz>"},
+	{ "debug",		'd', 0, G_OPTION_ARG_STRING,
+		&arv_option_debug_domains,	"Debug output selection", "{<category>[:<level>][,...]}"},
+	{ NULL }
+};
+
+static void
+run (ArvCamera *camera, guint n_workers, guint n_sockets)
+{
+	ArvStream *stream;
+	GError *error = NULL;
+	guint64 n_completed_buffers = 0;
+	guint64 n_failures = 0;
+	guint64 n_bytes = 0;
+	guint64 n_offloaded_bytes;
+	gint64 start_time;
+	gint64 end_time;
+	double elapsed_s;
+
+	stream = arv_camera_create_stream (camera, NULL, NULL, NULL, &error);
+	if (!ARV_IS_STREAM (stream)) {
+		printf ("Failed to create stream: %s\n", error != NULL ? error->message : "unknown error");
+		g_clear_error (&error);
+		return;
+	}
+
+	g_object_set (stream, "n-workers", n_workers, "n-sockets", n_sockets, NULL);
+
+	arv_stream_create_buffers (stream, N_BUFFERS, NULL, NULL, NULL);
+
+	arv_camera_start_acquisition (camera, NULL);
+
+	start_time = g_get_monotonic_time ();
+	end_time = start_time + (gint64) arv_option_duration_s * G_TIME_SPAN_SECOND;
+
+	while (g_get_monotonic_time () < end_time) {
+		ArvBuffer *buffer;
+
+		buffer = arv_stream_timeout_pop_buffer (stream, 100000);
+		if (buffer == NULL)
+			continue;
+
+		if (arv_buffer_get_status (buffer) == ARV_BUFFER_STATUS_SUCCESS) {
+			size_t size;
+
+			arv_buffer_get_data (buffer, &size);
+			n_bytes += size;
+		}
+
+		arv_stream_push_buffer (stream, buffer);
+	}
+
+	elapsed_s = (double) (g_get_monotonic_time () - start_time) / G_TIME_SPAN_SECOND;
+
+	arv_camera_stop_acquisition (camera, NULL);
+
+	arv_stream_get_statistics (stream, &n_completed_buffers, &n_failures, NULL);
+	n_offloaded_bytes = arv_stream_get_info_uint64_by_name (stream, "n_offloaded_bytes");
+
+	printf ("%2u workers %2u sockets: %8.1f MB/s %8.1f frames/s (%" G_GUINT64_FORMAT " completed, %"
+		G_GUINT64_FORMAT " failures, %.1f%% offloaded)\n",
+		n_workers, n_sockets,
+		n_bytes / elapsed_s / 1e6,
+		n_completed_buffers / elapsed_s,
+		n_completed_buffers, n_failures,
+		n_bytes > 0 ? 100.0 * n_offloaded_bytes / n_bytes : 0.0);
+
+	g_object_unref (stream);
+}
+
+int
+main (int argc, char **argv)
+{
+	ArvGvFakeCamera *gv_fake_camera;
+	ArvCamera *camera;
+	GOptionContext *context;
+	GError *error = NULL;
+	int i;
+
+	context = g_option_context_new (NULL);
+	g_option_context_set_summary (context, "Measure GigE Vision stream throughput against the number of copy workers, "
+				      "then against the number of receive sockets.");
+	g_option_context_add_main_entries (context, arv_option_entries, NULL);
+
+	if (!g_option_context_parse (context, &argc, &argv, &error)) {
+		g_option_context_free (context);
+		g_print ("Option parsing failed: %s\n", error->message);
+		g_error_free (error);
+		return EXIT_FAILURE;
+	}
+
+	g_option_context_free (context);
+
+	if (!arv_debug_enable (arv_option_debug_domains)) {
+		printf ("Invalid debug selection\n");
+		return EXIT_FAILURE;
+	}
+
+	gv_fake_camera = arv_gv_fake_camera_new_full ("127.0.0.1", "WorkerTest", arv_option_genicam_filename);
+	if (!arv_gv_fake_camera_is_running (gv_fake_camera)) {
+		printf ("Failed to start fake camera\n");
+		g_object_unref (gv_fake_camera);
+		return EXIT_FAILURE;
+	}
+
+	camera = arv_camera_new ("Aravis-Fake-WorkerTest", &error);
+	if (!ARV_IS_CAMERA (camera)) {
+		printf ("Failed to open camera: %s\n", error != NULL ? error->message : "unknown error");
+		g_clear_error (&error);
+		g_object_unref (gv_fake_camera);
+		return EXIT_FAILURE;
+	}
+
+	arv_camera_set_region (camera, 0, 0, arv_option_width, arv_option_height, NULL);
+	arv_camera_set_frame_rate (camera, arv_option_frame_rate, NULL);
+	arv_camera_set_acquisition_mode (camera, ARV_ACQUISITION_MODE_CONTINUOUS, NULL);
+
+	/* Multiple sockets are only used by the standard socket receive method */
+	arv_camera_gv_set_stream_options (camera, ARV_GV_STREAM_OPTION_PACKET_SOCKET_DISABLED);
+
+	printf ("Payload: %u bytes, frame rate: %g Hz\n",
+		arv_camera_get_payload (camera, NULL),
+		arv_camera_get_frame_rate (camera, NULL));
+
+	/* Payload copies sharded over the workers, the receive thread doing all the packet processing */
+	for (i = 0; i <= arv_option_max_workers; i++)
+		run (camera, i, 1);
+
+	/* Packet reception and processing sharded over the sockets bound to the stream port */
+	for (i = 2; i <= arv_option_max_sockets; i++)
+		run (camera, 0, i);
+
+	g_object_unref (camera);
+	g_object_unref (gv_fake_camera);
+
+	arv_shutdown ();
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,120 @@
+/* SPDX-License-Identifier:Unlicense */
+
+#include <arv.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include "../src/arvimageconvertprivate.h"
+
+static int arv_option_width = 2448;
+static int arv_option_height = 2048;
+static int arv_option_n_iterations = 50;
+
+static const GOptionEntry arv_option_entries[] =
+{
+	{ "width",		0, 0, G_OPTION_ARG_INT,
+		&arv_option_width,		"Image width", "<width>"},
+	{ "height",		0, 0, G_OPTION_ARG_INT,
+		&arv_option_height,		"Image height", "<height>"},
+	{ "n-iterations",	'n', 0, G_OPTION_ARG_INT,
+		&arv_option_n_iterations,	"Number of conversions per measure", "<n_iterations>"},
+	{ NULL }
+};
+
+static const struct {
+	const char *name;
+	ArvPixelFormat pixel_format;
+} formats[] = {
+	{ "Mono10Packed",	ARV_PIXEL_FORMAT_MONO_10_PACKED },
+	{ "Mono12Packed",	ARV_PIXEL_FORMAT_MONO_12_PACKED },
+	{ "Mono10p",		ARV_PIXEL_FORMAT_MONO_10P },
+	{ "Mono12p",		ARV_PIXEL_FORMAT_MONO_12P },
+	{ "Mono14p",		ARV_PIXEL_FORMAT_MONO_14P }
+};
+
+int
+main (int argc, char **argv)
+{
+	GOptionContext *context;
+	GError *error = NULL;
+	guint8 *input;
+	guint8 *output;
+	size_t input_size;
+	size_t output_size;
+	unsigned int i, j, k;
+	int n;
+
+	context = g_option_context_new (NULL);
+	g_option_context_set_summary (context, "Measure the throughput of the packed pixel format unpacking.");
+	g_option_context_add_main_entries (context, arv_option_entries, NULL);
+
+	if (!g_option_context_parse (context, &argc, &argv, &error)) {
+		g_option_context_free (context);
+		g_print ("Option parsing failed: %s\n", error->message);
+		g_error_free (error);
+		return EXIT_FAILURE;
+	}
+
+	g_option_context_free (context);
+
+	if (arv_option_width < 1 || arv_option_height < 1 || arv_option_n_iterations < 1) {
+		printf ("Invalid image size or iteration count\n");
+		return EXIT_FAILURE;
+	}
+
+	input_size = (size_t) arv_option_width * arv_option_height * 2;
+	output_size = (size_t) arv_option_width * arv_option_height * 2;
+	input = g_malloc (input_size);
+	output = g_malloc (output_size);
+
+	for (i = 0; i < input_size; i++)
+		input[i] = g_random_int ();
+
+	printf ("%dx%d images, throughput in GB/s of packed input\n", arv_option_width, arv_option_height);
+
+	printf ("%-16s %3s", "", "");
+	for (k = ARV_IMAGE_CONVERT_IMPLEMENTATION_SCALAR; k < ARV_IMAGE_CONVERT_IMPLEMENTATION_N_ELEMENTS; k++)
+		if (arv_image_convert_set_implementation (k))
+			printf (" %8s", arv_image_convert_implementation_to_string (k));
+	printf ("\n");
+
+	for (i = 0; i < G_N_ELEMENTS (formats); i++) {
+		size_t packed_size = (size_t) arv_option_width * arv_option_height *
+			ARV_PIXEL_FORMAT_BIT_PER_PIXEL (formats[i].pixel_format) / 8;
+
+		for (j = 8; j <= 16; j += 8) {
+			printf ("%-16s %3u", formats[i].name, j);
+
+			for (k = ARV_IMAGE_CONVERT_IMPLEMENTATION_SCALAR;
+			     k < ARV_IMAGE_CONVERT_IMPLEMENTATION_N_ELEMENTS; k++) {
+				gint64 start;
+				gint64 elapsed;
+
+				if (!arv_image_convert_set_implementation (k))
+					continue;
+
+				start = g_get_monotonic_time ();
+				for (n = 0; n < arv_option_n_iterations; n++) {
+					if (arv_image_unpack (formats[i].pixel_format, input, input_size,
+							      arv_option_width, arv_option_height, 0,
+							      j, output, output_size, &error) == 0) {
+						printf ("\nConversion failed: %s\n", error->message);
+						g_clear_error (&error);
+						break;
+					}
+				}
+				elapsed = g_get_monotonic_time () - start;
+
+				printf (" %8.3f", (double) packed_size * arv_option_n_iterations / (elapsed * 1e3));
+			}
+
+			printf ("\n");
+		}
+	}
+
+	g_free (input);
+	g_free (output);
+
+	arv_shutdown ();
+
+	return EXIT_SUCCESS;
+}
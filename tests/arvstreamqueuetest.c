@@ -0,0 +1,185 @@
+/* SPDX-License-Identifier:Unlicense */
+
+#include <arv.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <time.h>
+#include "../src/arvbufferqueueprivate.h"
+
+static int arv_option_n_buffers = 16;
+static int arv_option_n_transfers = 100000;
+static double arv_option_frequency = 10000.0;
+
+static const GOptionEntry arv_option_entries[] =
+{
+	{ "n-buffers",		'n', 0, G_OPTION_ARG_INT,
+		&arv_option_n_buffers,		"Number of buffers", "<n_buffers>"},
+	{ "n-transfers",	't', 0, G_OPTION_ARG_INT,
+		&arv_option_n_transfers,	"Number of transfers per run", "<n_transfers>"},
+	{ "frequency",		'f', 0, G_OPTION_ARG_DOUBLE,
+		&arv_option_frequency,		"Push frequency, 0 for no pacing", "<Hz>"},
+	{ NULL }
+};
+
+typedef struct {
+	const char *name;
+	gpointer (*new) (void);
+	void (*free) (gpointer queue);
+	void (*push) (gpointer queue, ArvBuffer *buffer);
+	ArvBuffer * (*pop) (gpointer queue);
+} QueueImplementation;
+
+static gpointer _arv_queue_new (void) { return arv_buffer_queue_new (); }
+static void _arv_queue_free (gpointer queue) { arv_buffer_queue_free (queue); }
+static void _arv_queue_push (gpointer queue, ArvBuffer *buffer) { arv_buffer_queue_push (queue, buffer); }
+static ArvBuffer * _arv_queue_pop (gpointer queue) { return arv_buffer_queue_pop (queue); }
+
+static gpointer _async_queue_new (void) { return g_async_queue_new (); }
+static void _async_queue_free (gpointer queue) { g_async_queue_unref (queue); }
+static void _async_queue_push (gpointer queue, ArvBuffer *buffer) { g_async_queue_push (queue, buffer); }
+static ArvBuffer * _async_queue_pop (gpointer queue) { return g_async_queue_pop (queue); }
+
+static const QueueImplementation implementations[] = {
+	{ "ArvBufferQueue", _arv_queue_new, _arv_queue_free, _arv_queue_push, _arv_queue_pop },
+	{ "GAsyncQueue", _async_queue_new, _async_queue_free, _async_queue_push, _async_queue_pop }
+};
+
+typedef struct {
+	const QueueImplementation *implementation;
+	gpointer input;
+	gpointer output;
+} RunData;
+
+static guint64
+_get_time_ns (void)
+{
+#ifdef G_OS_WIN32
+	return g_get_monotonic_time () * 1000;
+#else
+	struct timespec ts;
+
+	clock_gettime (CLOCK_MONOTONIC, &ts);
+
+	return (guint64) ts.tv_sec * 1000000000 + ts.tv_nsec;
+#endif
+}
+
+static void *
+producer_thread (void *user_data)
+{
+	RunData *data = user_data;
+	guint64 period_ns = arv_option_frequency > 0.0 ? 1e9 / arv_option_frequency : 0;
+	guint64 next_time_ns = _get_time_ns ();
+	int i;
+
+	for (i = 0; i < arv_option_n_transfers; i++) {
+		ArvBuffer *buffer;
+
+		buffer = data->implementation->pop (data->input);
+
+		/* Busy wait, in order to not add the scheduler latency to the measure */
+		next_time_ns += period_ns;
+		while (_get_time_ns () < next_time_ns);
+
+		arv_buffer_set_timestamp (buffer, _get_time_ns ());
+		data->implementation->push (data->output, buffer);
+	}
+
+	return NULL;
+}
+
+static int
+compare_latencies (const void *a, const void *b)
+{
+	guint64 latency_a = *(const guint64 *) a;
+	guint64 latency_b = *(const guint64 *) b;
+
+	return latency_a < latency_b ? -1 : latency_a > latency_b;
+}
+
+static void
+run (const QueueImplementation *implementation)
+{
+	static const double percentiles[] = {50.0, 90.0, 99.0, 99.9};
+	RunData data;
+	GThread *thread;
+	guint64 *latencies;
+	int i;
+
+	data.implementation = implementation;
+	data.input = implementation->new ();
+	data.output = implementation->new ();
+
+	if (implementation->new == _arv_queue_new) {
+		arv_buffer_queue_reserve (data.input, arv_option_n_buffers);
+		arv_buffer_queue_reserve (data.output, arv_option_n_buffers);
+	}
+
+	for (i = 0; i < arv_option_n_buffers; i++)
+		implementation->push (data.input, arv_buffer_new (64, NULL));
+
+	latencies = g_new (guint64, arv_option_n_transfers);
+
+	thread = g_thread_new ("producer", producer_thread, &data);
+
+	for (i = 0; i < arv_option_n_transfers; i++) {
+		ArvBuffer *buffer;
+
+		buffer = implementation->pop (data.output);
+		latencies[i] = _get_time_ns () - arv_buffer_get_timestamp (buffer);
+		implementation->push (data.input, buffer);
+	}
+
+	g_thread_join (thread);
+
+	qsort (latencies, arv_option_n_transfers, sizeof (guint64), compare_latencies);
+
+	printf ("%-16s", implementation->name);
+	for (i = 0; i < G_N_ELEMENTS (percentiles); i++)
+		printf (" p%-4g %8.3f µs", percentiles[i],
+			latencies[(int) (percentiles[i] / 100.0 * (arv_option_n_transfers - 1))] / 1000.0);
+	printf (" max %8.3f µs\n", latencies[arv_option_n_transfers - 1] / 1000.0);
+
+	for (i = 0; i < arv_option_n_buffers; i++)
+		g_object_unref (implementation->pop (data.input));
+
+	implementation->free (data.input);
+	implementation->free (data.output);
+	g_free (latencies);
+}
+
+int
+main (int argc, char **argv)
+{
+	GOptionContext *context;
+	GError *error = NULL;
+	int i;
+
+	context = g_option_context_new (NULL);
+	g_option_context_set_summary (context, "Measure the push to pop latency of the stream buffer queues.");
+	g_option_context_add_main_entries (context, arv_option_entries, NULL);
+
+	if (!g_option_context_parse (context, &argc, &argv, &error)) {
+		g_option_context_free (context);
+		g_print ("Option parsing failed: %s\n", error->message);
+		g_error_free (error);
+		return EXIT_FAILURE;
+	}
+
+	g_option_context_free (context);
+
+	if (arv_option_n_buffers < 1 || arv_option_n_transfers < 1) {
+		printf ("Invalid buffer or transfer count\n");
+		return EXIT_FAILURE;
+	}
+
+	printf ("%d buffers, %d transfers, push frequency %g Hz\n",
+		arv_option_n_buffers, arv_option_n_transfers, arv_option_frequency);
+
+	for (i = 0; i < G_N_ELEMENTS (implementations); i++)
+		run (&implementations[i]);
+
+	arv_shutdown ();
+
+	return EXIT_SUCCESS;
+}
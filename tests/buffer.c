@@ -2,6 +2,9 @@
 
 #include <glib.h>
 #include <arv.h>
+#include <string.h>
+#include "../src/arvbufferqueueprivate.h"
+#include "../src/arvimageconvertprivate.h"
 
 static void
 simple_buffer_test (void)
@@ -115,6 +118,464 @@ allocate (void)
 	g_object_unref (buffer);
 }
 
+#define N_QUEUE_BUFFERS		40
+
+static void
+queue_test (void)
+{
+	ArvBufferQueue *queue;
+	ArvBuffer *buffers[N_QUEUE_BUFFERS];
+	unsigned i;
+
+	queue = arv_buffer_queue_new ();
+
+	g_assert (arv_buffer_queue_try_pop (queue) == NULL);
+	g_assert (arv_buffer_queue_timeout_pop (queue, 1000) == NULL);
+
+	/* Ring smaller than the buffer count, the last buffers go through the overflow list */
+	g_assert (arv_buffer_queue_reserve (queue, N_QUEUE_BUFFERS / 2));
+	g_assert (!arv_buffer_queue_reserve (queue, N_QUEUE_BUFFERS));
+
+	for (i = 0; i < N_QUEUE_BUFFERS; i++) {
+		buffers[i] = arv_buffer_new (16, NULL);
+		arv_buffer_queue_push (queue, buffers[i]);
+	}
+
+	g_assert_cmpint (arv_buffer_queue_get_length (queue), ==, N_QUEUE_BUFFERS);
+
+	/* Order is kept, even when buffers are pushed while the overflow list is not empty */
+	for (i = 0; i < N_QUEUE_BUFFERS / 2; i++)
+		g_assert (arv_buffer_queue_pop (queue) == buffers[i]);
+	for (i = 0; i < N_QUEUE_BUFFERS / 2; i++)
+		arv_buffer_queue_push (queue, buffers[i]);
+	for (i = 0; i < N_QUEUE_BUFFERS; i++)
+		g_assert (arv_buffer_queue_try_pop (queue) == buffers[(i + N_QUEUE_BUFFERS / 2) % N_QUEUE_BUFFERS]);
+
+	g_assert_cmpint (arv_buffer_queue_get_length (queue), ==, 0);
+	g_assert (arv_buffer_queue_try_pop (queue) == NULL);
+
+	for (i = 0; i < N_QUEUE_BUFFERS; i++)
+		g_object_unref (buffers[i]);
+
+	arv_buffer_queue_free (queue);
+}
+
+static void
+queue_batch_test (void)
+{
+	ArvBufferQueue *queue;
+	ArvBuffer *buffers[N_QUEUE_BUFFERS];
+	ArvBuffer *popped[N_QUEUE_BUFFERS];
+	unsigned i;
+
+	queue = arv_buffer_queue_new ();
+
+	g_assert_cmpint (arv_buffer_queue_try_pop_many (queue, popped, N_QUEUE_BUFFERS), ==, 0);
+	g_assert_cmpint (arv_buffer_queue_timeout_pop_many (queue, popped, N_QUEUE_BUFFERS, 1000), ==, 0);
+
+	g_assert (arv_buffer_queue_reserve (queue, N_QUEUE_BUFFERS / 4));
+
+	for (i = 0; i < N_QUEUE_BUFFERS; i++)
+		buffers[i] = arv_buffer_new (16, NULL);
+
+	/* Partly in the ring, partly in the overflow list */
+	arv_buffer_queue_push_many (queue, buffers, N_QUEUE_BUFFERS);
+	g_assert_cmpint (arv_buffer_queue_get_length (queue), ==, N_QUEUE_BUFFERS);
+
+	g_assert_cmpint (arv_buffer_queue_try_pop_many (queue, popped, N_QUEUE_BUFFERS / 4), ==, N_QUEUE_BUFFERS / 4);
+	for (i = 0; i < N_QUEUE_BUFFERS / 4; i++)
+		g_assert (popped[i] == buffers[i]);
+
+	arv_buffer_queue_push_many (queue, popped, N_QUEUE_BUFFERS / 4);
+	g_assert_cmpint (arv_buffer_queue_get_length (queue), ==, N_QUEUE_BUFFERS);
+
+	g_assert_cmpint (arv_buffer_queue_timeout_pop_many (queue, popped, N_QUEUE_BUFFERS, 1000), ==, N_QUEUE_BUFFERS);
+	for (i = 0; i < N_QUEUE_BUFFERS; i++)
+		g_assert (popped[i] == buffers[(i + N_QUEUE_BUFFERS / 4) % N_QUEUE_BUFFERS]);
+
+	/* Single and batch operations can be mixed */
+	arv_buffer_queue_push_many (queue, buffers, 3);
+	arv_buffer_queue_push (queue, buffers[3]);
+	g_assert (arv_buffer_queue_try_pop (queue) == buffers[0]);
+	g_assert_cmpint (arv_buffer_queue_try_pop_many (queue, popped, N_QUEUE_BUFFERS), ==, 3);
+	g_assert (popped[0] == buffers[1]);
+	g_assert (popped[2] == buffers[3]);
+
+	g_assert_cmpint (arv_buffer_queue_get_length (queue), ==, 0);
+
+	for (i = 0; i < N_QUEUE_BUFFERS; i++)
+		g_object_unref (buffers[i]);
+
+	arv_buffer_queue_free (queue);
+}
+
+#define N_POOL_BUFFERS		4
+#define POOL_BUFFER_SIZE	1000
+
+static void
+pool_test (void)
+{
+	ArvBufferPool *pool;
+	ArvBuffer *buffers[N_POOL_BUFFERS];
+	GError *error = NULL;
+	unsigned i;
+
+	pool = arv_buffer_pool_new (POOL_BUFFER_SIZE, N_POOL_BUFFERS, 3, ARV_BUFFER_POOL_NUMA_NODE_NONE,
+				    ARV_BUFFER_POOL_FLAGS_NONE, &error);
+	g_assert (pool == NULL);
+	g_assert_error (error, ARV_BUFFER_POOL_ERROR, ARV_BUFFER_POOL_ERROR_INVALID_PARAMETER);
+	g_clear_error (&error);
+
+	pool = arv_buffer_pool_new (POOL_BUFFER_SIZE, N_POOL_BUFFERS, 0, ARV_BUFFER_POOL_NUMA_NODE_NONE,
+				    ARV_BUFFER_POOL_FLAGS_NONE, &error);
+	g_assert (ARV_IS_BUFFER_POOL (pool));
+	g_assert_no_error (error);
+
+	g_assert_cmpint (arv_buffer_pool_get_n_buffers (pool), ==, N_POOL_BUFFERS);
+	g_assert_cmpint (arv_buffer_pool_get_buffer_size (pool), ==, POOL_BUFFER_SIZE);
+	g_assert_cmpint (arv_buffer_pool_get_alignment (pool), ==, ARV_BUFFER_POOL_DEFAULT_ALIGNMENT);
+	g_assert_cmpint (arv_buffer_pool_get_size (pool), >=, N_POOL_BUFFERS * ARV_BUFFER_POOL_DEFAULT_ALIGNMENT);
+	g_assert_cmpint (arv_buffer_pool_get_locked_size (pool), ==, 0);
+	g_assert_cmpint (arv_buffer_pool_get_numa_node (pool), ==, ARV_BUFFER_POOL_NUMA_NODE_NONE);
+
+	for (i = 0; i < N_POOL_BUFFERS; i++) {
+		size_t size;
+		const guint8 *data;
+
+		buffers[i] = arv_buffer_pool_new_buffer (pool, NULL, NULL);
+		g_assert (ARV_IS_BUFFER (buffers[i]));
+
+		data = arv_buffer_get_data (buffers[i], &size);
+		g_assert_cmpint (size, ==, POOL_BUFFER_SIZE);
+		g_assert_cmpint (((size_t) data) % ARV_BUFFER_POOL_DEFAULT_ALIGNMENT, ==, 0);
+		g_assert_cmpint (data[0], ==, 0);
+		if (i > 0)
+			g_assert (data != arv_buffer_get_data (buffers[i - 1], NULL));
+	}
+
+	g_assert_cmpint (arv_buffer_pool_get_n_available_buffers (pool), ==, 0);
+	g_assert (arv_buffer_pool_new_buffer (pool, NULL, NULL) == NULL);
+
+	/* The buffers keep the pool memory alive */
+	g_object_unref (pool);
+	for (i = 0; i < N_POOL_BUFFERS; i++)
+		memset ((void *) arv_buffer_get_data (buffers[i], NULL), 0xff, POOL_BUFFER_SIZE);
+	for (i = 0; i < N_POOL_BUFFERS; i++)
+		g_object_unref (buffers[i]);
+
+	/* Huge pages and memory locking are best effort */
+	pool = arv_buffer_pool_new (POOL_BUFFER_SIZE, N_POOL_BUFFERS, 64, ARV_BUFFER_POOL_NUMA_NODE_NONE,
+				    ARV_BUFFER_POOL_FLAGS_HUGE_PAGES | ARV_BUFFER_POOL_FLAGS_LOCK, &error);
+	g_assert (ARV_IS_BUFFER_POOL (pool));
+	g_assert_no_error (error);
+	g_assert_cmpint (arv_buffer_pool_get_size (pool), >=, N_POOL_BUFFERS * 1024);
+
+	buffers[0] = arv_buffer_pool_new_buffer (pool, NULL, NULL);
+	g_assert_cmpint (((size_t) arv_buffer_get_data (buffers[0], NULL)) % 64, ==, 0);
+	g_object_unref (buffers[0]);
+
+	g_object_unref (pool);
+}
+
+static const struct {
+	ArvPixelFormat pixel_format;
+	guint depth;
+	guint8 packed[7];
+	guint n_pixels;
+	guint16 unpacked[4];
+} unpack_data[] = {
+	{ ARV_PIXEL_FORMAT_MONO_10_PACKED,	10, {0xff, 0x31, 0x80},			2, {0x3fd, 0x203}},
+	{ ARV_PIXEL_FORMAT_MONO_12_PACKED,	12, {0x12, 0x43, 0x65},			2, {0x123, 0x654}},
+	{ ARV_PIXEL_FORMAT_MONO_10P,		10, {0x01, 0xfc, 0x5f, 0x95, 0xaa},		4, {0x001, 0x3ff, 0x155, 0x2aa}},
+	{ ARV_PIXEL_FORMAT_MONO_12P,		12, {0x21, 0x43, 0x65},			2, {0x321, 0x654}},
+	{ ARV_PIXEL_FORMAT_MONO_14P,		14, {0xff, 0x3f, 0x8d, 0xc4, 0xab, 0x00, 0x80}, 4, {0x3fff, 0x1234, 0x0abc, 0x2000}}
+};
+
+static const ArvPixelFormat unpack_formats[] = {
+	ARV_PIXEL_FORMAT_MONO_10_PACKED,
+	ARV_PIXEL_FORMAT_MONO_12_PACKED,
+	ARV_PIXEL_FORMAT_MONO_10P,
+	ARV_PIXEL_FORMAT_MONO_12P,
+	ARV_PIXEL_FORMAT_MONO_14P,
+	ARV_PIXEL_FORMAT_COORD3D_ABC_10P
+};
+
+static void
+unpack_test (void)
+{
+	GError *error = NULL;
+	guint16 output_16[4];
+	guint8 output_8[4];
+	guint8 *input;
+	guint8 *reference;
+	guint8 *output;
+	size_t size;
+	unsigned int i, j, k;
+
+	g_assert_cmpint (arv_image_get_unpacked_pixel_format (ARV_PIXEL_FORMAT_MONO_12P, 16), ==, ARV_PIXEL_FORMAT_MONO_12);
+	g_assert_cmpint (arv_image_get_unpacked_pixel_format (ARV_PIXEL_FORMAT_BAYER_RG_10P, 8), ==, ARV_PIXEL_FORMAT_BAYER_RG_8);
+	g_assert_cmpint (arv_image_get_unpacked_pixel_format (ARV_PIXEL_FORMAT_MONO_8, 8), ==, 0);
+	g_assert_cmpint (arv_image_get_unpacked_size (ARV_PIXEL_FORMAT_COORD3D_ABC_12P, 10, 2, 16), ==, 120);
+
+	/* Scalar reference implementation against known values */
+	g_assert (arv_image_convert_set_implementation (ARV_IMAGE_CONVERT_IMPLEMENTATION_SCALAR));
+
+	for (i = 0; i < G_N_ELEMENTS (unpack_data); i++) {
+		size = arv_image_unpack (unpack_data[i].pixel_format, unpack_data[i].packed,
+					 sizeof (unpack_data[i].packed), unpack_data[i].n_pixels, 1, 0,
+					 16, output_16, sizeof (output_16), &error);
+		g_assert_no_error (error);
+		g_assert_cmpint (size, ==, unpack_data[i].n_pixels * 2);
+
+		size = arv_image_unpack (unpack_data[i].pixel_format, unpack_data[i].packed,
+					 sizeof (unpack_data[i].packed), unpack_data[i].n_pixels, 1, 0,
+					 8, output_8, sizeof (output_8), &error);
+		g_assert_no_error (error);
+		g_assert_cmpint (size, ==, unpack_data[i].n_pixels);
+
+		for (j = 0; j < unpack_data[i].n_pixels; j++) {
+			g_assert_cmpint (output_16[j], ==, unpack_data[i].unpacked[j]);
+			g_assert_cmpint (output_8[j], ==, unpack_data[i].unpacked[j] >> (unpack_data[i].depth - 8));
+		}
+	}
+
+	size = arv_image_unpack (ARV_PIXEL_FORMAT_MONO_8, unpack_data[0].packed, 3, 2, 1, 0,
+				 16, output_16, sizeof (output_16), &error);
+	g_assert_error (error, ARV_IMAGE_CONVERT_ERROR, ARV_IMAGE_CONVERT_ERROR_PIXEL_FORMAT_NOT_SUPPORTED);
+	g_assert_cmpint (size, ==, 0);
+	g_clear_error (&error);
+
+	size = arv_image_unpack (ARV_PIXEL_FORMAT_MONO_12P, unpack_data[3].packed, 3, 2, 2, 0,
+				 16, output_16, sizeof (output_16), &error);
+	g_assert_error (error, ARV_IMAGE_CONVERT_ERROR, ARV_IMAGE_CONVERT_ERROR_BUFFER_TOO_SMALL);
+	g_assert_cmpint (size, ==, 0);
+	g_clear_error (&error);
+
+	/* Vector implementations against the scalar one, with odd sizes and line padding */
+	input = g_malloc (65536);
+	reference = g_malloc (131072);
+	output = g_malloc (131072);
+
+	for (i = 0; i < 65536; i++)
+		input[i] = g_random_int ();
+
+	for (i = 0; i < G_N_ELEMENTS (unpack_formats); i++) {
+		for (j = 0; j < 4; j++) {
+			guint width = 37 + 64 * j;
+			guint height = 17;
+			guint x_padding = j % 2 == 0 ? 0 : 3;
+			guint output_bits = j < 2 ? 8 : 16;
+			size_t reference_size;
+
+			arv_image_convert_set_implementation (ARV_IMAGE_CONVERT_IMPLEMENTATION_SCALAR);
+			reference_size = arv_image_unpack (unpack_formats[i], input, 65536, width, height, x_padding,
+							   output_bits, reference, 131072, &error);
+			g_assert_no_error (error);
+			g_assert_cmpint (reference_size, >, 0);
+
+			for (k = ARV_IMAGE_CONVERT_IMPLEMENTATION_SSE4_1;
+			     k < ARV_IMAGE_CONVERT_IMPLEMENTATION_N_ELEMENTS; k++) {
+				if (!arv_image_convert_set_implementation (k))
+					continue;
+
+				memset (output, 0, reference_size);
+				size = arv_image_unpack (unpack_formats[i], input, 65536, width, height, x_padding,
+							 output_bits, output, 131072, &error);
+				g_assert_no_error (error);
+				g_assert_cmpint (size, ==, reference_size);
+				g_assert (memcmp (output, reference, size) == 0);
+			}
+		}
+	}
+
+	arv_image_convert_set_implementation (ARV_IMAGE_CONVERT_IMPLEMENTATION_AUTO);
+
+	g_free (input);
+	g_free (reference);
+	g_free (output);
+}
+
+static const ArvPixelFormat demosaic_formats[] = {
+	ARV_PIXEL_FORMAT_BAYER_RG_8,
+	ARV_PIXEL_FORMAT_BAYER_GR_8,
+	ARV_PIXEL_FORMAT_BAYER_GB_8,
+	ARV_PIXEL_FORMAT_BAYER_BG_8,
+	ARV_PIXEL_FORMAT_BAYER_RG_12,
+	ARV_PIXEL_FORMAT_BAYER_BG_16
+};
+
+static void
+demosaic_test (void)
+{
+	GError *error = NULL;
+	guint8 *input;
+	guint8 *reference;
+	guint8 *output;
+	size_t size;
+	guint i, j, k, x, y;
+
+	g_assert_cmpint (arv_image_get_demosaiced_pixel_format (ARV_PIXEL_FORMAT_BAYER_GR_8, 8), ==,
+			 ARV_PIXEL_FORMAT_RGB_8_PACKED);
+	g_assert_cmpint (arv_image_get_demosaiced_pixel_format (ARV_PIXEL_FORMAT_BAYER_GR_12, 16), ==,
+			 ARV_PIXEL_FORMAT_RGB_12_PACKED);
+	g_assert_cmpint (arv_image_get_demosaiced_pixel_format (ARV_PIXEL_FORMAT_BAYER_GR_8, 16), ==, 0);
+	g_assert_cmpint (arv_image_get_demosaiced_pixel_format (ARV_PIXEL_FORMAT_MONO_8, 8), ==, 0);
+	g_assert_cmpint (arv_image_get_demosaiced_size (ARV_PIXEL_FORMAT_BAYER_RG_10, 10, 2, 16), ==, 120);
+
+	input = g_malloc (131072);
+	reference = g_malloc (393216);
+	output = g_malloc (393216);
+
+	/* Uniform color planes give a uniform image, whatever the Bayer phase */
+
+	for (i = 0; i < 4; i++) {
+		guint red_x = i % 2;
+		guint red_y = i / 2;
+
+		for (y = 0; y < 8; y++) {
+			for (x = 0; x < 16; x++) {
+				if ((x & 1) == red_x && (y & 1) == red_y)
+					input[y * 16 + x] = 200;
+				else if ((x & 1) != red_x && (y & 1) != red_y)
+					input[y * 16 + x] = 50;
+				else
+					input[y * 16 + x] = 100;
+			}
+		}
+
+		size = arv_image_demosaic (demosaic_formats[i], input, 128, 16, 8, 0, ARV_DEMOSAIC_METHOD_BILINEAR,
+					   8, output, 384, 1, &error);
+		g_assert_no_error (error);
+		g_assert_cmpint (size, ==, 384);
+
+		for (j = 0; j < 128; j++) {
+			g_assert_cmpint (output[3 * j], ==, 200);
+			g_assert_cmpint (output[3 * j + 1], ==, 100);
+			g_assert_cmpint (output[3 * j + 2], ==, 50);
+		}
+	}
+
+	size = arv_image_demosaic (ARV_PIXEL_FORMAT_MONO_8, input, 128, 16, 8, 0, ARV_DEMOSAIC_METHOD_BILINEAR,
+				   8, output, 384, 1, &error);
+	g_assert_error (error, ARV_IMAGE_CONVERT_ERROR, ARV_IMAGE_CONVERT_ERROR_PIXEL_FORMAT_NOT_SUPPORTED);
+	g_assert_cmpint (size, ==, 0);
+	g_clear_error (&error);
+
+	size = arv_image_demosaic (ARV_PIXEL_FORMAT_BAYER_RG_8, input, 128, 16, 8, 0, ARV_DEMOSAIC_METHOD_BILINEAR,
+				   8, output, 383, 1, &error);
+	g_assert_error (error, ARV_IMAGE_CONVERT_ERROR, ARV_IMAGE_CONVERT_ERROR_BUFFER_TOO_SMALL);
+	g_assert_cmpint (size, ==, 0);
+	g_clear_error (&error);
+
+	/* Vectorized and multithreaded conversions must match the scalar one */
+
+	for (i = 0; i < 131072; i++)
+		input[i] = g_random_int ();
+
+	for (i = 0; i < G_N_ELEMENTS (demosaic_formats); i++) {
+		ArvPixelFormat pixel_format = demosaic_formats[i];
+		guint depth = ARV_PIXEL_FORMAT_BIT_PER_PIXEL (pixel_format);
+
+		/* Clear the unused most significant bits */
+		if (depth > 8 && depth < 16)
+			for (j = 0; j < 65536; j++)
+				((guint16 *) input)[j] &= (1 << depth) - 1;
+
+		for (j = 0; j < 8; j++) {
+			ArvDemosaicMethod method = j % 2 == 0 ? ARV_DEMOSAIC_METHOD_BILINEAR : ARV_DEMOSAIC_METHOD_EDGE_AWARE;
+			guint width = 37 + 64 * (j / 2);
+			guint height = 70;
+			guint x_padding = j / 2 % 2 == 0 ? 0 : 3;
+			guint output_bits = depth > 8 && j / 4 == 1 ? 16 : 8;
+			size_t reference_size;
+
+			arv_image_convert_set_implementation (ARV_IMAGE_CONVERT_IMPLEMENTATION_SCALAR);
+			reference_size = arv_image_demosaic (pixel_format, input, 131072, width, height, x_padding,
+							     method, output_bits, reference, 393216, 1, &error);
+			g_assert_no_error (error);
+			g_assert_cmpint (reference_size, ==, (size_t) width * height * 3 * output_bits / 8);
+
+			for (k = ARV_IMAGE_CONVERT_IMPLEMENTATION_SCALAR;
+			     k < ARV_IMAGE_CONVERT_IMPLEMENTATION_N_ELEMENTS; k++) {
+				if (!arv_image_convert_set_implementation (k))
+					continue;
+
+				memset (output, 0, reference_size);
+				size = arv_image_demosaic (pixel_format, input, 131072, width, height, x_padding,
+							   method, output_bits, output, 393216, 3, &error);
+				g_assert_no_error (error);
+				g_assert_cmpint (size, ==, reference_size);
+				g_assert (memcmp (output, reference, size) == 0);
+			}
+		}
+	}
+
+	arv_image_convert_set_implementation (ARV_IMAGE_CONVERT_IMPLEMENTATION_AUTO);
+
+	g_free (input);
+	g_free (reference);
+	g_free (output);
+}
+
+#define N_QUEUE_TRANSFERS	100000
+
+typedef struct {
+	ArvBufferQueue *input;
+	ArvBufferQueue *output;
+} QueueThreadData;
+
+static void *
+queue_thread (void *user_data)
+{
+	QueueThreadData *data = user_data;
+	unsigned i;
+
+	for (i = 0; i < N_QUEUE_TRANSFERS; i++)
+		arv_buffer_queue_push (data->output, arv_buffer_queue_pop (data->input));
+
+	return NULL;
+}
+
+static void
+queue_thread_test (void)
+{
+	QueueThreadData data;
+	GThread *threads[2];
+	unsigned i;
+
+	data.input = arv_buffer_queue_new ();
+	data.output = arv_buffer_queue_new ();
+
+	arv_buffer_queue_reserve (data.input, 4);
+	arv_buffer_queue_reserve (data.output, 4);
+
+	for (i = 0; i < 4; i++)
+		arv_buffer_queue_push (data.input, arv_buffer_new (16, NULL));
+
+	threads[0] = g_thread_new ("queue-test-0", queue_thread, &data);
+	threads[1] = g_thread_new ("queue-test-1", queue_thread, &data);
+
+	for (i = 0; i < 2 * N_QUEUE_TRANSFERS; i++) {
+		ArvBuffer *buffer;
+
+		buffer = arv_buffer_queue_timeout_pop (data.output, 1000000);
+		g_assert (ARV_IS_BUFFER (buffer));
+		arv_buffer_queue_push (data.input, buffer);
+	}
+
+	g_thread_join (threads[0]);
+	g_thread_join (threads[1]);
+
+	g_assert_cmpint (arv_buffer_queue_get_length (data.input), ==, 4);
+	g_assert_cmpint (arv_buffer_queue_get_length (data.output), ==, 0);
+
+	for (i = 0; i < 4; i++)
+		g_object_unref (arv_buffer_queue_pop (data.input));
+
+	arv_buffer_queue_free (data.input);
+	arv_buffer_queue_free (data.output);
+}
+
 int
 main (int argc, char *argv[])
 {
@@ -127,6 +588,12 @@ main (int argc, char *argv[])
 	g_test_add_func ("/buffer/full-buffer", full_buffer_test);
 	g_test_add_func ("/buffer/timestamp", timestamp);
 	g_test_add_func ("/buffer/allocate", allocate);
+	g_test_add_func ("/buffer/queue", queue_test);
+	g_test_add_func ("/buffer/queue-batch", queue_batch_test);
+	g_test_add_func ("/buffer/pool", pool_test);
+	g_test_add_func ("/buffer/unpack", unpack_test);
+	g_test_add_func ("/buffer/demosaic", demosaic_test);
+	g_test_add_func ("/buffer/queue-threads", queue_thread_test);
 
 	result = g_test_run();
 
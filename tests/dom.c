@@ -1,6 +1,8 @@
 /* SPDX-License-Identifier:Unlicense */
 
 #include <arv.h>
+#include <arvdomparserprivate.h>
+#include <string.h>
 
 static void
 child_list_test (void)
@@ -34,6 +36,75 @@ child_list_test (void)
         g_object_unref (device);
 }
 
+static void
+_compare_trees (ArvDomNode *a, ArvDomNode *b)
+{
+	ArvDomNode *a_child;
+	ArvDomNode *b_child;
+
+	g_assert (G_OBJECT_TYPE (a) == G_OBJECT_TYPE (b));
+	g_assert_cmpstr (arv_dom_node_get_node_name (a), ==, arv_dom_node_get_node_name (b));
+	if (ARV_IS_DOM_TEXT (a))
+		g_assert_cmpstr (arv_dom_node_get_node_value (a), ==, arv_dom_node_get_node_value (b));
+
+	for (a_child = arv_dom_node_get_first_child (a), b_child = arv_dom_node_get_first_child (b);
+	     a_child != NULL && b_child != NULL;
+	     a_child = arv_dom_node_get_next_sibling (a_child), b_child = arv_dom_node_get_next_sibling (b_child))
+		_compare_trees (a_child, b_child);
+
+	g_assert (a_child == NULL && b_child == NULL);
+}
+
+static void
+recording_test (void)
+{
+	ArvDomDocument *document;
+	ArvDomDocument *replayed;
+	GBytes *recording = NULL;
+	GError *error = NULL;
+	char *xml;
+	gsize size;
+	gsize recording_size;
+	const guint8 *data;
+
+	g_assert (g_file_get_contents (GENICAM_FILENAME, &xml, &size, NULL));
+
+	document = arv_dom_document_new_from_memory_recorded (xml, size, &recording, &error);
+	g_assert (ARV_IS_GC (document));
+	g_assert (error == NULL);
+	g_assert (recording != NULL);
+
+	data = g_bytes_get_data (recording, &recording_size);
+
+	replayed = arv_dom_document_new_from_recording (data, recording_size, &error);
+	g_assert (ARV_IS_GC (replayed));
+	g_assert (error == NULL);
+
+	_compare_trees (ARV_DOM_NODE (document), ARV_DOM_NODE (replayed));
+
+	g_assert (ARV_IS_GC_FEATURE_NODE (arv_gc_get_node (ARV_GC (replayed), "RWFloat")));
+
+	g_object_unref (replayed);
+
+	/* Truncated recording */
+	replayed = arv_dom_document_new_from_recording (data, recording_size - 4, &error);
+	g_assert (replayed == NULL);
+	g_assert (error != NULL);
+	g_clear_error (&error);
+
+	g_bytes_unref (recording);
+
+	/* Invalid xml */
+	replayed = arv_dom_document_new_from_memory_recorded ("<RegisterDescription>", -1, &recording, &error);
+	g_assert (replayed == NULL);
+	g_assert (recording == NULL);
+	g_assert (error != NULL);
+	g_clear_error (&error);
+
+	g_object_unref (document);
+	g_free (xml);
+}
+
 int
 main (int argc, char *argv[])
 {
@@ -44,6 +115,7 @@ main (int argc, char *argv[])
 	arv_set_fake_camera_genicam_filename (GENICAM_FILENAME);
 
 	g_test_add_func ("/dom/child-list", child_list_test);
+	g_test_add_func ("/dom/recording", recording_test);
 
 	result = g_test_run();
 
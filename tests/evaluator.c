@@ -3,6 +3,7 @@
 #include <glib.h>
 #include <arv.h>
 #include <math.h>
+#include "../src/arvevaluatorprivate.h"
 
 typedef struct {
 	const char *test_name;
@@ -103,6 +104,11 @@ static const ExpressionTestData expression_test_data[] = {
 
 	{"/evaluator/bugs/681048-remaining-op",		"(0 & 1)=0?((0 & 1)+2):1",		2,	FALSE,	2.0},
 	{"/evaluator/bugs/743025-division-by-zero",	"(4/(20/10000))",			2000,	TRUE,	2000.0},
+	{"/evaluator/folding/mixed-types",		"(1+2)*2.5+10/4",		8,	FALSE,	10.0},
+	{"/evaluator/folding/ternary",			"(2>1?3:4)*(1=0?5:6)",		18,	FALSE,	18.0},
+	{"/evaluator/folding/round",			"ROUND(1.25*2,1)+1",		0,	TRUE,	3.5},
+	{"/evaluator/folding/constant-function",	"SQRT(16)+PI-PI",		0,	TRUE,	4.0},
+
 	{"/evaluator/bugs/gh98-not-operatorprecedence",	"(~(~0xC2000221|0xFEFFFFFF)) ? 2:0", 	0, 	FALSE,	0.0},
 };
 
@@ -198,6 +204,83 @@ set_int64_variable_test (void)
 	g_object_unref (evaluator);
 }
 
+static void
+variable_slot_test (void)
+{
+	ArvEvaluator *evaluator;
+	GError *error = NULL;
+	gint64 v_int64;
+	double v_double;
+	guint slot_a;
+	guint slot_b;
+
+	evaluator = arv_evaluator_new ("(2 * 8 + 4) * SLOT_A + SLOT_B / (4 - 2)");
+
+	slot_a = arv_evaluator_get_variable_slot (evaluator, "SLOT_A");
+	slot_b = arv_evaluator_get_variable_slot (evaluator, "SLOT_B");
+	g_assert_cmpint (slot_a, !=, slot_b);
+	g_assert_cmpint (arv_evaluator_get_variable_slot (evaluator, "SLOT_A"), ==, slot_a);
+
+	/* Variables referenced by the expression, but not set yet */
+	arv_evaluator_evaluate_as_int64 (evaluator, &error);
+	g_assert (error != NULL);
+	g_clear_error (&error);
+
+	arv_evaluator_set_int64_variable_by_slot (evaluator, slot_a, 3);
+	arv_evaluator_set_double_variable_by_slot (evaluator, slot_b, 5.0);
+	v_int64 = arv_evaluator_evaluate_as_int64 (evaluator, &error);
+	g_assert (error == NULL);
+	g_assert_cmpint (v_int64, ==, 62);
+
+	arv_evaluator_set_double_variable_by_slot (evaluator, slot_b, 1.0);
+	v_double = arv_evaluator_evaluate_as_double (evaluator, &error);
+	g_assert (error == NULL);
+	g_assert_cmpfloat (v_double, ==, 60.5);
+
+	/* Slots are independent of the expression */
+	arv_evaluator_set_expression (evaluator, "SLOT_B - SLOT_A");
+	v_double = arv_evaluator_evaluate_as_double (evaluator, &error);
+	g_assert (error == NULL);
+	g_assert_cmpfloat (v_double, ==, -2.0);
+
+	arv_evaluator_set_int64_variable (evaluator, "SLOT_A", 10);
+	v_int64 = arv_evaluator_evaluate_as_int64 (evaluator, &error);
+	g_assert (error == NULL);
+	g_assert_cmpint (v_int64, ==, -9);
+
+	g_object_unref (evaluator);
+}
+
+static void
+folding_error_test (void)
+{
+	ArvEvaluator *evaluator;
+	GError *error = NULL;
+
+	/* Errors of constant sub-expressions are reported at evaluation time */
+	evaluator = arv_evaluator_new ("X + 1 / (2 - 2)");
+	arv_evaluator_set_double_variable (evaluator, "X", 1.0);
+
+	arv_evaluator_evaluate_as_double (evaluator, &error);
+	g_assert (error != NULL);
+	g_clear_error (&error);
+
+	arv_evaluator_evaluate_as_int64 (evaluator, &error);
+	g_assert (error != NULL);
+	g_clear_error (&error);
+
+	arv_evaluator_set_expression (evaluator, "X = 0 ? 1 / (2 - 2) : 3");
+	arv_evaluator_evaluate_as_double (evaluator, &error);
+	g_assert (error != NULL);
+	g_clear_error (&error);
+
+	arv_evaluator_set_expression (evaluator, "X + ~0x7fffffffffffffff / -1");
+	arv_evaluator_evaluate_as_int64 (evaluator, &error);
+	g_assert (error == NULL);
+
+	g_object_unref (evaluator);
+}
+
 static void
 sub_expression_test (void)
 {
@@ -346,6 +429,8 @@ main (int argc, char *argv[])
 	g_test_add_func ("/evaluator/set-get-expression", set_get_expression_test);
 	g_test_add_func ("/evaluator/double-variable", set_double_variable_test);
 	g_test_add_func ("/evaluator/int64-variable", set_int64_variable_test);
+	g_test_add_func ("/evaluator/variable-slot", variable_slot_test);
+	g_test_add_func ("/evaluator/folding-error", folding_error_test);
 	g_test_add_func ("/evaluator/sub-expression", sub_expression_test);
 	g_test_add_func ("/evaluator/constant", constant_test);
 	g_test_add_func ("/evaluator/empty", empty_test);
@@ -181,6 +181,40 @@ registers_test (void)
 	g_object_unref (device);
 }
 
+static void
+batched_registers_test (void)
+{
+	ArvDevice *device;
+	GError *error = NULL;
+	guint64 addresses[3] = {ARV_FAKE_CAMERA_REGISTER_TEST, ARV_FAKE_CAMERA_REGISTER_GAIN_RAW,
+				ARV_FAKE_CAMERA_REGISTER_TEST};
+	guint32 values[3] = {0x12345678, 5, 0x87654321};
+	guint32 read_values[3];
+	guint32 value;
+
+	device = arv_fake_device_new ("TEST0", &error);
+	g_assert (ARV_IS_FAKE_DEVICE (device));
+	g_assert (error == NULL);
+
+	/* Devices without a batch implementation fall back on single register accesses */
+	arv_device_write_registers (device, 3, addresses, values, &error);
+	g_assert (error == NULL);
+
+	arv_device_read_register (device, ARV_FAKE_CAMERA_REGISTER_TEST, &value, &error);
+	g_assert (error == NULL);
+	g_assert_cmpuint (value, ==, 0x87654321);
+
+	arv_device_read_registers (device, 3, addresses, read_values, &error);
+	g_assert (error == NULL);
+	g_assert_cmpuint (read_values[0], ==, 0x87654321);
+	g_assert_cmpuint (read_values[1], ==, 5);
+	g_assert_cmpuint (read_values[2], ==, 0x87654321);
+
+	g_assert (arv_device_read_registers (device, 0, NULL, NULL, &error));
+
+	g_object_unref (device);
+}
+
 static void
 fake_device_test (void)
 {
@@ -378,8 +412,9 @@ fake_stream_test (void)
 	g_assert_cmpint (n_output_buffers, ==, 0);
         g_assert_cmpint (n_buffer_filling, == , 0);
 
+        /* 5 fake stream infos, then 4 statistics for each of the 4 latency histograms */
         n_infos = arv_stream_get_n_infos (stream);
-        g_assert_cmpint (n_infos, ==, 5);
+        g_assert_cmpint (n_infos, ==, 21);
 
         info_name = arv_stream_get_info_name (stream, 0);
         g_assert_cmpstr (info_name, ==, "n_completed_buffers");
@@ -408,11 +443,251 @@ fake_stream_test (void)
         g_assert_cmpint (n_underruns, ==, arv_stream_get_info_uint64_by_name (stream, "n_underruns"));
         g_assert_cmpint (n_underruns, ==, arv_stream_get_info_uint64 (stream, 2));
 
+        g_assert_cmpint (arv_stream_get_info_uint64_by_name (stream, "completion_latency_count"), ==, 1);
+        g_assert_cmpint (arv_stream_get_info_uint64_by_name (stream, "output_latency_count"), ==, 1);
+        g_assert_cmpint (arv_stream_get_info_uint64_by_name (stream, "resend_rtt_count"), ==, 0);
+        g_assert_cmpint (arv_stream_get_info_uint64_by_name (stream, "resend_rtt_p99"), ==, 0);
+        g_assert_cmpint (arv_stream_get_info_uint64_by_name (stream, "output_latency_p50"), <=,
+                         arv_stream_get_info_uint64_by_name (stream, "output_latency_p999"));
+
 	g_clear_object (&buffer);
 	g_clear_object (&stream);
 	g_clear_object (&camera);
 }
 
+static void
+fake_stream_fd_test (void)
+{
+	ArvCamera *camera;
+	ArvStream *stream;
+	ArvBuffer *buffer;
+	GError *error = NULL;
+	GPollFD poll_fd;
+	gint payload;
+	int fd;
+
+	camera = arv_camera_new ("Fake_1", &error);
+	g_assert (ARV_IS_CAMERA (camera));
+	g_assert (error == NULL);
+
+	stream = arv_camera_create_stream (camera, NULL, NULL, NULL, &error);
+	g_assert (ARV_IS_STREAM (stream));
+	g_assert (error == NULL);
+
+	fd = arv_stream_get_fd (stream);
+#ifdef G_OS_WIN32
+	g_assert_cmpint (fd, ==, -1);
+#else
+	g_assert_cmpint (fd, >=, 0);
+	g_assert_cmpint (arv_stream_get_fd (stream), ==, fd);
+
+	poll_fd.fd = fd;
+	poll_fd.events = G_IO_IN;
+	poll_fd.revents = 0;
+
+	g_assert_cmpint (g_poll (&poll_fd, 1, 0), ==, 0);
+
+	payload = arv_camera_get_payload (camera, NULL);
+	arv_stream_push_buffer (stream,  arv_buffer_new (payload, NULL));
+	arv_camera_set_acquisition_mode (camera, ARV_ACQUISITION_MODE_SINGLE_FRAME, NULL);
+	arv_camera_start_acquisition (camera, NULL);
+
+	g_assert_cmpint (g_poll (&poll_fd, 1, 5000), ==, 1);
+	g_assert (poll_fd.revents & G_IO_IN);
+
+	/* Level triggered, readable until the output queue is emptied */
+	g_assert_cmpint (g_poll (&poll_fd, 1, 0), ==, 1);
+
+	buffer = arv_stream_try_pop_buffer (stream);
+	g_assert (ARV_IS_BUFFER (buffer));
+
+	arv_camera_stop_acquisition (camera, NULL);
+
+	g_assert_cmpint (g_poll (&poll_fd, 1, 0), ==, 0);
+	g_assert (arv_stream_try_pop_buffer (stream) == NULL);
+
+	g_clear_object (&buffer);
+#endif
+
+	g_clear_object (&stream);
+	g_clear_object (&camera);
+}
+
+#define N_BATCH_BUFFERS	4
+
+static void
+fake_stream_batch_test (void)
+{
+	ArvCamera *camera;
+	ArvStream *stream;
+	ArvBuffer *buffers[N_BATCH_BUFFERS];
+	GError *error = NULL;
+	gint n_input_buffers;
+	gint n_output_buffers;
+	gint payload;
+	guint n_popped;
+	int i;
+
+	camera = arv_camera_new ("Fake_1", &error);
+	g_assert (ARV_IS_CAMERA (camera));
+	g_assert (error == NULL);
+
+	stream = arv_camera_create_stream (camera, NULL, NULL, NULL, &error);
+	g_assert (ARV_IS_STREAM (stream));
+	g_assert (error == NULL);
+
+	g_assert_cmpint (arv_stream_pop_buffers (stream, buffers, N_BATCH_BUFFERS, 0), ==, 0);
+
+	payload = arv_camera_get_payload (camera, NULL);
+	for (i = 0; i < N_BATCH_BUFFERS; i++)
+		buffers[i] = arv_buffer_new (payload, NULL);
+	arv_stream_push_buffers (stream, buffers, N_BATCH_BUFFERS);
+
+	arv_stream_get_n_owned_buffers (stream, &n_input_buffers, NULL, NULL);
+	g_assert_cmpint (n_input_buffers, ==, N_BATCH_BUFFERS);
+
+	arv_camera_set_frame_rate (camera, 100.0, NULL);
+	arv_camera_set_acquisition_mode (camera, ARV_ACQUISITION_MODE_CONTINUOUS, NULL);
+	arv_camera_start_acquisition (camera, NULL);
+
+	for (n_popped = 0; n_popped < N_BATCH_BUFFERS; ) {
+		guint n_buffers;
+
+		n_buffers = arv_stream_pop_buffers (stream, buffers + n_popped, N_BATCH_BUFFERS - n_popped, 1000000);
+		g_assert_cmpint (n_buffers, >, 0);
+		n_popped += n_buffers;
+	}
+
+	arv_camera_stop_acquisition (camera, NULL);
+
+	for (i = 0; i < N_BATCH_BUFFERS; i++) {
+		g_assert (ARV_IS_BUFFER (buffers[i]));
+		g_assert_cmpint (arv_buffer_get_status (buffers[i]), ==, ARV_BUFFER_STATUS_SUCCESS);
+		if (i > 0)
+			g_assert_cmpint (arv_buffer_get_frame_id (buffers[i]), >, arv_buffer_get_frame_id (buffers[i - 1]));
+	}
+
+	arv_stream_get_n_owned_buffers (stream, &n_input_buffers, &n_output_buffers, NULL);
+	g_assert_cmpint (n_input_buffers, ==, 0);
+	g_assert_cmpint (n_output_buffers, ==, 0);
+
+	for (i = 0; i < N_BATCH_BUFFERS; i++)
+		g_clear_object (&buffers[i]);
+
+	g_clear_object (&stream);
+	g_clear_object (&camera);
+}
+
+#define N_PROCESSING_BUFFERS	10
+
+typedef struct {
+	gint n_processed;
+	gint n_destroyed;
+	gint n_done;
+	guint64 last_done_frame_id;
+} ProcessingData;
+
+static void
+processing_stage (ArvBuffer *buffer, void *user_data)
+{
+	ProcessingData *data = user_data;
+
+	/* Shuffles the completion order of the processing threads */
+	g_usleep (g_random_int_range (0, 20000));
+
+	g_object_set_data (G_OBJECT (buffer), "processed", GINT_TO_POINTER (TRUE));
+	g_atomic_int_inc (&data->n_processed);
+}
+
+static void
+processing_stream_callback (void *user_data, ArvStreamCallbackType type, ArvBuffer *buffer)
+{
+	ProcessingData *data = user_data;
+
+	if (type != ARV_STREAM_CALLBACK_TYPE_BUFFER_DONE)
+		return;
+
+	/* The buffer done callback is called after the processing stages, in the frame order */
+	g_assert (g_object_get_data (G_OBJECT (buffer), "processed") == GINT_TO_POINTER (TRUE));
+	g_object_set_data (G_OBJECT (buffer), "processed", GINT_TO_POINTER (FALSE));
+
+	if (arv_buffer_get_status (buffer) == ARV_BUFFER_STATUS_SUCCESS) {
+		g_assert_cmpint (arv_buffer_get_frame_id (buffer), >, data->last_done_frame_id);
+		data->last_done_frame_id = arv_buffer_get_frame_id (buffer);
+	}
+
+	data->n_done++;
+}
+
+static void
+processing_stage_destroy (void *user_data)
+{
+	ProcessingData *data = user_data;
+
+	data->n_destroyed++;
+}
+
+static void
+fake_stream_processing_test (void)
+{
+	ArvCamera *camera;
+	ArvStream *stream;
+	ArvBuffer *buffers[N_PROCESSING_BUFFERS];
+	ProcessingData data = {0, 0, 0, 0};
+	GError *error = NULL;
+	gint n_buffer_filling;
+	gint payload;
+	guint n_threads;
+	int i;
+
+	camera = arv_camera_new ("Fake_1", &error);
+	g_assert (ARV_IS_CAMERA (camera));
+	g_assert (error == NULL);
+
+	stream = arv_camera_create_stream (camera, processing_stream_callback, &data, NULL, &error);
+	g_assert (ARV_IS_STREAM (stream));
+	g_assert (error == NULL);
+
+	g_object_set (stream, "n-processing-threads", 4, NULL);
+	g_object_get (stream, "n-processing-threads", &n_threads, NULL);
+	g_assert_cmpint (n_threads, ==, 4);
+
+	arv_stream_add_processing_stage (stream, processing_stage, &data, processing_stage_destroy);
+
+	payload = arv_camera_get_payload (camera, NULL);
+	for (i = 0; i < N_PROCESSING_BUFFERS; i++)
+		arv_stream_push_buffer (stream, arv_buffer_new (payload, NULL));
+
+	arv_camera_set_frame_rate (camera, 500.0, NULL);
+	arv_camera_set_acquisition_mode (camera, ARV_ACQUISITION_MODE_CONTINUOUS, NULL);
+	arv_camera_start_acquisition (camera, NULL);
+
+	for (i = 0; i < N_PROCESSING_BUFFERS; i++) {
+		buffers[i] = arv_stream_timeout_pop_buffer (stream, 1000000);
+		g_assert (ARV_IS_BUFFER (buffers[i]));
+	}
+
+	arv_camera_stop_acquisition (camera, NULL);
+
+	/* The buffers are processed before reaching the output queue, in their reception order */
+	g_assert_cmpint (g_atomic_int_get (&data.n_processed), >=, N_PROCESSING_BUFFERS);
+	for (i = 1; i < N_PROCESSING_BUFFERS; i++)
+		g_assert_cmpint (arv_buffer_get_frame_id (buffers[i]), >, arv_buffer_get_frame_id (buffers[i - 1]));
+
+	arv_stream_get_n_owned_buffers (stream, NULL, NULL, &n_buffer_filling);
+	g_assert_cmpint (n_buffer_filling, ==, 0);
+
+	for (i = 0; i < N_PROCESSING_BUFFERS; i++)
+		g_clear_object (&buffers[i]);
+
+	g_clear_object (&stream);
+	g_clear_object (&camera);
+
+	/* The stream destruction waits for the processing threads */
+	g_assert_cmpint (data.n_done, >=, N_PROCESSING_BUFFERS);
+	g_assert_cmpint (data.n_destroyed, ==, 1);
+}
+
 static void
 camera_api_test (void)
 {
@@ -748,9 +1023,13 @@ main (int argc, char *argv[])
 	g_test_add_func ("/fake/discovery-test", discovery_test);
 	g_test_add_func ("/fake/trigger-registers", trigger_registers_test);
 	g_test_add_func ("/fake/registers", registers_test);
+	g_test_add_func ("/fake/batched-registers", batched_registers_test);
 	g_test_add_func ("/fake/fake-device", fake_device_test);
 	g_test_add_func ("/fake/fake-device-error", fake_device_error_test);
 	g_test_add_func ("/fake/fake-stream", fake_stream_test);
+	g_test_add_func ("/fake/fake-stream-fd", fake_stream_fd_test);
+	g_test_add_func ("/fake/fake-stream-batch", fake_stream_batch_test);
+	g_test_add_func ("/fake/fake-stream-processing", fake_stream_processing_test);
 	g_test_add_func ("/fake/camera-api", camera_api_test);
 	g_test_add_func ("/fake/camera-device", camera_device_test);
 	g_test_add_func ("/fake/camera-trigger-selector", camera_trigger_selector_test);
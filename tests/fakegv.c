@@ -2,7 +2,9 @@
 
 #include <glib.h>
 #include <arv.h>
+#include <string.h>
 
+static ArvGvFakeCamera *simulator = NULL;
 static ArvCamera *camera = NULL;
 
 static void
@@ -206,6 +208,645 @@ stream_test (void)
 	g_usleep (2000000);
 }
 
+/* Payload pattern depending on the frame id, which lets the receiver check the placement of every packet */
+
+static void
+payload_pattern_cb (ArvBuffer *buffer, void *fill_pattern_data, guint32 exposure_time_us, guint32 gain,
+		    ArvPixelFormat pixel_format)
+{
+	guint8 *data;
+	guint64 frame_id;
+	size_t size;
+	size_t i;
+
+	/* The received size is only set by the fill pattern callback */
+	data = (guint8 *) arv_buffer_get_data (buffer, NULL);
+	frame_id = arv_buffer_get_frame_id (buffer);
+	size = (size_t) arv_buffer_get_image_width (buffer) * arv_buffer_get_image_height (buffer) *
+		ARV_PIXEL_FORMAT_BIT_PER_PIXEL (pixel_format) / 8;
+
+	for (i = 0; i < size; i++)
+		data[i] = (i * 7 + frame_id) & 0xff;
+}
+
+static void
+check_payload_pattern (ArvBuffer *buffer)
+{
+	const guint8 *data;
+	guint64 frame_id;
+	size_t size;
+	size_t i;
+
+	data = arv_buffer_get_data (buffer, &size);
+	frame_id = arv_buffer_get_frame_id (buffer);
+
+	g_assert_cmpint (size, >, 0);
+
+	for (i = 0; i < size; i++)
+		if (data[i] != ((i * 7 + frame_id) & 0xff))
+			g_error ("Frame %" G_GUINT64_FORMAT ": unexpected byte 0x%02x at offset %" G_GSIZE_FORMAT,
+				 frame_id, data[i], i);
+}
+
+static void
+zero_copy_test (void)
+{
+	ArvGvStreamOption options[] = { ARV_GV_STREAM_OPTION_NONE, ARV_GV_STREAM_OPTION_ZERO_COPY_ENABLED };
+	ArvFakeCamera *fake_camera;
+	ArvStream *stream;
+	ArvBuffer *buffer;
+	GError *error = NULL;
+	guint64 n_completed_buffers;
+	unsigned i, j;
+
+	fake_camera = arv_gv_fake_camera_get_fake_camera (simulator);
+	arv_fake_camera_set_fill_pattern (fake_camera, payload_pattern_cb, NULL, NULL);
+
+	/* The payload received with the standard copy is the reference for the zero copy receive */
+	for (j = 0; j < G_N_ELEMENTS (options); j++) {
+		arv_camera_gv_set_stream_options (camera, options[j]);
+
+		stream = arv_camera_create_stream (camera, NULL, NULL, NULL, &error);
+		g_assert (ARV_IS_STREAM (stream));
+		g_assert (error == NULL);
+
+		arv_stream_create_buffers (stream, 5, NULL, NULL, &error);
+		g_assert (error == NULL);
+
+		arv_camera_start_acquisition (camera, NULL);
+
+		for (i = 0; i < 10; i++) {
+			buffer = arv_stream_timeout_pop_buffer (stream, 2000000);
+			g_assert (ARV_IS_BUFFER (buffer));
+			if (arv_buffer_get_status (buffer) == ARV_BUFFER_STATUS_SUCCESS)
+				check_payload_pattern (buffer);
+			arv_stream_push_buffer (stream, buffer);
+		}
+
+		arv_camera_stop_acquisition (camera, NULL);
+
+		n_completed_buffers = arv_stream_get_info_uint64_by_name (stream, "n_completed_buffers");
+		g_assert_cmpint (n_completed_buffers, >, 0);
+		if (options[j] == ARV_GV_STREAM_OPTION_ZERO_COPY_ENABLED)
+			g_assert_cmpint (arv_stream_get_info_uint64_by_name (stream, "n_zero_copy_bytes"), >, 0);
+
+		g_clear_object (&stream);
+	}
+
+	arv_fake_camera_set_fill_pattern (fake_camera, NULL, NULL, NULL);
+
+	arv_camera_gv_set_stream_options (camera, ARV_GV_STREAM_OPTION_NONE);
+}
+
+static void
+xdp_fallback_test (void)
+{
+	ArvStream *stream;
+	ArvBuffer *buffer;
+	GError *error = NULL;
+	unsigned i;
+
+	arv_camera_gv_set_stream_options (camera, ARV_GV_STREAM_OPTION_XDP_ENABLED);
+
+	stream = arv_camera_create_stream (camera, NULL, NULL, NULL, &error);
+	g_assert (ARV_IS_STREAM (stream));
+	g_assert (error == NULL);
+
+	/* The loopback interface has a single receive queue, the AF_XDP socket bind always fails */
+	g_object_set (stream, "xdp-queue", 63, NULL);
+
+	arv_stream_create_buffers (stream, 5, NULL, NULL, &error);
+	g_assert (error == NULL);
+
+	arv_camera_start_acquisition (camera, NULL);
+
+	for (i = 0; i < 10; i++) {
+		buffer = arv_stream_timeout_pop_buffer (stream, 2000000);
+		g_assert (ARV_IS_BUFFER (buffer));
+		arv_stream_push_buffer (stream, buffer);
+	}
+
+	arv_camera_stop_acquisition (camera, NULL);
+
+	g_assert_cmpint (arv_stream_get_info_uint64_by_name (stream, "n_xdp_fallbacks"), >, 0);
+	g_assert_cmpint (arv_stream_get_info_uint64_by_name (stream, "n_completed_buffers"), >, 0);
+
+	g_clear_object (&stream);
+
+	arv_camera_gv_set_stream_options (camera, ARV_GV_STREAM_OPTION_NONE);
+}
+
+static void
+packet_resend_test (void)
+{
+	ArvStream *stream;
+	ArvBuffer *buffer;
+	GError *error = NULL;
+	guint64 n_resend_requests;
+	guint64 n_resend_commands;
+	unsigned i;
+
+	/* Bursts of 8 lost data packets */
+	g_object_set (simulator, "gvsp-lost-ratio", 0.01, "gvsp-lost-burst-length", 8, NULL);
+
+	stream = arv_camera_create_stream (camera, NULL, NULL, NULL, &error);
+	g_assert (ARV_IS_STREAM (stream));
+	g_assert (error == NULL);
+
+	g_object_set (stream, "packet-resend", ARV_GV_STREAM_PACKET_RESEND_ALWAYS, NULL);
+
+	arv_stream_create_buffers (stream, 5, NULL, NULL, &error);
+	g_assert (error == NULL);
+
+	arv_camera_start_acquisition (camera, NULL);
+
+	for (i = 0; i < 10; i++) {
+		buffer = arv_stream_timeout_pop_buffer (stream, 2000000);
+		g_assert (ARV_IS_BUFFER (buffer));
+		arv_stream_push_buffer (stream, buffer);
+	}
+
+	arv_camera_stop_acquisition (camera, NULL);
+
+	n_resend_requests = arv_stream_get_info_uint64_by_name (stream, "n_resend_requests");
+	n_resend_commands = arv_stream_get_info_uint64_by_name (stream, "n_resend_commands");
+	g_assert_cmpint (n_resend_requests, >, 0);
+
+	/* The consecutive missing packets are requested by a single command */
+	g_assert_cmpint (n_resend_commands, >, 0);
+	g_assert_cmpint (n_resend_commands, <, n_resend_requests);
+
+	g_clear_object (&stream);
+
+	g_object_set (simulator, "gvsp-lost-ratio", 0.0, "gvsp-lost-burst-length", 1, NULL);
+}
+
+static void
+gvcp_pipelining_test (void)
+{
+	ArvDevice *device;
+	ArvFakeCamera *fake_camera;
+	GError *error = NULL;
+	const char *genicam;
+	size_t genicam_size;
+	char *data;
+	char *reference;
+	size_t size;
+	guint window;
+	int i;
+
+	device = arv_camera_get_device (camera);
+	g_assert (ARV_IS_GV_DEVICE (device));
+
+	g_object_get (device, "gvcp-window", &window, NULL);
+	g_assert_cmpuint (window, >, 1);
+
+	fake_camera = arv_gv_fake_camera_get_fake_camera (simulator);
+	genicam = arv_fake_camera_get_genicam_xml (fake_camera, &genicam_size);
+	g_assert (genicam != NULL);
+
+	size = 0x10000 + genicam_size - 1;
+	data = g_malloc0 (size);
+	reference = g_malloc (size);
+
+	/* Several commands in flight */
+	arv_device_read_memory (device, 0x10000, genicam_size - 1, data, &error);
+	g_assert (error == NULL);
+	g_assert (memcmp (data, genicam, genicam_size - 1) == 0);
+
+	for (i = 0; i < 0x8000; i++)
+		reference[i] = i * 7;
+	arv_device_write_memory (device, 0x8000, 0x8000, reference, &error);
+	g_assert (error == NULL);
+
+	/* Several segments */
+	arv_device_read_memory (device, 0, size, data, &error);
+	g_assert (error == NULL);
+	g_assert (memcmp (data + 0x8000, reference, 0x8000) == 0);
+	arv_fake_camera_read_memory (fake_camera, 0, size, reference);
+	g_assert (memcmp (data, reference, size) == 0);
+
+	/* With a simulated round trip time, acknowledges arrive while commands are still sent */
+	g_object_set (simulator, "gvcp-latency", 2000, NULL);
+	memset (data, 0, size);
+	arv_device_read_memory (device, 0x10000, genicam_size - 1, data, &error);
+	g_assert (error == NULL);
+	g_assert (memcmp (data, genicam, genicam_size - 1) == 0);
+	g_object_set (simulator, "gvcp-latency", 0, NULL);
+
+	g_free (data);
+	g_free (reference);
+}
+
+/* Eight memory commands of 512 bytes */
+#define GVCP_WINDOW_FALLBACK_SIZE	4096
+
+static void
+gvcp_window_fallback_test (void)
+{
+	ArvDevice *device;
+	ArvFakeCamera *fake_camera;
+	GError *error = NULL;
+	const char *genicam;
+	size_t genicam_size;
+	char data[GVCP_WINDOW_FALLBACK_SIZE];
+	char reference[GVCP_WINDOW_FALLBACK_SIZE];
+	guint i;
+
+	device = arv_camera_get_device (camera);
+	g_assert (ARV_IS_GV_DEVICE (device));
+
+	fake_camera = arv_gv_fake_camera_get_fake_camera (simulator);
+	genicam = arv_fake_camera_get_genicam_xml (fake_camera, &genicam_size);
+	g_assert (genicam != NULL);
+	g_assert_cmpuint (genicam_size, >, GVCP_WINDOW_FALLBACK_SIZE);
+
+	/* A device serving one command at a time, which drops the commands received in the meantime */
+	g_object_set (simulator, "gvcp-latency", 2000, "gvcp-n-pending-max", 1, NULL);
+
+	memset (data, 0, sizeof (data));
+	arv_device_read_memory (device, 0x10000, sizeof (data), data, &error);
+	g_assert (error == NULL);
+	g_assert (memcmp (data, genicam, sizeof (data)) == 0);
+
+	for (i = 0; i < sizeof (reference); i++)
+		reference[i] = i * 11;
+	arv_device_write_memory (device, 0x8000, sizeof (reference), reference, &error);
+	g_assert (error == NULL);
+
+	g_object_set (simulator, "gvcp-latency", 0, "gvcp-n-pending-max", 0, NULL);
+
+	arv_fake_camera_read_memory (fake_camera, 0x8000, sizeof (data), data);
+	g_assert (memcmp (data, reference, sizeof (reference)) == 0);
+}
+
+static void
+batched_registers_test (void)
+{
+	ArvDevice *device;
+	ArvFakeCamera *fake_camera;
+	GError *error = NULL;
+	guint64 addresses[200];
+	guint32 values[200];
+	guint32 read_values[200];
+	guint32 value;
+	int i;
+
+	device = arv_camera_get_device (camera);
+	g_assert (ARV_IS_GV_DEVICE (device));
+
+	fake_camera = arv_gv_fake_camera_get_fake_camera (simulator);
+
+	/* More registers than a single command can carry */
+	for (i = 0; i < G_N_ELEMENTS (addresses); i++) {
+		addresses[i] = 0x8000 + 4 * i;
+		values[i] = 0x01010101 * i;
+	}
+
+	arv_device_write_registers (device, G_N_ELEMENTS (addresses), addresses, values, &error);
+	g_assert (error == NULL);
+
+	for (i = 0; i < G_N_ELEMENTS (addresses); i++) {
+		arv_fake_camera_read_register (fake_camera, addresses[i], &value);
+		g_assert_cmpuint (value, ==, values[i]);
+	}
+
+	arv_device_read_registers (device, G_N_ELEMENTS (addresses), addresses, read_values, &error);
+	g_assert (error == NULL);
+	g_assert (memcmp (values, read_values, sizeof (values)) == 0);
+
+	/* Scattered addresses, answered in the request order */
+	addresses[0] = ARV_FAKE_CAMERA_REGISTER_TEST;
+	addresses[1] = ARV_FAKE_CAMERA_REGISTER_WIDTH;
+	addresses[2] = 0x8000;
+	addresses[3] = ARV_FAKE_CAMERA_REGISTER_HEIGHT;
+
+	arv_device_read_registers (device, 4, addresses, read_values, &error);
+	g_assert (error == NULL);
+	for (i = 0; i < 4; i++) {
+		arv_device_read_register (device, addresses[i], &value, &error);
+		g_assert (error == NULL);
+		g_assert_cmpuint (read_values[i], ==, value);
+	}
+
+	/* Writes are applied in order */
+	addresses[0] = 0x8000;
+	addresses[1] = 0x8004;
+	addresses[2] = 0x8000;
+	values[0] = 1;
+	values[1] = 2;
+	values[2] = 3;
+	arv_device_write_registers (device, 3, addresses, values, &error);
+	g_assert (error == NULL);
+	arv_fake_camera_read_register (fake_camera, 0x8000, &value);
+	g_assert_cmpuint (value, ==, 3);
+	arv_fake_camera_read_register (fake_camera, 0x8004, &value);
+	g_assert_cmpuint (value, ==, 2);
+}
+
+static void
+transaction_test (void)
+{
+	ArvDevice *device;
+	ArvFakeCamera *fake_camera;
+	ArvGc *genicam;
+	GError *error = NULL;
+	guint32 test_register;
+	guint32 width;
+	guint32 value;
+
+	device = arv_camera_get_device (camera);
+	g_assert (ARV_IS_GV_DEVICE (device));
+
+	genicam = arv_device_get_genicam (device);
+	fake_camera = arv_gv_fake_camera_get_fake_camera (simulator);
+
+	arv_fake_camera_read_register (fake_camera, ARV_FAKE_CAMERA_REGISTER_TEST, &test_register);
+	arv_fake_camera_read_register (fake_camera, ARV_FAKE_CAMERA_REGISTER_WIDTH, &width);
+
+	arv_gc_begin_transaction (genicam);
+
+	/* Two bitfields of the same register */
+	arv_device_set_integer_feature_value (device, "StructEntry_0_15", 0x1234, &error);
+	g_assert (error == NULL);
+	arv_device_set_integer_feature_value (device, "StructEntry_16_31", 0x5678, &error);
+	g_assert (error == NULL);
+	arv_device_set_integer_feature_value (device, "Width", 512, &error);
+	g_assert (error == NULL);
+
+	/* Nothing sent yet */
+	arv_fake_camera_read_register (fake_camera, ARV_FAKE_CAMERA_REGISTER_TEST, &value);
+	g_assert_cmpuint (value, ==, test_register);
+	arv_fake_camera_read_register (fake_camera, ARV_FAKE_CAMERA_REGISTER_WIDTH, &value);
+	g_assert_cmpuint (value, ==, width);
+
+	/* But the pending values are visible */
+	g_assert_cmpint (arv_device_get_integer_feature_value (device, "StructEntry_0_31", NULL), ==, 0x56781234);
+	g_assert_cmpint (arv_device_get_integer_feature_value (device, "Width", NULL), ==, 512);
+
+	g_assert (arv_gc_commit_transaction (genicam, &error));
+	g_assert (error == NULL);
+
+	arv_fake_camera_read_register (fake_camera, ARV_FAKE_CAMERA_REGISTER_TEST, &value);
+	g_assert_cmpuint (value, ==, 0x56781234);
+	arv_fake_camera_read_register (fake_camera, ARV_FAKE_CAMERA_REGISTER_WIDTH, &value);
+	g_assert_cmpuint (value, ==, 512);
+
+	/* Reading a register without pending write flushes the transaction */
+	arv_gc_begin_transaction (genicam);
+	arv_device_set_integer_feature_value (device, "Width", width, &error);
+	g_assert (error == NULL);
+	arv_device_get_integer_feature_value (device, "Height", &error);
+	g_assert (error == NULL);
+	arv_fake_camera_read_register (fake_camera, ARV_FAKE_CAMERA_REGISTER_WIDTH, &value);
+	g_assert_cmpuint (value, ==, width);
+	arv_device_set_integer_feature_value (device, "TestRegister", test_register, &error);
+	g_assert (error == NULL);
+
+	/* Nested transaction */
+	arv_gc_begin_transaction (genicam);
+	g_assert (arv_gc_commit_transaction (genicam, &error));
+	arv_fake_camera_read_register (fake_camera, ARV_FAKE_CAMERA_REGISTER_TEST, &value);
+	g_assert_cmpuint (value, ==, 0x56781234);
+
+	g_assert (arv_gc_commit_transaction (genicam, &error));
+	g_assert (error == NULL);
+	arv_fake_camera_read_register (fake_camera, ARV_FAKE_CAMERA_REGISTER_TEST, &value);
+	g_assert_cmpuint (value, ==, test_register);
+}
+
+static void
+range_checked_transaction_test (void)
+{
+	ArvDevice *device;
+	ArvFakeCamera *fake_camera;
+	ArvGc *genicam;
+	GError *error = NULL;
+	guint32 test_register;
+	guint32 width;
+	guint32 value;
+	gint64 sensor_width;
+
+	device = arv_camera_get_device (camera);
+	g_assert (ARV_IS_GV_DEVICE (device));
+
+	genicam = arv_device_get_genicam (device);
+	fake_camera = arv_gv_fake_camera_get_fake_camera (simulator);
+
+	arv_fake_camera_read_register (fake_camera, ARV_FAKE_CAMERA_REGISTER_TEST, &test_register);
+	arv_fake_camera_read_register (fake_camera, ARV_FAKE_CAMERA_REGISTER_WIDTH, &width);
+
+	sensor_width = arv_device_get_integer_feature_value (device, "SensorWidth", &error);
+	g_assert (error == NULL);
+
+	arv_device_set_range_check_policy (device, ARV_RANGE_CHECK_POLICY_ENABLE);
+
+	arv_gc_begin_transaction (genicam);
+
+	/* The pMax read of the Width validation must not flush the queued bitfield write */
+	arv_device_set_integer_feature_value (device, "StructEntry_0_15", 0x4321, &error);
+	g_assert (error == NULL);
+	arv_device_set_integer_feature_value (device, "Width", 256, &error);
+	g_assert (error == NULL);
+	arv_device_set_integer_feature_value (device, "Width", sensor_width + 1, &error);
+	g_assert_error (error, ARV_GC_ERROR, ARV_GC_ERROR_OUT_OF_RANGE);
+	g_clear_error (&error);
+	arv_device_set_integer_feature_value (device, "StructEntry_16_31", 0x6543, &error);
+	g_assert (error == NULL);
+
+	arv_fake_camera_read_register (fake_camera, ARV_FAKE_CAMERA_REGISTER_TEST, &value);
+	g_assert_cmpuint (value, ==, test_register);
+	arv_fake_camera_read_register (fake_camera, ARV_FAKE_CAMERA_REGISTER_WIDTH, &value);
+	g_assert_cmpuint (value, ==, width);
+
+	g_assert (arv_gc_commit_transaction (genicam, &error));
+	g_assert (error == NULL);
+
+	/* Everything sent at commit, without the rejected value */
+	arv_fake_camera_read_register (fake_camera, ARV_FAKE_CAMERA_REGISTER_TEST, &value);
+	g_assert_cmpuint (value, ==, 0x65434321);
+	arv_fake_camera_read_register (fake_camera, ARV_FAKE_CAMERA_REGISTER_WIDTH, &value);
+	g_assert_cmpuint (value, ==, 256);
+
+	arv_device_set_range_check_policy (device, ARV_RANGE_CHECK_POLICY_DEFAULT);
+
+	arv_device_set_integer_feature_value (device, "TestRegister", test_register, &error);
+	g_assert (error == NULL);
+	arv_device_set_integer_feature_value (device, "Width", width, &error);
+	g_assert (error == NULL);
+}
+
+/* Schema 1.1, which disables the legacy endianness mechanism of the fake camera description */
+static const char little_endian_transaction_test_xml[] =
+"<?xml version=\"1.0\" encoding=\"utf-8\"?>\n"
+"<RegisterDescription ModelName=\"Model\" VendorName=\"Vendor\" StandardNameSpace=\"None\"\n"
+"                     SchemaMajorVersion=\"1\" SchemaMinorVersion=\"1\" SchemaSubMinorVersion=\"0\"\n"
+"                     MajorVersion=\"1\" MinorVersion=\"0\" SubMinorVersion=\"0\"\n"
+"                     ProductGuid=\"0\" VersionGuid=\"0\"\n"
+"                     xmlns=\"http://www.genicam.org/GenApi/Version_1_1\">\n"
+"  <IntReg Name=\"LittleEndianA\">\n"
+"    <Address>0x8000</Address>\n"
+"    <Length>4</Length>\n"
+"    <AccessMode>RW</AccessMode>\n"
+"    <pPort>Device</pPort>\n"
+"    <Cachable>NoCache</Cachable>\n"
+"    <Sign>Unsigned</Sign>\n"
+"    <Endianess>LittleEndian</Endianess>\n"
+"  </IntReg>\n"
+"  <IntReg Name=\"LittleEndianB\">\n"
+"    <Address>0x8008</Address>\n"
+"    <Length>4</Length>\n"
+"    <AccessMode>RW</AccessMode>\n"
+"    <pPort>Device</pPort>\n"
+"    <Cachable>NoCache</Cachable>\n"
+"    <Sign>Unsigned</Sign>\n"
+"    <Endianess>LittleEndian</Endianess>\n"
+"  </IntReg>\n"
+"  <Port Name=\"Device\"/>\n"
+"</RegisterDescription>\n";
+
+static void
+little_endian_transaction_test (void)
+{
+	ArvDevice *device;
+	ArvFakeCamera *fake_camera;
+	ArvGc *genicam;
+	ArvGcNode *node_a;
+	ArvGcNode *node_b;
+	GError *error = NULL;
+	guint8 data[12];
+	guint8 reference[12] = {0x78, 0x56, 0x34, 0x12, 0x00, 0x00, 0x00, 0x00, 0xf0, 0xde, 0xbc, 0x9a};
+
+	device = arv_camera_get_device (camera);
+	g_assert (ARV_IS_GV_DEVICE (device));
+
+	fake_camera = arv_gv_fake_camera_get_fake_camera (simulator);
+
+	genicam = arv_gc_new (device, little_endian_transaction_test_xml, strlen (little_endian_transaction_test_xml));
+	g_assert (ARV_IS_GC (genicam));
+
+	node_a = arv_gc_get_node (genicam, "LittleEndianA");
+	node_b = arv_gc_get_node (genicam, "LittleEndianB");
+	g_assert (ARV_IS_GC_INTEGER (node_a));
+	g_assert (ARV_IS_GC_INTEGER (node_b));
+
+	memset (data, 0, sizeof (data));
+	arv_fake_camera_write_memory (fake_camera, 0x8000, sizeof (data), data);
+
+	arv_gc_begin_transaction (genicam);
+
+	arv_gc_integer_set_value (ARV_GC_INTEGER (node_a), 0x12345678, &error);
+	g_assert (error == NULL);
+	arv_gc_integer_set_value (ARV_GC_INTEGER (node_b), 0x9abcdef0, &error);
+	g_assert (error == NULL);
+
+	g_assert (arv_gc_commit_transaction (genicam, &error));
+	g_assert (error == NULL);
+
+	/* The values keep the byte order declared by the description */
+	arv_fake_camera_read_memory (fake_camera, 0x8000, sizeof (data), data);
+	g_assert (memcmp (data, reference, sizeof (reference)) == 0);
+
+	g_assert_cmpint (arv_gc_integer_get_value (ARV_GC_INTEGER (node_a), NULL), ==, 0x12345678);
+	g_assert_cmpint (arv_gc_integer_get_value (ARV_GC_INTEGER (node_b), NULL), ==, 0x9abcdef0);
+
+	g_object_unref (genicam);
+}
+
+static void
+clock_synchronization_test (void)
+{
+	ArvDevice *device;
+	ArvBuffer *buffer;
+	GError *error = NULL;
+	guint32 high, low;
+	gint64 now_ns;
+	gint64 latched_ns;
+	guint64 host_timestamp_ns;
+
+	device = arv_camera_get_device (camera);
+	g_assert (ARV_IS_GV_DEVICE (device));
+
+	/* GevTimestampControlLatch */
+	now_ns = g_get_real_time () * 1000;
+	arv_device_write_register (device, 0x944, 0x2, &error);
+	g_assert (error == NULL);
+	arv_device_read_register (device, 0x948, &high, &error);
+	g_assert (error == NULL);
+	arv_device_read_register (device, 0x94c, &low, &error);
+	g_assert (error == NULL);
+
+	latched_ns = ((guint64) high << 32) | low;
+	g_assert_cmpint (latched_ns, >=, now_ns);
+	g_assert_cmpint (latched_ns - now_ns, <, 1000000000);
+
+	arv_gv_device_set_clock_synchronization (ARV_GV_DEVICE (device), TRUE);
+	g_assert_true (arv_gv_device_get_clock_synchronization (ARV_GV_DEVICE (device)));
+
+	buffer = arv_camera_acquisition (camera, 0, &error);
+	g_assert (error == NULL);
+	g_assert (ARV_IS_BUFFER (buffer));
+
+	if (arv_buffer_get_status (buffer) == ARV_BUFFER_STATUS_SUCCESS) {
+		host_timestamp_ns = arv_buffer_get_host_timestamp (buffer);
+		now_ns = g_get_monotonic_time () * 1000;
+
+		g_assert_cmpuint (host_timestamp_ns, >, 0);
+		g_assert_cmpint (now_ns - (gint64) host_timestamp_ns, >=, 0);
+		g_assert_cmpint (now_ns - (gint64) host_timestamp_ns, <, 10000000000LL);
+	}
+
+	g_clear_object (&buffer);
+
+	arv_gv_device_set_clock_synchronization (ARV_GV_DEVICE (device), FALSE);
+}
+
+static void
+multiple_sockets_test (void)
+{
+	ArvStream *stream;
+	ArvBuffer *buffer;
+	GError *error = NULL;
+	unsigned i;
+
+	arv_camera_gv_set_stream_options (camera, ARV_GV_STREAM_OPTION_PACKET_SOCKET_DISABLED);
+
+	stream = arv_camera_create_stream (camera, NULL, NULL, NULL, &error);
+	g_assert (ARV_IS_STREAM (stream));
+	g_assert (error == NULL);
+
+	g_object_set (stream, "n-sockets", 4, NULL);
+
+	arv_stream_create_buffers (stream, 5, NULL, NULL, &error);
+	g_assert (error == NULL);
+
+	arv_camera_start_acquisition (camera, NULL);
+
+	for (i = 0; i < 10; i++) {
+		buffer = arv_stream_timeout_pop_buffer (stream, 2000000);
+		g_assert (ARV_IS_BUFFER (buffer));
+		arv_stream_push_buffer (stream, buffer);
+	}
+
+	arv_camera_stop_acquisition (camera, NULL);
+
+	g_assert_cmpint (arv_stream_get_info_uint64_by_name (stream, "n_completed_buffers"), >, 0);
+
+#ifdef __linux__
+	/* Each socket, the primary one included, must have received its share of the packets */
+	for (i = 0; i < 4; i++) {
+		char *name = g_strdup_printf ("n_received_packets_socket_%u", i);
+
+		g_assert_cmpint (arv_stream_get_info_uint64_by_name (stream, name), >, 0);
+		g_free (name);
+	}
+#endif
+
+	g_clear_object (&stream);
+
+	arv_camera_gv_set_stream_options (camera, ARV_GV_STREAM_OPTION_NONE);
+}
+
 #define N_BUFFERS	5
 
 static struct {
@@ -267,7 +908,6 @@ dynamic_roi_test (void)
 int
 main (int argc, char *argv[])
 {
-	ArvGvFakeCamera *simulator;
 	int result;
 
 	g_test_init (&argc, &argv, NULL);
@@ -286,6 +926,17 @@ main (int argc, char *argv[])
 	g_test_add_func ("/fakegv/device_registers", register_test);
 	g_test_add_func ("/fakegv/acquisition", acquisition_test);
 	g_test_add_func ("/fakegv/stream", stream_test);
+	g_test_add_func ("/fakegv/zero-copy", zero_copy_test);
+	g_test_add_func ("/fakegv/xdp-fallback", xdp_fallback_test);
+	g_test_add_func ("/fakegv/packet-resend", packet_resend_test);
+	g_test_add_func ("/fakegv/multiple-sockets", multiple_sockets_test);
+	g_test_add_func ("/fakegv/gvcp-pipelining", gvcp_pipelining_test);
+	g_test_add_func ("/fakegv/gvcp-window-fallback", gvcp_window_fallback_test);
+	g_test_add_func ("/fakegv/batched-registers", batched_registers_test);
+	g_test_add_func ("/fakegv/transaction", transaction_test);
+	g_test_add_func ("/fakegv/range-checked-transaction", range_checked_transaction_test);
+	g_test_add_func ("/fakegv/little-endian-transaction", little_endian_transaction_test);
+	g_test_add_func ("/fakegv/clock-synchronization", clock_synchronization_test);
 	g_test_add_func ("/fakegv/dynamic_roi", dynamic_roi_test);
 
 	result = g_test_run();
@@ -1422,6 +1422,308 @@ access_mode_test (void)
 	g_object_unref (device);
 }
 
+static const char link_test_xml[] =
+	"<?xml version=\"1.0\" encoding=\"utf-8\"?>"
+	"<RegisterDescription ModelName=\"Link\" VendorName=\"Aravis\">"
+	"  <Integer Name=\"Pointer\">"
+	"    <pValue>Target</pValue>"
+	"  </Integer>"
+	"  <Integer Name=\"Literal\">"
+	"    <Value>0x10</Value>"
+	"    <Min>-5</Min>"
+	"    <Max>100</Max>"
+	"  </Integer>"
+	"</RegisterDescription>";
+
+static void
+link_test (void)
+{
+	ArvGc *genicam;
+	ArvGcNode *node;
+	GError *error = NULL;
+
+	genicam = arv_gc_new (NULL, link_test_xml, strlen (link_test_xml));
+	g_assert (ARV_IS_GC (genicam));
+
+	node = arv_gc_get_node (genicam, "Literal");
+	g_assert (ARV_IS_GC_INTEGER_NODE (node));
+
+	g_assert_cmpint (arv_gc_integer_get_value (ARV_GC_INTEGER (node), &error), ==, 0x10);
+	g_assert (error == NULL);
+	g_assert_cmpint (arv_gc_integer_get_min (ARV_GC_INTEGER (node), &error), ==, -5);
+	g_assert (error == NULL);
+	g_assert_cmpint (arv_gc_integer_get_max (ARV_GC_INTEGER (node), &error), ==, 100);
+	g_assert (error == NULL);
+
+	/* The pre-parsed value must follow the writes */
+	arv_gc_integer_set_value (ARV_GC_INTEGER (node), 42, &error);
+	g_assert (error == NULL);
+	g_assert_cmpint (arv_gc_integer_get_value (ARV_GC_INTEGER (node), &error), ==, 42);
+	g_assert (error == NULL);
+
+	node = arv_gc_get_node (genicam, "Pointer");
+	g_assert (ARV_IS_GC_INTEGER_NODE (node));
+	g_assert_cmpint (arv_gc_integer_get_value (ARV_GC_INTEGER (node), &error), ==, 0);
+	g_assert (error == NULL);
+
+	/* A dangling reference must be resolved once the referenced node is added */
+	arv_gc_set_default_node_data (genicam, "Target",
+				      "<Integer Name=\"Target\">"
+				      "  <Value>1234</Value>"
+				      "</Integer>", NULL);
+	g_assert (ARV_IS_GC_INTEGER_NODE (arv_gc_get_node (genicam, "Target")));
+
+	g_assert_cmpint (arv_gc_integer_get_value (ARV_GC_INTEGER (node), &error), ==, 1234);
+	g_assert (error == NULL);
+
+	g_object_unref (genicam);
+}
+
+static const char value_cache_test_xml[] =
+	"<?xml version=\"1.0\" encoding=\"utf-8\"?>"
+	"<RegisterDescription ModelName=\"ValueCache\" VendorName=\"Aravis\">"
+	"  <Integer Name=\"A\">"
+	"    <Value>2</Value>"
+	"  </Integer>"
+	"  <Integer Name=\"B\">"
+	"    <Value>3</Value>"
+	"  </Integer>"
+	"  <Integer Name=\"Other\">"
+	"    <Value>0</Value>"
+	"  </Integer>"
+	"  <IntSwissKnife Name=\"Sum\">"
+	"    <pVariable Name=\"A\">A</pVariable>"
+	"    <pVariable Name=\"B\">B</pVariable>"
+	"    <Formula>A + B</Formula>"
+	"  </IntSwissKnife>"
+	"  <IntSwissKnife Name=\"Product\">"
+	"    <pVariable Name=\"SUM\">Sum</pVariable>"
+	"    <pVariable Name=\"B\">B</pVariable>"
+	"    <Formula>SUM * B</Formula>"
+	"  </IntSwissKnife>"
+	"  <Converter Name=\"Half\">"
+	"    <FormulaTo>2 * FROM</FormulaTo>"
+	"    <FormulaFrom>0.5 * TO</FormulaFrom>"
+	"    <pValue>Product</pValue>"
+	"  </Converter>"
+	"</RegisterDescription>";
+
+static void
+value_cache_test (void)
+{
+	ArvGc *genicam;
+	ArvGcNode *a;
+	ArvGcNode *other;
+	ArvGcNode *product;
+	ArvGcNode *half;
+	GError *error = NULL;
+	int i;
+
+	genicam = arv_gc_new (NULL, value_cache_test_xml, strlen (value_cache_test_xml));
+	g_assert (ARV_IS_GC (genicam));
+
+	a = arv_gc_get_node (genicam, "A");
+	other = arv_gc_get_node (genicam, "Other");
+	product = arv_gc_get_node (genicam, "Product");
+	half = arv_gc_get_node (genicam, "Half");
+	g_assert (ARV_IS_GC_INTEGER (a));
+	g_assert (ARV_IS_GC_INTEGER (other));
+	g_assert (ARV_IS_GC_INTEGER (product));
+	g_assert (ARV_IS_GC_FLOAT (half));
+
+	for (i = 0; i < 2; i++) {
+		g_assert_cmpint (arv_gc_integer_get_value (ARV_GC_INTEGER (product), &error), ==, 15);
+		g_assert (error == NULL);
+		g_assert_cmpfloat (arv_gc_float_get_value (ARV_GC_FLOAT (half), &error), ==, 7.5);
+		g_assert (error == NULL);
+	}
+
+	/* Change of a transitive input */
+	arv_gc_integer_set_value (ARV_GC_INTEGER (a), 7, &error);
+	g_assert (error == NULL);
+
+	g_assert_cmpint (arv_gc_integer_get_value (ARV_GC_INTEGER (product), &error), ==, 30);
+	g_assert (error == NULL);
+	g_assert_cmpfloat (arv_gc_float_get_value (ARV_GC_FLOAT (half), &error), ==, 15.0);
+	g_assert (error == NULL);
+
+	/* Change of a feature which is not an input */
+	arv_gc_integer_set_value (ARV_GC_INTEGER (other), 1, &error);
+	g_assert (error == NULL);
+
+	g_assert_cmpint (arv_gc_integer_get_value (ARV_GC_INTEGER (product), &error), ==, 30);
+	g_assert (error == NULL);
+	g_assert_cmpfloat (arv_gc_float_get_value (ARV_GC_FLOAT (half), &error), ==, 15.0);
+	g_assert (error == NULL);
+
+	g_object_unref (genicam);
+}
+
+static const char invalidator_test_xml[] =
+	"<?xml version=\"1.0\" encoding=\"utf-8\"?>"
+	"<RegisterDescription ModelName=\"Invalidator\" VendorName=\"Aravis\">"
+	"  <IntReg Name=\"Cached\">"
+	"    <Address>0x8000</Address>"
+	"    <Length>4</Length>"
+	"    <AccessMode>RW</AccessMode>"
+	"    <pPort>Device</pPort>"
+	"    <Cachable>WriteThrough</Cachable>"
+	"    <pInvalidator>Invalidator</pInvalidator>"
+	"    <Sign>Unsigned</Sign>"
+	"    <Endianess>BigEndian</Endianess>"
+	"  </IntReg>"
+	"  <IntReg Name=\"Invalidator\">"
+	"    <Address>0x8004</Address>"
+	"    <Length>4</Length>"
+	"    <AccessMode>RW</AccessMode>"
+	"    <pPort>Device</pPort>"
+	"    <Cachable>WriteThrough</Cachable>"
+	"    <Sign>Unsigned</Sign>"
+	"    <Endianess>BigEndian</Endianess>"
+	"  </IntReg>"
+	"  <IntReg Name=\"Unrelated\">"
+	"    <Address>0x8008</Address>"
+	"    <Length>4</Length>"
+	"    <AccessMode>RW</AccessMode>"
+	"    <pPort>Device</pPort>"
+	"    <Cachable>WriteThrough</Cachable>"
+	"    <Sign>Unsigned</Sign>"
+	"    <Endianess>BigEndian</Endianess>"
+	"  </IntReg>"
+	"  <Port Name=\"Device\"/>"
+	"</RegisterDescription>";
+
+static void
+invalidator_test (void)
+{
+	ArvDevice *device;
+	ArvGc *genicam;
+	ArvGcNode *cached;
+	ArvGcNode *invalidator;
+	ArvGcNode *unrelated;
+	GError *error = NULL;
+
+	device = arv_fake_device_new ("TEST0", &error);
+	g_assert (ARV_IS_FAKE_DEVICE (device));
+	g_assert (error == NULL);
+
+	genicam = arv_gc_new (device, invalidator_test_xml, strlen (invalidator_test_xml));
+	g_assert (ARV_IS_GC (genicam));
+
+	arv_gc_set_register_cache_policy (genicam, ARV_REGISTER_CACHE_POLICY_ENABLE);
+
+	cached = arv_gc_get_node (genicam, "Cached");
+	invalidator = arv_gc_get_node (genicam, "Invalidator");
+	unrelated = arv_gc_get_node (genicam, "Unrelated");
+	g_assert (ARV_IS_GC_INTEGER (cached));
+	g_assert (ARV_IS_GC_INTEGER (invalidator));
+	g_assert (ARV_IS_GC_INTEGER (unrelated));
+
+	arv_device_write_register (device, 0x8000, 1, &error);
+	g_assert (error == NULL);
+	g_assert_cmpint (arv_gc_integer_get_value (ARV_GC_INTEGER (cached), &error), ==, 1);
+	g_assert (error == NULL);
+
+	/* Device side change, behind the register cache */
+	arv_device_write_register (device, 0x8000, 2, &error);
+	g_assert (error == NULL);
+	g_assert_cmpint (arv_gc_integer_get_value (ARV_GC_INTEGER (cached), &error), ==, 1);
+	g_assert (error == NULL);
+
+	/* Writing a feature which is not an invalidator keeps the cached value */
+	arv_gc_integer_set_value (ARV_GC_INTEGER (unrelated), 5, &error);
+	g_assert (error == NULL);
+	g_assert_cmpint (arv_gc_integer_get_value (ARV_GC_INTEGER (cached), &error), ==, 1);
+	g_assert (error == NULL);
+
+	/* Writing the invalidator forces a new device read */
+	arv_gc_integer_set_value (ARV_GC_INTEGER (invalidator), 3, &error);
+	g_assert (error == NULL);
+	g_assert_cmpint (arv_gc_integer_get_value (ARV_GC_INTEGER (cached), &error), ==, 2);
+	g_assert (error == NULL);
+
+	g_object_unref (genicam);
+	g_object_unref (device);
+}
+
+static const char affected_features_test_xml[] =
+	"<?xml version=\"1.0\" encoding=\"utf-8\"?>"
+	"<RegisterDescription ModelName=\"AffectedFeatures\" VendorName=\"Aravis\">"
+	"  <Integer Name=\"Selector\">"
+	"    <Value>0</Value>"
+	"    <pSelected>Gain</pSelected>"
+	"  </Integer>"
+	"  <Integer Name=\"GainRaw\">"
+	"    <Value>10</Value>"
+	"  </Integer>"
+	"  <Integer Name=\"Gain\">"
+	"    <pValue>GainRaw</pValue>"
+	"  </Integer>"
+	"  <IntSwissKnife Name=\"Doubled\">"
+	"    <pVariable Name=\"GAIN\">Gain</pVariable>"
+	"    <Formula>2 * GAIN</Formula>"
+	"  </IntSwissKnife>"
+	"  <Integer Name=\"Unrelated\">"
+	"    <Value>0</Value>"
+	"  </Integer>"
+	"</RegisterDescription>";
+
+static void
+affected_features_test (void)
+{
+	ArvGc *genicam;
+	ArvGcNode *selector;
+	ArvGcNode *gain_raw;
+	ArvGcNode *gain;
+	ArvGcNode *doubled;
+	ArvGcNode *unrelated;
+	GSList *affected;
+	GError *error = NULL;
+
+	genicam = arv_gc_new (NULL, affected_features_test_xml, strlen (affected_features_test_xml));
+	g_assert (ARV_IS_GC (genicam));
+
+	selector = arv_gc_get_node (genicam, "Selector");
+	gain_raw = arv_gc_get_node (genicam, "GainRaw");
+	gain = arv_gc_get_node (genicam, "Gain");
+	doubled = arv_gc_get_node (genicam, "Doubled");
+	unrelated = arv_gc_get_node (genicam, "Unrelated");
+	g_assert (ARV_IS_GC_FEATURE_NODE (selector));
+	g_assert (ARV_IS_GC_FEATURE_NODE (gain_raw));
+	g_assert (ARV_IS_GC_FEATURE_NODE (gain));
+	g_assert (ARV_IS_GC_FEATURE_NODE (doubled));
+	g_assert (ARV_IS_GC_FEATURE_NODE (unrelated));
+
+	affected = arv_gc_get_affected_features (genicam, ARV_GC_FEATURE_NODE (selector));
+	g_assert_cmpint (g_slist_length (affected), ==, 2);
+	g_assert (g_slist_nth_data (affected, 0) == gain);
+	g_assert (g_slist_nth_data (affected, 1) == doubled);
+	g_slist_free (affected);
+
+	affected = arv_gc_get_affected_features (genicam, ARV_GC_FEATURE_NODE (gain_raw));
+	g_assert_cmpint (g_slist_length (affected), ==, 2);
+	g_assert (g_slist_nth_data (affected, 0) == gain);
+	g_assert (g_slist_nth_data (affected, 1) == doubled);
+	g_slist_free (affected);
+
+	affected = arv_gc_get_affected_features (genicam, ARV_GC_FEATURE_NODE (doubled));
+	g_assert (affected == NULL);
+
+	affected = arv_gc_get_affected_features (genicam, ARV_GC_FEATURE_NODE (unrelated));
+	g_assert (affected == NULL);
+
+	g_assert_cmpint (arv_gc_integer_get_value (ARV_GC_INTEGER (doubled), &error), ==, 20);
+	g_assert (error == NULL);
+
+	arv_gc_integer_set_value (ARV_GC_INTEGER (gain), 4, &error);
+	g_assert (error == NULL);
+
+	g_assert_cmpint (arv_gc_integer_get_value (ARV_GC_INTEGER (doubled), &error), ==, 8);
+	g_assert (error == NULL);
+
+	g_object_unref (genicam);
+}
+
 int
 main (int argc, char *argv[])
 {
@@ -1448,6 +1750,10 @@ main (int argc, char *argv[])
 	g_test_add_func ("/genicam/category", category_test);
 	g_test_add_func ("/genicam/lock", lock_test);
 	g_test_add_func ("/genicam/access-mode", access_mode_test);
+	g_test_add_func ("/genicam/link", link_test);
+	g_test_add_func ("/genicam/value-cache", value_cache_test);
+	g_test_add_func ("/genicam/invalidator", invalidator_test);
+	g_test_add_func ("/genicam/affected-features", affected_features_test);
 
 	result = g_test_run();
 
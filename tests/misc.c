@@ -4,7 +4,10 @@
 #include <arv.h>
 #include <arvstr.h>
 #include <string.h>
+#include <stdlib.h>
+#include <math.h>
 #include "../src/arvmiscprivate.h"
+#include "../src/arvclockmodelprivate.h"
 
 #if !ARAVIS_CHECK_VERSION (ARAVIS_MAJOR_VERSION, ARAVIS_MINOR_VERSION, ARAVIS_MICRO_VERSION)
 #error
@@ -278,6 +281,130 @@ match_test (void)
 	}
 }
 
+static void
+log_histogram_test (void)
+{
+	ArvLogHistogram *histogram;
+	guint64 value;
+	int i;
+
+	histogram = arv_log_histogram_new ();
+
+	g_assert_cmpint (arv_log_histogram_get_count (histogram), ==, 0);
+	g_assert_cmpint (arv_log_histogram_get_percentile (histogram, 50.0), ==, 0);
+
+	/* Small values are exactly counted */
+	for (i = 1; i <= 10; i++)
+		arv_log_histogram_fill (histogram, i);
+
+	g_assert_cmpint (arv_log_histogram_get_count (histogram), ==, 10);
+	g_assert_cmpint (arv_log_histogram_get_percentile (histogram, 0.0), ==, 1);
+	g_assert_cmpint (arv_log_histogram_get_percentile (histogram, 50.0), ==, 5);
+	g_assert_cmpint (arv_log_histogram_get_percentile (histogram, 90.0), ==, 9);
+	g_assert_cmpint (arv_log_histogram_get_percentile (histogram, 100.0), ==, 10);
+
+	arv_log_histogram_fill (histogram, -5);
+	g_assert_cmpint (arv_log_histogram_get_percentile (histogram, 0.0), ==, 0);
+
+	arv_log_histogram_free (histogram);
+
+	/* Large values, within 1/16 */
+	histogram = arv_log_histogram_new ();
+
+	for (i = 0; i < 989; i++)
+		arv_log_histogram_fill (histogram, 1000);
+	for (i = 0; i < 10; i++)
+		arv_log_histogram_fill (histogram, 100000);
+	arv_log_histogram_fill (histogram, G_MAXINT64);
+
+	value = arv_log_histogram_get_percentile (histogram, 50.0);
+	g_assert_cmpint (value, >=, 1000);
+	g_assert_cmpint (value, <, 1000 + 1000 / 16);
+
+	value = arv_log_histogram_get_percentile (histogram, 99.0);
+	g_assert_cmpint (value, >=, 100000);
+	g_assert_cmpint (value, <, 100000 + 100000 / 16);
+
+	g_assert_cmpuint (arv_log_histogram_get_percentile (histogram, 100.0), >=, G_MAXINT64);
+
+	arv_log_histogram_free (histogram);
+}
+
+/* Device clock 40 ppm slower than the host clock, with an arbitrary origin */
+#define CLOCK_MODEL_DRIFT	(-40e-6)
+#define CLOCK_MODEL_HOST_ORIGIN	1000000000000LL
+#define CLOCK_MODEL_DEVICE_ORIGIN	5000000000ULL
+
+static guint64
+_host_to_device (gint64 host_ns)
+{
+	return CLOCK_MODEL_DEVICE_ORIGIN + (guint64) ((host_ns - CLOCK_MODEL_HOST_ORIGIN) * (1.0 + CLOCK_MODEL_DRIFT));
+}
+
+static void
+clock_model_test (void)
+{
+	ArvClockModel *model;
+	GRand *rand;
+	double drift_ppm;
+	gint64 host_ns;
+	gint64 host_end_ns = CLOCK_MODEL_HOST_ORIGIN + 600 * 1000000000LL;
+	guint n_samples;
+	int i;
+
+	rand = g_rand_new_with_seed (1234);
+	model = arv_clock_model_new ();
+
+	g_assert_false (arv_clock_model_to_host (model, CLOCK_MODEL_DEVICE_ORIGIN, &host_ns));
+	g_assert_false (arv_clock_model_get_parameters (model, NULL, NULL, NULL));
+
+	/* One latch per second, with a round trip between 200 and 500 µs */
+	for (i = 0; i < 600; i++) {
+		gint64 latch_ns = CLOCK_MODEL_HOST_ORIGIN + i * 1000000000LL;
+		gint64 round_trip_ns = g_rand_int_range (rand, 200000, 500000);
+		gint64 before_ns = latch_ns - g_rand_int_range (rand, 0, round_trip_ns);
+
+		arv_clock_model_add_latch_sample (model, _host_to_device (latch_ns),
+						  before_ns, before_ns + round_trip_ns);
+	}
+
+	g_assert_true (arv_clock_model_get_parameters (model, &drift_ppm, NULL, &n_samples));
+	g_assert_cmpuint (n_samples, >, 0);
+	g_assert_cmpfloat (fabs (drift_ppm - 40.0), <, 1.0);
+
+	g_assert_true (arv_clock_model_to_host (model, _host_to_device (host_end_ns), &host_ns));
+	g_assert_cmpint (llabs (host_ns - host_end_ns), <, 50000);
+
+	/* Frames at 100 Hz, with a latency of at least 500 µs */
+	arv_clock_model_reset (model);
+	g_assert_false (arv_clock_model_to_host (model, CLOCK_MODEL_DEVICE_ORIGIN, &host_ns));
+
+	for (i = 0; i < 60000; i++) {
+		gint64 frame_ns = CLOCK_MODEL_HOST_ORIGIN + i * 10000000LL;
+
+		arv_clock_model_add_frame_sample (model, _host_to_device (frame_ns),
+						  frame_ns + 500000 + g_rand_int_range (rand, 0, 5000000));
+	}
+
+	g_assert_true (arv_clock_model_get_parameters (model, &drift_ppm, NULL, NULL));
+	g_assert_cmpfloat (fabs (drift_ppm - 40.0), <, 1.0);
+
+	g_assert_true (arv_clock_model_to_host (model, _host_to_device (host_end_ns), &host_ns));
+	g_assert_cmpint (host_ns - host_end_ns, >=, 450000);
+	g_assert_cmpint (host_ns - host_end_ns, <, 600000);
+
+	/* Device timestamp reset */
+	arv_clock_model_add_frame_sample (model, 1000, host_end_ns + 2000000000LL);
+	arv_clock_model_add_frame_sample (model, 2000001000, host_end_ns + 4000000000LL);
+	g_assert_true (arv_clock_model_get_parameters (model, NULL, NULL, &n_samples));
+	g_assert_cmpuint (n_samples, ==, 1);
+	g_assert_true (arv_clock_model_to_host (model, 1000, &host_ns));
+	g_assert_cmpint (host_ns, ==, host_end_ns + 2000000000LL);
+
+	arv_clock_model_free (model);
+	g_rand_free (rand);
+}
+
 int
 main (int argc, char *argv[])
 {
@@ -294,6 +421,8 @@ main (int argc, char *argv[])
 	g_test_add_func ("/gstreamer/caps-string", caps_string_test);
 	g_test_add_func ("/misc/globs", glob_test);
 	g_test_add_func ("/misc/matches", match_test);
+	g_test_add_func ("/misc/log-histogram", log_histogram_test);
+	g_test_add_func ("/misc/clock-model", clock_model_test);
 
 
 	result = g_test_run();